@@ -0,0 +1,35 @@
+#include "CarFollowingModel.h"
+
+void FCarFollowingModel::StepQueue(TArrayView<FLaneFollower> Queue, float DeltaTime)
+{
+	const int32 Count = Queue.Num();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FLaneFollower& Follower = Queue[Index];
+
+		// En öndeki araç için lider yok - serbest yol
+		float Gap = FLT_MAX;
+		float ClosingSpeed = 0.0f;
+
+		if (Index > 0)
+		{
+			// Lider bu geçişte zaten güncellendi: yeni hızı kullanılır (kare gecikmesi yok)
+			const FLaneFollower& Leader = Queue[Index - 1];
+			const float HalfLengths = 0.5f * (Leader.Params.VehicleLength + Follower.Params.VehicleLength);
+			Gap = Leader.Distance - Follower.Distance - HalfLengths;
+			ClosingSpeed = Follower.Speed - Leader.Speed;
+		}
+
+		Follower.Acceleration = ComputeAcceleration(
+			Follower.Params,
+			Follower.Speed,
+			Follower.DesiredSpeed,
+			Follower.MaxDeceleration,
+			Gap,
+			ClosingSpeed
+		);
+
+		// Hız negatif olamaz (geri gitme yok)
+		Follower.Speed = FMath::Max(0.0f, Follower.Speed + Follower.Acceleration * DeltaTime);
+	}
+}
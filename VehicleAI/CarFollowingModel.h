@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarFollowingModel.generated.h"
+
+/**
+ * Araç takip modeli (IDM - Intelligent Driver Model) parametreleri.
+ * Şerit kuyruğundaki her aracın öndeki araca göre ivmesini belirler.
+ */
+USTRUCT(BlueprintType)
+struct YOURGAMENAME_API FCarFollowingParams
+{
+	GENERATED_BODY()
+
+	/**
+	 * Maksimum hızlanma (cm/s²).
+	 * IDM formülündeki 'a' değeri.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Car Following", meta = (ClampMin = "1.0"))
+	float MaxAcceleration = 300.0f;
+
+	/**
+	 * Konforlu frenleme (cm/s², pozitif değer).
+	 * IDM formülündeki 'b' değeri. Acil durum dışındaki yavaşlamalar bu değere yakın kalır.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Car Following", meta = (ClampMin = "1.0"))
+	float ComfortableDeceleration = 400.0f;
+
+	/**
+	 * Zaman aralığı (saniye).
+	 * Öndeki araçla korunmak istenen zaman mesafesi (IDM 'T').
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Car Following", meta = (ClampMin = "0.0"))
+	float TimeHeadway = 1.2f;
+
+	/**
+	 * Durma halindeki minimum boşluk (cm).
+	 * Kuyrukta duran araçlar arasında kalan mesafe (IDM 's0').
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Car Following", meta = (ClampMin = "0.0"))
+	float MinimumGap = 200.0f;
+
+	/**
+	 * Araç uzunluğu (cm).
+	 * Boşluk hesabında merkezden merkeze mesafeden düşülür.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Car Following", meta = (ClampMin = "0.0"))
+	float VehicleLength = 450.0f;
+};
+
+/**
+ * Şerit kuyruğundaki tek bir aracın kompakt durumu.
+ * Şerit başına bitişik bir dizi halinde tutulur; kuyruk tek döngüde önden arkaya taranır.
+ */
+struct FLaneFollower
+{
+	/** Şerit (spline) başından itibaren mesafe (cm). */
+	float Distance = 0.0f;
+
+	/** Mevcut hız (cm/s). */
+	float Speed = 0.0f;
+
+	/** Hedef hız (cm/s) - CheckForwardPath tarafından belirlenen TargetSpeed. */
+	float DesiredSpeed = 0.0f;
+
+	/** Maksimum frenleme (cm/s², pozitif değer). */
+	float MaxDeceleration = 500.0f;
+
+	/** Son adımda hesaplanan ivme (cm/s²). */
+	float Acceleration = 0.0f;
+
+	FCarFollowingParams Params;
+};
+
+/**
+ * IDM tabanlı araç takip kerneli.
+ *
+ * İvme formülü:
+ * a = a_max * [1 - (v / v0)^4 - (s* / s)^2]
+ * s* = s0 + v*T + v*Δv / (2 * sqrt(a_max * b))
+ *
+ * Burada s öndeki araçla boşluk, Δv ise yaklaşma hızıdır (v - v_lider).
+ */
+struct YOURGAMENAME_API FCarFollowingModel
+{
+	/**
+	 * Sıfır olmayan hedef hızın alt sınırı (cm/s). v / v0 oranı çok küçük hedeflerde
+	 * patlamaz; aksi halde sürünen bir hedef hız maksimum frenlemeye dönüşür.
+	 */
+	static constexpr float MinDesiredSpeed = 10.0f;
+
+	/**
+	 * Tek bir araç için ivmeyi hesaplar.
+	 *
+	 * @param Params IDM parametreleri
+	 * @param Speed Mevcut hız (cm/s)
+	 * @param DesiredSpeed Hedef hız (cm/s). 0 ise araç maksimum frenleme ile durur; diğer değerler en az MinDesiredSpeed.
+	 * @param MaxDeceleration Maksimum frenleme (cm/s², pozitif)
+	 * @param Gap Öndeki araçla boşluk (cm). Lider yoksa FLT_MAX.
+	 * @param ClosingSpeed Yaklaşma hızı (cm/s, pozitif = yaklaşıyoruz)
+	 * @return İvme (cm/s²), [-MaxDeceleration, MaxAcceleration] aralığında
+	 */
+	static FORCEINLINE float ComputeAcceleration(const FCarFollowingParams& Params, float Speed, float DesiredSpeed, float MaxDeceleration, float Gap, float ClosingSpeed)
+	{
+		// Serbest yol terimi
+		float Acceleration;
+		if (DesiredSpeed <= KINDA_SMALL_NUMBER)
+		{
+			// Hedef hız 0 (kırmızı ışık, engel): CalculateBrakingDistance ile tutarlı olması için maksimum frenleme
+			Acceleration = Speed > KINDA_SMALL_NUMBER ? -MaxDeceleration : 0.0f;
+		}
+		else
+		{
+			const float SpeedRatio = Speed / FMath::Max(DesiredSpeed, MinDesiredSpeed);
+			const float SpeedRatioSquared = SpeedRatio * SpeedRatio;
+			Acceleration = Params.MaxAcceleration * (1.0f - SpeedRatioSquared * SpeedRatioSquared);
+		}
+
+		// Etkileşim terimi (öndeki araç varsa)
+		if (Gap < FLT_MAX)
+		{
+			const float DynamicGap = Speed * Params.TimeHeadway
+				+ (Speed * ClosingSpeed) / (2.0f * FMath::Sqrt(Params.MaxAcceleration * Params.ComfortableDeceleration));
+			const float DesiredGap = Params.MinimumGap + FMath::Max(0.0f, DynamicGap);
+			const float GapRatio = DesiredGap / FMath::Max(Gap, 1.0f);
+			Acceleration -= Params.MaxAcceleration * GapRatio * GapRatio;
+		}
+
+		return FMath::Clamp(Acceleration, -MaxDeceleration, Params.MaxAcceleration);
+	}
+
+	/**
+	 * Bir şerit kuyruğunu tek geçişte günceller.
+	 * Kuyruk önden arkaya sıralı olmalıdır (Queue[0] en öndeki araç).
+	 * Her araç, liderinin bu adımda güncellenmiş hızını kullandığı için
+	 * zincirleme frenleme kuyruk boyunca aynı adımda yayılır.
+	 *
+	 * @param Queue Şerit kuyruğu (Speed ve Acceleration güncellenir)
+	 * @param DeltaTime Adım süresi (saniye)
+	 */
+	static void StepQueue(TArrayView<FLaneFollower> Queue, float DeltaTime);
+};
@@ -0,0 +1,142 @@
+#include "TrafficAllocationTracker.h"
+
+#if TRAFFIC_ALLOCATION_TRACKING
+
+FTrafficMallocCounter* FTrafficMallocCounter::Instance = nullptr;
+thread_local bool FTrafficMallocCounter::bTrackingThread = false;
+
+FTrafficMallocCounter::FTrafficMallocCounter(FMalloc* InInnerMalloc)
+	: InnerMalloc(InInnerMalloc)
+	, AllocationCount(0)
+	, AllocatedBytes(0)
+{
+}
+
+FTrafficMallocCounter& FTrafficMallocCounter::Install()
+{
+	check(IsInGameThread());
+
+	if (!Instance)
+	{
+		// Vekilin kendisi sayılmaz (izleme kapsamı dışında)
+		Instance = new FTrafficMallocCounter(GMalloc);
+		GMalloc = Instance;
+		UE_LOG(LogTemp, Display, TEXT("Trafik tahsis sayacı kuruldu (%s üzerinde)"), Instance->InnerMalloc->GetDescriptiveName());
+	}
+
+	return *Instance;
+}
+
+void FTrafficMallocCounter::ResetCounts()
+{
+	AllocationCount.store(0, std::memory_order_relaxed);
+	AllocatedBytes.store(0, std::memory_order_relaxed);
+}
+
+void FTrafficMallocCounter::CountAllocation(SIZE_T Size)
+{
+	if (bTrackingThread)
+	{
+		AllocationCount.fetch_add(1, std::memory_order_relaxed);
+		AllocatedBytes.fetch_add((int64)Size, std::memory_order_relaxed);
+	}
+}
+
+void* FTrafficMallocCounter::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation(Count);
+	return InnerMalloc->Malloc(Count, Alignment);
+}
+
+void* FTrafficMallocCounter::TryMalloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation(Count);
+	return InnerMalloc->TryMalloc(Count, Alignment);
+}
+
+void* FTrafficMallocCounter::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	// Serbest bırakma (Count = 0) sayılmaz; küçültme dahil diğer her yeniden tahsis sayılır
+	// (allocator yerinde küçültmeyebilir, yeni blok ayırıp kopyalayabilir)
+	if (Count > 0)
+	{
+		CountAllocation(Count);
+	}
+	return InnerMalloc->Realloc(Original, Count, Alignment);
+}
+
+void* FTrafficMallocCounter::TryRealloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	if (Count > 0)
+	{
+		CountAllocation(Count);
+	}
+	return InnerMalloc->TryRealloc(Original, Count, Alignment);
+}
+
+void FTrafficMallocCounter::Free(void* Original)
+{
+	InnerMalloc->Free(Original);
+}
+
+SIZE_T FTrafficMallocCounter::QuantizeSize(SIZE_T Count, uint32 Alignment)
+{
+	return InnerMalloc->QuantizeSize(Count, Alignment);
+}
+
+bool FTrafficMallocCounter::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return InnerMalloc->GetAllocationSize(Original, SizeOut);
+}
+
+void FTrafficMallocCounter::Trim(bool bTrimThreadCaches)
+{
+	InnerMalloc->Trim(bTrimThreadCaches);
+}
+
+void FTrafficMallocCounter::SetupTLSCachesOnCurrentThread()
+{
+	InnerMalloc->SetupTLSCachesOnCurrentThread();
+}
+
+void FTrafficMallocCounter::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+}
+
+void FTrafficMallocCounter::InitializeStatsMetadata()
+{
+	InnerMalloc->InitializeStatsMetadata();
+}
+
+void FTrafficMallocCounter::UpdateStats()
+{
+	InnerMalloc->UpdateStats();
+}
+
+void FTrafficMallocCounter::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	InnerMalloc->GetAllocatorStats(OutStats);
+}
+
+void FTrafficMallocCounter::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	InnerMalloc->DumpAllocatorStats(Ar);
+}
+
+bool FTrafficMallocCounter::IsInternallyThreadSafe() const
+{
+	return InnerMalloc->IsInternallyThreadSafe();
+}
+
+bool FTrafficMallocCounter::ValidateHeap()
+{
+	return InnerMalloc->ValidateHeap();
+}
+
+const TCHAR* FTrafficMallocCounter::GetDescriptiveName()
+{
+	return TEXT("TrafficMallocCounter");
+}
+
+#endif
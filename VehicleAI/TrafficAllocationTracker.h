@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+
+/** Tahsis sayacı shipping dışındaki derlemelerde vardır. */
+#define TRAFFIC_ALLOCATION_TRACKING !UE_BUILD_SHIPPING
+
+#if TRAFFIC_ALLOCATION_TRACKING
+
+/**
+ * GMalloc'u saran sayaçlı tahsis vekili (hata ayıklama).
+ * Sadece FTrafficAllocationScope(true) içindeki thread'lerin Malloc / Realloc çağrıları sayılır;
+ * headless düzenek ısınmadan sonra trafik adımında tahsis olursa testi başarısız sayar.
+ *
+ * Kurulduktan sonra kaldırılmaz: vekil öncesi ve sonrası bloklar aynı iç ayırıcıya gider.
+ */
+class YOURGAMENAME_API FTrafficMallocCounter : public FMalloc
+{
+public:
+	/**
+	 * Sayacı GMalloc'un önüne kurar (ilk çağrıda; sonrakilerde mevcut sayacı döndürür).
+	 * Sadece oyun thread'inden, trafik adımı çalışmıyorken çağrılmalıdır.
+	 */
+	static FTrafficMallocCounter& Install();
+
+	/** Kurulu sayaç (nullptr = kurulmadı). */
+	static FTrafficMallocCounter* Get() { return Instance; }
+
+	/** İzlenen kapsamlarda yapılan tahsis sayısı. */
+	int64 GetAllocationCount() const { return AllocationCount.load(std::memory_order_relaxed); }
+
+	/** İzlenen kapsamlarda tahsis edilen toplam byte. */
+	int64 GetAllocatedBytes() const { return AllocatedBytes.load(std::memory_order_relaxed); }
+
+	void ResetCounts();
+
+	// FMalloc
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void Trim(bool bTrimThreadCaches) override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void InitializeStatsMetadata() override;
+	virtual void UpdateStats() override;
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual bool ValidateHeap() override;
+	virtual const TCHAR* GetDescriptiveName() override;
+
+private:
+	explicit FTrafficMallocCounter(FMalloc* InInnerMalloc);
+
+	/** İzlenen bir kapsamdaysa tahsisi sayar. */
+	void CountAllocation(SIZE_T Size);
+
+	FMalloc* InnerMalloc;
+
+	std::atomic<int64> AllocationCount;
+	std::atomic<int64> AllocatedBytes;
+
+	static FTrafficMallocCounter* Instance;
+
+	friend class FTrafficAllocationScope;
+
+	/** Bu thread'deki tahsisler sayılıyor mu (FTrafficAllocationScope ile değişir). */
+	static thread_local bool bTrackingThread;
+};
+
+/**
+ * Bu thread'in tahsislerini kapsam boyunca izler (true) veya izlemeyi durdurur (false).
+ * Kapsamlar iç içe geçebilir; çıkışta önceki durum geri yüklenir. Örnek:
+ * trafik adımı izlenir, ParallelFor'un kendi görev verisi (motor) izlenmez,
+ * şerit gövdeleri tekrar izlenir.
+ */
+class FTrafficAllocationScope
+{
+public:
+	explicit FTrafficAllocationScope(bool bTrack)
+		: bPreviousTracking(FTrafficMallocCounter::bTrackingThread)
+	{
+		FTrafficMallocCounter::bTrackingThread = bTrack;
+	}
+
+	~FTrafficAllocationScope()
+	{
+		FTrafficMallocCounter::bTrackingThread = bPreviousTracking;
+	}
+
+private:
+	bool bPreviousTracking;
+};
+
+#define TRAFFIC_TRACK_ALLOCATIONS() FTrafficAllocationScope PREPROCESSOR_JOIN(TrafficAllocationScope, __LINE__)(true)
+#define TRAFFIC_IGNORE_ALLOCATIONS() FTrafficAllocationScope PREPROCESSOR_JOIN(TrafficAllocationScope, __LINE__)(false)
+
+#else
+
+#define TRAFFIC_TRACK_ALLOCATIONS()
+#define TRAFFIC_IGNORE_ALLOCATIONS()
+
+#endif
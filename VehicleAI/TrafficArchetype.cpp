@@ -0,0 +1,151 @@
+#include "TrafficArchetype.h"
+#include "TrafficSubsystem.h"
+
+TArray<FTrafficArchetypeParams> FTrafficArchetypeTable::Entries = { FTrafficArchetypeParams() };
+TMap<TObjectKey<UTrafficArchetype>, uint16> FTrafficArchetypeTable::Indices;
+TArray<TPair<FString, FString>> FTrafficArchetypeTable::ParamOverrides;
+TArray<UTrafficSubsystem*> FTrafficArchetypeTable::Readers;
+
+namespace
+{
+	/** Alan yolunu (iç içe struct'lar '.' ile) yansıma ile bulur ve değeri metinden yazar. */
+	bool ImportParam(FTrafficArchetypeParams& Params, const FString& PropertyPath, const FString& Value)
+	{
+		TArray<FString> Names;
+		PropertyPath.ParseIntoArray(Names, TEXT("."));
+
+		const UStruct* Struct = FTrafficArchetypeParams::StaticStruct();
+		void* Container = &Params;
+		for (int32 Index = 0; Index < Names.Num(); ++Index)
+		{
+			const FProperty* Property = Struct->FindPropertyByName(FName(*Names[Index]));
+			if (!Property)
+			{
+				return false;
+			}
+
+			void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Container);
+			if (Index == Names.Num() - 1)
+			{
+				return Property->ImportText_Direct(*Value, ValuePtr, nullptr, PPF_None) != nullptr;
+			}
+
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			if (!StructProperty)
+			{
+				return false;
+			}
+			Struct = StructProperty->Struct;
+			Container = ValuePtr;
+		}
+		return false;
+	}
+}
+
+#if WITH_EDITOR
+void UTrafficArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	FTrafficArchetypeTable::Refresh(this);
+}
+#endif
+
+uint16 FTrafficArchetypeTable::Register(const UTrafficArchetype* Archetype)
+{
+	if (!Archetype)
+	{
+		return DefaultIndex;
+	}
+
+	check(IsInGameThread());
+
+	if (const uint16* ExistingIndex = Indices.Find(Archetype))
+	{
+		return *ExistingIndex;
+	}
+
+	// Araç başına 16-bit indeks
+	if (Entries.Num() > MAX_uint16)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Archetype tablosu dolu, varsayılan kullanılıyor: %s"), *Archetype->GetName());
+		return DefaultIndex;
+	}
+
+	// Entries yeniden tahsis edilebilir
+	FinishReaderSteps();
+
+	const uint16 NewIndex = (uint16)Entries.Add(Archetype->Params);
+	ApplyParamOverrides(Entries[NewIndex]);
+	Indices.Add(Archetype, NewIndex);
+	return NewIndex;
+}
+
+void FTrafficArchetypeTable::Refresh(const UTrafficArchetype* Archetype)
+{
+	if (const uint16* ExistingIndex = Indices.Find(Archetype))
+	{
+		FinishReaderSteps();
+		Entries[*ExistingIndex] = Archetype->Params;
+		ApplyParamOverrides(Entries[*ExistingIndex]);
+	}
+}
+
+bool FTrafficArchetypeTable::SetParamOverride(const FString& PropertyPath, const FString& Value)
+{
+	check(IsInGameThread());
+
+	// Önce kopya üzerinde dene: geçersiz yol tabloyu yarım değiştirmesin
+	FTrafficArchetypeParams Probe = Entries[DefaultIndex];
+	if (!ImportParam(Probe, PropertyPath, Value))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Archetype parametresi ayarlanamadı: %s = %s"), *PropertyPath, *Value);
+		return false;
+	}
+
+	FinishReaderSteps();
+
+	ParamOverrides.Emplace(PropertyPath, Value);
+	for (FTrafficArchetypeParams& Params : Entries)
+	{
+		ImportParam(Params, PropertyPath, Value);
+	}
+	return true;
+}
+
+void FTrafficArchetypeTable::AddReader(UTrafficSubsystem* Subsystem)
+{
+	check(IsInGameThread());
+	Readers.AddUnique(Subsystem);
+}
+
+void FTrafficArchetypeTable::RemoveReader(UTrafficSubsystem* Subsystem)
+{
+	check(IsInGameThread());
+	Readers.Remove(Subsystem);
+
+	// Son dünya kapandı: indeksler bir sonraki dünyada kayıt sırasıyla yeniden verilir
+	if (Readers.Num() == 0)
+	{
+		Entries.Reset();
+		Entries.Add(FTrafficArchetypeParams());
+		Indices.Reset();
+		ParamOverrides.Reset();
+	}
+}
+
+void FTrafficArchetypeTable::FinishReaderSteps()
+{
+	for (UTrafficSubsystem* Subsystem : Readers)
+	{
+		Subsystem->FinishPipelinedStep();
+	}
+}
+
+void FTrafficArchetypeTable::ApplyParamOverrides(FTrafficArchetypeParams& Params)
+{
+	for (const TPair<FString, FString>& Override : ParamOverrides)
+	{
+		ImportParam(Params, Override.Key, Override.Value);
+	}
+}
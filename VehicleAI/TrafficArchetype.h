@@ -0,0 +1,255 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CarFollowingModel.h"
+#include "TrafficArchetype.generated.h"
+
+class UTrafficSubsystem;
+
+/**
+ * Archetype yetenekleri.
+ * Controller güncellemesi yetenek kümesine göre ayrı derlenmiş varyantlarla yapılır
+ * (TrafficUpdatePolicy.h); yeteneği olmayan archetype'ların döngüsünde ilgili dallar yoktur.
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ETrafficCapability : uint8
+{
+	None			= 0 UMETA(Hidden),
+
+	/** Tehdit yayınlarıyla paniğe girer (ışıkları görmezden gelir, kaçar). */
+	Panic			= 1 << 0,
+
+	/** Işının algıladığı araçların hızına uyar (şerit dışı veya başka şeritteki araçlar). */
+	AdaptiveCruise	= 1 << 1 UMETA(DisplayName = "Adaptive Cruise (ACC)"),
+
+	/** TargetLaneOffset'e yumuşak geçiş (yoksa offset doğrudan hedefe eşitlenir). */
+	LaneChange		= 1 << 2,
+
+	/** Trafik ışıklarına uyar (yoksa ışıklar sıradan engeldir; sinyalsiz yollar için). */
+	SignalAware		= 1 << 3,
+
+	All				= Panic | AdaptiveCruise | LaneChange | SignalAware UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(ETrafficCapability);
+
+/**
+ * Sürücü + araç archetype parametreleri ("temkinli işe giden", "taksi", "otobüs").
+ * Aynı archetype'taki tüm araçlar bu değerleri paylaşır; araç başına sadece
+ * archetype indeksi ve birkaç sürücü varyans byte'ı tutulur (FTrafficDriverVariance).
+ */
+USTRUCT(BlueprintType)
+struct YOURGAMENAME_API FTrafficArchetypeParams
+{
+	GENERATED_BODY()
+
+	// ============================================
+	// SÜRÜCÜ - ALGILAMA
+	// ============================================
+
+	/**
+	 * Önündeki engelleri algılamak için kullanılan maksimum algılama mesafesi (birim).
+	 * CheckForwardPath'teki LineTrace bu mesafe içindeki nesneleri algılar.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Perception", meta = (ClampMin = "0.0"))
+	float DetectionDistance = 1000.0f;
+
+	/**
+	 * Engelin rotamızda olup olmadığını anlamak için kullanılan Dot Product eşiği.
+	 * 1.0'a yakınsa engel tam önümüzde, 0.0'a yakınsa yanımızda demektir.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Perception", meta = (ClampMin = "-1.0", ClampMax = "1.0"))
+	float DotProductThreshold = 0.7f;
+
+	// ============================================
+	// SÜRÜCÜ - KİNEMATİK
+	// ============================================
+
+	/** Yeşil ışıkta veya engel yokken hedef hız (cm/s). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Kinematics", meta = (ClampMin = "0.0"))
+	float MaxSpeed = 1000.0f;
+
+	/**
+	 * Maksimum frenleme gücü (negatif ivme, cm/s²).
+	 * CalculateBrakingDistance'ta v² = u² + 2as formülündeki 'a'.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Kinematics", meta = (ClampMax = "0.0"))
+	float MaxBrakingDeceleration = -500.0f;
+
+	/** Spline üzerinde en yakın noktadan ileriye bakılan mesafe (birim). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline Path", meta = (ClampMin = "1.0"))
+	float LookAheadDistance = 500.0f;
+
+	/** Şerit değiştirme hızı (birim/saniye). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lane Changing", meta = (ClampMin = "0.0"))
+	float LaneChangeSpeed = 200.0f;
+
+	/**
+	 * Şeritteki lider bu hızın (MaxSpeed oranı) altındaysa sollama planlanır (0 = sollama yok).
+	 * LaneChange yeteneği gerekir.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lane Changing", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float OvertakeSpeedRatio = 0.8f;
+
+	/** Sollanacak liderin en fazla uzaklığı (birim). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lane Changing", meta = (ClampMin = "0.0"))
+	float OvertakeLookahead = 3000.0f;
+
+	/** Öndeki araçla mesafe bu değerden azsa hız öndeki aracın hızına eşitlenir (ACC, birim). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ACC", meta = (ClampMin = "0.0"))
+	float SafeFollowingDistance = 500.0f;
+
+	/** Araç takip modeli (IDM) parametreleri. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Car Following")
+	FCarFollowingParams CarFollowing;
+
+	/**
+	 * Yetenekler (ETrafficCapability). Arka plan trafiği için gereksiz yetenekleri kapatmak
+	 * araç güncellemesini dalsız bir varyanta taşır.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Capabilities", meta = (Bitmask, BitmaskEnum = "/Script/YourGameName.ETrafficCapability"))
+	uint8 Capabilities = (uint8)ETrafficCapability::All;
+
+	// ============================================
+	// SÜRÜCÜ VARYANSI
+	// ============================================
+
+	/** MaxSpeed'in sürücüden sürücüye en fazla sapma oranı (0.1 = ±%10). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Driver Variance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float SpeedVariance = 0.1f;
+
+	/** TimeHeadway ve SafeFollowingDistance sapma oranı. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Driver Variance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float HeadwayVariance = 0.2f;
+
+	/** LaneChangeSpeed sapma oranı. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Driver Variance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float LaneChangeVariance = 0.25f;
+
+	// ============================================
+	// ARAÇ
+	// ============================================
+
+	/** Aracın uygulayabileceği en yüksek hız (cm/s). AVehicle::ApplyMovement'ta kullanılır. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vehicle", meta = (ClampMin = "0.0"))
+	float MaxMovementSpeed = 1000.0f;
+
+	/** Maksimum direksiyon açısı (derece). AVehicle::ApplySteering'de kullanılır. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vehicle", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float MaxSteeringAngle = 45.0f;
+};
+
+/**
+ * Sürücü başına varyans (3 byte).
+ * 128 = archetype değeri; 0 - 255 aralığı archetype'ın varyans oranına [-1, +1] olarak eşlenir.
+ * TrafficId'den türetilir, böylece uzak alana inip dönen araç aynı sürücü karakterini korur.
+ */
+struct FTrafficDriverVariance
+{
+	uint8 Speed = 128;
+	uint8 Headway = 128;
+	uint8 LaneChange = 128;
+
+	/** Kimlikten deterministik varyans üretir. */
+	static FTrafficDriverVariance FromSeed(uint32 Seed)
+	{
+		const uint32 Hash = MurmurFinalize32(Seed);
+
+		FTrafficDriverVariance Variance;
+		Variance.Speed = (uint8)(Hash & 0xFF);
+		Variance.Headway = (uint8)((Hash >> 8) & 0xFF);
+		Variance.LaneChange = (uint8)((Hash >> 16) & 0xFF);
+		return Variance;
+	}
+
+	/** Varyans byte'ını çarpana çevirir (1 ± Range). */
+	static FORCEINLINE float ToScale(uint8 Value, float Range)
+	{
+		return 1.0f + ((float)Value - 128.0f) * (1.0f / 128.0f) * Range;
+	}
+};
+
+/**
+ * Sürücü / araç archetype veri asset'i.
+ * AVehicle::Archetype ile araç sınıfına veya yerleştirilmiş araca atanır.
+ * Çalışma zamanında parametreler FTrafficArchetypeTable'a bir kez kopyalanır.
+ */
+UCLASS(BlueprintType)
+class YOURGAMENAME_API UTrafficArchetype : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Archetype", meta = (ShowOnlyInnerProperties))
+	FTrafficArchetypeParams Params;
+
+#if WITH_EDITOR
+	/** PIE sırasında yapılan düzenlemeler tablodaki kopyaya yansıtılır. */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
+
+/**
+ * Archetype parametrelerinin bitişik, değişmez çalışma zamanı tablosu.
+ * İndeks 0, archetype atanmamış araçların kullandığı varsayılan parametrelerdir.
+ * Kayıt sadece oyun thread'inde yapılır (spawn); paralel adımlar sadece okur. Tabloyu
+ * değiştiren her çağrı önce okuyucu subsystem'lerin devam eden adımlarını bekler.
+ * Tablo, oyun dünyalarının ömrüne bağlıdır: son UTrafficSubsystem kapanınca sıfırlanır,
+ * böylece her dünya (PIE, headless koşu) aynı kayıt sırasıyla aynı indeksleri alır.
+ */
+class YOURGAMENAME_API FTrafficArchetypeTable
+{
+public:
+	/** Varsayılan archetype indeksi. */
+	static constexpr uint16 DefaultIndex = 0;
+
+	/**
+	 * Archetype'ı tabloya ekler (ilk seferde) ve indeksini döndürür.
+	 *
+	 * @param Archetype Asset (nullptr = DefaultIndex)
+	 */
+	static uint16 Register(const UTrafficArchetype* Archetype);
+
+	/** Kayıtlıysa tablodaki kopyayı asset'ten yeniler (editör). */
+	static void Refresh(const UTrafficArchetype* Archetype);
+
+	/**
+	 * Tüm archetype'larda (kayıtlı ve sonradan kaydedilecek) bir parametreyi değiştirir
+	 * (headless parametre taraması). Değişiklik dünya kapanana kadar kalır.
+	 *
+	 * @param PropertyPath FTrafficArchetypeParams alan yolu (ör. "SafeFollowingDistance", "CarFollowing.TimeHeadway")
+	 * @param Value Değer metni (UPROPERTY metin biçimi)
+	 * @return Alan bulunamadıysa veya değer ayrıştırılamadıysa false
+	 */
+	static bool SetParamOverride(const FString& PropertyPath, const FString& Value);
+
+	static FORCEINLINE const FTrafficArchetypeParams& Get(uint16 Index)
+	{
+		return Entries[Index];
+	}
+
+	/** Tabloyu okuyan subsystem'i ekler (UTrafficSubsystem::Initialize). */
+	static void AddReader(UTrafficSubsystem* Subsystem);
+
+	/** Subsystem'i çıkarır (Deinitialize). Son okuyucu çıkınca tablo ve değişiklikler sıfırlanır. */
+	static void RemoveReader(UTrafficSubsystem* Subsystem);
+
+private:
+	/** Tablo değişmeden önce okuyucuların worker adımlarını bekler (adımlar Entries'i okur). */
+	static void FinishReaderSteps();
+
+	/** Tabloyu okuyan subsystem'ler (kendilerini Deinitialize'da çıkarır). */
+	static TArray<UTrafficSubsystem*> Readers;
+
+	/** Parametreler (indeks 0 = varsayılan). */
+	static TArray<FTrafficArchetypeParams> Entries;
+
+	/** Asset -> indeks. */
+	static TMap<TObjectKey<UTrafficArchetype>, uint16> Indices;
+
+	/** SetParamOverride değişiklikleri (alan yolu, değer), kayıt sırasıyla uygulanır. */
+	static TArray<TPair<FString, FString>> ParamOverrides;
+
+	/** Değişiklikleri parametrelere uygular. */
+	static void ApplyParamOverrides(FTrafficArchetypeParams& Params);
+};
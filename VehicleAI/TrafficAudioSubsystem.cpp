@@ -0,0 +1,267 @@
+#include "TrafficAudioSubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Sound/SoundBase.h"
+#include "TrafficSubsystem.h" // STATGROUP_Traffic
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Audio Voices"), STAT_TrafficActiveVoices, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Audio Requests"), STAT_TrafficCulledAudioRequests, STATGROUP_Traffic);
+
+UTrafficAudioSubsystem::UTrafficAudioSubsystem()
+{
+	MaxVoices = 8;
+	MaxVoicesPerSound = 4;
+	MaxAudibleDistance = 5000.0f; // 50 metre
+	ListenerLocation = FVector::ZeroVector;
+}
+
+void UTrafficAudioSubsystem::Deinitialize()
+{
+	for (UAudioComponent* Component : VoiceComponents)
+	{
+		if (Component)
+		{
+			Component->Stop();
+			Component->DestroyComponent();
+		}
+	}
+
+	VoiceComponents.Empty();
+	Voices.Empty();
+	PendingRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UTrafficAudioSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrafficAudioSubsystem, STATGROUP_Tickables);
+}
+
+bool UTrafficAudioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrafficAudioSubsystem::RequestSound(USoundBase* Sound, AActor* Source, float Urgency)
+{
+	if (!Sound || !Source || Urgency <= 0.0f)
+	{
+		return;
+	}
+
+	FTrafficAudioRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Source = Source;
+	Request.Sound = Sound;
+	Request.Location = Source->GetActorLocation();
+	Request.Urgency = Urgency;
+}
+
+int32 UTrafficAudioSubsystem::GetActiveVoiceCount() const
+{
+	int32 Count = 0;
+	for (const UAudioComponent* Component : VoiceComponents)
+	{
+		if (Component && Component->IsPlaying())
+		{
+			++Count;
+		}
+	}
+	return Count;
+}
+
+void UTrafficAudioSubsystem::Tick(float DeltaTime)
+{
+	if (!UpdateListenerLocation())
+	{
+		// Dinleyici yok (headless / sunucu): ses çalınmaz
+		SET_DWORD_STAT(STAT_TrafficCulledAudioRequests, PendingRequests.Num());
+		PendingRequests.Reset();
+		return;
+	}
+
+	// Çalan kanalların önceliğini ve konumunu güncelle, bitenleri boşalt
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		FTrafficAudioVoice& Voice = Voices[Index];
+		UAudioComponent* Component = VoiceComponents[Index];
+
+		if (!Component || !Component->IsPlaying())
+		{
+			Voice = FTrafficAudioVoice();
+			continue;
+		}
+
+		if (const AActor* Source = Voice.Source.Get())
+		{
+			Component->SetWorldLocation(Source->GetActorLocation());
+		}
+		Voice.Priority = CalculatePriority(Component->GetComponentLocation(), Voice.Urgency);
+	}
+
+	if (PendingRequests.Num() == 0)
+	{
+		SET_DWORD_STAT(STAT_TrafficActiveVoices, GetActiveVoiceCount());
+		SET_DWORD_STAT(STAT_TrafficCulledAudioRequests, 0);
+		return;
+	}
+
+	if (VoiceComponents.Num() == 0)
+	{
+		CreateVoices();
+	}
+
+	// Duyulmayan istekleri ele, kalanları önceliğe göre sırala
+	int32 NumCulled = 0;
+	for (int32 Index = PendingRequests.Num() - 1; Index >= 0; --Index)
+	{
+		FTrafficAudioRequest& Request = PendingRequests[Index];
+		Request.Priority = CalculatePriority(Request.Location, Request.Urgency);
+		if (Request.Priority <= 0.0f)
+		{
+			PendingRequests.RemoveAtSwap(Index, 1, false);
+			++NumCulled;
+		}
+	}
+
+	PendingRequests.Sort([](const FTrafficAudioRequest& A, const FTrafficAudioRequest& B)
+	{
+		return A.Priority > B.Priority;
+	});
+
+	for (const FTrafficAudioRequest& Request : PendingRequests)
+	{
+		const int32 VoiceIndex = FindVoiceForRequest(Request);
+		if (VoiceIndex == INDEX_NONE)
+		{
+			++NumCulled;
+			continue;
+		}
+
+		UAudioComponent* Component = VoiceComponents[VoiceIndex];
+		Component->Stop();
+		Component->SetSound(Request.Sound);
+		Component->SetWorldLocation(Request.Location);
+		Component->Play();
+
+		FTrafficAudioVoice& Voice = Voices[VoiceIndex];
+		Voice.Source = Request.Source;
+		Voice.Sound = Request.Sound;
+		Voice.Urgency = Request.Urgency;
+		Voice.Priority = Request.Priority;
+	}
+
+	PendingRequests.Reset();
+
+	SET_DWORD_STAT(STAT_TrafficActiveVoices, GetActiveVoiceCount());
+	SET_DWORD_STAT(STAT_TrafficCulledAudioRequests, NumCulled);
+}
+
+void UTrafficAudioSubsystem::CreateVoices()
+{
+	UWorld* World = GetWorld();
+	AWorldSettings* WorldSettings = World ? World->GetWorldSettings() : nullptr;
+	if (!WorldSettings)
+	{
+		return;
+	}
+
+	VoiceComponents.Reserve(MaxVoices);
+	Voices.SetNum(MaxVoices);
+
+	for (int32 Index = 0; Index < MaxVoices; ++Index)
+	{
+		// Hiçbir araca bağlı değil - konum her karede kaynaktan kopyalanır
+		UAudioComponent* Component = NewObject<UAudioComponent>(WorldSettings);
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false;
+		Component->bAllowSpatialization = true;
+		Component->RegisterComponentWithWorld(World);
+		VoiceComponents.Add(Component);
+	}
+}
+
+bool UTrafficAudioSubsystem::UpdateListenerLocation()
+{
+	UWorld* World = GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PlayerController || !PlayerController->IsLocalController())
+	{
+		return false;
+	}
+
+	FVector FrontDir;
+	FVector RightDir;
+	PlayerController->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+	return true;
+}
+
+float UTrafficAudioSubsystem::CalculatePriority(const FVector& Location, float Urgency) const
+{
+	const float DistanceSquared = FVector::DistSquared(Location, ListenerLocation);
+	if (DistanceSquared >= FMath::Square(MaxAudibleDistance))
+	{
+		return 0.0f;
+	}
+
+	// Yakın ve acil sesler önce: mesafe ile doğrusal azalan ağırlık
+	const float DistanceWeight = 1.0f - FMath::Sqrt(DistanceSquared) / MaxAudibleDistance;
+	return Urgency * DistanceWeight;
+}
+
+int32 UTrafficAudioSubsystem::FindVoiceForRequest(const FTrafficAudioRequest& Request) const
+{
+	int32 FreeVoice = INDEX_NONE;
+	int32 LowestVoice = INDEX_NONE;
+	int32 LowestSameSoundVoice = INDEX_NONE;
+	int32 SameSoundCount = 0;
+
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		const FTrafficAudioVoice& Voice = Voices[Index];
+
+		if (!Voice.Sound)
+		{
+			if (FreeVoice == INDEX_NONE)
+			{
+				FreeVoice = Index;
+			}
+			continue;
+		}
+
+		// Aynı kaynak zaten çalıyorsa onun kanalı yeniden kullanılır
+		if (Voice.Source == Request.Source)
+		{
+			return Index;
+		}
+
+		if (LowestVoice == INDEX_NONE || Voice.Priority < Voices[LowestVoice].Priority)
+		{
+			LowestVoice = Index;
+		}
+
+		if (Voice.Sound == Request.Sound)
+		{
+			++SameSoundCount;
+			if (LowestSameSoundVoice == INDEX_NONE || Voice.Priority < Voices[LowestSameSoundVoice].Priority)
+			{
+				LowestSameSoundVoice = Index;
+			}
+		}
+	}
+
+	// Ses başına eşzamanlılık sınırı: sadece aynı sesin daha düşük öncelikli kanalı çalınabilir
+	if (SameSoundCount >= MaxVoicesPerSound)
+	{
+		return Voices[LowestSameSoundVoice].Priority < Request.Priority ? LowestSameSoundVoice : INDEX_NONE;
+	}
+
+	if (FreeVoice != INDEX_NONE)
+	{
+		return FreeVoice;
+	}
+
+	return LowestVoice != INDEX_NONE && Voices[LowestVoice].Priority < Request.Priority ? LowestVoice : INDEX_NONE;
+}
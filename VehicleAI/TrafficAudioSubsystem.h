@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrafficAudioSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+/**
+ * Havuzdaki bir ses kanalının (voice) durumu.
+ * Component'in kendisi GC için UTrafficAudioSubsystem::VoiceComponents içinde tutulur.
+ */
+USTRUCT()
+struct FTrafficAudioVoice
+{
+	GENERATED_BODY()
+
+	/** Sesin takip ettiği aktör (araç). Yok olursa ses son konumunda biter. */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Source;
+
+	/** Çalan ses (eşzamanlılık sınırı için). Kanal çaldıkça GC'den korunur. */
+	UPROPERTY()
+	TObjectPtr<USoundBase> Sound = nullptr;
+
+	/** İsteğin aciliyeti (öncelik her karede dinleyici mesafesiyle yeniden hesaplanır). */
+	float Urgency = 0.0f;
+
+	/** Güncel öncelik. Daha yüksek öncelikli bir istek gelirse en düşük öncelikli kanal çalınır. */
+	float Priority = 0.0f;
+};
+
+/**
+ * Bekleyen ses isteği (bir sonraki Tick'te kanallara dağıtılır).
+ */
+USTRUCT()
+struct FTrafficAudioRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Source;
+
+	/** İstek dağıtılana kadar GC'den korunur. */
+	UPROPERTY()
+	TObjectPtr<USoundBase> Sound = nullptr;
+
+	FVector Location = FVector::ZeroVector;
+	float Urgency = 0.0f;
+	float Priority = 0.0f;
+};
+
+/**
+ * Trafik ses alt sistemi.
+ * Araç başına UAudioComponent yerine sabit sayıda ses kanalını (MaxVoices) paylaştırır.
+ * İstekler kare boyunca toplanır, Tick'te dinleyiciye uzaklık ve aciliyete göre
+ * önceliklendirilir; duyulma mesafesi dışındakiler ve sınırı aşanlar hiç çalınmaz.
+ * Böylece ses CPU ve bellek maliyeti trafik yoğunluğundan bağımsız kalır.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficAudioSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficAudioSubsystem();
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Bir aracın sesini çalma isteği gönderir (korna vb.).
+	 * İstek hemen çalınmaz; bir sonraki Tick'te diğer isteklerle birlikte önceliklendirilir.
+	 *
+	 * @param Sound Çalınacak ses
+	 * @param Source Sesi çıkaran aktör (ses onu takip eder)
+	 * @param Urgency Aciliyet (1 = normal, panik vb. durumlarda daha yüksek)
+	 */
+	void RequestSound(USoundBase* Sound, AActor* Source, float Urgency = 1.0f);
+
+	/** Şu an çalan kanal sayısı. */
+	int32 GetActiveVoiceCount() const;
+
+protected:
+	/** Havuzdaki toplam ses kanalı. */
+	UPROPERTY(Config)
+	int32 MaxVoices;
+
+	/** Aynı sesin (ör. aynı korna) aynı anda çalabileceği en fazla kanal. */
+	UPROPERTY(Config)
+	int32 MaxVoicesPerSound;
+
+	/** Bu mesafeden (birim) uzak istekler öncelik hesaplanmadan elenir. */
+	UPROPERTY(Config)
+	float MaxAudibleDistance;
+
+private:
+	/** Havuz kanallarını oluşturur (ilk istekte, bir kez). */
+	void CreateVoices();
+
+	/** Dinleyici konumunu günceller. Dinleyici yoksa (headless) false döner. */
+	bool UpdateListenerLocation();
+
+	/** Dinleyici mesafesi ve aciliyetten öncelik hesaplar (0 = duyulmaz). */
+	float CalculatePriority(const FVector& Location, float Urgency) const;
+
+	/** İsteği çalacak kanalı seçer: boş kanal, yoksa daha düşük öncelikli en düşük kanal. */
+	int32 FindVoiceForRequest(const FTrafficAudioRequest& Request) const;
+
+	/** Havuz ses component'leri (Voices ile aynı sırada). */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> VoiceComponents;
+
+	/** Kanal durumları. */
+	UPROPERTY(Transient)
+	TArray<FTrafficAudioVoice> Voices;
+
+	/** Bu karede toplanan istekler. */
+	UPROPERTY(Transient)
+	TArray<FTrafficAudioRequest> PendingRequests;
+
+	/** Dinleyici (oyuncu kamerası) konumu. */
+	FVector ListenerLocation;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VehicleAIController.h" // EVehicleBehavior
+
+/**
+ * Davranış olayları.
+ * Her karede sürüş kararlarından (panik, şerit offset'i, hız, durma nedeni) türetilir
+ * ve sabit sırada geçiş tablosuna uygulanır: panik, şerit değiştirme, hareket.
+ */
+enum class EVehicleBehaviorEvent : uint8
+{
+	/** Hız TrafficBehavior::StoppedSpeed'in üstünde. */
+	Move,
+
+	/** Kırmızı / sarı ışıkta durdu. */
+	StopAtLight,
+
+	/** Öndeki araç nedeniyle durdu (şerit kuyruğu veya ACC). */
+	StopInQueue,
+
+	/** Araç olmayan bir engel nedeniyle durdu. */
+	StopForObstacle,
+
+	BeginLaneChange,
+	EndLaneChange,
+	BeginPanic,
+	EndPanic,
+
+	Count
+};
+
+/**
+ * Durum başına çalışan güncellemeler.
+ * UTrafficSubsystem her güncellemeyi sadece o güncellemeye ihtiyaç duyan durum kovalarında çalıştırır.
+ */
+enum class EVehicleBehaviorUpdate : uint8
+{
+	None		= 0,
+
+	/** UpdateSteering (sadece hareket eden araçlar; duran aracın direksiyonu sıfırlanır). */
+	Steering	= 1 << 0,
+
+	/** Şerit değiştirme yönünde yan sensör (IsSidePathClear). */
+	SideCheck	= 1 << 1,
+};
+ENUM_CLASS_FLAGS(EVehicleBehaviorUpdate);
+
+/**
+ * Davranış durum makinesi tabloları.
+ */
+namespace TrafficBehavior
+{
+	constexpr int32 NumStates = 6;
+	constexpr int32 NumEvents = (int32)EVehicleBehaviorEvent::Count;
+
+	static_assert((int32)EVehicleBehavior::Panicking == NumStates - 1, "NumStates EVehicleBehavior ile uyumlu olmalı");
+
+	/** Bu hızın (cm/s) altındaki araç durmuş sayılır. */
+	constexpr float StoppedSpeed = 10.0f;
+
+	/**
+	 * Geçiş tablosu: Transitions[durum][olay] = yeni durum.
+	 * Panik diğer tüm olayları bastırır; şerit değiştirme tamamlanana kadar durma olaylarını bastırır.
+	 */
+	constexpr EVehicleBehavior Transitions[NumStates][NumEvents] =
+	{
+		//					Move							StopAtLight							StopInQueue						StopForObstacle					BeginLaneChange						EndLaneChange						BeginPanic						EndPanic
+		/* Normal */		{ EVehicleBehavior::Normal,		EVehicleBehavior::StoppedAtLight,	EVehicleBehavior::Queued,		EVehicleBehavior::Waiting,		EVehicleBehavior::LaneChanging,		EVehicleBehavior::Normal,			EVehicleBehavior::Panicking,	EVehicleBehavior::Normal },
+		/* Waiting */		{ EVehicleBehavior::Normal,		EVehicleBehavior::StoppedAtLight,	EVehicleBehavior::Queued,		EVehicleBehavior::Waiting,		EVehicleBehavior::LaneChanging,		EVehicleBehavior::Waiting,			EVehicleBehavior::Panicking,	EVehicleBehavior::Waiting },
+		/* LaneChanging */	{ EVehicleBehavior::LaneChanging,	EVehicleBehavior::LaneChanging,		EVehicleBehavior::LaneChanging,	EVehicleBehavior::LaneChanging,	EVehicleBehavior::LaneChanging,		EVehicleBehavior::Normal,			EVehicleBehavior::Panicking,	EVehicleBehavior::LaneChanging },
+		/* StoppedAtLight */	{ EVehicleBehavior::Normal,		EVehicleBehavior::StoppedAtLight,	EVehicleBehavior::Queued,		EVehicleBehavior::Waiting,		EVehicleBehavior::LaneChanging,		EVehicleBehavior::StoppedAtLight,	EVehicleBehavior::Panicking,	EVehicleBehavior::StoppedAtLight },
+		/* Queued */		{ EVehicleBehavior::Normal,		EVehicleBehavior::StoppedAtLight,	EVehicleBehavior::Queued,		EVehicleBehavior::Waiting,		EVehicleBehavior::LaneChanging,		EVehicleBehavior::Queued,			EVehicleBehavior::Panicking,	EVehicleBehavior::Queued },
+		/* Panicking */		{ EVehicleBehavior::Panicking,	EVehicleBehavior::Panicking,		EVehicleBehavior::Panicking,	EVehicleBehavior::Panicking,	EVehicleBehavior::Panicking,		EVehicleBehavior::Panicking,		EVehicleBehavior::Panicking,	EVehicleBehavior::Normal },
+	};
+
+	/** Durum başına güncellemeler. */
+	constexpr EVehicleBehaviorUpdate Updates[NumStates] =
+	{
+		/* Normal */			EVehicleBehaviorUpdate::Steering,
+		/* Waiting */			EVehicleBehaviorUpdate::None,
+		/* LaneChanging */		EVehicleBehaviorUpdate::Steering | EVehicleBehaviorUpdate::SideCheck,
+		/* StoppedAtLight */	EVehicleBehaviorUpdate::None,
+		/* Queued */			EVehicleBehaviorUpdate::None,
+		/* Panicking */			EVehicleBehaviorUpdate::Steering,
+	};
+
+	FORCEINLINE EVehicleBehavior Transition(EVehicleBehavior State, EVehicleBehaviorEvent Event)
+	{
+		return Transitions[(int32)State][(int32)Event];
+	}
+
+	FORCEINLINE bool HasUpdate(EVehicleBehavior State, EVehicleBehaviorUpdate Update)
+	{
+		return EnumHasAnyFlags(Updates[(int32)State], Update);
+	}
+}
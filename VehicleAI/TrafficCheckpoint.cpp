@@ -0,0 +1,148 @@
+#include "TrafficCheckpoint.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	/** Dosya ve blok başlığı boyutu; blok verisi bu hizada başlar. */
+	constexpr int32 HeaderSize = 16;
+
+	template<typename T>
+	FORCEINLINE void WriteRaw(TArray<uint8>& Out, const T& Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	template<typename T>
+	FORCEINLINE void PatchRaw(TArray<uint8>& Out, int32 Offset, const T& Value)
+	{
+		FMemory::Memcpy(Out.GetData() + Offset, &Value, sizeof(T));
+	}
+
+	template<typename T>
+	FORCEINLINE bool ReadRaw(const uint8*& Cursor, const uint8* End, T& OutValue)
+	{
+		if (End - Cursor < (int64)sizeof(T))
+		{
+			return false;
+		}
+		FMemory::Memcpy(&OutValue, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return true;
+	}
+}
+
+// ============================================
+// YAZICI
+// ============================================
+
+FTrafficCheckpointWriter::FTrafficCheckpointWriter(TArray<uint8>& InOutput)
+	: Output(InOutput)
+{
+	Output.Reset();
+	WriteRaw(Output, TrafficCheckpoint::FileMagic);
+	WriteRaw(Output, TrafficCheckpoint::Version);
+	WriteRaw(Output, (uint32)0); // Blok sayısı (EndBlock'ta güncellenir)
+	WriteRaw(Output, (uint32)0);
+}
+
+void FTrafficCheckpointWriter::BeginBlock(uint32 Tag, uint32 BlockVersion, uint32 InElementSize)
+{
+	check(!bInBlock && InElementSize > 0);
+
+	BlockHeaderOffset = Output.Num();
+	WriteRaw(Output, Tag);
+	WriteRaw(Output, BlockVersion);
+	WriteRaw(Output, InElementSize);
+	WriteRaw(Output, (uint32)0); // Eleman sayısı (EndBlock'ta)
+
+	ElementSize = InElementSize;
+	BlockCount = 0;
+	bInBlock = true;
+}
+
+void FTrafficCheckpointWriter::EndBlock()
+{
+	check(bInBlock);
+
+	PatchRaw(Output, BlockHeaderOffset + 3 * sizeof(uint32), (uint32)BlockCount);
+	Output.AddZeroed(Align(Output.Num(), HeaderSize) - Output.Num());
+
+	++NumBlocks;
+	PatchRaw(Output, 2 * sizeof(uint32), (uint32)NumBlocks);
+	bInBlock = false;
+}
+
+// ============================================
+// OKUYUCU
+// ============================================
+
+bool FTrafficCheckpointReader::Open(const FString& FilePath)
+{
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası okunamadı: %s"), *FilePath);
+		return false;
+	}
+
+	// OpenFromMemory FileData'yı boşaltmaz; görünüm bu diziye bakar
+	const TArrayView<const uint8> FileView(FileData);
+	return OpenFromMemory(FileView);
+}
+
+bool FTrafficCheckpointReader::OpenFromMemory(TArrayView<const uint8> InData)
+{
+	Data = InData;
+	Blocks.Reset();
+
+	const uint8* Begin = Data.GetData();
+	const uint8* Cursor = Begin;
+	const uint8* End = Begin + Data.Num();
+
+	uint32 Magic = 0;
+	uint32 FileVersion = 0;
+	uint32 NumBlocks = 0;
+	uint32 Reserved = 0;
+	if (!ReadRaw(Cursor, End, Magic) || !ReadRaw(Cursor, End, FileVersion) || !ReadRaw(Cursor, End, NumBlocks) || !ReadRaw(Cursor, End, Reserved)
+		|| Magic != TrafficCheckpoint::FileMagic || FileVersion != TrafficCheckpoint::Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Geçersiz trafik kontrol noktası formatı"));
+		return false;
+	}
+
+	Blocks.Reserve(NumBlocks);
+	for (uint32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+	{
+		FBlock& Block = Blocks.AddDefaulted_GetRef();
+		uint32 Count = 0;
+		if (!ReadRaw(Cursor, End, Block.Tag) || !ReadRaw(Cursor, End, Block.Version) || !ReadRaw(Cursor, End, Block.ElementSize) || !ReadRaw(Cursor, End, Count)
+			|| Block.ElementSize == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktasında bozuk blok başlığı (%u)"), BlockIndex);
+			Blocks.Reset();
+			return false;
+		}
+
+		const int64 PayloadSize = (int64)Count * Block.ElementSize;
+		if (End - Cursor < PayloadSize || Count > (uint32)MAX_int32)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası yarım kalmış (blok %u)"), BlockIndex);
+			Blocks.Reset();
+			return false;
+		}
+
+		Block.Count = (int32)Count;
+		Block.Offset = Cursor - Begin;
+		// Son bloğun dolgusu dosya sonunda kesilmiş olabilir
+		Cursor += FMath::Min(Align(PayloadSize, (int64)HeaderSize), (int64)(End - Cursor));
+	}
+
+	return true;
+}
+
+const FTrafficCheckpointReader::FBlock* FTrafficCheckpointReader::FindBlock(uint32 Tag) const
+{
+	return Blocks.FindByPredicate([Tag](const FBlock& Block)
+	{
+		return Block.Tag == Tag;
+	});
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trafik kontrol noktası dosya formatı.
+ *
+ * Dosya: [Magic 'TCKP'][Version][BlockCount][Reserved] ardından bloklar.
+ * Blok: [Tag][BlockVersion][ElementSize][Count][Count * ElementSize byte][16 byte'a dolgu]
+ * Her blok sabit boyutlu POD kayıtların bitişik dizisidir (başlıklar 16 byte, veri 16 byte'a hizalı).
+ * Geri yükleme kayıtları ayrıştırmaz: uzak alan dizileri tek kopyalama ile şeritlere yazılır.
+ * Tanınmayan bloklar atlanır; sürümü veya eleman boyutu farklı blok reddedilir.
+ * Zamanlar "şimdiye göre" (geçen / kalan saniye) tutulur, dünya saatinden bağımsızdır.
+ */
+namespace TrafficCheckpoint
+{
+	constexpr uint32 FileMagic = 0x504B4354; // 'TCKP'
+	constexpr uint32 Version = 1;
+
+	/** Blok etiketleri. */
+	constexpr uint32 GlobalsTag = 0x424F4C47; // 'GLOB'
+	constexpr uint32 LanesTag = 0x454E414C; // 'LANE'
+	constexpr uint32 FarFieldTag = 0x52414646; // 'FFAR'
+	constexpr uint32 FarFieldIdsTag = 0x44494646; // 'FFID'
+	constexpr uint32 NearFieldTag = 0x5241454E; // 'NEAR'
+	constexpr uint32 FreeVehiclesTag = 0x45455246; // 'FREE'
+	constexpr uint32 LightsTag = 0x5448474C; // 'LGHT'
+	constexpr uint32 ClassesTag = 0x53534C43; // 'CLSS'
+
+	/** Ham dizi blok sürümleri (FFarFieldVehicle düzeni değişirse artırılmalıdır). */
+	constexpr uint32 FarFieldVersion = 1;
+	constexpr uint32 FarFieldIdsVersion = 1;
+
+	/** Sınıf tablosu: UTF-8 sınıf yolları, her biri 0 ile biter (FFarFieldVehicle::ClassIndex sırası). */
+	constexpr uint32 ClassesVersion = 1;
+}
+
+/** Simülasyon sayaçları (tek kayıt). */
+struct FTrafficCheckpointGlobals
+{
+	static constexpr uint32 Version = 1;
+
+	uint32 NextTrafficId = 0;
+	int32 StepIndex = 0;
+	float FarFieldTimeAccumulator = 0.0f;
+	int32 NumLanes = 0;
+};
+
+static_assert(sizeof(FTrafficCheckpointGlobals) == 16, "FTrafficCheckpointGlobals layout is part of the checkpoint format");
+
+/**
+ * Şerit kaydı (şerit ID'si sırasıyla). Uzak alan blokları şeritlerin dizilerinin art arda
+ * eklenmesidir; şeridin dilimi önceki şeritlerin NumFarField toplamından başlar.
+ */
+struct FTrafficCheckpointLane
+{
+	static constexpr uint32 Version = 1;
+
+	/** Doğrulama: geri yüklenen dünyanın şeridi aynı uzunlukta olmalıdır. */
+	float Length = 0.0f;
+
+	/** Yol kapanması (FLT_MAX = açık). */
+	float ClosureDistance = FLT_MAX;
+
+	int32 NumFarField = 0;
+
+	/** Doğrulama: yakın alan bloğunda bu şeride ait kayıt sayısı. */
+	int32 NumNearField = 0;
+};
+
+static_assert(sizeof(FTrafficCheckpointLane) == 16, "FTrafficCheckpointLane layout is part of the checkpoint format");
+
+/**
+ * Yakın alan (aktörlü) araç kaydı. Kayıtlar TrafficId'ye göre artan sıradadır.
+ * Konum ve dönüş aktörden tam hassasiyetle alınır (araç şeritten bağımsız hareket eder).
+ *
+ * Şeride bağlı olmayan kayıtlı araçlar (spline'sız, seviyeye yerleştirilmiş veya oyun kodunun
+ * spawn ettiği) aynı kayıtla FreeVehiclesTag bloğuna yazılır: LaneId = INDEX_NONE, Distance = 0.
+ * Bu aktörlerin sahibi subsystem değildir; geri yüklemede yeniden spawn edilmez, aynı TrafficId'li
+ * kayıtlı controller bulunup kaydedilen duruma taşınır.
+ */
+struct FTrafficCheckpointVehicle
+{
+	static constexpr uint32 Version = 1;
+
+	uint32 TrafficId = 0;
+	int32 LaneId = INDEX_NONE;
+	float Distance = 0.0f;
+	float CurrentSpeed = 0.0f;
+
+	float TargetSpeed = 0.0f;
+	float CurrentLaneOffset = 0.0f;
+	float TargetLaneOffset = 0.0f;
+
+	/** Kalan panik süresi (saniye, 0 = panik yok). */
+	float PanicRemaining = 0.0f;
+
+	FVector3d Location = FVector3d::ZeroVector;
+
+	/** Dönüş (X, Y, Z, W). FQuat4d 16 byte hizalı olduğundan düz dizi: kayıt 8 byte hizalı kalır. */
+	double Rotation[4] = { 0.0, 0.0, 0.0, 1.0 };
+
+	FVector3f PanicEscapeDirection = FVector3f::ZeroVector;
+
+	/** Sınıf tablosu indeksi (ClassesTag). */
+	uint16 ClassIndex = 0;
+
+	/** EVehicleBehavior. */
+	uint8 Behavior = 0;
+
+	uint8 Padding = 0;
+};
+
+static_assert(sizeof(FTrafficCheckpointVehicle) == 104 && alignof(FTrafficCheckpointVehicle) == 8, "FTrafficCheckpointVehicle layout is part of the checkpoint format");
+
+/**
+ * Trafik ışığı kaydı (UTrafficSubsystem kayıt sırasıyla). Faz zamanı ve zamanlayıcı
+ * şimdiye göre tutulur; adaptif zamanlamanın değiştirdiği süreler de kaydedilir.
+ */
+struct FTrafficCheckpointLight
+{
+	static constexpr uint32 Version = 1;
+
+	/** Doğrulama: geri yüklenen dünyada aynı sıradaki ışık bu konumda olmalıdır. */
+	FVector3d Location = FVector3d::ZeroVector;
+
+	float GreenDuration = 0.0f;
+	float YellowDuration = 0.0f;
+	float RedDuration = 0.0f;
+
+	/** Mevcut fazda geçen süre (saniye). */
+	float PhaseElapsed = 0.0f;
+
+	/** Faz zamanlayıcısına kalan süre (saniye, < 0 = zamanlayıcı yok). */
+	float TimerRemaining = -1.0f;
+
+	/** ETrafficLightState. */
+	uint8 State = 0;
+	uint8 Padding[3] = {};
+};
+
+static_assert(sizeof(FTrafficCheckpointLight) == 48, "FTrafficCheckpointLight layout is part of the checkpoint format");
+
+/**
+ * Kontrol noktası yazıcısı. Bloklar doğrudan çıktı dizisine eklenir; büyük diziler
+ * (uzak alan) BeginBlock / Append / EndBlock ile ara kopya olmadan şerit şerit yazılır.
+ */
+class YOURGAMENAME_API FTrafficCheckpointWriter
+{
+public:
+	/** Çıktıyı sıfırlar ve dosya başlığını yazar. */
+	explicit FTrafficCheckpointWriter(TArray<uint8>& InOutput);
+
+	/** Blok başlığını yazar; eleman sayısı EndBlock'ta doldurulur. */
+	void BeginBlock(uint32 Tag, uint32 BlockVersion, uint32 ElementSize);
+
+	/** Açık bloğa eleman ekler. */
+	template<typename T>
+	void Append(const T* Elements, int32 Count)
+	{
+		check(bInBlock && sizeof(T) == ElementSize);
+		Output.Append(reinterpret_cast<const uint8*>(Elements), Count * (int32)sizeof(T));
+		BlockCount += Count;
+	}
+
+	/** Eleman sayısını başlığa yazar ve veriyi 16 byte'a doldurur. */
+	void EndBlock();
+
+	/** Tek parça blok. */
+	template<typename T>
+	void AddBlock(uint32 Tag, uint32 BlockVersion, const T* Elements, int32 Count)
+	{
+		BeginBlock(Tag, BlockVersion, sizeof(T));
+		Append(Elements, Count);
+		EndBlock();
+	}
+
+private:
+	TArray<uint8>& Output;
+
+	/** Açık bloğun başlığının konumu ve eleman sayısı. */
+	int32 BlockHeaderOffset = 0;
+	uint32 ElementSize = 0;
+	int32 BlockCount = 0;
+	bool bInBlock = false;
+
+	int32 NumBlocks = 0;
+};
+
+/**
+ * Kontrol noktası okuyucusu. Açılışta sadece blok başlıkları taranır; bloklar veri üzerinde
+ * görünüm olarak döndürülür (kopya yok). Veri okuyucu yaşadıkça geçerli kalmalıdır.
+ */
+class YOURGAMENAME_API FTrafficCheckpointReader
+{
+public:
+	/** Dosyayı belleğe okur ve açar. */
+	bool Open(const FString& FilePath);
+
+	/** Verinin sahipliğini almadan açar (Data okuyucudan uzun yaşamalıdır). */
+	bool OpenFromMemory(TArrayView<const uint8> Data);
+
+	/**
+	 * Blok görünümü.
+	 *
+	 * @return Blok yoksa, sürümü farklıysa veya eleman boyutu T ile uyuşmuyorsa false
+	 */
+	template<typename T>
+	bool GetBlock(uint32 Tag, uint32 BlockVersion, TArrayView<const T>& OutElements) const
+	{
+		const FBlock* Block = FindBlock(Tag);
+		if (!Block || Block->Version != BlockVersion || Block->ElementSize != sizeof(T))
+		{
+			return false;
+		}
+		OutElements = TArrayView<const T>(reinterpret_cast<const T*>(Data.GetData() + Block->Offset), Block->Count);
+		return true;
+	}
+
+private:
+	struct FBlock
+	{
+		uint32 Tag = 0;
+		uint32 Version = 0;
+		uint32 ElementSize = 0;
+		int32 Count = 0;
+		int64 Offset = 0;
+	};
+
+	const FBlock* FindBlock(uint32 Tag) const;
+
+	/** Open ile okunan dosya (OpenFromMemory'de boş). */
+	TArray<uint8> FileData;
+
+	TArrayView<const uint8> Data;
+	TArray<FBlock> Blocks;
+};
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+#include "VehicleAIController.h" // ETrafficLightState enum'u için
+
+class ATrafficLight;
+
+/** Oyun mantığından trafiğe gönderilen olay türü. */
+enum class ETrafficEventType : uint8
+{
+	/** Noktanın yarıçapındaki araçlar paniğe girer (silah ateşi, patlama). */
+	Threat,
+
+	/** Işık verilen duruma zorlanır (ATrafficLight::SetLightState). */
+	LightOverride,
+
+	/** Şerit verilen mesafeden itibaren kapanır (araçlar önünde durur). */
+	RoadClosure,
+
+	/** Şerit kapanması kaldırılır. */
+	RoadReopen,
+
+	/** Kalıcı kimliği verilen araç (yakın veya uzak alan) kaldırılır. */
+	Despawn,
+};
+
+/**
+ * Oyun mantığından trafiğe tipli olay. Herhangi bir thread'de oluşturulup
+ * UTrafficSubsystem::PostEvent ile gönderilir; trafik adımının başında oyun thread'inde uygulanır.
+ * Sadece türün kullandığı alanlar anlamlıdır.
+ */
+struct FTrafficEvent
+{
+	ETrafficEventType Type = ETrafficEventType::Threat;
+
+	/** LightOverride: zorlanan durum. */
+	ETrafficLightState LightState = ETrafficLightState::Green;
+
+	/** RoadClosure / RoadReopen: şerit ID'si. */
+	int32 LaneId = INDEX_NONE;
+
+	/** Despawn: kalıcı araç kimliği. */
+	uint32 TrafficId = 0;
+
+	/** Threat: tehdit noktası. */
+	FVector Location = FVector::ZeroVector;
+
+	/** Threat: etki yarıçapı (birim). */
+	float Radius = 0.0f;
+
+	/** Threat: panik süresi (saniye, <= 0 = varsayılan). */
+	float Duration = 0.0f;
+
+	/** RoadClosure: kapanmanın şerit üzerindeki mesafesi (birim). */
+	float Distance = 0.0f;
+
+	/** LightOverride: ışık (zayıf referans - olay kuyruktayken ışık yok edilebilir). */
+	TWeakObjectPtr<ATrafficLight> Light;
+
+	static FTrafficEvent MakeThreat(const FVector& InLocation, float InRadius, float InDuration = 0.0f)
+	{
+		FTrafficEvent Event;
+		Event.Type = ETrafficEventType::Threat;
+		Event.Location = InLocation;
+		Event.Radius = InRadius;
+		Event.Duration = InDuration;
+		return Event;
+	}
+
+	static FTrafficEvent MakeLightOverride(ATrafficLight* InLight, ETrafficLightState InState)
+	{
+		FTrafficEvent Event;
+		Event.Type = ETrafficEventType::LightOverride;
+		Event.Light = InLight;
+		Event.LightState = InState;
+		return Event;
+	}
+
+	static FTrafficEvent MakeRoadClosure(int32 InLaneId, float InDistance)
+	{
+		FTrafficEvent Event;
+		Event.Type = ETrafficEventType::RoadClosure;
+		Event.LaneId = InLaneId;
+		Event.Distance = InDistance;
+		return Event;
+	}
+
+	static FTrafficEvent MakeRoadReopen(int32 InLaneId)
+	{
+		FTrafficEvent Event;
+		Event.Type = ETrafficEventType::RoadReopen;
+		Event.LaneId = InLaneId;
+		return Event;
+	}
+
+	static FTrafficEvent MakeDespawn(uint32 InTrafficId)
+	{
+		FTrafficEvent Event;
+		Event.Type = ETrafficEventType::Despawn;
+		Event.TrafficId = InTrafficId;
+		return Event;
+	}
+};
+
+/**
+ * Sınırlı, kilitsiz çok üreticili / tek tüketicili kuyruk.
+ *
+ * Halka tamponu, her yuvada sıra numarası tutar: üretici boş yuvayı konumu CAS ile
+ * ayırır, öğeyi yazar ve sıra numarasını yayınlar; tüketici yayınlanmış yuvaları sırayla
+ * okur. Kilit ve tahsis yoktur (tampon Initialize'da bir kez ayrılır). Kuyruk doluysa
+ * Push öğeyi düşürür ve taşma sayacını artırır - üretici asla beklemez.
+ * Aynı üreticinin öğeleri gönderildiği sırayla tüketilir.
+ */
+template<typename T>
+class TTrafficEventQueue
+{
+public:
+	/**
+	 * @param InCapacity Kapasite (2'nin kuvvetine yukarı yuvarlanır). Üretici yokken çağrılmalıdır.
+	 */
+	void Initialize(int32 InCapacity)
+	{
+		const uint32 Capacity = FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(InCapacity, 2));
+		Slots = MakeUnique<FSlot[]>(Capacity);
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+		Mask = Capacity - 1;
+		EnqueuePosition.store(0, std::memory_order_relaxed);
+		DequeuePosition = 0;
+		NumPushed.store(0, std::memory_order_relaxed);
+		NumDropped.store(0, std::memory_order_relaxed);
+		MaxDepth = 0;
+	}
+
+	int32 GetCapacity() const { return Slots ? (int32)(Mask + 1) : 0; }
+
+	/**
+	 * Öğeyi kuyruğa ekler. Herhangi bir thread'den çağrılabilir.
+	 *
+	 * @return Kuyruk doluysa (veya başlatılmadıysa) false - öğe düşürülür
+	 */
+	bool Push(const T& Item)
+	{
+		if (!Slots)
+		{
+			NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		FSlot* Slot;
+		uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot = &Slots[Position & Mask];
+			const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+			const int64 Difference = (int64)(Sequence - Position);
+
+			if (Difference == 0)
+			{
+				// Yuva boş: konumu ayır (başka üretici aldıysa Position güncellenir, tekrar dene)
+				if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Difference < 0)
+			{
+				// Yuva bir tur önceki öğeyi tutuyor, tüketici henüz okumadı: dolu
+				NumDropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				Position = EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		Slot->Item = Item;
+		Slot->Sequence.store(Position + 1, std::memory_order_release);
+		NumPushed.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * Yayınlanmış tüm öğeler için Func(T&&) çağırır. Sadece tek tüketici thread'inden.
+	 * Boşaltma sırasında eklenen öğeler de işlenebilir; en fazla kapasite kadar öğe okunur.
+	 *
+	 * @return İşlenen öğe sayısı
+	 */
+	template<typename FuncType>
+	int32 Drain(FuncType&& Func)
+	{
+		if (!Slots)
+		{
+			return 0;
+		}
+
+		int32 NumDrained = 0;
+		const int32 Capacity = GetCapacity();
+		while (NumDrained < Capacity)
+		{
+			FSlot& Slot = Slots[DequeuePosition & Mask];
+			const uint64 Sequence = Slot.Sequence.load(std::memory_order_acquire);
+			if ((int64)(Sequence - (DequeuePosition + 1)) < 0)
+			{
+				// Boş veya üretici yazmayı henüz bitirmedi (sonraki boşaltmada okunur)
+				break;
+			}
+
+			T Item = MoveTemp(Slot.Item);
+			Slot.Item = T();
+
+			// Yuvayı bir sonraki tura aç
+			Slot.Sequence.store(DequeuePosition + Mask + 1, std::memory_order_release);
+			++DequeuePosition;
+			++NumDrained;
+
+			Func(MoveTemp(Item));
+		}
+
+		MaxDepth = FMath::Max(MaxDepth, NumDrained);
+		return NumDrained;
+	}
+
+	/** Kabul edilen öğe sayısı (başlatmadan beri). */
+	int64 GetNumPushed() const { return NumPushed.load(std::memory_order_relaxed); }
+
+	/** Kuyruk dolu olduğu için düşürülen öğe sayısı (başlatmadan beri). */
+	int64 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+
+	/** Tek boşaltmada okunan en fazla öğe (kapasite ihtiyacı için). Sadece tüketici thread'inden. */
+	int32 GetMaxDepth() const { return MaxDepth; }
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence{ 0 };
+		T Item;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Mask = 0;
+
+	/** Üreticilerin paylaştığı yazma konumu (tüketici alanlarından ayrı önbellek satırında). */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePosition{ 0 };
+
+	/** Tüketicinin okuma konumu (sadece tüketici). */
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePosition = 0;
+	int32 MaxDepth = 0;
+
+	std::atomic<int64> NumPushed{ 0 };
+	std::atomic<int64> NumDropped{ 0 };
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CarFollowingModel.h"
+#include "TrafficArchetype.h"
+
+class AVehicle;
+class AVehicleAIController;
+
+/**
+ * Uzak alan (far field) aracı.
+ * Kameradan uzaktaki araçlar aktör, controller veya transform olmadan
+ * sadece bu 1D temsil ile simüle edilir: şerit, şerit üzerindeki mesafe ve hız.
+ * Mesafe ve hız 16-bit olarak kuantize edilir (araç başına 8 byte).
+ */
+struct FFarFieldVehicle
+{
+	/** UTrafficSubsystem şerit ID'si. */
+	uint16 LaneId = 0;
+
+	/** Şerit üzerindeki mesafe, şerit uzunluğuna göre normalize (0 - 65535). */
+	uint16 QuantizedDistance = 0;
+
+	/** Hız, SpeedQuantum biriminde (0 - 65535). */
+	uint16 QuantizedSpeed = 0;
+
+	/** Yakın alana dönüşte spawn edilecek araç sınıfının indeksi (FFarFieldVehicleClass tablosu). */
+	uint8 ClassIndex = 0;
+
+	/** Hız kuantizasyon adımı (cm/s). 0.1 cm/s ile en fazla ~6553 cm/s temsil edilir. */
+	static constexpr float SpeedQuantum = 0.1f;
+
+	static FORCEINLINE uint16 QuantizeDistance(float Distance, float LaneLength)
+	{
+		if (LaneLength <= 0.0f)
+		{
+			return 0;
+		}
+		return (uint16)FMath::Clamp(FMath::RoundToInt(Distance / LaneLength * (float)MAX_uint16), 0, (int32)MAX_uint16);
+	}
+
+	static FORCEINLINE float DequantizeDistance(uint16 Quantized, float LaneLength)
+	{
+		return (float)Quantized / (float)MAX_uint16 * LaneLength;
+	}
+
+	static FORCEINLINE uint16 QuantizeSpeed(float Speed)
+	{
+		return (uint16)FMath::Clamp(FMath::RoundToInt(Speed / SpeedQuantum), 0, (int32)MAX_uint16);
+	}
+
+	static FORCEINLINE float DequantizeSpeed(uint16 Quantized)
+	{
+		return (float)Quantized * SpeedQuantum;
+	}
+};
+
+static_assert(sizeof(FFarFieldVehicle) <= 8, "FFarFieldVehicle must stay compact");
+
+/**
+ * Uzak alan araç sınıfı.
+ * Aynı sınıftaki tüm uzak alan araçları bu parametreleri paylaşır.
+ * Parametreler sınıfın archetype'ından (AVehicle::Archetype) alınır.
+ */
+struct FFarFieldVehicleClass
+{
+	/** Yakın alana dönüşte spawn edilecek araç sınıfı. */
+	TSubclassOf<AVehicle> VehicleClass;
+
+	/** Spawn edilen araca atanacak AI Controller sınıfı (AVehicle::AIControllerClass). */
+	TSubclassOf<AVehicleAIController> ControllerClass;
+
+	/** Sınıfın archetype'ı (FTrafficArchetypeTable). Uzak alanda sürücü varyansı uygulanmaz. */
+	uint16 ArchetypeIndex = FTrafficArchetypeTable::DefaultIndex;
+};
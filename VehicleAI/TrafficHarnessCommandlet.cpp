@@ -0,0 +1,2224 @@
+#include "TrafficHarnessCommandlet.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "TrafficAllocationTracker.h"
+#include "TrafficEventQueue.h"
+#include "TrafficLight.h"
+#include "TrafficOccupancyGrid.h"
+#include "TrafficOvertakePlanner.h"
+#include "TrafficPedestrianCrowd.h"
+#include "TrafficPedestrianSubsystem.h"
+#include "TrafficRecordingSubsystem.h"
+#include "TrafficRegion.h"
+#include "TrafficReplication.h"
+#include "TrafficReplicationSubsystem.h"
+#include "TrafficScenario.h"
+#include "TrafficSignalSubsystem.h"
+#include "TrafficSpatialHash.h"
+#include "TrafficSubsystem.h"
+#include "TrafficSweep.h"
+#include "VehicleAIController.h"
+
+namespace
+{
+	/** Bölge süreçlerinin varsayılan taban portu (bölge i = taban + i). */
+	constexpr int32 DefaultRegionPort = 7400;
+
+	/**
+	 * Özet satırı: tek satır, betiklerle ayrıştırılabilir ("TrafficHarness<Tag> Key=Value ...").
+	 * Bütün modlar sonuçlarını bu biçimde yazar.
+	 */
+	void LogSummary(const TCHAR* Tag, const FString& Fields)
+	{
+		UE_LOG(LogTemp, Display, TEXT("TrafficHarness%s %s"), Tag, *Fields);
+	}
+
+	/**
+	 * -ManeuverBenchmark görevi: şerit değiştirme adımlarını (boşluk bekle, sinyal, offset bekle)
+	 * bitmeden tekrarlar, böylece bütün manevralar ölçüm boyunca askıda kalır.
+	 */
+	FTrafficManeuverTask RunBenchmarkManeuver(bool bRight)
+	{
+		for (;;)
+		{
+			if (co_await TrafficManeuver::WaitForGap(bRight, 4.0f) == ETrafficManeuverWake::TimedOut)
+			{
+				continue;
+			}
+
+			co_await TrafficManeuver::Delay(0.5f);
+			co_await TrafficManeuver::WaitForOffset(3.0f);
+		}
+	}
+
+	/** Adım süresi istatistikleri (milisaniye). */
+	struct FStepTimeStats
+	{
+		int32 NumSteps = 0;
+		double MeanMs = 0.0;
+		double MedianMs = 0.0;
+		double P95Ms = 0.0;
+		double MinMs = 0.0;
+	};
+
+	/** Süreleri (saniye) sıralar ve istatistikleri hesaplar; ölçüm yoksa false. */
+	bool ComputeStepTimeStats(TArray<double>& StepTimes, FStepTimeStats& OutStats)
+	{
+		if (StepTimes.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Zamanlama: ölçülen adım yok (WarmupSteps >= Steps)"));
+			return false;
+		}
+
+		StepTimes.Sort();
+
+		double Total = 0.0;
+		for (const double StepTime : StepTimes)
+		{
+			Total += StepTime;
+		}
+
+		OutStats.NumSteps = StepTimes.Num();
+		OutStats.MeanMs = Total / StepTimes.Num() * 1000.0;
+		OutStats.MedianMs = StepTimes[StepTimes.Num() / 2] * 1000.0;
+		OutStats.P95Ms = StepTimes[FMath::Min(StepTimes.Num() - 1, (int32)(StepTimes.Num() * 0.95))] * 1000.0;
+		OutStats.MinMs = StepTimes[0] * 1000.0;
+		return true;
+	}
+
+	/** -Scenario= ile verilen senaryoyu yükler; parametre yoksa kullanım satırını yazar. */
+	bool LoadScenario(const FString& Params, const TCHAR* Usage, FTrafficScenario& OutScenario, FString* OutPath = nullptr)
+	{
+		FString ScenarioPath;
+		if (!FParse::Value(*Params, TEXT("Scenario="), ScenarioPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Kullanım: %s"), Usage);
+			return false;
+		}
+
+		if (OutPath)
+		{
+			*OutPath = ScenarioPath;
+		}
+		return OutScenario.LoadFromFile(ScenarioPath);
+	}
+
+	/**
+	 * Senaryo dünyası: CreateHarnessWorld / Spawn / DestroyHarnessWorld sırasını tek yerde toplar.
+	 * Dünya yıkıcıda yok edilir, böylece hata dönüşlerinde ayrıca temizlik gerekmez.
+	 */
+	class FHarnessScenarioWorld
+	{
+	public:
+		~FHarnessScenarioWorld()
+		{
+			Destroy();
+		}
+
+		/** Dünyayı oluşturur (henüz araç yok). */
+		bool Create(const FTrafficScenario& Scenario)
+		{
+			World = UTrafficHarnessCommandlet::CreateHarnessWorld(Scenario);
+			TrafficSubsystem = World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+			return TrafficSubsystem != nullptr;
+		}
+
+		/** Senaryo araçlarını oluşturur ve adım modunu -SerialStep'ten ayarlar. */
+		int32 Spawn(const FTrafficScenario& Scenario, const FString& Params)
+		{
+			const int32 NumVehicles = Scenario.Spawn(World);
+			TrafficSubsystem->SetPipelinedSimulation(!FParse::Param(*Params, TEXT("SerialStep")));
+			return NumVehicles;
+		}
+
+		void Step(float DeltaTime)
+		{
+			UTrafficHarnessCommandlet::StepHarnessWorld(World, DeltaTime);
+		}
+
+		void Destroy()
+		{
+			UTrafficHarnessCommandlet::DestroyHarnessWorld(World);
+			World = nullptr;
+			TrafficSubsystem = nullptr;
+		}
+
+		UWorld* GetWorld() const { return World; }
+		UTrafficSubsystem* GetSubsystem() const { return TrafficSubsystem; }
+		UTrafficRecordingSubsystem* GetRecordingSubsystem() const { return World ? World->GetSubsystem<UTrafficRecordingSubsystem>() : nullptr; }
+
+	private:
+		UWorld* World = nullptr;
+		UTrafficSubsystem* TrafficSubsystem = nullptr;
+	};
+
+	/** Tolerans dışı alan varsa adını ve değerlerini döndürür. */
+	bool FindFieldDivergence(const FTrafficRecordedVehicle& Expected, const FTrafficRecordedVehicle& Actual, const FTrafficGoldenTolerance& Tolerance,
+		const TCHAR*& OutField, float& OutExpected, float& OutActual)
+	{
+		const float PositionError = FVector::Dist(Expected.Location, Actual.Location);
+		if (PositionError > Tolerance.Position)
+		{
+			OutField = TEXT("Location");
+			OutExpected = 0.0f;
+			OutActual = PositionError;
+			return true;
+		}
+
+		if (FMath::Abs(FRotator::NormalizeAxis(Expected.Yaw - Actual.Yaw)) > Tolerance.Yaw)
+		{
+			OutField = TEXT("Yaw");
+			OutExpected = Expected.Yaw;
+			OutActual = Actual.Yaw;
+			return true;
+		}
+
+		if (FMath::Abs(Expected.CurrentSpeed - Actual.CurrentSpeed) > Tolerance.Speed)
+		{
+			OutField = TEXT("CurrentSpeed");
+			OutExpected = Expected.CurrentSpeed;
+			OutActual = Actual.CurrentSpeed;
+			return true;
+		}
+
+		if (FMath::Abs(Expected.TargetSpeed - Actual.TargetSpeed) > Tolerance.Speed)
+		{
+			OutField = TEXT("TargetSpeed");
+			OutExpected = Expected.TargetSpeed;
+			OutActual = Actual.TargetSpeed;
+			return true;
+		}
+
+		if (FMath::Abs(Expected.LaneOffset - Actual.LaneOffset) > Tolerance.LaneOffset)
+		{
+			OutField = TEXT("LaneOffset");
+			OutExpected = Expected.LaneOffset;
+			OutActual = Actual.LaneOffset;
+			return true;
+		}
+
+		if (Expected.Behavior != Actual.Behavior)
+		{
+			OutField = TEXT("Behavior");
+			OutExpected = (float)Expected.Behavior;
+			OutActual = (float)Actual.Behavior;
+			return true;
+		}
+
+		if (Expected.Flags != Actual.Flags)
+		{
+			OutField = TEXT("Flags");
+			OutExpected = (float)Expected.Flags;
+			OutActual = (float)Actual.Flags;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Subsystem'in kimliğe göre sıralı karesini yakalar (CaptureFrame ekler; dizi önce temizlenir,
+	 * kapasite korunur). İki dünya aynı adımda karşılaştırılırken kullanılır.
+	 */
+	void CaptureSortedFrame(UTrafficSubsystem* TrafficSubsystem, FTrafficRecordingFrame& OutFrame)
+	{
+		OutFrame.Vehicles.Reset();
+		OutFrame.Lights.Reset();
+		OutFrame.NewLights.Reset();
+		TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficRecordingSubsystem>()->CaptureFrame(OutFrame);
+		OutFrame.Vehicles.Sort([](const FTrafficRecordedVehicle& A, const FTrafficRecordedVehicle& B)
+		{
+			return A.TrafficId < B.TrafficId;
+		});
+	}
+
+	/**
+	 * Aynı adımdaki iki sıralı kareyi karşılaştırır; ilk sapmayı yazar.
+	 *
+	 * @return Araç kümeleri, alanlar (tolerans içinde) ve ışık durumları aynıysa true
+	 */
+	bool CompareFrames(const FTrafficRecordingFrame& Expected, const FTrafficRecordingFrame& Actual, const FTrafficGoldenTolerance& Tolerance, int32 Step)
+	{
+		if (Expected.Vehicles.Num() != Actual.Vehicles.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç sayısı beklenen %d, gerçek %d"), Step, Expected.Vehicles.Num(), Actual.Vehicles.Num());
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Expected.Vehicles.Num(); ++Index)
+		{
+			const FTrafficRecordedVehicle& ExpectedVehicle = Expected.Vehicles[Index];
+			const FTrafficRecordedVehicle& ActualVehicle = Actual.Vehicles[Index];
+			if (ExpectedVehicle.TrafficId != ActualVehicle.TrafficId)
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u beklenirken %u bulundu"), Step, ExpectedVehicle.TrafficId, ActualVehicle.TrafficId);
+				return false;
+			}
+
+			const TCHAR* Field = nullptr;
+			float ExpectedValue = 0.0f;
+			float ActualValue = 0.0f;
+			if (FindFieldDivergence(ExpectedVehicle, ActualVehicle, Tolerance, Field, ExpectedValue, ActualValue))
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u, %s: beklenen %.3f, gerçek %.3f"),
+					Step, ActualVehicle.TrafficId, Field, ExpectedValue, ActualValue);
+				return false;
+			}
+		}
+
+		// Işık kimlikleri kayıt sırasıyla atanır; aynı senaryoda iki dünyada aynıdır
+		if (Expected.Lights.Num() != Actual.Lights.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, ışık sayısı beklenen %d, gerçek %d"), Step, Expected.Lights.Num(), Actual.Lights.Num());
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Expected.Lights.Num(); ++Index)
+		{
+			if (Expected.Lights[Index].LightId != Actual.Lights[Index].LightId || Expected.Lights[Index].State != Actual.Lights[Index].State)
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, ışık %d durumu farklı (beklenen %d, gerçek %d)"),
+					Step, Expected.Lights[Index].LightId, (int32)Expected.Lights[Index].State, (int32)Actual.Lights[Index].State);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Tek süreçte replikasyon: her sanal istemci için sunucu kanalı ve istemci önbelleği.
+	 * Paketler ağ yerine doğrudan okunur (gecikme ve kayıp yok); şerit ID'leri ortak olduğu için
+	 * istemci şerit eşlemesi gerekmez.
+	 */
+	class FReplicationLoopback
+	{
+	public:
+		/** Görüş noktaları tohumdan rastgele seçilen araç konumlarıdır. */
+		void Initialize(int32 NumClients, UTrafficSubsystem* TrafficSubsystem, int32 Seed)
+		{
+			const FTrafficReplicationSnapshot& Snapshot = TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficReplicationSubsystem>()->GetSnapshot();
+			FRandomStream Random(Seed);
+
+			Clients.SetNum(NumClients);
+			for (FClient& Client : Clients)
+			{
+				Client.ViewLocation = Snapshot.Vehicles.Num() > 0
+					? Snapshot.Vehicles[Random.RandHelper(Snapshot.Vehicles.Num())].Location
+					: FVector::ZeroVector;
+			}
+		}
+
+		void Step(UTrafficSubsystem* TrafficSubsystem, float DeltaTime)
+		{
+			const FTrafficReplicationSnapshot& Snapshot = TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficReplicationSubsystem>()->GetSnapshot();
+			const float InnerRadius = Settings.Rings.Num() > 0 ? Settings.Rings[0].Radius : 0.0f;
+
+			// Sunucuda artık olmayan araçların vekilleri (silme kaydı ile bir paket içinde kalkmalı)
+			SnapshotIds.Reset();
+			for (const FTrafficReplicatedVehicle& Vehicle : Snapshot.Vehicles)
+			{
+				SnapshotIds.Add(Vehicle.TrafficId);
+			}
+
+			for (FClient& Client : Clients)
+			{
+				if (Client.Channel.Tick(DeltaTime, Settings))
+				{
+					FBitWriter Writer(Settings.MaxPacketBytes * 8, true);
+
+					const double StartTime = FPlatformTime::Seconds();
+					VehiclesSent += Client.Channel.BuildPacket(Snapshot, Client.ViewLocation, Settings, Writer, NewLanes);
+					BuildSeconds += FPlatformTime::Seconds() - StartTime;
+
+					FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+					Client.ProxyCache.ReadPacket(Reader, Snapshot.Time);
+				}
+
+				Client.ProxyCache.Update(Snapshot.Time, Settings, [TrafficSubsystem](int32 LaneId, float Distance, FVector& OutLocation, FRotator& OutRotation)
+				{
+					return TrafficSubsystem->GetLaneTransform(LaneId, Distance, OutLocation, OutRotation);
+				});
+
+				int32 NumOrphans = 0;
+				Client.ProxyCache.ForEach([this, &NumOrphans](const FTrafficProxyVehicle& Proxy)
+				{
+					NumOrphans += SnapshotIds.Contains(Proxy.State.TrafficId) ? 0 : 1;
+				});
+				MaxOrphanProxies = FMath::Max(MaxOrphanProxies, NumOrphans);
+
+				// Tahmin hatası en yakın halkada ölçülür (oyuncunun gördüğü araçlar)
+				Snapshot.SpatialHash.ForEachInRadius(Client.ViewLocation, InnerRadius, [&](int32 SnapshotIndex, const FVector& Location)
+				{
+					const FTrafficProxyVehicle* Proxy = Client.ProxyCache.Find(Snapshot.Vehicles[SnapshotIndex].TrafficId);
+					if (Proxy && Proxy->bHasTransform)
+					{
+						const float Error = FVector::Dist(Proxy->Location, Location);
+						ErrorSum += Error;
+						MaxError = FMath::Max(MaxError, Error);
+						++ErrorSamples;
+					}
+				});
+			}
+
+			ElapsedTime += DeltaTime;
+		}
+
+		void Report() const
+		{
+			int64 TotalBytes = 0;
+			int64 TotalRemovals = 0;
+			int32 TotalPackets = 0;
+			for (const FClient& Client : Clients)
+			{
+				TotalBytes += Client.Channel.GetBytesSent();
+				TotalRemovals += Client.Channel.GetRemovalsSent();
+				TotalPackets += Client.Channel.GetPacketsSent();
+			}
+
+			const double BytesPerClientPerSecond = ElapsedTime > 0.0f && Clients.Num() > 0 ? (double)TotalBytes / Clients.Num() / ElapsedTime : 0.0;
+			const double BitsPerVehicle = VehiclesSent > 0 ? (double)TotalBytes * 8.0 / VehiclesSent : 0.0;
+			const double VehiclesPerPacket = TotalPackets > 0 ? (double)VehiclesSent / TotalPackets : 0.0;
+			const double MeanError = ErrorSamples > 0 ? ErrorSum / ErrorSamples : 0.0;
+			const double BuildUs = TotalPackets > 0 ? BuildSeconds * 1000000.0 / TotalPackets : 0.0;
+
+			LogSummary(TEXT("Replication"), FString::Printf(TEXT("Clients=%d BytesPerClientPerSec=%.1f BitsPerVehicle=%.1f VehiclesPerPacket=%.1f MeanErrorCm=%.2f MaxErrorCm=%.2f BuildUsPerPacket=%.2f Removals=%lld MaxOrphanProxies=%d"),
+				Clients.Num(), BytesPerClientPerSecond, BitsPerVehicle, VehiclesPerPacket, MeanError, MaxError, BuildUs, TotalRemovals, MaxOrphanProxies));
+		}
+
+	private:
+		struct FClient
+		{
+			FTrafficReplicationChannel Channel;
+			FTrafficReplicationProxyCache ProxyCache;
+			FVector ViewLocation = FVector::ZeroVector;
+		};
+
+		TArray<FClient> Clients;
+		FTrafficReplicationSettings Settings;
+		TArray<int32> NewLanes;
+		TSet<uint32> SnapshotIds;
+		int32 MaxOrphanProxies = 0;
+
+		float ElapsedTime = 0.0f;
+		int64 VehiclesSent = 0;
+		double BuildSeconds = 0.0;
+		double ErrorSum = 0.0;
+		float MaxError = 0.0f;
+		int64 ErrorSamples = 0;
+	};
+}
+
+UTrafficHarnessCommandlet::UTrafficHarnessCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTrafficHarnessCommandlet::Main(const FString& Params)
+{
+	// Mod anahtarı: '=' ile bitiyorsa değerli (-Key=...), değilse bayrak (-Key).
+	// İlk eşleşen çalışır; SweepJob, Sweep'ten önce olmalı (iş süreçleri ikisini de alır).
+	struct FHarnessMode
+	{
+		const TCHAR* Switch;
+		int32 (*Run)(const FString& Params);
+	};
+
+	static const FHarnessMode Modes[] =
+	{
+		{ TEXT("PedestrianBenchmark="), &RunPedestrianBenchmark },
+		{ TEXT("EventStress="), &RunEventStress },
+		{ TEXT("OvertakeBenchmark="), &RunOvertakeBenchmark },
+		{ TEXT("ManeuverBenchmark="), &RunManeuverBenchmark },
+		{ TEXT("OccupancyTest"), &RunOccupancyTest },
+		{ TEXT("BrakingEnvelopeTest"), &RunBrakingEnvelopeTest },
+		{ TEXT("RegionCluster="), &RunRegionCluster },
+		{ TEXT("Region="), &RunRegion },
+		{ TEXT("Checkpoint"), &RunCheckpoint },
+		{ TEXT("SweepJob="), &RunSweepJob },
+		{ TEXT("Sweep="), &RunSweep },
+	};
+
+	for (const FHarnessMode& Mode : Modes)
+	{
+		const int32 Length = FCString::Strlen(Mode.Switch);
+		FString Value;
+		const bool bSelected = Mode.Switch[Length - 1] == TEXT('=')
+			? FParse::Value(*Params, Mode.Switch, Value)
+			: FParse::Param(*Params, Mode.Switch);
+
+		if (bSelected)
+		{
+			return Mode.Run(Params);
+		}
+	}
+
+	return RunScenario(Params);
+}
+
+int32 UTrafficHarnessCommandlet::RunScenario(const FString& Params)
+{
+	FString ScenarioPath;
+	FTrafficScenario Scenario;
+	if (!LoadScenario(Params, TEXT("-run=TrafficHarness -Scenario=Path.json [-Steps=N] [-Golden=Path | -WriteGolden=Path] [-Timing]"), Scenario, &ScenarioPath))
+	{
+		return 2;
+	}
+
+	int32 NumSteps = Scenario.NumSteps;
+	FParse::Value(*Params, TEXT("Steps="), NumSteps);
+
+	FString GoldenPath;
+	FString WriteGoldenPath;
+	const bool bCompareGolden = FParse::Value(*Params, TEXT("Golden="), GoldenPath);
+	const bool bWriteGolden = FParse::Value(*Params, TEXT("WriteGolden="), WriteGoldenPath);
+	const bool bTiming = FParse::Param(*Params, TEXT("Timing"));
+	const bool bGenericUpdate = FParse::Param(*Params, TEXT("GenericUpdate"));
+
+	int32 WarmupSteps = 30;
+	FParse::Value(*Params, TEXT("WarmupSteps="), WarmupSteps);
+
+	FTrafficGoldenTolerance Tolerance;
+	FParse::Value(*Params, TEXT("PositionTolerance="), Tolerance.Position);
+	FParse::Value(*Params, TEXT("YawTolerance="), Tolerance.Yaw);
+	FParse::Value(*Params, TEXT("SpeedTolerance="), Tolerance.Speed);
+
+	int32 NumReplicationClients = 0;
+	FParse::Value(*Params, TEXT("Replication="), NumReplicationClients);
+
+	const bool bCheckAllocations = FParse::Param(*Params, TEXT("CheckAllocations"));
+#if !TRAFFIC_ALLOCATION_TRACKING
+	if (bCheckAllocations)
+	{
+		UE_LOG(LogTemp, Error, TEXT("-CheckAllocations bu derlemede yok (shipping)"));
+		return 2;
+	}
+#endif
+
+	FTrafficRecordingReader Golden;
+	if (bCompareGolden && !Golden.Open(GoldenPath))
+	{
+		return 2;
+	}
+
+	FHarnessScenarioWorld HarnessWorld;
+	if (!HarnessWorld.Create(Scenario))
+	{
+		return 2;
+	}
+
+	const int32 NumVehicles = HarnessWorld.Spawn(Scenario, Params);
+	UTrafficSubsystem* TrafficSubsystem = HarnessWorld.GetSubsystem();
+	TrafficSubsystem->SetGenericControllerUpdate(bGenericUpdate);
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: %s, %d araç, %d adım, dt=%.4f, tohum=%d"),
+		*ScenarioPath, NumVehicles, NumSteps, Scenario.DeltaTime, Scenario.Seed);
+
+	const bool bCapture = bCompareGolden || bWriteGolden;
+	TArray<FTrafficRecordingFrame> Frames;
+	if (bCapture)
+	{
+		Frames.Reserve(NumSteps);
+	}
+
+	TArray<double> StepTimes;
+	StepTimes.Reserve(NumSteps);
+
+	FReplicationLoopback ReplicationLoopback;
+	if (NumReplicationClients > 0)
+	{
+		ReplicationLoopback.Initialize(NumReplicationClients, TrafficSubsystem, Scenario.Seed);
+	}
+
+	int32 AllocationSteps = 0;
+	int64 TotalAllocations = 0;
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+#if TRAFFIC_ALLOCATION_TRACKING
+		// Isınma bitti: havuzlar ve diziler kapasitelerine ulaştı, sayaç bundan sonra sıfır kalmalı
+		FTrafficMallocCounter* AllocationCounter = nullptr;
+		if (bCheckAllocations && Step >= WarmupSteps)
+		{
+			AllocationCounter = &FTrafficMallocCounter::Install();
+			AllocationCounter->ResetCounts();
+		}
+#endif
+
+		const double StartTime = FPlatformTime::Seconds();
+		HarnessWorld.Step(Scenario.DeltaTime);
+		const double EndTime = FPlatformTime::Seconds();
+
+#if TRAFFIC_ALLOCATION_TRACKING
+		if (AllocationCounter && AllocationCounter->GetAllocationCount() > 0)
+		{
+			// İlk adımı ayrıntılı raporla, sonrakileri say
+			if (AllocationSteps == 0)
+			{
+				UE_LOG(LogTemp, Error, TEXT("TAHSİS: adım %d, trafik güncellemesinde %lld heap tahsisi (%lld byte)"),
+					Step, AllocationCounter->GetAllocationCount(), AllocationCounter->GetAllocatedBytes());
+			}
+			++AllocationSteps;
+			TotalAllocations += AllocationCounter->GetAllocationCount();
+		}
+#endif
+
+		if (Step >= WarmupSteps)
+		{
+			StepTimes.Add(EndTime - StartTime);
+		}
+
+		// Replikasyon maliyeti adım süresinden ayrı ölçülür
+		if (NumReplicationClients > 0)
+		{
+			ReplicationLoopback.Step(TrafficSubsystem, Scenario.DeltaTime);
+		}
+
+		// Kopya zamanlama dışında
+		if (bCapture)
+		{
+			FTrafficRecordingFrame& Frame = Frames.AddDefaulted_GetRef();
+			TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficRecordingSubsystem>()->CaptureFrame(Frame);
+			Frame.StepIndex = Step;
+			Frame.Vehicles.Sort([](const FTrafficRecordedVehicle& A, const FTrafficRecordedVehicle& B)
+			{
+				return A.TrafficId < B.TrafficId;
+			});
+		}
+	}
+
+	HarnessWorld.Destroy();
+
+	int32 Result = 0;
+
+	if (bWriteGolden)
+	{
+		FTrafficRecordingWriter Writer;
+		for (const FTrafficRecordingFrame& Frame : Frames)
+		{
+			Writer.AddFrame(Frame);
+		}
+		Writer.Finish();
+
+		if (!Writer.SaveToFile(WriteGoldenPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Golden dosyası yazılamadı: %s"), *WriteGoldenPath);
+			Result = 2;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("Golden yazıldı: %s (%d kare)"), *WriteGoldenPath, Frames.Num());
+		}
+	}
+
+	if (bCompareGolden)
+	{
+		if (CompareWithGolden(Frames, Golden, Tolerance))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Golden karşılaştırması BAŞARILI: %d kare"), Frames.Num());
+		}
+		else
+		{
+			Result = 1;
+		}
+	}
+
+	if (bTiming)
+	{
+		ReportTiming(StepTimes, NumVehicles, bGenericUpdate ? TEXT("Generic") : TEXT("Variant"));
+	}
+
+	if (NumReplicationClients > 0)
+	{
+		ReplicationLoopback.Report();
+	}
+
+	if (bCheckAllocations)
+	{
+		LogSummary(TEXT("Allocations"), FString::Printf(TEXT("Steps=%d StepsWithAllocations=%d Allocations=%lld"),
+			FMath::Max(0, NumSteps - WarmupSteps), AllocationSteps, TotalAllocations));
+
+		if (AllocationSteps > 0)
+		{
+			Result = FMath::Max(Result, 1);
+		}
+	}
+
+	return Result;
+}
+
+UWorld* UTrafficHarnessCommandlet::CreateHarnessWorld(const FTrafficScenario& Scenario)
+{
+	if (!GEngine)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: GEngine yok"));
+		return nullptr;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TrafficHarnessWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+
+	// Oyun modu yok: BeginPlay doğrudan dünya ayarları üzerinden başlatılır
+	if (AWorldSettings* WorldSettings = World->GetWorldSettings())
+	{
+		WorldSettings->NotifyBeginPlay();
+	}
+
+	// Sinyal optimizasyonu worker thread zamanlamasına bağlı kalmasın
+	if (UTrafficSignalSubsystem* SignalSubsystem = World->GetSubsystem<UTrafficSignalSubsystem>())
+	{
+		SignalSubsystem->SetSynchronousOptimization(true);
+	}
+
+	return World;
+}
+
+void UTrafficHarnessCommandlet::DestroyHarnessWorld(UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	World->EndPlay(EEndPlayReason::Quit);
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+void UTrafficHarnessCommandlet::StepHarnessWorld(UWorld* World, float DeltaTime)
+{
+	// UWorld::Tick aktör tick gruplarını ve (sonunda) tickable world subsystem'leri çalıştırır
+	World->Tick(LEVELTICK_All, DeltaTime);
+	++GFrameCounter;
+}
+
+bool UTrafficHarnessCommandlet::CompareWithGolden(const TArray<FTrafficRecordingFrame>& Frames, const FTrafficRecordingReader& Golden, const FTrafficGoldenTolerance& Tolerance)
+{
+	if (Golden.GetFrameCount() != Frames.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Golden kare sayısı farklı: beklenen %d, gerçek %d (ortak kareler karşılaştırılıyor)"),
+			Golden.GetFrameCount(), Frames.Num());
+	}
+
+	const int32 NumFrames = FMath::Min(Golden.GetFrameCount(), Frames.Num());
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		const FTrafficRecordingFrame& Expected = Golden.GetFrame(FrameIndex);
+		const FTrafficRecordingFrame& Actual = Frames[FrameIndex];
+
+		// İki liste de kimliğe göre sıralı - birleştirerek tara
+		int32 ExpectedIndex = 0;
+		int32 ActualIndex = 0;
+		while (ExpectedIndex < Expected.Vehicles.Num() || ActualIndex < Actual.Vehicles.Num())
+		{
+			const FTrafficRecordedVehicle* ExpectedVehicle = Expected.Vehicles.IsValidIndex(ExpectedIndex) ? &Expected.Vehicles[ExpectedIndex] : nullptr;
+			const FTrafficRecordedVehicle* ActualVehicle = Actual.Vehicles.IsValidIndex(ActualIndex) ? &Actual.Vehicles[ActualIndex] : nullptr;
+
+			if (!ActualVehicle || (ExpectedVehicle && ExpectedVehicle->TrafficId < ActualVehicle->TrafficId))
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u golden'da var, çalıştırmada yok"), FrameIndex, ExpectedVehicle->TrafficId);
+				return false;
+			}
+
+			if (!ExpectedVehicle || ActualVehicle->TrafficId < ExpectedVehicle->TrafficId)
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u çalıştırmada var, golden'da yok"), FrameIndex, ActualVehicle->TrafficId);
+				return false;
+			}
+
+			const TCHAR* Field = nullptr;
+			float ExpectedValue = 0.0f;
+			float ActualValue = 0.0f;
+			if (FindFieldDivergence(*ExpectedVehicle, *ActualVehicle, Tolerance, Field, ExpectedValue, ActualValue))
+			{
+				if (FCString::Strcmp(Field, TEXT("Location")) == 0)
+				{
+					UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u, konum farkı %.2f cm (beklenen %s, gerçek %s)"),
+						FrameIndex, ActualVehicle->TrafficId, ActualValue, *ExpectedVehicle->Location.ToString(), *ActualVehicle->Location.ToString());
+				}
+				else
+				{
+					UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, araç %u, %s: beklenen %.3f, gerçek %.3f"),
+						FrameIndex, ActualVehicle->TrafficId, Field, ExpectedValue, ActualValue);
+				}
+				return false;
+			}
+
+			++ExpectedIndex;
+			++ActualIndex;
+		}
+
+		for (const FTrafficRecordedLight& ActualLight : Actual.Lights)
+		{
+			ETrafficLightState ExpectedState;
+			if (Golden.GetLightState(FrameIndex, ActualLight.LightId, ExpectedState) && ExpectedState != ActualLight.State)
+			{
+				UE_LOG(LogTemp, Error, TEXT("İLK SAPMA: adım %d, ışık %d: beklenen durum %d, gerçek %d"),
+					FrameIndex, ActualLight.LightId, (int32)ExpectedState, (int32)ActualLight.State);
+				return false;
+			}
+		}
+	}
+
+	return Golden.GetFrameCount() == Frames.Num();
+}
+
+int32 UTrafficHarnessCommandlet::RunPedestrianBenchmark(const FString& Params)
+{
+	int32 NumPedestrians = 0;
+	FParse::Value(*Params, TEXT("PedestrianBenchmark="), NumPedestrians);
+	if (NumPedestrians <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: -run=TrafficHarness -PedestrianBenchmark=N [-Steps=N] [-WarmupSteps=N] [-BudgetMs=2]"));
+		return 2;
+	}
+
+	int32 NumSteps = 300;
+	int32 WarmupSteps = 30;
+	float BudgetMs = 2.0f;
+	FParse::Value(*Params, TEXT("Steps="), NumSteps);
+	FParse::Value(*Params, TEXT("WarmupSteps="), WarmupSteps);
+	FParse::Value(*Params, TEXT("BudgetMs="), BudgetMs);
+
+	// Sentetik şehir: blok başına kapalı döngü kaldırım (kare çevre), blok başına ~100 yaya
+	constexpr float BlockSize = 10000.0f;
+	constexpr float StreetWidth = 2000.0f;
+	constexpr float SampleSpacing = 1000.0f;
+	constexpr float SidewalkWidth = 300.0f;
+	constexpr float DeltaTime = 1.0f / 30.0f;
+	constexpr int32 PedestriansPerBlock = 100;
+
+	const int32 NumBlocks = FMath::DivideAndRoundUp(NumPedestrians, PedestriansPerBlock);
+	const int32 BlocksPerRow = FMath::CeilToInt(FMath::Sqrt((float)NumBlocks));
+	const int32 SamplesPerSide = FMath::RoundToInt(BlockSize / SampleSpacing);
+
+	FTrafficPedestrianCrowd Crowd;
+	Crowd.Initialize(FTrafficPedestrianSettings(), 1);
+
+	TArray<int32> SidewalkIds;
+	for (int32 Block = 0; Block < NumBlocks; ++Block)
+	{
+		const FVector Corner((Block % BlocksPerRow) * (BlockSize + StreetWidth), (Block / BlocksPerRow) * (BlockSize + StreetWidth), 0.0f);
+		const FVector Sides[4] = { FVector(1.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f), FVector(-1.0f, 0.0f, 0.0f), FVector(0.0f, -1.0f, 0.0f) };
+
+		TArray<FVector> SamplePoints;
+		FVector Point = Corner;
+		SamplePoints.Add(Point);
+		for (const FVector& Side : Sides)
+		{
+			for (int32 Sample = 0; Sample < SamplesPerSide; ++Sample)
+			{
+				Point += Side * SampleSpacing;
+				SamplePoints.Add(Point);
+			}
+		}
+
+		SidewalkIds.Add(Crowd.AddSidewalk(MoveTemp(SamplePoints), SampleSpacing, BlockSize * 4.0f, SidewalkWidth, true));
+	}
+
+	FRandomStream Random(1);
+	for (int32 Pedestrian = 0; Pedestrian < NumPedestrians; ++Pedestrian)
+	{
+		Crowd.AddPedestrian(SidewalkIds[Pedestrian % NumBlocks], Random.FRandRange(0.0f, BlockSize * 4.0f));
+	}
+
+	// Araç tarafıyla aynı yapılandırma (UTrafficSubsystem'de yayalar araç hash'ine eklenir)
+	FTrafficSpatialHash SpatialHash;
+	SpatialHash.Initialize(2000.0f, 4096);
+
+	const int32 MaxThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	TArray<int32> TaskCounts;
+	for (int32 Tasks = 1; Tasks < MaxThreads; Tasks *= 2)
+	{
+		TaskCounts.Add(Tasks);
+	}
+	TaskCounts.Add(MaxThreads);
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: %d yaya, %d kaldırım, %d adım, dt=%.4f"), NumPedestrians, NumBlocks, NumSteps, DeltaTime);
+
+	int32 Result = 0;
+	double SingleTaskMeanMs = 0.0;
+	TArray<double> StepTimes;
+	StepTimes.Reserve(NumSteps);
+
+	for (const int32 Tasks : TaskCounts)
+	{
+		StepTimes.Reset();
+		double BroadphaseSeconds = 0.0;
+
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Crowd.Step(DeltaTime, Tasks);
+			const double CrowdTime = FPlatformTime::Seconds();
+
+			SpatialHash.Reset();
+			Crowd.AddToSpatialHash(SpatialHash);
+			SpatialHash.Build();
+			const double EndTime = FPlatformTime::Seconds();
+
+			if (Step >= WarmupSteps)
+			{
+				StepTimes.Add(EndTime - StartTime);
+				BroadphaseSeconds += EndTime - CrowdTime;
+			}
+		}
+
+		FStepTimeStats Stats;
+		if (!ComputeStepTimeStats(StepTimes, Stats))
+		{
+			return 2;
+		}
+
+		const double BroadphaseMs = BroadphaseSeconds / Stats.NumSteps * 1000.0;
+		if (Tasks == 1)
+		{
+			SingleTaskMeanMs = Stats.MeanMs;
+		}
+
+		LogSummary(TEXT("Pedestrians"), FString::Printf(TEXT("Pedestrians=%d Tasks=%d MeanMs=%.4f MedianMs=%.4f P95Ms=%.4f BroadphaseMs=%.4f Speedup=%.2f"),
+			NumPedestrians, Tasks, Stats.MeanMs, Stats.MedianMs, Stats.P95Ms, BroadphaseMs, Stats.MeanMs > 0.0 ? SingleTaskMeanMs / Stats.MeanMs : 0.0));
+	}
+
+	if (SingleTaskMeanMs > BudgetMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Yaya adımı tek görevde bütçeyi aştı: %.4f ms > %.2f ms"), SingleTaskMeanMs, BudgetMs);
+		Result = 1;
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunEventStress(const FString& Params)
+{
+	int32 NumEvents = 0;
+	int32 NumProducers = 8;
+	int32 Capacity = 1024;
+	FParse::Value(*Params, TEXT("EventStress="), NumEvents);
+	FParse::Value(*Params, TEXT("Producers="), NumProducers);
+	FParse::Value(*Params, TEXT("Capacity="), Capacity);
+
+	if (NumEvents <= 0 || NumProducers <= 0 || Capacity <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: -run=TrafficHarness -EventStress=N [-Producers=8] [-Capacity=1024]"));
+		return 2;
+	}
+
+	TTrafficEventQueue<FTrafficEvent> Queue;
+	Queue.Initialize(Capacity);
+
+	// Olay üreticiyi (TrafficId) ve üreticideki sırasını (LaneId) taşır
+	const int32 EventsPerProducer = FMath::DivideAndRoundUp(NumEvents, NumProducers);
+	TArray<int64> Accepted;
+	Accepted.SetNumZeroed(NumProducers);
+	std::atomic<int32> NumRunning{ NumProducers };
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: %d üretici, üretici başına %d olay, kapasite %d"), NumProducers, EventsPerProducer, Queue.GetCapacity());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<TFuture<void>> Producers;
+	for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+	{
+		Producers.Add(Async(EAsyncExecution::Thread, [&Queue, &Accepted, &NumRunning, Producer, EventsPerProducer]()
+		{
+			int64 NumAccepted = 0;
+			for (int32 Sequence = 0; Sequence < EventsPerProducer; ++Sequence)
+			{
+				FTrafficEvent Event = FTrafficEvent::MakeRoadClosure(Sequence, 0.0f);
+				Event.TrafficId = (uint32)Producer;
+				NumAccepted += Queue.Push(Event);
+			}
+			Accepted[Producer] = NumAccepted;
+			NumRunning.fetch_sub(1);
+		}));
+	}
+
+	// Tüketici: oyun thread'indeki adım başı boşaltma gibi, üreticiler çalışırken sürekli
+	TArray<int32> LastSequence;
+	LastSequence.Init(INDEX_NONE, NumProducers);
+	int64 NumReceived = 0;
+	int32 NumOrderViolations = 0;
+	int32 NumDrains = 0;
+
+	const auto Consume = [&](FTrafficEvent&& Event)
+	{
+		const int32 Producer = (int32)Event.TrafficId;
+		if (!LastSequence.IsValidIndex(Producer) || Event.LaneId <= LastSequence[Producer])
+		{
+			++NumOrderViolations;
+			return;
+		}
+		LastSequence[Producer] = Event.LaneId;
+		++NumReceived;
+	};
+
+	while (NumRunning.load() > 0)
+	{
+		if (Queue.Drain(Consume) == 0)
+		{
+			FPlatformProcess::Yield();
+		}
+		++NumDrains;
+	}
+
+	for (TFuture<void>& Producer : Producers)
+	{
+		Producer.Wait();
+	}
+
+	// Üreticiler bitti - kalanı boşalt
+	while (Queue.Drain(Consume) > 0)
+	{
+		++NumDrains;
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+	int64 NumAccepted = 0;
+	for (const int64 ProducerAccepted : Accepted)
+	{
+		NumAccepted += ProducerAccepted;
+	}
+	const int64 NumPosted = (int64)EventsPerProducer * NumProducers;
+	const int64 NumDropped = Queue.GetNumDropped();
+
+	LogSummary(TEXT("Events"), FString::Printf(TEXT("Producers=%d Events=%lld Received=%lld Dropped=%lld MaxDepth=%d Drains=%d EventsPerSec=%.0f"),
+		NumProducers, NumPosted, NumReceived, NumDropped, Queue.GetMaxDepth(), NumDrains, Seconds > 0.0 ? NumPosted / Seconds : 0.0));
+
+	int32 Result = 0;
+	if (NumOrderViolations > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Olay kuyruğu üretici sırasını bozdu: %d olay"), NumOrderViolations);
+		Result = 1;
+	}
+	if (NumReceived != NumAccepted || NumReceived + NumDropped != NumPosted || Queue.GetNumPushed() != NumAccepted)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Olay sayıları tutmuyor: gönderilen %lld, kabul edilen %lld, alınan %lld, düşürülen %lld"),
+			NumPosted, NumAccepted, NumReceived, NumDropped);
+		Result = 1;
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunOvertakeBenchmark(const FString& Params)
+{
+	int32 NumPlanners = 0;
+	int32 NumSteps = 300;
+	int32 WarmupSteps = 30;
+	int32 VehiclesPerLane = 40;
+	float BudgetMs = 1.0f;
+	FParse::Value(*Params, TEXT("OvertakeBenchmark="), NumPlanners);
+	FParse::Value(*Params, TEXT("Steps="), NumSteps);
+	FParse::Value(*Params, TEXT("WarmupSteps="), WarmupSteps);
+	FParse::Value(*Params, TEXT("VehiclesPerLane="), VehiclesPerLane);
+	FParse::Value(*Params, TEXT("BudgetMs="), BudgetMs);
+
+	if (NumPlanners <= 0 || VehiclesPerLane <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: -run=TrafficHarness -OvertakeBenchmark=N [-Steps=N] [-WarmupSteps=N] [-VehiclesPerLane=40] [-BudgetMs=1]"));
+		return 2;
+	}
+
+	// Sentetik yol: 3 şerit, isteyen ortada yavaş bir liderin arkasında; şeritler sıkı dolu
+	// (pencerede MaxObstacles'tan fazla araç, tampon en yakınları tutmalı)
+	constexpr float LaneWidth = 350.0f;
+	constexpr float Spacing = 1200.0f;
+	constexpr float Horizon = 4.0f;
+	constexpr float LateralClearance = LaneWidth * 0.5f;
+
+	FRandomStream Random(1);
+	TArray<FTrafficOvertakeRequest> Requests;
+	TArray<FTrafficOvertakeObstacles> Obstacles;
+	Requests.SetNum(NumPlanners);
+	Obstacles.SetNum(NumPlanners);
+
+	int32 NumNearestViolations = 0;
+	TArray<float> Gaps;
+	for (int32 Planner = 0; Planner < NumPlanners; ++Planner)
+	{
+		FTrafficOvertakeRequest& Request = Requests[Planner];
+		Request.LaneId = 1;
+		Request.TargetLaneIds[0] = 0;
+		Request.TargetLaneIds[1] = 2;
+		Request.TargetOffsets[0] = -LaneWidth;
+		Request.TargetOffsets[1] = LaneWidth;
+		Request.Distance = Random.FRandRange(0.0f, 100000.0f);
+		Request.Speed = Random.FRandRange(800.0f, 1400.0f);
+		Request.MaxSpeed = 1600.0f;
+		Request.MaxAcceleration = 300.0f;
+		Request.VehicleLength = 450.0f;
+		Request.MinimumGap = 200.0f;
+		Request.TimeHeadway = 1.5f;
+		Request.BaseLaneChangeDuration = 2.0f;
+		Request.OvertakeSpeedRatio = 0.7f;
+		Request.OvertakeLookahead = 3000.0f;
+
+		// Şeritler GatherLaneObstacles gibi önden arkaya (uzaktan yakına) eklenir
+		FTrafficOvertakeObstacles& Set = Obstacles[Planner];
+		Set.Reference = Request.Distance;
+		Gaps.Reset();
+		for (int32 Lane = 0; Lane < 3; ++Lane)
+		{
+			for (int32 Vehicle = VehiclesPerLane; Vehicle >= -VehiclesPerLane; --Vehicle)
+			{
+				const float Distance = Request.Distance + Vehicle * Spacing + Random.FRandRange(-200.0f, 200.0f) + (Lane == 1 ? Spacing * 0.5f : 0.0f);
+				if (Lane == 1 && Distance < Request.Distance)
+				{
+					continue;
+				}
+
+				Set.Add(Lane * VehiclesPerLane * 4 + Vehicle + VehiclesPerLane + 1, Distance, Random.FRandRange(600.0f, 1400.0f), (Lane - 1) * LaneWidth, 450.0f);
+				Gaps.Add(FMath::Abs(Distance - Request.Distance));
+			}
+		}
+
+		// Tutulan araçlar en yakın MaxObstacles olmalı
+		Gaps.Sort();
+		const float Cutoff = Gaps[FMath::Min(Set.Num, Gaps.Num()) - 1];
+		for (int32 Obstacle = 0; Obstacle < Set.Num; ++Obstacle)
+		{
+			NumNearestViolations += FMath::Abs(Set.Distance[Obstacle] - Request.Distance) > Cutoff ? 1 : 0;
+		}
+	}
+
+	TArray<FTrafficOvertakePlan> Plans;
+	Plans.SetNum(NumPlanners);
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: %d sollama planlayıcısı, şerit başına %d araç, %d adım"), NumPlanners, VehiclesPerLane * 2 + 1, NumSteps);
+
+	// Seri ve paralel (UTrafficSubsystem::PlanOvertakes gibi ParallelFor ile)
+	int32 Result = NumNearestViolations > 0 ? 1 : 0;
+	for (const bool bParallel : { false, true })
+	{
+		TArray<double> StepTimes;
+		StepTimes.Reserve(NumSteps);
+
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumPlanners, [&](int32 Index)
+			{
+				Plans[Index] = FTrafficOvertakePlanner::Plan(Requests[Index], Obstacles[Index], Horizon, LateralClearance);
+			}, !bParallel);
+
+			if (Step >= WarmupSteps)
+			{
+				StepTimes.Add(FPlatformTime::Seconds() - StartTime);
+			}
+		}
+
+		FStepTimeStats Stats;
+		if (!ComputeStepTimeStats(StepTimes, Stats))
+		{
+			return 2;
+		}
+
+		int32 NumPlanned = 0;
+		for (const FTrafficOvertakePlan& Plan : Plans)
+		{
+			NumPlanned += Plan.Candidate != INDEX_NONE ? 1 : 0;
+		}
+
+		LogSummary(TEXT("Overtake"), FString::Printf(TEXT("Planners=%d Parallel=%d MeanMs=%.4f MedianMs=%.4f P95Ms=%.4f UsPerPlan=%.3f Planned=%d NearestViolations=%d"),
+			NumPlanners, bParallel ? 1 : 0, Stats.MeanMs, Stats.MedianMs, Stats.P95Ms, Stats.MeanMs * 1000.0 / NumPlanners, NumPlanned, NumNearestViolations));
+
+		if (!bParallel && Stats.MeanMs > BudgetMs)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Sollama planlaması seri yolda bütçeyi aştı: %.4f ms > %.2f ms"), Stats.MeanMs, BudgetMs);
+			Result = 1;
+		}
+	}
+
+	if (NumNearestViolations > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Engel tamponu en yakın araçları tutmadı: %d kayıt"), NumNearestViolations);
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunManeuverBenchmark(const FString& Params)
+{
+	int32 NumManeuvers = 0;
+	int32 NumSteps = 300;
+	int32 WarmupSteps = 30;
+	float BudgetMs = 1.0f;
+	FParse::Value(*Params, TEXT("ManeuverBenchmark="), NumManeuvers);
+	FParse::Value(*Params, TEXT("Steps="), NumSteps);
+	FParse::Value(*Params, TEXT("WarmupSteps="), WarmupSteps);
+	FParse::Value(*Params, TEXT("BudgetMs="), BudgetMs);
+
+	if (NumManeuvers <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: -run=TrafficHarness -ManeuverBenchmark=N [-Steps=N] [-WarmupSteps=N] [-BudgetMs=1]"));
+		return 2;
+	}
+
+	constexpr float DeltaTime = 1.0f / 30.0f;
+	constexpr float WheelTickInterval = 0.1f;
+	constexpr int32 WheelSlots = 256;
+
+	// Adım başına manevraların 1/RestartPeriod'u iptal edilip yeniden başlar (çerçeve havuzu),
+	// 1/SignalPeriod'u offset'e ulaşır ve boşluk yoklamalarının 1/GapPeriod'u boş çıkar
+	constexpr int32 RestartPeriod = 16;
+	constexpr int32 SignalPeriod = 8;
+	constexpr int32 GapPeriod = 16;
+
+	// Controller'lar sadece manevra yuvası için: pawn yok, şeride bağlı değil, dünya adımlanmaz
+	FHarnessScenarioWorld HarnessWorld;
+	if (!HarnessWorld.Create(FTrafficScenario()))
+	{
+		return 2;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<AVehicleAIController*> Controllers;
+	Controllers.Reserve(NumManeuvers);
+	for (int32 Index = 0; Index < NumManeuvers; ++Index)
+	{
+		Controllers.Add(HarnessWorld.GetWorld()->SpawnActor<AVehicleAIController>(AVehicleAIController::StaticClass(), FTransform::Identity, SpawnParams));
+	}
+
+	FTrafficManeuverScheduler Scheduler;
+	Scheduler.Initialize(WheelSlots, WheelTickInterval);
+	for (int32 Index = 0; Index < NumManeuvers; ++Index)
+	{
+		Scheduler.Start(Controllers[Index], RunBenchmarkManeuver((Index & 1) != 0));
+	}
+
+	TArray<double> StepTimes;
+	StepTimes.Reserve(NumSteps);
+
+	int64 GapPolls = 0;
+	int64 Resumes = 0;
+	int32 MaxGapWaiters = 0;
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		for (int32 Index = Step % RestartPeriod; Index < NumManeuvers; Index += RestartPeriod)
+		{
+			Scheduler.Start(Controllers[Index], RunBenchmarkManeuver((Index & 1) != 0));
+		}
+
+		for (int32 Index = Step % SignalPeriod; Index < NumManeuvers; Index += SignalPeriod)
+		{
+			Scheduler.Signal(Controllers[Index], ETrafficManeuverWait::OffsetReached);
+		}
+
+		const int32 NumGapWaiters = Scheduler.GetGapWaiterCount();
+		const double StartTime = FPlatformTime::Seconds();
+		Scheduler.Update(DeltaTime, [Step](const AVehicleAIController* Controller, bool bRight)
+		{
+			return (GetTypeHash(Controller) + Step) % GapPeriod == 0;
+		});
+		const double EndTime = FPlatformTime::Seconds();
+
+		if (Step >= WarmupSteps)
+		{
+			StepTimes.Add(EndTime - StartTime);
+			GapPolls += NumGapWaiters;
+			Resumes += Scheduler.GetLastResumeCount();
+			MaxGapWaiters = FMath::Max(MaxGapWaiters, NumGapWaiters);
+		}
+	}
+
+	const int32 NumInFlight = Scheduler.Num();
+	const int32 NumPooledFrames = FTrafficManeuverTask::GetPooledFrameCount();
+
+	// Kapanış: yuvalar yok edilir ve havuz belleğe geri verilir
+	Scheduler.Reset();
+	const int32 NumLeakedFrames = FTrafficManeuverTask::GetPooledFrameCount();
+
+	FStepTimeStats Stats;
+	if (!ComputeStepTimeStats(StepTimes, Stats))
+	{
+		return 2;
+	}
+
+	LogSummary(TEXT("Maneuver"), FString::Printf(TEXT("Maneuvers=%d InFlight=%d MeanMs=%.4f MedianMs=%.4f P95Ms=%.4f GapPollsPerStep=%.1f MaxGapWaiters=%d ResumesPerStep=%.1f PooledFrames=%d FramesAfterReset=%d"),
+		NumManeuvers, NumInFlight, Stats.MeanMs, Stats.MedianMs, Stats.P95Ms, (double)GapPolls / Stats.NumSteps, MaxGapWaiters, (double)Resumes / Stats.NumSteps, NumPooledFrames, NumLeakedFrames));
+
+	int32 Result = 0;
+	if (NumInFlight != NumManeuvers)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Askıdaki manevra sayısı tutmuyor: %d / %d"), NumInFlight, NumManeuvers);
+		Result = 1;
+	}
+	if (NumLeakedFrames > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Zamanlayıcı sıfırlandıktan sonra havuzda %d çerçeve kaldı"), NumLeakedFrames);
+		Result = 1;
+	}
+	if (Stats.MeanMs > BudgetMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Manevra güncellemesi bütçeyi aştı: %.4f ms > %.2f ms"), Stats.MeanMs, BudgetMs);
+		Result = 1;
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunOccupancyTest(const FString& Params)
+{
+	int32 NumCases = 0;
+	int32 NumFailed = 0;
+	const auto Check = [&NumCases, &NumFailed](bool bPassed, const TCHAR* Name)
+	{
+		++NumCases;
+		if (!bPassed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Doluluk testi başarısız: %s"), Name);
+			++NumFailed;
+		}
+	};
+
+	const auto MakeBox = [](const FVector& Location, const FVector2D& Forward, float HalfLength, float HalfWidth, int32 ItemId = INDEX_NONE)
+	{
+		FTrafficOccupant Box;
+		Box.Location = Location;
+		Box.Forward = Forward.GetSafeNormal();
+		Box.HalfLength = HalfLength;
+		Box.HalfWidth = HalfWidth;
+		Box.ItemId = ItemId;
+		return Box;
+	};
+
+	// 1) Ayırma ekseni testi (FTrafficOccupant::Overlaps)
+	const FVector2D AlongX(1.0f, 0.0f);
+	const FVector2D Diagonal(1.0f, 1.0f);
+	const FVector2D AntiDiagonal(1.0f, -1.0f);
+	const FTrafficOccupant Car = MakeBox(FVector::ZeroVector, AlongX, 225.0f, 140.0f);
+
+	Check(FTrafficOccupant::Overlaps(Car, MakeBox(FVector(400.0f, 0.0f, 0.0f), AlongX, 225.0f, 140.0f)), TEXT("SAT: aynı şeritte iç içe"));
+	Check(!FTrafficOccupant::Overlaps(Car, MakeBox(FVector(500.0f, 0.0f, 0.0f), AlongX, 225.0f, 140.0f)), TEXT("SAT: aynı şeritte boşluklu"));
+	Check(!FTrafficOccupant::Overlaps(Car, MakeBox(FVector(0.0f, 350.0f, 0.0f), AlongX, 225.0f, 140.0f)), TEXT("SAT: komşu şerit"));
+	Check(FTrafficOccupant::Overlaps(Car, MakeBox(FVector(100.0f, 100.0f, 0.0f), FVector2D(0.0f, 1.0f), 225.0f, 140.0f)), TEXT("SAT: dik kesişme"));
+
+	// Çapraz ince çubuk: eksen hizalı sınır kutuları kesişir, sadece çubuğun kendi ekseni ayırır
+	const FTrafficOccupant Square = MakeBox(FVector::ZeroVector, AlongX, 100.0f, 100.0f);
+	const FVector2D DiagonalNormal = Diagonal.GetSafeNormal();
+	Check(!FTrafficOccupant::Overlaps(Square, MakeBox(FVector(DiagonalNormal * 170.0f, 0.0f), AntiDiagonal, 100.0f, 10.0f)), TEXT("SAT: çapraz, sadece B ekseni ayırır"));
+	Check(FTrafficOccupant::Overlaps(Square, MakeBox(FVector(DiagonalNormal * 140.0f, 0.0f), AntiDiagonal, 100.0f, 10.0f)), TEXT("SAT: çapraz kesişme"));
+	Check(FTrafficOccupant::Overlaps(MakeBox(FVector(DiagonalNormal * 140.0f, 0.0f), AntiDiagonal, 100.0f, 10.0f), Square), TEXT("SAT: simetri"));
+
+	// 2) Zaman katmanlı ızgara: 0.5 sn aralıkla 0 - 2 sn (5 katman)
+	FTrafficOccupancyGrid Grid;
+	Grid.Initialize(1000.0f, 64, 0.5f, 2.0f);
+	Check(Grid.GetNumLayers() == 5, TEXT("Izgara: katman sayısı"));
+	Check(Grid.GetLayerForTime(-1.0f) == 0 && Grid.GetLayerForTime(0.74f) == 1 && Grid.GetLayerForTime(10.0f) == 4, TEXT("Izgara: zaman -> katman"));
+
+	// 0: +X yönünde 1000 cm/s; 1: önde duran araç (2 sn sonra 0 ile kesişir); 2: komşu şeritte 0 ile aynı hızda; 3: yok
+	struct FItem
+	{
+		FVector Location;
+		float Speed;
+		int32 Lane;
+	};
+	const FItem Items[] =
+	{
+		{ FVector(0.0f, 0.0f, 0.0f), 1000.0f, 0 },
+		{ FVector(2300.0f, 0.0f, 0.0f), 0.0f, 0 },
+		{ FVector(0.0f, 350.0f, 0.0f), 1000.0f, 1 },
+		{ FVector::ZeroVector, 0.0f, INDEX_NONE },
+	};
+
+	Grid.Build(UE_ARRAY_COUNT(Items), [&Grid, &Items](int32 Index, TArrayView<FTrafficOccupant> OutLayers)
+	{
+		const FItem& Item = Items[Index];
+		if (Item.Lane == INDEX_NONE)
+		{
+			return false;
+		}
+
+		for (int32 Layer = 0; Layer < OutLayers.Num(); ++Layer)
+		{
+			FTrafficOccupant& Occupant = OutLayers[Layer];
+			Occupant.Location = Item.Location + FVector(Item.Speed * Grid.GetLayerTime(Layer), 0.0f, 0.0f);
+			Occupant.Forward = FVector2D(1.0f, 0.0f);
+			Occupant.HalfLength = 225.0f;
+			Occupant.HalfWidth = 140.0f;
+			Occupant.Group = Item.Lane;
+		}
+		return true;
+	});
+
+	const auto Overlapping = [&Grid](int32 Layer, const FTrafficOccupant& Box)
+	{
+		TArray<int32, TInlineAllocator<4>> Found;
+		Grid.ForEachOverlap(Layer, Box, [&Found](const FTrafficOccupant& Other)
+		{
+			Found.Add(Other.ItemId);
+		});
+		Found.Sort();
+		return Found;
+	};
+
+	Check(Grid.GetNumItems() == 4 && Grid.GetOccupant(0, 3) == nullptr && Grid.GetOccupant(4, 0) != nullptr, TEXT("Izgara: geçersiz öğe katmanda yok"));
+	Check(Overlapping(0, *Grid.GetOccupant(0, 0)).Num() == 0, TEXT("Izgara: şimdi çakışma yok (kendisi hariç)"));
+	Check(Overlapping(3, *Grid.GetOccupant(3, 0)).Num() == 0, TEXT("Izgara: 1.5 sn sonra boşluk var"));
+	{
+		const TArray<int32, TInlineAllocator<4>> Found = Overlapping(4, *Grid.GetOccupant(4, 0));
+		Check(Found.Num() == 1 && Found[0] == 1, TEXT("Izgara: 2 sn sonra öndeki araçla çakışma"));
+	}
+
+	// IsSideLaneOccupied'ın yan kutusu: aracın yanından komşu şerit ortasına kadar
+	{
+		FTrafficOccupant SideBox = *Grid.GetOccupant(0, 0);
+		SideBox.Location += FVector(0.0f, 175.0f, 0.0f);
+		SideBox.HalfWidth = 175.0f;
+		const TArray<int32, TInlineAllocator<4>> Right = Overlapping(0, SideBox);
+		Check(Right.Num() == 1 && Right[0] == 2, TEXT("Izgara: sağ yan kutu komşu şeridi görür"));
+
+		SideBox.Location -= FVector(0.0f, 350.0f, 0.0f);
+		Check(Overlapping(0, SideBox).Num() == 0, TEXT("Izgara: sol yan kutu boş"));
+	}
+
+	Grid.Reset();
+	Check(Grid.GetNumItems() == 0 && Overlapping(0, Car).Num() == 0, TEXT("Izgara: sıfırlama"));
+
+	LogSummary(TEXT("Occupancy"), FString::Printf(TEXT("Cases=%d Failed=%d"), NumCases, NumFailed));
+	return NumFailed > 0 ? 1 : 0;
+}
+
+int32 UTrafficHarnessCommandlet::RunBrakingEnvelopeTest(const FString& Params)
+{
+	// Yarım çember yol (merkez orijin, saat yönünün tersine): araç virajın başında,
+	// fren hacmi viraj boyunca uzanmalı
+	constexpr float ArcRadius = 3000.0f;
+	constexpr int32 NumArcPoints = 25;
+
+	// Şerit örnekleri 10 m aralıklı kirişlerdir: eksen çemberden en fazla kiriş sehimi kadar içeridedir
+	constexpr float LaneSampleSpacing = 1000.0f;
+	const float ArcTolerance = ArcRadius * (1.0f - FMath::Cos(LaneSampleSpacing * 0.5f / ArcRadius)) + 15.0f;
+
+	FTrafficScenario Scenario;
+	FTrafficScenarioSpline& Spline = Scenario.Splines.AddDefaulted_GetRef();
+	Spline.Name = TEXT("Curve");
+	for (int32 Point = 0; Point < NumArcPoints; ++Point)
+	{
+		const float Angle = PI * Point / (NumArcPoints - 1);
+		Spline.Points.Add(FVector(ArcRadius * FMath::Cos(Angle), ArcRadius * FMath::Sin(Angle), 0.0f));
+	}
+
+	FTrafficScenarioVehicle& Vehicle = Scenario.Vehicles.AddDefaulted_GetRef();
+	Vehicle.Spline = Spline.Name;
+	Vehicle.Distance = 300.0f;
+	Vehicle.Speed = 2000.0f;
+
+	FHarnessScenarioWorld HarnessWorld;
+	if (!HarnessWorld.Create(Scenario) || HarnessWorld.Spawn(Scenario, Params) != 1)
+	{
+		return 2;
+	}
+	HarnessWorld.Step(Scenario.DeltaTime);
+
+	TActorIterator<AVehicleAIController> It(HarnessWorld.GetWorld());
+	FTrafficBrakingEnvelope Envelope;
+	if (!It || !It->IsLaneBound() || !HarnessWorld.GetSubsystem()->GetPedestrianSubsystem()->GetBrakingEnvelope(*It, Envelope))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: şeride bağlı araç veya fren hacmi yok"));
+		return 2;
+	}
+
+	int32 NumCases = 0;
+	int32 NumFailed = 0;
+	const auto Check = [&NumCases, &NumFailed](bool bPassed, const TCHAR* Name)
+	{
+		++NumCases;
+		if (!bPassed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Fren hacmi testi başarısız: %s"), Name);
+			++NumFailed;
+		}
+	};
+
+	// Eksen uzunluğu ve çembere uzaklık (ilk nokta pawn'ın ön tamponu, şerit örneği değil)
+	float AxisLength = 0.0f;
+	float MaxArcError = 0.0f;
+	for (int32 Index = 1; Index < Envelope.NumPoints; ++Index)
+	{
+		AxisLength += FVector::Dist2D(Envelope.Points[Index - 1], Envelope.Points[Index]);
+		MaxArcError = FMath::Max(MaxArcError, FMath::Abs(FVector2D(Envelope.Points[Index]).Size() - ArcRadius));
+	}
+
+	// Eksen boyunca 3/4'teki nokta: yol üzerindeki nokta içeride, aynı uzaklıktaki teğet nokta dışarıda.
+	// Teğet noktanın çembere uzaklığı sqrt(R² + s²) - R; kapsül yarıçapını aşmıyorsa test anlamsız
+	const float ProbeLength = AxisLength * 0.75f;
+	const float TangentDeviation = FMath::Sqrt(FMath::Square(ArcRadius) + FMath::Square(ProbeLength)) - ArcRadius;
+
+	Check(Envelope.NumPoints > 2, TEXT("viraj ekseni birden fazla parça"));
+	Check(TangentDeviation > Envelope.Radius + ArcTolerance, TEXT("hacim 2000 cm/s için teğetten ayrılacak kadar uzun"));
+	Check(MaxArcError < ArcTolerance, TEXT("eksen noktaları şerit üzerinde"));
+
+	const FVector Front = Envelope.Points[0];
+	const float FrontAngle = FMath::Atan2(Front.Y, Front.X);
+	const float ProbeAngle = FrontAngle + ProbeLength / ArcRadius;
+	const FVector OnRoad(ArcRadius * FMath::Cos(ProbeAngle), ArcRadius * FMath::Sin(ProbeAngle), 0.0f);
+	const FVector Tangent = Front + FVector(-FMath::Sin(FrontAngle), FMath::Cos(FrontAngle), 0.0f) * ProbeLength;
+
+	Check(Envelope.Contains(OnRoad), TEXT("virajdaki yol noktası hacmin içinde"));
+	Check(!Envelope.Contains(Tangent), TEXT("teğet doğrultudaki nokta hacmin dışında"));
+	Check(!Envelope.Contains(FVector::ZeroVector), TEXT("viraj merkezi hacmin dışında"));
+
+	FVector Center;
+	float QueryRadius = 0.0f;
+	Envelope.GetBoundingCircle(Center, QueryRadius);
+	Check(FVector::Dist2D(Center, OnRoad) <= QueryRadius && FVector::Dist2D(Center, Front) <= QueryRadius, TEXT("sorgu dairesi hacmi kapsar"));
+
+	LogSummary(TEXT("BrakingEnvelope"), FString::Printf(TEXT("Cases=%d Failed=%d Points=%d AxisLength=%.1f MaxArcErrorCm=%.2f"),
+		NumCases, NumFailed, Envelope.NumPoints, AxisLength, MaxArcError));
+	return NumFailed > 0 ? 1 : 0;
+}
+
+int32 UTrafficHarnessCommandlet::RunRegion(const FString& Params)
+{
+	const TCHAR* Usage = TEXT("-run=TrafficHarness -Scenario=Path.json -Region=I -Regions=N [-RegionPort=7400] [-RegionReport=Path]");
+
+	int32 Region = INDEX_NONE;
+	int32 NumRegions = 0;
+	FParse::Value(*Params, TEXT("Region="), Region);
+	if (!FParse::Value(*Params, TEXT("Regions="), NumRegions) || NumRegions < 2 || Region < 0 || Region >= NumRegions)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: %s"), Usage);
+		return 2;
+	}
+
+	FTrafficScenario Scenario;
+	if (!LoadScenario(Params, Usage, Scenario))
+	{
+		return 2;
+	}
+
+	int32 NumSteps = Scenario.NumSteps;
+	int32 BasePort = DefaultRegionPort;
+	float ConnectTimeout = 60.0f;
+	FString ReportPath;
+	FParse::Value(*Params, TEXT("Steps="), NumSteps);
+	FParse::Value(*Params, TEXT("RegionPort="), BasePort);
+	FParse::Value(*Params, TEXT("RegionTimeout="), ConnectTimeout);
+	FParse::Value(*Params, TEXT("RegionReport="), ReportPath);
+
+	FTrafficRegionNode Node;
+	FParse::Value(*Params, TEXT("GhostWidth="), Node.GhostWidth);
+	FParse::Value(*Params, TEXT("HandoffMargin="), Node.HandoffMargin);
+	FParse::Value(*Params, TEXT("RebalanceInterval="), Node.RebalanceInterval);
+	FParse::Value(*Params, TEXT("RebalanceThreshold="), Node.RebalanceThreshold);
+
+	// Başlangıç bölmesi şehrin X aralığından (tüm süreçler aynı senaryodan aynısını hesaplar)
+	float MinX = FLT_MAX;
+	float MaxX = -FLT_MAX;
+	for (const FTrafficScenarioSpline& Spline : Scenario.Splines)
+	{
+		for (const FVector& Point : Spline.Points)
+		{
+			MinX = FMath::Min(MinX, (float)Point.X);
+			MaxX = FMath::Max(MaxX, (float)Point.X);
+		}
+	}
+	if (MinX >= MaxX)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: senaryoda bölünecek yol yok"));
+		return 2;
+	}
+
+	FTrafficRegionPartition Partition;
+	Partition.InitializeUniform(NumRegions, MinX, MaxX);
+
+	FHarnessScenarioWorld HarnessWorld;
+	if (!HarnessWorld.Create(Scenario))
+	{
+		return 2;
+	}
+
+	// Her süreç tüm şehri kurar (şerit ID'leri ve araç kimlikleri ortak), sonra yabancı araçları siler
+	HarnessWorld.Spawn(Scenario, Params);
+	UTrafficSubsystem* TrafficSubsystem = HarnessWorld.GetSubsystem();
+
+	if (!Node.Initialize(Region, Partition, BasePort, ConnectTimeout))
+	{
+		return 2;
+	}
+
+	Node.ClaimVehicles(TrafficSubsystem);
+	const int32 InitialVehicles = TrafficSubsystem->GetNearFieldVehicleCount() + TrafficSubsystem->GetFarFieldVehicleCount();
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: bölge %d / %d, %d araç, %d adım"), Region, NumRegions, InitialVehicles, NumSteps);
+
+	int32 Result = 0;
+	int32 MaxGhosts = 0;
+	double ExchangeSeconds = 0.0;
+	int32 NumExchanges = 0;
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		HarnessWorld.Step(Scenario.DeltaTime);
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (!Node.Exchange(TrafficSubsystem, Step))
+		{
+			Result = 1;
+			break;
+		}
+		ExchangeSeconds += FPlatformTime::Seconds() - StartTime;
+		++NumExchanges;
+		MaxGhosts = FMath::Max(MaxGhosts, Node.GetNumGhosts());
+	}
+
+	// Son durum: bu bölgenin araç kimlikleri (koordinatör çakışma arar)
+	FTrafficRecordingFrame Frame;
+	TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficRecordingSubsystem>()->CaptureFrame(Frame);
+	Frame.Vehicles.Sort([](const FTrafficRecordedVehicle& A, const FTrafficRecordedVehicle& B)
+	{
+		return A.TrafficId < B.TrafficId;
+	});
+
+	HarnessWorld.Destroy();
+	Node.Shutdown();
+
+	const FString Summary = FString::Printf(TEXT("Region=%d Regions=%d Steps=%d InitialVehicles=%d Vehicles=%d Sent=%d Received=%d MaxGhosts=%d Rebalances=%d Epoch=%u BytesSent=%lld ExchangeMs=%.3f"),
+		Region, NumRegions, NumExchanges, InitialVehicles, Frame.Vehicles.Num(), Node.GetNumSent(), Node.GetNumReceived(), MaxGhosts,
+		Node.GetNumRebalances(), Node.GetPartition().Epoch, Node.GetBytesSent(), NumExchanges > 0 ? ExchangeSeconds * 1000.0 / NumExchanges : 0.0);
+	LogSummary(TEXT("Region"), Summary);
+
+	if (!ReportPath.IsEmpty())
+	{
+		// Rapor: özet satırı ve kimlikler
+		FString Report = Summary + LINE_TERMINATOR;
+		for (const FTrafficRecordedVehicle& Vehicle : Frame.Vehicles)
+		{
+			Report += FString::Printf(TEXT("%u "), Vehicle.TrafficId);
+		}
+		Report += LINE_TERMINATOR;
+
+		if (!FFileHelper::SaveStringToFile(Report, *ReportPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge raporu yazılamadı: %s"), *ReportPath);
+			Result = FMath::Max(Result, 2);
+		}
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunRegionCluster(const FString& Params)
+{
+	const TCHAR* Usage = TEXT("-run=TrafficHarness -Scenario=Path.json -RegionCluster=N [-Steps=N] [-RegionPort=7400]");
+
+	int32 NumRegions = 0;
+	FParse::Value(*Params, TEXT("RegionCluster="), NumRegions);
+	if (NumRegions < 2)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: %s"), Usage);
+		return 2;
+	}
+
+	FString ScenarioPath;
+	FTrafficScenario Scenario;
+	if (!LoadScenario(Params, Usage, Scenario, &ScenarioPath))
+	{
+		return 2;
+	}
+
+	// Alt süreçler aynı ayarları alır; bölge ve rapor yolu süreç başına eklenir
+	FString ChildParams = FString::Printf(TEXT("-run=TrafficHarness -Scenario=\"%s\" -Regions=%d"), *ScenarioPath, NumRegions);
+	for (const TCHAR* Key : { TEXT("Steps="), TEXT("RegionPort="), TEXT("RegionTimeout="), TEXT("GhostWidth="), TEXT("HandoffMargin="), TEXT("RebalanceInterval="), TEXT("RebalanceThreshold=") })
+	{
+		FString Value;
+		if (FParse::Value(*Params, Key, Value))
+		{
+			ChildParams += FString::Printf(TEXT(" -%s%s"), Key, *Value);
+		}
+	}
+	if (FParse::Param(*Params, TEXT("SerialStep")))
+	{
+		ChildParams += TEXT(" -SerialStep");
+	}
+
+	const FString ReportDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TrafficRegions"));
+	IFileManager::Get().MakeDirectory(*ReportDirectory, true);
+
+	const FString Executable = FPlatformProcess::ExecutablePath();
+	const FString ProjectArgument = FPaths::IsProjectFilePathSet() ? FString::Printf(TEXT("\"%s\" "), *FPaths::GetProjectFilePath()) : FString();
+
+	TArray<FProcHandle> Processes;
+	TArray<FString> ReportPaths;
+	for (int32 Region = 0; Region < NumRegions; ++Region)
+	{
+		const FString& ReportPath = ReportPaths.Add_GetRef(FPaths::Combine(ReportDirectory, FString::Printf(TEXT("Region%d.txt"), Region)));
+		IFileManager::Get().Delete(*ReportPath, false, false, true);
+
+		const FString Arguments = FString::Printf(TEXT("%s%s -Region=%d -RegionReport=\"%s\" -unattended -nullrhi -nosplash"),
+			*ProjectArgument, *ChildParams, Region, *ReportPath);
+
+		FProcHandle Process = FPlatformProcess::CreateProc(*Executable, *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Process.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d süreci başlatılamadı: %s"), Region, *Executable);
+			for (FProcHandle& Started : Processes)
+			{
+				FPlatformProcess::TerminateProc(Started);
+				FPlatformProcess::CloseProc(Started);
+			}
+			return 2;
+		}
+		Processes.Add(Process);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: %d bölge süreci başlatıldı (%s)"), NumRegions, *ScenarioPath);
+
+	int32 NumFailed = 0;
+	for (int32 Region = 0; Region < NumRegions; ++Region)
+	{
+		FPlatformProcess::WaitForProc(Processes[Region]);
+
+		int32 ReturnCode = -1;
+		FPlatformProcess::GetProcReturnCode(Processes[Region], &ReturnCode);
+		FPlatformProcess::CloseProc(Processes[Region]);
+
+		if (ReturnCode != 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d süreci %d ile bitti"), Region, ReturnCode);
+			++NumFailed;
+		}
+	}
+
+	// Raporları birleştir: her araç tek bölgede, devirler korunur, bölme herkeste aynı
+	int64 TotalSent = 0;
+	int64 TotalReceived = 0;
+	int32 NumVehicles = 0;
+	int32 NumDuplicates = 0;
+	int32 NumMissingReports = 0;
+	TSet<uint32> Ids;
+	TSet<uint32> Epochs;
+
+	for (int32 Region = 0; Region < NumRegions; ++Region)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *ReportPaths[Region]) || Lines.Num() < 1)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d raporu okunamadı: %s"), Region, *ReportPaths[Region]);
+			++NumMissingReports;
+			continue;
+		}
+
+		int32 Sent = 0;
+		int32 Received = 0;
+		uint32 Epoch = 0;
+		FParse::Value(*Lines[0], TEXT("Sent="), Sent);
+		FParse::Value(*Lines[0], TEXT("Received="), Received);
+		FParse::Value(*Lines[0], TEXT("Epoch="), Epoch);
+		TotalSent += Sent;
+		TotalReceived += Received;
+		Epochs.Add(Epoch);
+
+		TArray<FString> Tokens;
+		if (Lines.Num() > 1)
+		{
+			Lines[1].ParseIntoArray(Tokens, TEXT(" "));
+		}
+
+		for (const FString& Token : Tokens)
+		{
+			bool bAlreadyInSet = false;
+			Ids.Add((uint32)FCString::Atoi64(*Token), &bAlreadyInSet);
+			if (bAlreadyInSet)
+			{
+				++NumDuplicates;
+			}
+			++NumVehicles;
+		}
+	}
+
+	LogSummary(TEXT("RegionCluster"), FString::Printf(TEXT("Regions=%d ScenarioVehicles=%d Vehicles=%d Duplicates=%d Sent=%lld Received=%lld Epochs=%d FailedRegions=%d"),
+		NumRegions, Scenario.Vehicles.Num(), NumVehicles, NumDuplicates, TotalSent, TotalReceived, Epochs.Num(), NumFailed + NumMissingReports));
+
+	if (NumFailed > 0 || NumMissingReports > 0)
+	{
+		return 1;
+	}
+
+	int32 Result = 0;
+	if (NumDuplicates > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%d araç birden fazla bölgede"), NumDuplicates);
+		Result = 1;
+	}
+	if (TotalSent != TotalReceived)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Devirler tutmuyor: gönderilen %lld, alınan %lld"), TotalSent, TotalReceived);
+		Result = 1;
+	}
+	if (NumVehicles > Scenario.Vehicles.Num())
+	{
+		// Araçlar şehirden çıkabilir ama yenisi oluşmaz
+		UE_LOG(LogTemp, Error, TEXT("Araç sayısı arttı: senaryo %d, bölgeler %d"), Scenario.Vehicles.Num(), NumVehicles);
+		Result = 1;
+	}
+	if (Epochs.Num() > 1)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Bölgeler farklı bölmelerde bitti"));
+		Result = 1;
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunCheckpoint(const FString& Params)
+{
+	FTrafficScenario Scenario;
+	if (!LoadScenario(Params, TEXT("-run=TrafficHarness -Scenario=Path.json -Checkpoint [-CheckpointAt=N] [-VerifySteps=60] [-RestoreBudgetMs=N] [-WriteCheckpoint=Path]"), Scenario))
+	{
+		return 2;
+	}
+
+	int32 CheckpointStep = Scenario.NumSteps;
+	int32 VerifySteps = 60;
+	float RestoreBudgetMs = 0.0f;
+	FString WriteCheckpointPath;
+	FParse::Value(*Params, TEXT("CheckpointAt="), CheckpointStep);
+	FParse::Value(*Params, TEXT("VerifySteps="), VerifySteps);
+	FParse::Value(*Params, TEXT("RestoreBudgetMs="), RestoreBudgetMs);
+	FParse::Value(*Params, TEXT("WriteCheckpoint="), WriteCheckpointPath);
+
+	FTrafficGoldenTolerance Tolerance;
+	FParse::Value(*Params, TEXT("PositionTolerance="), Tolerance.Position);
+	FParse::Value(*Params, TEXT("YawTolerance="), Tolerance.Yaw);
+	FParse::Value(*Params, TEXT("SpeedTolerance="), Tolerance.Speed);
+
+	// Kaynak dünya: senaryoyu CheckpointStep adım çalıştır ve kaydet (devam karşılaştırması için açık kalır)
+	FHarnessScenarioWorld SourceWorld;
+	if (!SourceWorld.Create(Scenario))
+	{
+		return 2;
+	}
+
+	SourceWorld.Spawn(Scenario, Params);
+	UTrafficSubsystem* SourceSubsystem = SourceWorld.GetSubsystem();
+
+	for (int32 Step = 0; Step < CheckpointStep; ++Step)
+	{
+		SourceWorld.Step(Scenario.DeltaTime);
+	}
+
+	TArray<uint8> Checkpoint;
+	const double SaveStartTime = FPlatformTime::Seconds();
+	const bool bSaved = SourceWorld.GetRecordingSubsystem()->SaveCheckpoint(Checkpoint);
+	const double SaveSeconds = FPlatformTime::Seconds() - SaveStartTime;
+
+	const int32 NumNearField = SourceSubsystem->GetNearFieldVehicleCount();
+	const int32 NumFarField = SourceSubsystem->GetFarFieldVehicleCount();
+
+	if (!bSaved)
+	{
+		return 2;
+	}
+
+	if (!WriteCheckpointPath.IsEmpty() && !FFileHelper::SaveArrayToFile(Checkpoint, *WriteCheckpointPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kontrol noktası yazılamadı: %s"), *WriteCheckpointPath);
+		return 2;
+	}
+
+	// Hedef dünya: şerit ID'leri araç kaydıyla oluştuğu için aynı senaryo kurulur, durum kontrol noktasından gelir
+	FHarnessScenarioWorld TargetWorld;
+	if (!TargetWorld.Create(Scenario))
+	{
+		return 2;
+	}
+
+	TargetWorld.Spawn(Scenario, Params);
+	UTrafficSubsystem* TargetSubsystem = TargetWorld.GetSubsystem();
+
+	const double RestoreStartTime = FPlatformTime::Seconds();
+	const bool bRestored = TargetWorld.GetRecordingSubsystem()->RestoreCheckpoint(Checkpoint);
+	const double RestoreSeconds = FPlatformTime::Seconds() - RestoreStartTime;
+
+	// Tam gidiş-dönüş: geri yüklenen durumun kaydı kaynağınkiyle byte byte aynı olmalı
+	TArray<uint8> RoundTrip;
+	const bool bRoundTripSaved = bRestored && TargetWorld.GetRecordingSubsystem()->SaveCheckpoint(RoundTrip);
+
+	if (!bRoundTripSaved)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: kontrol noktası geri yüklenemedi"));
+		return 2;
+	}
+
+	int32 FirstMismatch = INDEX_NONE;
+	for (int32 Index = 0; Index < FMath::Min(Checkpoint.Num(), RoundTrip.Num()); ++Index)
+	{
+		if (Checkpoint[Index] != RoundTrip[Index])
+		{
+			FirstMismatch = Index;
+			break;
+		}
+	}
+	if (FirstMismatch == INDEX_NONE && Checkpoint.Num() != RoundTrip.Num())
+	{
+		FirstMismatch = FMath::Min(Checkpoint.Num(), RoundTrip.Num());
+	}
+
+	// Devam: serileştirici eşgüçlü olsa bile geri yüklenen dünya kaynağın gideceği yere gitmeli
+	FTrafficRecordingFrame SourceFrame;
+	FTrafficRecordingFrame TargetFrame;
+	int32 DivergedStep = INDEX_NONE;
+	for (int32 Step = 0; Step < VerifySteps; ++Step)
+	{
+		SourceWorld.Step(Scenario.DeltaTime);
+		TargetWorld.Step(Scenario.DeltaTime);
+
+		CaptureSortedFrame(SourceSubsystem, SourceFrame);
+		CaptureSortedFrame(TargetSubsystem, TargetFrame);
+		if (!CompareFrames(SourceFrame, TargetFrame, Tolerance, CheckpointStep + Step))
+		{
+			DivergedStep = CheckpointStep + Step;
+			break;
+		}
+	}
+
+	SourceWorld.Destroy();
+	TargetWorld.Destroy();
+
+	const double RestoreMs = RestoreSeconds * 1000.0;
+	LogSummary(TEXT("Checkpoint"), FString::Printf(TEXT("Steps=%d Vehicles=%d NearField=%d FarField=%d Bytes=%d SaveMs=%.3f RestoreMs=%.3f RoundTrip=%s VerifySteps=%d Continuation=%s DivergedStep=%d"),
+		CheckpointStep, NumNearField + NumFarField, NumNearField, NumFarField, Checkpoint.Num(), SaveSeconds * 1000.0, RestoreMs,
+		FirstMismatch == INDEX_NONE ? TEXT("OK") : TEXT("FAIL"), VerifySteps, DivergedStep == INDEX_NONE ? TEXT("OK") : TEXT("FAIL"), DivergedStep));
+
+	int32 Result = 0;
+	if (FirstMismatch != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: kontrol noktası gidiş-dönüşte farklı (ilk fark byte %d, %d / %d byte)"), FirstMismatch, RoundTrip.Num(), Checkpoint.Num());
+		Result = 1;
+	}
+	if (DivergedStep != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: geri yüklenen dünya adım %d'de kaynaktan ayrıldı"), DivergedStep);
+		Result = 1;
+	}
+	if (RestoreBudgetMs > 0.0f && RestoreMs > RestoreBudgetMs)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TrafficHarness: geri yükleme bütçeyi aştı: %.3f ms > %.2f ms (%d araç)"), RestoreMs, RestoreBudgetMs, NumNearField + NumFarField);
+		Result = 1;
+	}
+
+	return Result;
+}
+
+int32 UTrafficHarnessCommandlet::RunSweep(const FString& Params)
+{
+	FString SweepPath;
+	FParse::Value(*Params, TEXT("Sweep="), SweepPath);
+
+	FTrafficSweep Sweep;
+	if (!Sweep.LoadFromFile(SweepPath))
+	{
+		return 2;
+	}
+
+	const int32 NumJobs = Sweep.GetNumJobs();
+	int32 MaxParallel = FPlatformMisc::NumberOfCores();
+	FParse::Value(*Params, TEXT("Jobs="), MaxParallel);
+	MaxParallel = FMath::Clamp(MaxParallel, 1, NumJobs);
+
+	const FString SweepName = FPaths::GetBaseFilename(SweepPath);
+	const FString ReportDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TrafficSweeps"), SweepName);
+	IFileManager::Get().MakeDirectory(*ReportDirectory, true);
+
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TrafficSweeps"), SweepName + TEXT(".csv"));
+	FParse::Value(*Params, TEXT("SweepOutput="), OutputPath);
+
+	// İşler tek iş parçacıklı ve seri adımla çalışır: paralellik süreç sayısından gelir, worker'lar çekirdekleri paylaşmaz
+	const FString FullSweepPath = FPaths::ConvertRelativePathToFull(SweepPath);
+	const FString Executable = FPlatformProcess::ExecutablePath();
+	const FString ProjectArgument = FPaths::IsProjectFilePathSet() ? FString::Printf(TEXT("\"%s\" "), *FPaths::GetProjectFilePath()) : FString();
+
+	TArray<FString> ReportPaths;
+	TArray<int32> ReturnCodes;
+	ReturnCodes.Init(-1, NumJobs);
+
+	struct FRunningJob
+	{
+		int32 JobIndex = INDEX_NONE;
+		FProcHandle Process;
+	};
+	TArray<FRunningJob> Running;
+
+	UE_LOG(LogTemp, Display, TEXT("TrafficHarness: tarama %s, %d iş, en fazla %d paralel"), *SweepName, NumJobs, MaxParallel);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NextJob = 0;
+	while (NextJob < NumJobs || Running.Num() > 0)
+	{
+		while (NextJob < NumJobs && Running.Num() < MaxParallel)
+		{
+			const int32 JobIndex = NextJob++;
+			const FString& ReportPath = ReportPaths.Add_GetRef(FPaths::Combine(ReportDirectory, FString::Printf(TEXT("Job%d.txt"), JobIndex)));
+			IFileManager::Get().Delete(*ReportPath, false, false, true);
+
+			const FString Arguments = FString::Printf(TEXT("%s-run=TrafficHarness -Sweep=\"%s\" -SweepJob=%d -SweepReport=\"%s\" -SerialStep -unattended -nullrhi -nosplash"),
+				*ProjectArgument, *FullSweepPath, JobIndex, *ReportPath);
+
+			FProcHandle Process = FPlatformProcess::CreateProc(*Executable, *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+			if (!Process.IsValid())
+			{
+				UE_LOG(LogTemp, Error, TEXT("Tarama işi %d başlatılamadı: %s"), JobIndex, *Executable);
+				continue;
+			}
+			Running.Add({ JobIndex, Process });
+		}
+
+		for (int32 Index = Running.Num() - 1; Index >= 0; --Index)
+		{
+			FRunningJob& Job = Running[Index];
+			if (FPlatformProcess::IsProcRunning(Job.Process))
+			{
+				continue;
+			}
+
+			FPlatformProcess::GetProcReturnCode(Job.Process, &ReturnCodes[Job.JobIndex]);
+			FPlatformProcess::CloseProc(Job.Process);
+			Running.RemoveAtSwap(Index);
+		}
+
+		if (Running.Num() >= MaxParallel || (NextJob >= NumJobs && Running.Num() > 0))
+		{
+			FPlatformProcess::Sleep(0.05f);
+		}
+	}
+
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// CSV: konfigürasyon başına bir satır (iş sırasıyla)
+	FString Csv = TEXT("Job,Seed");
+	for (const FTrafficSweepParameter& Parameter : Sweep.Parameters)
+	{
+		Csv += TEXT(",") + Parameter.Name;
+	}
+	Csv += TEXT(",Vehicles,Throughput,MeanDelay,Stops,StopsPerVehicle,MeanSpeed,StepMs,Status");
+	Csv += LINE_TERMINATOR;
+
+	int32 NumFailed = 0;
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		TArray<FString> Values;
+		int32 Seed = 0;
+		Sweep.GetJob(JobIndex, Values, Seed, 0);
+
+		TArray<FString> Lines;
+		const bool bHasReport = FFileHelper::LoadFileToStringArray(Lines, *ReportPaths[JobIndex]) && Lines.Num() > 0;
+		if (!bHasReport || ReturnCodes[JobIndex] != 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Tarama işi %d başarısız (dönüş kodu %d)"), JobIndex, ReturnCodes[JobIndex]);
+			++NumFailed;
+		}
+
+		int32 Vehicles = 0;
+		int32 Stops = 0;
+		double Throughput = 0.0;
+		double MeanDelay = 0.0;
+		double MeanSpeed = 0.0;
+		double StepMs = 0.0;
+		if (bHasReport)
+		{
+			FParse::Value(*Lines[0], TEXT("Seed="), Seed);
+			FParse::Value(*Lines[0], TEXT("Vehicles="), Vehicles);
+			FParse::Value(*Lines[0], TEXT("Throughput="), Throughput);
+			FParse::Value(*Lines[0], TEXT("MeanDelay="), MeanDelay);
+			FParse::Value(*Lines[0], TEXT("Stops="), Stops);
+			FParse::Value(*Lines[0], TEXT("MeanSpeed="), MeanSpeed);
+			FParse::Value(*Lines[0], TEXT("StepMs="), StepMs);
+		}
+
+		Csv += FString::Printf(TEXT("%d,%d"), JobIndex, Seed);
+		for (const FString& Value : Values)
+		{
+			Csv += TEXT(",") + Value;
+		}
+		Csv += FString::Printf(TEXT(",%d,%.2f,%.3f,%d,%.3f,%.1f,%.4f,%d"), Vehicles, Throughput, MeanDelay, Stops,
+			Vehicles > 0 ? (double)Stops / Vehicles : 0.0, MeanSpeed, StepMs, ReturnCodes[JobIndex]);
+		Csv += LINE_TERMINATOR;
+	}
+
+	const bool bWritten = FFileHelper::SaveStringToFile(Csv, *OutputPath);
+	if (!bWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Tarama sonucu yazılamadı: %s"), *OutputPath);
+	}
+
+	LogSummary(TEXT("Sweep"), FString::Printf(TEXT("Jobs=%d Failed=%d Parallel=%d WallSeconds=%.1f Output=%s"),
+		NumJobs, NumFailed, MaxParallel, WallSeconds, *OutputPath));
+
+	if (!bWritten)
+	{
+		return 2;
+	}
+	return NumFailed > 0 ? 1 : 0;
+}
+
+int32 UTrafficHarnessCommandlet::RunSweepJob(const FString& Params)
+{
+	FString SweepPath;
+	int32 JobIndex = INDEX_NONE;
+	FParse::Value(*Params, TEXT("Sweep="), SweepPath);
+	FParse::Value(*Params, TEXT("SweepJob="), JobIndex);
+
+	FTrafficSweep Sweep;
+	if (!Sweep.LoadFromFile(SweepPath) || JobIndex < 0 || JobIndex >= Sweep.GetNumJobs())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Kullanım: -run=TrafficHarness -Sweep=Path.json -SweepJob=I [-SweepReport=Path]"));
+		return 2;
+	}
+
+	FTrafficScenario Scenario;
+	if (!Scenario.LoadFromFile(Sweep.ScenarioPath))
+	{
+		return 2;
+	}
+
+	TArray<FString> Values;
+	Sweep.GetJob(JobIndex, Values, Scenario.Seed, Scenario.Seed);
+	// Subsystem ayarları dünya (ve subsystem Initialize) oluşmadan önce
+	if (!Sweep.ApplyToScenario(Values, Scenario) || !Sweep.ApplyToSubsystemDefaults(Values))
+	{
+		return 2;
+	}
+
+	const int32 NumSteps = Sweep.NumSteps > 0 ? Sweep.NumSteps : Scenario.NumSteps;
+	FString ReportPath;
+	FParse::Value(*Params, TEXT("SweepReport="), ReportPath);
+
+	FHarnessScenarioWorld HarnessWorld;
+	if (!HarnessWorld.Create(Scenario))
+	{
+		return 2;
+	}
+
+	// Archetype ayarları araçlar oluşmadan önce
+	UTrafficSubsystem* TrafficSubsystem = HarnessWorld.GetSubsystem();
+	if (!Sweep.ApplyToArchetypes(Values))
+	{
+		return 2;
+	}
+
+	const int32 NumVehicles = HarnessWorld.Spawn(Scenario, Params);
+	UWorld* World = HarnessWorld.GetWorld();
+
+	for (int32 Step = 0; Step < Sweep.WarmupSteps; ++Step)
+	{
+		HarnessWorld.Step(Scenario.DeltaTime);
+	}
+
+	// Işık metrikleri ısınmadan sonra başlar (boş şehirden dolmaya geçiş ölçülmez)
+	for (TActorIterator<ATrafficLight> It(World); It; ++It)
+	{
+		It->ResetMetrics();
+	}
+
+	// Duruş: hız StopSpeed altına düşünce, araç MoveSpeed'i geçene kadar yeni duruş sayılmaz
+	constexpr float StopSpeed = 10.0f;
+	constexpr float MoveSpeed = 100.0f;
+	TMap<uint32, bool> Stopped;
+	int32 NumStops = 0;
+	double SpeedSum = 0.0;
+	int64 SpeedSamples = 0;
+	double StepSeconds = 0.0;
+
+	// Isınma sonunda zaten duran araçlar ölçümün ilk adımında yeni duruş sayılmasın
+	FTrafficRecordingFrame Frame;
+	TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficRecordingSubsystem>()->CaptureFrame(Frame);
+	for (const FTrafficRecordedVehicle& Vehicle : Frame.Vehicles)
+	{
+		Stopped.Add(Vehicle.TrafficId, Vehicle.CurrentSpeed < StopSpeed);
+	}
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		HarnessWorld.Step(Scenario.DeltaTime);
+		StepSeconds += FPlatformTime::Seconds() - StartTime;
+
+		// CaptureFrame ekler; kapasite adımlar arasında korunur
+		Frame.Vehicles.Reset();
+		TrafficSubsystem->GetWorld()->GetSubsystem<UTrafficRecordingSubsystem>()->CaptureFrame(Frame);
+		for (const FTrafficRecordedVehicle& Vehicle : Frame.Vehicles)
+		{
+			bool& bStopped = Stopped.FindOrAdd(Vehicle.TrafficId, false);
+			if (!bStopped && Vehicle.CurrentSpeed < StopSpeed)
+			{
+				bStopped = true;
+				++NumStops;
+			}
+			else if (bStopped && Vehicle.CurrentSpeed > MoveSpeed)
+			{
+				bStopped = false;
+			}
+
+			SpeedSum += Vehicle.CurrentSpeed;
+			++SpeedSamples;
+		}
+	}
+
+	int64 Departures = 0;
+	double TotalDelay = 0.0;
+	double MetricsSeconds = 0.0;
+	for (TActorIterator<ATrafficLight> It(World); It; ++It)
+	{
+		Departures += It->GetTotalDepartures();
+		TotalDelay += It->GetTotalDelay();
+		MetricsSeconds = FMath::Max(MetricsSeconds, (double)It->GetMetricsElapsedTime());
+	}
+
+	HarnessWorld.Destroy();
+
+	const FString Summary = FString::Printf(TEXT("Job=%d Seed=%d Steps=%d Vehicles=%d Departures=%lld Throughput=%.2f MeanDelay=%.3f Stops=%d MeanSpeed=%.1f StepMs=%.4f"),
+		JobIndex, Scenario.Seed, NumSteps, NumVehicles, Departures,
+		MetricsSeconds > 0.0 ? Departures / MetricsSeconds * 3600.0 : 0.0,
+		Departures > 0 ? TotalDelay / Departures : 0.0,
+		NumStops,
+		SpeedSamples > 0 ? SpeedSum / SpeedSamples : 0.0,
+		NumSteps > 0 ? StepSeconds * 1000.0 / NumSteps : 0.0);
+	LogSummary(TEXT("SweepJob"), Summary);
+
+	if (!ReportPath.IsEmpty() && !FFileHelper::SaveStringToFile(Summary + LINE_TERMINATOR, *ReportPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Tarama raporu yazılamadı: %s"), *ReportPath);
+		return 2;
+	}
+
+	return 0;
+}
+
+void UTrafficHarnessCommandlet::ReportTiming(TArray<double>& StepTimes, int32 NumVehicles, const TCHAR* UpdatePath)
+{
+	FStepTimeStats Stats;
+	if (!ComputeStepTimeStats(StepTimes, Stats))
+	{
+		return;
+	}
+
+	const double UsPerVehicle = NumVehicles > 0 ? Stats.MeanMs * 1000.0 / NumVehicles : 0.0;
+	LogSummary(TEXT("Timing"), FString::Printf(TEXT("Steps=%d Vehicles=%d MeanMs=%.4f MedianMs=%.4f P95Ms=%.4f MinMs=%.4f UsPerVehicle=%.4f Update=%s"),
+		Stats.NumSteps, NumVehicles, Stats.MeanMs, Stats.MedianMs, Stats.P95Ms, Stats.MinMs, UsPerVehicle, UpdatePath));
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TrafficRecording.h"
+#include "TrafficHarnessCommandlet.generated.h"
+
+class UWorld;
+struct FTrafficScenario;
+
+/**
+ * Golden karşılaştırma toleransları.
+ */
+struct FTrafficGoldenTolerance
+{
+	/** Konum (cm). Kayıt 1 cm'ye kuantize edilir. */
+	float Position = 2.0f;
+
+	/** Yaw (derece). */
+	float Yaw = 0.5f;
+
+	/** CurrentSpeed / TargetSpeed (cm/s). */
+	float Speed = 2.0f;
+
+	/** Şerit offset'i (cm). */
+	float LaneOffset = 2.0f;
+};
+
+/**
+ * Headless trafik test düzeneği.
+ * Bir senaryoyu (yollar, ışıklar, araç listesi, tohum) oyuncu ve render olmadan
+ * sabit adım süresiyle N adım çalıştırır.
+ *
+ * Kullanım:
+ *   -run=TrafficHarness -Scenario=Path.json [-Steps=N]
+ *     -WriteGolden=Path.trec       Sonucu golden iz dosyası olarak kaydeder
+ *     -Golden=Path.trec            Sonucu golden ile karşılaştırır, ilk sapmayı (adım, araç, alan) raporlar
+ *     -Timing [-WarmupSteps=N]     Adım süresi istatistikleri (ortalama, medyan, p95, araç başına)
+ *     -GenericUpdate               Controller'ları varyant grupları yerine genel yolla günceller (-Timing ile karşılaştırma)
+ *     -SerialStep                  Trafik adımını worker boru hattı yerine subsystem Tick'inde seri çalıştırır
+ *     -Replication=N               N sanal istemci ile tek süreçte replikasyon (istemci başına byte/s, tahmin hatası)
+ *     -CheckAllocations            Isınmadan (WarmupSteps) sonra trafik adımında heap tahsisi olursa başarısız
+ *     -PositionTolerance=, -YawTolerance=, -SpeedTolerance=
+ *
+ *   -run=TrafficHarness -PedestrianBenchmark=N [-Steps=N] [-WarmupSteps=N] [-BudgetMs=2]
+ *     Senaryo ve dünya olmadan N yayalık kalabalığı sentetik kaldırımlarda çalıştırır; adım süresini
+ *     (kalabalık + paylaşılan spatial hash) 1 görevden worker sayısına kadar ölçer. Tek görevde
+ *     ortalama BudgetMs'i aşarsa başarısız.
+ *
+ *   -run=TrafficHarness -EventStress=N [-Producers=8] [-Capacity=1024]
+ *     Producers thread'i toplam N olayı trafik olay kuyruğuna gönderirken ana thread sürekli boşaltır.
+ *     Üretici başına sıra korunmuyorsa veya alınan + düşürülen olaylar gönderilene eşit değilse başarısız.
+ *
+ *   -run=TrafficHarness -OvertakeBenchmark=N [-Steps=N] [-WarmupSteps=N] [-VehiclesPerLane=40] [-BudgetMs=1]
+ *     Dünya olmadan N sollama isteğini sentetik 3 şeritli yolda planlar (seri ve ParallelFor ile).
+ *     Şeritler engel tamponundan kalabalıktır; tampon isteyene en yakın araçları tutmuyorsa
+ *     veya seri planlama ortalama BudgetMs'i aşarsa başarısız.
+ *
+ *   -run=TrafficHarness -ManeuverBenchmark=N [-Steps=N] [-WarmupSteps=N] [-BudgetMs=1]
+ *     N pawn'sız controller için birer şerit değiştirme manevrasını FTrafficManeuverScheduler'da
+ *     sürekli askıda tutar (boşluk yoklaması, sinyal, zaman aşımı, yeniden başlatma). Update
+ *     ortalaması BudgetMs'i aşarsa, manevralar askıda kalmazsa veya Reset sonrası çerçeve havuzu
+ *     boşalmazsa başarısız.
+ *
+ *   -run=TrafficHarness -OccupancyTest
+ *     Dünya olmadan FTrafficOccupant::Overlaps (ayırma ekseni) ve FTrafficOccupancyGrid
+ *     (katman zamanı, ForEachOverlap, yan kutu, geçersiz öğe) için sabit durumları çalıştırır.
+ *     Herhangi bir durum tutmazsa başarısız.
+ *
+ *   -run=TrafficHarness -BrakingEnvelopeTest
+ *     Yarım çember yolda 2000 cm/s giden tek aracın fren hacmini kurar. Eksen şeridi izlemiyorsa,
+ *     yol üzerindeki nokta içeride veya teğet doğrultudaki nokta dışarıda değilse başarısız.
+ *
+ *   -run=TrafficHarness -Scenario=Path.json -RegionCluster=N [-Steps=N] [-RegionPort=7400]
+ *       [-GhostWidth=5000] [-HandoffMargin=200] [-RebalanceInterval=60] [-RebalanceThreshold=1.5]
+ *     Şehri X ekseninde N bölgeye böler ve her bölge için ayrı süreç başlatır (-Region=I -Regions=N);
+ *     süreçler loopback TCP ile sınırı geçen araçları devreder ve sınır hayaletlerini paylaşır.
+ *     Bir araç birden fazla bölgede kalırsa, gönderilen ve alınan devirler tutmazsa veya
+ *     süreçler farklı bölmede biterse başarısız.
+ *
+ *   -run=TrafficHarness -Scenario=Path.json -Checkpoint [-CheckpointAt=N] [-VerifySteps=60] [-RestoreBudgetMs=N]
+ *       [-WriteCheckpoint=Path.tckp]
+ *     Senaryoyu N adım çalıştırıp kontrol noktası alır, aynı senaryoyla kurulan yeni dünyaya geri yükler
+ *     ve yeniden kaydeder; sonra iki dünyayı VerifySteps adım daha birlikte ilerletip kareleri
+ *     (golden toleranslarıyla) karşılaştırır. Kayıt ve geri yükleme süresini raporlar; iki kayıt byte
+ *     byte aynı değilse, dünyalar ayrılırsa veya geri yükleme RestoreBudgetMs'i aşarsa başarısız.
+ *     Büyük ölçek için senaryonun Generate bölümü kullanılır (ör. Count 50000, FarField true).
+ *
+ *   -run=TrafficHarness -Sweep=Path.json [-Jobs=N] [-SweepOutput=Path.csv]
+ *     Tarama tanımındaki her konfigürasyon ve tohum için ayrı süreç başlatır (aynı anda en fazla
+ *     Jobs, varsayılan çekirdek sayısı). Her iş ısınmadan sonra ışık verimini (araç/saat), ortalama
+ *     gecikmeyi, duruş sayısını ve adım başına CPU süresini ölçer; sonuçlar tek CSV'de toplanır.
+ *     Herhangi bir iş başarısız olursa başarısız.
+ *
+ * Golden ve zamanlama aynı çalıştırmada birlikte kullanılabilir; böylece CheckForwardPath,
+ * UpdateSteering veya hareket kodundaki bir optimizasyon tek komutla hem doğruluk hem hız
+ * açısından ölçülür. Dönüş kodu: 0 = başarılı, 1 = sapma veya tahsis, 2 = kurulum hatası.
+ */
+UCLASS()
+class YOURGAMENAME_API UTrafficHarnessCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficHarnessCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/**
+	 * Senaryo için oyun dünyası oluşturur ve BeginPlay'i başlatır (oyun modu veya oyuncu olmadan).
+	 */
+	static UWorld* CreateHarnessWorld(const FTrafficScenario& Scenario);
+
+	/** CreateHarnessWorld ile oluşturulan dünyayı yok eder. */
+	static void DestroyHarnessWorld(UWorld* World);
+
+	/** Dünyayı bir adım ilerletir (aktörler, controller'lar ve tickable subsystem'ler). */
+	static void StepHarnessWorld(UWorld* World, float DeltaTime);
+
+private:
+	/**
+	 * Çalıştırılan kareleri golden ile karşılaştırır.
+	 *
+	 * @return İlk sapma yoksa true
+	 */
+	static bool CompareWithGolden(const TArray<FTrafficRecordingFrame>& Frames, const FTrafficRecordingReader& Golden, const FTrafficGoldenTolerance& Tolerance);
+
+	// Modlar: Main anahtar tablosundan seçer, her mod kendi parametrelerini Params'tan okur
+
+	/** Senaryo çalıştırma: golden, zamanlama, replikasyon, tahsis kontrolü (varsayılan mod). */
+	static int32 RunScenario(const FString& Params);
+
+	/** Yaya kalabalığı ölçümü (-PedestrianBenchmark). */
+	static int32 RunPedestrianBenchmark(const FString& Params);
+
+	/** Olay kuyruğu çok üretici stres testi (-EventStress). */
+	static int32 RunEventStress(const FString& Params);
+
+	/** Sollama planlayıcısı ölçümü (-OvertakeBenchmark). */
+	static int32 RunOvertakeBenchmark(const FString& Params);
+
+	/** Askıdaki manevra zamanlayıcısı ölçümü (-ManeuverBenchmark). */
+	static int32 RunManeuverBenchmark(const FString& Params);
+
+	/** Doluluk ızgarası ve ayırma ekseni testi durumları (-OccupancyTest). */
+	static int32 RunOccupancyTest(const FString& Params);
+
+	/** Virajlı şeritte fren hacmi testi (-BrakingEnvelopeTest). */
+	static int32 RunBrakingEnvelopeTest(const FString& Params);
+
+	/** Tek bölge süreci (-Region). */
+	static int32 RunRegion(const FString& Params);
+
+	/** Bölge süreçlerini başlatır ve raporlarını doğrular (-RegionCluster). */
+	static int32 RunRegionCluster(const FString& Params);
+
+	/** Kontrol noktası gidiş-dönüş testi (-Checkpoint). */
+	static int32 RunCheckpoint(const FString& Params);
+
+	/** Tarama işlerini paralel süreçlerde çalıştırır ve CSV'ye toplar (-Sweep). */
+	static int32 RunSweep(const FString& Params);
+
+	/** Tek tarama işi (-SweepJob). */
+	static int32 RunSweepJob(const FString& Params);
+
+	/** Adım sürelerinin istatistiklerini log'a yazar. */
+	static void ReportTiming(TArray<double>& StepTimes, int32 NumVehicles, const TCHAR* UpdatePath);
+};
@@ -2,6 +2,9 @@
 #include "TimerManager.h"
 #include "Engine/Engine.h"
 #include "Components/SceneComponent.h"
+#include "TrafficSubsystem.h"
+#include "TrafficSignalSubsystem.h"
+#include "Vehicle.h"
 
 // Sets default values
 ATrafficLight::ATrafficLight()
@@ -27,22 +30,66 @@ ATrafficLight::ATrafficLight()
 	GreenDuration = 10.0f;  // 10 saniye yeşil
 	YellowDuration = 3.0f;  // 3 saniye sarı
 	RedDuration = 8.0f;     // 8 saniye kırmızı
+	PhaseStartTime = 0.0f;
+	ApproachIndex = 0;
+	QueueCount = 0;
+	PendingArrivals = 0;
+	TotalDepartures = 0;
+	TotalDelay = 0.0;
+	LastQueueChangeTime = 0.0f;
+	MetricsStartTime = 0.0f;
 }
 
 // Called when the game starts or when spawned
 void ATrafficLight::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// İlk faz şimdi başlıyor (ortak saat: dünya zamanı)
+	PhaseStartTime = GetWorld()->GetTimeSeconds();
+	LastQueueChangeTime = PhaseStartTime;
+	MetricsStartTime = PhaseStartTime;
+
+	// Kuyruk sayaçları: TriggerBox overlap olayları
+	TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &ATrafficLight::OnTriggerBeginOverlap);
+	TriggerBox->OnComponentEndOverlap.AddDynamic(this, &ATrafficLight::OnTriggerEndOverlap);
 	
 	// Oyun başladığında ilk ışık değişimini zamanla
-	// İlk durum Green olduğu için, GreenDuration sonra Yellow'a geçecek
+	// Varsayılan ilk durum Green olduğu için, GreenDuration sonra Yellow'a geçecek
 	GetWorldTimerManager().SetTimer(
 		LightSwitchTimerHandle,
 		this,
 		&ATrafficLight::SwitchLight,
-		GreenDuration,
+		GetPhaseDuration(CurrentState),
 		false // Tekrar eden değil, bir kez çalışacak
 	);
+
+	// Şeritlere durma çizgisi olarak kaydol (uzak alan araçları ışığı trace olmadan görür)
+	if (UTrafficSubsystem* TrafficSubsystem = GetWorld()->GetSubsystem<UTrafficSubsystem>())
+	{
+		TrafficSubsystem->RegisterTrafficLight(this);
+	}
+
+	// Kavşağa bağlı ışıklar adaptif zamanlanır
+	if (UTrafficSignalSubsystem* SignalSubsystem = GetWorld()->GetSubsystem<UTrafficSignalSubsystem>())
+	{
+		SignalSubsystem->RegisterTrafficLight(this);
+	}
+}
+
+void ATrafficLight::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UTrafficSubsystem* TrafficSubsystem = GetWorld()->GetSubsystem<UTrafficSubsystem>())
+	{
+		TrafficSubsystem->UnregisterTrafficLight(this);
+	}
+
+	if (UTrafficSignalSubsystem* SignalSubsystem = GetWorld()->GetSubsystem<UTrafficSignalSubsystem>())
+	{
+		SignalSubsystem->UnregisterTrafficLight(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Tick fonksiyonu kullanılmıyor (timer sistemi kullanıldığı için gerekli değil)
@@ -99,6 +146,11 @@ void ATrafficLight::SwitchLight()
 		break;
 	}
 
+	// Yeni faz şimdi başladı
+	PhaseStartTime = GetWorld()->GetTimeSeconds();
+
+	OnLightStateChanged.Broadcast(this, CurrentState);
+
 	// Debug mesajı (isteğe bağlı - geliştirme sırasında kullanılabilir)
 	// UE_LOG(LogTemp, Warning, TEXT("Traffic Light switched to: %d"), (int32)CurrentState);
 }
@@ -108,6 +160,65 @@ ETrafficLightState ATrafficLight::GetCurrentState() const
 	return CurrentState;
 }
 
+ETrafficLightState ATrafficLight::GetStateAtTime(float WorldTime) const
+{
+	float TimeIntoPhase = WorldTime - PhaseStartTime;
+	ETrafficLightState State = CurrentState;
+
+	// Geçmiş veya mevcut faz içindeki zaman
+	if (TimeIntoPhase < GetPhaseDuration(State))
+	{
+		return State;
+	}
+
+	// Mevcut fazı atla, sonra tam döngüleri mod ile at
+	TimeIntoPhase -= GetPhaseDuration(State);
+	State = GetNextState(State);
+
+	const float CycleDuration = GreenDuration + YellowDuration + RedDuration;
+	if (CycleDuration > 0.0f)
+	{
+		TimeIntoPhase = FMath::Fmod(TimeIntoPhase, CycleDuration);
+	}
+
+	// En fazla üç faz ilerlenir
+	for (int32 Step = 0; Step < 3 && TimeIntoPhase >= GetPhaseDuration(State); ++Step)
+	{
+		TimeIntoPhase -= GetPhaseDuration(State);
+		State = GetNextState(State);
+	}
+
+	return State;
+}
+
+float ATrafficLight::GetPhaseDuration(ETrafficLightState State) const
+{
+	switch (State)
+	{
+	case ETrafficLightState::Green:
+		return GreenDuration;
+	case ETrafficLightState::Yellow:
+		return YellowDuration;
+	case ETrafficLightState::Red:
+		return RedDuration;
+	}
+	return 0.0f;
+}
+
+ETrafficLightState ATrafficLight::GetNextState(ETrafficLightState State)
+{
+	switch (State)
+	{
+	case ETrafficLightState::Green:
+		return ETrafficLightState::Yellow;
+	case ETrafficLightState::Yellow:
+		return ETrafficLightState::Red;
+	case ETrafficLightState::Red:
+		return ETrafficLightState::Green;
+	}
+	return ETrafficLightState::Green;
+}
+
 void ATrafficLight::SetLightState(ETrafficLightState NewState)
 {
 	// Mevcut timer'ı iptal et
@@ -115,21 +226,10 @@ void ATrafficLight::SetLightState(ETrafficLightState NewState)
 
 	// Yeni durumu ayarla
 	CurrentState = NewState;
+	PhaseStartTime = GetWorld()->GetTimeSeconds();
 
 	// Yeni duruma göre timer'ı ayarla
-	float Duration = 0.0f;
-	switch (CurrentState)
-	{
-	case ETrafficLightState::Green:
-		Duration = GreenDuration;
-		break;
-	case ETrafficLightState::Yellow:
-		Duration = YellowDuration;
-		break;
-	case ETrafficLightState::Red:
-		Duration = RedDuration;
-		break;
-	}
+	float Duration = GetPhaseDuration(CurrentState);
 
 	// Timer'ı yeniden başlat
 	if (Duration > 0.0f)
@@ -142,4 +242,148 @@ void ATrafficLight::SetLightState(ETrafficLightState NewState)
 			false
 		);
 	}
+
+	OnLightStateChanged.Broadcast(this, CurrentState);
+}
+
+void ATrafficLight::InitializeTiming(float InGreenDuration, float InYellowDuration, float InRedDuration, ETrafficLightState InitialState, FName InIntersectionId, int32 InApproachIndex)
+{
+	// BeginPlay sonrası çağrılırsa zamanlayıcı ve kavşak kaydı eski değerlerle kalır
+	ensure(!HasActorBegunPlay());
+
+	GreenDuration = FMath::Max(InGreenDuration, 0.1f);
+	YellowDuration = FMath::Max(InYellowDuration, 0.1f);
+	RedDuration = FMath::Max(InRedDuration, 0.1f);
+	CurrentState = InitialState;
+	IntersectionId = InIntersectionId;
+	ApproachIndex = FMath::Max(InApproachIndex, 0);
+}
+
+float ATrafficLight::GetPhaseElapsedTime() const
+{
+	return GetWorld()->GetTimeSeconds() - PhaseStartTime;
+}
+
+float ATrafficLight::GetPhaseTimeRemaining() const
+{
+	return GetWorldTimerManager().GetTimerRemaining(LightSwitchTimerHandle);
+}
+
+void ATrafficLight::RestorePhase(ETrafficLightState State, float InGreenDuration, float InYellowDuration, float InRedDuration, float PhaseElapsed, float TimerRemaining)
+{
+	GreenDuration = FMath::Max(InGreenDuration, 0.1f);
+	YellowDuration = FMath::Max(InYellowDuration, 0.1f);
+	RedDuration = FMath::Max(InRedDuration, 0.1f);
+
+	GetWorldTimerManager().ClearTimer(LightSwitchTimerHandle);
+
+	const ETrafficLightState PreviousState = CurrentState;
+	CurrentState = State;
+
+	// Faz başlangıcı geriye alınır ki GetStateAtTime kaydedilen dünyadaki tahmini versin
+	PhaseStartTime = GetWorld()->GetTimeSeconds() - PhaseElapsed;
+
+	// Süresi 0 olan zamanlayıcı kurulmaz - bitmek üzere kaydedilen faz bir sonraki tick'te geçer
+	if (TimerRemaining >= 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(LightSwitchTimerHandle, this, &ATrafficLight::SwitchLight, FMath::Max(TimerRemaining, KINDA_SMALL_NUMBER), false);
+	}
+
+	if (CurrentState != PreviousState)
+	{
+		OnLightStateChanged.Broadcast(this, CurrentState);
+	}
+}
+
+void ATrafficLight::ApplyCycleTiming(float NewGreenDuration, float NewRedDuration, float GreenStartDelay)
+{
+	GreenDuration = FMath::Max(0.1f, NewGreenDuration);
+	RedDuration = FMath::Max(0.1f, NewRedDuration);
+
+	GetWorldTimerManager().ClearTimer(LightSwitchTimerHandle);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const ETrafficLightState PreviousState = CurrentState;
+
+	if (GreenStartDelay <= KINDA_SMALL_NUMBER)
+	{
+		// Döngü şimdi başlıyor: yeşil
+		CurrentState = ETrafficLightState::Green;
+		PhaseStartTime = Now;
+		GetWorldTimerManager().SetTimer(LightSwitchTimerHandle, this, &ATrafficLight::SwitchLight, GreenDuration, false);
+	}
+	else
+	{
+		// Önceki yaklaşımlar yeşil alırken kırmızıda bekle
+		// PhaseStartTime geriye alınır ki GetStateAtTime kalan kırmızı süreyi doğru tahmin etsin
+		CurrentState = ETrafficLightState::Red;
+		PhaseStartTime = Now - FMath::Max(0.0f, RedDuration - GreenStartDelay);
+		GetWorldTimerManager().SetTimer(LightSwitchTimerHandle, this, &ATrafficLight::SwitchLight, GreenStartDelay, false);
+	}
+
+	if (CurrentState != PreviousState)
+	{
+		OnLightStateChanged.Broadcast(this, CurrentState);
+	}
+}
+
+void ATrafficLight::AccumulateDelay()
+{
+	// Kuyruk integrali: Σ (kuyruk sayısı * geçen süre) = toplam araç-saniye bekleme
+	const float Now = GetWorld()->GetTimeSeconds();
+	TotalDelay += (double)QueueCount * (Now - LastQueueChangeTime);
+	LastQueueChangeTime = Now;
+}
+
+void ATrafficLight::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// Sadece araçlar sayılır
+	if (!Cast<AVehicle>(OtherActor))
+	{
+		return;
+	}
+
+	AccumulateDelay();
+	++QueueCount;
+	++PendingArrivals;
+}
+
+void ATrafficLight::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (!Cast<AVehicle>(OtherActor))
+	{
+		return;
+	}
+
+	AccumulateDelay();
+	QueueCount = FMath::Max(0, QueueCount - 1);
+	++TotalDepartures;
+}
+
+int32 ATrafficLight::ConsumeArrivalCount()
+{
+	const int32 Arrivals = PendingArrivals;
+	PendingArrivals = 0;
+	return Arrivals;
+}
+
+double ATrafficLight::GetTotalDelay() const
+{
+	// Son değişiklikten bu yana biriken kısım da dahil
+	const float Now = GetWorld()->GetTimeSeconds();
+	return TotalDelay + (double)QueueCount * (Now - LastQueueChangeTime);
+}
+
+float ATrafficLight::GetMetricsElapsedTime() const
+{
+	return GetWorld()->GetTimeSeconds() - MetricsStartTime;
+}
+
+void ATrafficLight::ResetMetrics()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	TotalDepartures = 0;
+	TotalDelay = 0.0;
+	LastQueueChangeTime = Now;
+	MetricsStartTime = Now;
 }
@@ -7,6 +7,11 @@
 #include "VehicleAIController.h" // ETrafficLightState enum'u için
 #include "TrafficLight.generated.h"
 
+class ATrafficLight;
+
+/** Işık durumu değiştiğinde yayınlanır (faz sınırları, adaptif zamanlama). */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTrafficLightStateChanged, ATrafficLight* /*TrafficLight*/, ETrafficLightState /*NewState*/);
+
 /**
  * Trafik ışığı aktörü.
  * AActor'dan türeyen bu sınıf, trafik ışıklarının durumunu yönetir ve
@@ -61,6 +66,26 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Light Timing", meta = (ClampMin = "0.1"))
 	float RedDuration;
 
+	// ============================================
+	// ADAPTİF ZAMANLAMA
+	// ============================================
+
+	/**
+	 * Işığın ait olduğu kavşak.
+	 * Aynı IntersectionId'ye sahip ışıklar bir kavşağın yaklaşımlarıdır ve
+	 * UTrafficSignalSubsystem tarafından TriggerBox kuyruk sayılarına göre adaptif zamanlanır.
+	 * None ise ışık sabit GreenDuration / YellowDuration / RedDuration döngüsünde çalışır.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Adaptive Timing")
+	FName IntersectionId;
+
+	/**
+	 * Kavşaktaki faz sırası.
+	 * Yaklaşımlar bu sırayla yeşil alır (0 döngüyü başlatan yaklaşımdır).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Adaptive Timing", meta = (ClampMin = "0"))
+	int32 ApproachIndex;
+
 	// ============================================
 	// COMPONENT'LER
 	// ============================================
@@ -85,9 +110,57 @@ protected:
 	 */
 	FTimerHandle LightSwitchTimerHandle;
 
+	/**
+	 * Mevcut fazın başladığı zaman (World->GetTimeSeconds()).
+	 * Ortak saat olarak dünya zamanı kullanılır; araçlar ışığın gelecekteki
+	 * durumunu bu değer ve faz süreleri ile tahmin eder.
+	 */
+	float PhaseStartTime;
+
+	// ============================================
+	// KUYRUK SAYAÇLARI
+	// ============================================
+
+	/** TriggerBox içindeki araç sayısı (kuyruk). */
+	int32 QueueCount;
+
+	/** Son ConsumeArrivalCount çağrısından beri gelen araç sayısı. */
+	int32 PendingArrivals;
+
+	/** Toplam ayrılan araç sayısı (metrik). */
+	int32 TotalDepartures;
+
+	/** Toplam bekleme (araç * saniye). Kuyruk sayısının zamana göre integrali. */
+	double TotalDelay;
+
+	/** Kuyruk sayısının son değiştiği zaman (integral için). */
+	float LastQueueChangeTime;
+
+	/** Metriklerin sıfırlandığı zaman. */
+	float MetricsStartTime;
+
+	/** Kuyruk integralini şimdiki zamana kadar ilerletir. */
+	void AccumulateDelay();
+
+	/**
+	 * TriggerBox'a giren araçları sayar.
+	 */
+	UFUNCTION()
+	void OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/**
+	 * TriggerBox'tan çıkan araçları sayar.
+	 */
+	UFUNCTION()
+	void OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
 	// Tick fonksiyonu kullanılmıyor (performans için kapatıldı)
 	// virtual void Tick(float DeltaTime) override;
 
+	// Called when the actor is removed from the world
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
 	// ============================================
 	// FONKSİYONLAR
 	// ============================================
@@ -110,6 +183,88 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Traffic Light")
 	ETrafficLightState GetCurrentState() const;
 
+	/**
+	 * Işığın verilen dünya zamanındaki durumunu tahmin eder.
+	 * Mevcut fazın başlangıcından itibaren Green -> Yellow -> Red döngüsü
+	 * faz süreleriyle ileri sarılır (SetLightState ile dışarıdan müdahale edilmezse kesin sonuç verir).
+	 *
+	 * @param WorldTime Dünya zamanı (saniye, World->GetTimeSeconds() ile aynı saat)
+	 * @return O andaki tahmini ışık durumu
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Light")
+	ETrafficLightState GetStateAtTime(float WorldTime) const;
+
+	/**
+	 * Verilen durumun faz süresini döndürür (GreenDuration, YellowDuration veya RedDuration).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Light")
+	float GetPhaseDuration(ETrafficLightState State) const;
+
+	/**
+	 * Döngüdeki bir sonraki durumu döndürür: Green -> Yellow -> Red -> Green.
+	 */
+	static ETrafficLightState GetNextState(ETrafficLightState State);
+
+	/**
+	 * Döngü sınırında yeni faz sürelerini uygular (adaptif zamanlama).
+	 * GreenStartDelay 0 ise ışık hemen yeşile geçer; değilse ışık kırmızıda
+	 * GreenStartDelay kadar bekler. Bu sayede kavşaktaki yaklaşımlar sırayla yeşil alır.
+	 *
+	 * @param NewGreenDuration Yeni yeşil süre (saniye)
+	 * @param NewRedDuration Yeni kırmızı süre (saniye)
+	 * @param GreenStartDelay Yeşilin başlamasına kalan süre (saniye)
+	 */
+	void ApplyCycleTiming(float NewGreenDuration, float NewRedDuration, float GreenStartDelay);
+
+	/**
+	 * Faz sürelerini ve kavşak bilgisini ayarlar (senaryo yükleme, headless test).
+	 * BeginPlay'den önce çağrılmalıdır (SpawnActorDeferred + FinishSpawning); kayıtlar
+	 * BeginPlay'de bu değerlerle yapılır.
+	 */
+	void InitializeTiming(float InGreenDuration, float InYellowDuration, float InRedDuration, ETrafficLightState InitialState, FName InIntersectionId, int32 InApproachIndex);
+
+	/** Mevcut fazda geçen süre (saniye). */
+	float GetPhaseElapsedTime() const;
+
+	/** Faz zamanlayıcısına kalan süre (saniye, zamanlayıcı yoksa < 0). */
+	float GetPhaseTimeRemaining() const;
+
+	/**
+	 * Kontrol noktasından faz durumunu geri yükler: süreler, durum, fazda geçen süre ve
+	 * zamanlayıcıya kalan süre (TimerRemaining < 0 = zamanlayıcı kurulmaz). Durum
+	 * değiştiyse OnLightStateChanged yayınlanır.
+	 */
+	void RestorePhase(ETrafficLightState State, float InGreenDuration, float InYellowDuration, float InRedDuration, float PhaseElapsed, float TimerRemaining);
+
+	/** Işık durumu her değiştiğinde yayınlanır. */
+	FOnTrafficLightStateChanged OnLightStateChanged;
+
+	/** Kavşak ID'si (None = adaptif değil). */
+	FName GetIntersectionId() const { return IntersectionId; }
+
+	/** Kavşaktaki faz sırası. */
+	int32 GetApproachIndex() const { return ApproachIndex; }
+
+	/** TriggerBox içindeki araç sayısı. */
+	int32 GetQueueCount() const { return QueueCount; }
+
+	/**
+	 * Son çağrıdan beri gelen araç sayısını döndürür ve sayacı sıfırlar.
+	 */
+	int32 ConsumeArrivalCount();
+
+	/** Toplam ayrılan araç sayısı. */
+	int32 GetTotalDepartures() const { return TotalDepartures; }
+
+	/** Toplam bekleme (araç * saniye), şimdiki zamana kadar. */
+	double GetTotalDelay() const;
+
+	/** Metrik ölçüm süresi (saniye). */
+	float GetMetricsElapsedTime() const;
+
+	/** Verim ve bekleme metriklerini sıfırlar. */
+	void ResetMetrics();
+
 	/**
 	 * Trafik ışığını belirli bir duruma ayarlayan fonksiyon.
 	 * 
@@ -0,0 +1,264 @@
+#include "TrafficManeuver.h"
+#include "VehicleAIController.h"
+
+namespace
+{
+	/** Çerçeve havuzunun boyut sınıfı adımı ve sınıf sayısı (1 KB'tan büyük çerçeveler havuzlanmaz). */
+	constexpr SIZE_T FrameGranularity = 64;
+	constexpr int32 NumFrameClasses = 16;
+
+	struct FFreeFrame
+	{
+		FFreeFrame* Next;
+	};
+
+	/** Boyut sınıfı başına boş çerçeve listesi (TrimFramePool'a kadar tutulur). */
+	FFreeFrame* FreeFrames[NumFrameClasses] = {};
+	int32 NumFreeFrames = 0;
+
+	FORCEINLINE int32 GetFrameClass(SIZE_T Size)
+	{
+		return (int32)((Size - 1) / FrameGranularity);
+	}
+}
+
+void* FTrafficManeuverTask::promise_type::operator new(SIZE_T Size)
+{
+	check(IsInGameThread());
+
+	const int32 FrameClass = GetFrameClass(Size);
+	if (FrameClass >= NumFrameClasses)
+	{
+		return FMemory::Malloc(Size);
+	}
+
+	if (FFreeFrame* Frame = FreeFrames[FrameClass])
+	{
+		FreeFrames[FrameClass] = Frame->Next;
+		--NumFreeFrames;
+		return Frame;
+	}
+	return FMemory::Malloc((FrameClass + 1) * FrameGranularity);
+}
+
+void FTrafficManeuverTask::promise_type::operator delete(void* Ptr, SIZE_T Size)
+{
+	const int32 FrameClass = GetFrameClass(Size);
+	if (FrameClass >= NumFrameClasses)
+	{
+		FMemory::Free(Ptr);
+		return;
+	}
+
+	FFreeFrame* Frame = static_cast<FFreeFrame*>(Ptr);
+	Frame->Next = FreeFrames[FrameClass];
+	FreeFrames[FrameClass] = Frame;
+	++NumFreeFrames;
+}
+
+void FTrafficManeuverTask::TrimFramePool()
+{
+	check(IsInGameThread());
+
+	for (FFreeFrame*& Head : FreeFrames)
+	{
+		while (FFreeFrame* Frame = Head)
+		{
+			Head = Frame->Next;
+			FMemory::Free(Frame);
+		}
+	}
+	NumFreeFrames = 0;
+}
+
+int32 FTrafficManeuverTask::GetPooledFrameCount()
+{
+	return NumFreeFrames;
+}
+
+void FTrafficManeuverAwaiter::await_suspend(FTrafficManeuverTask::FHandle InHandle)
+{
+	Handle = InHandle;
+	FTrafficManeuverTask::promise_type& Promise = InHandle.promise();
+	Promise.Scheduler->Suspend(Promise.Slot, *this);
+}
+
+void FTrafficManeuverScheduler::Initialize(int32 NumWheelSlots, float WheelTickInterval)
+{
+	Reset();
+	Wheel.Initialize(NumWheelSlots, WheelTickInterval);
+}
+
+void FTrafficManeuverScheduler::Reset()
+{
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		if (Slots[SlotIndex].Handle)
+		{
+			Free(SlotIndex);
+		}
+	}
+
+	Slots.Reset();
+	FreeSlots.Reset();
+	GapWaiters.Reset();
+	Ready.Reset();
+	Resuming.Reset();
+	Wheel.Reset();
+	NumActive = 0;
+
+	// Yok edilen çerçeveler havuza döndü; kapanışta bellek süreç sonuna kadar tutulmasın
+	FTrafficManeuverTask::TrimFramePool();
+}
+
+bool FTrafficManeuverScheduler::Start(AVehicleAIController* Controller, FTrafficManeuverTask&& Task)
+{
+	check(IsInGameThread());
+
+	if (!Controller || !Task.IsValid())
+	{
+		return false;
+	}
+
+	Cancel(Controller);
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(false);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Handle = Task.Release();
+	Slot.Controller = Controller;
+	Slot.Wait = ETrafficManeuverWait::None;
+
+	FTrafficManeuverTask::promise_type& Promise = Slot.Handle.promise();
+	Promise.Scheduler = this;
+	Promise.Slot = SlotIndex;
+
+	Controller->ManeuverSlot = SlotIndex;
+	++NumActive;
+
+	// İlk co_await'e kadar hemen
+	Resume(SlotIndex);
+	return Controller->ManeuverSlot == SlotIndex;
+}
+
+void FTrafficManeuverScheduler::Cancel(AVehicleAIController* Controller)
+{
+	if (!Controller || !Slots.IsValidIndex(Controller->ManeuverSlot))
+	{
+		return;
+	}
+
+	const int32 SlotIndex = Controller->ManeuverSlot;
+	Unlink(SlotIndex);
+	Ready.RemoveSingleSwap(SlotIndex, false);
+	Free(SlotIndex);
+}
+
+void FTrafficManeuverScheduler::Signal(const AVehicleAIController* Controller, ETrafficManeuverWait Event)
+{
+	if (Controller && Slots.IsValidIndex(Controller->ManeuverSlot) && Slots[Controller->ManeuverSlot].Wait == Event)
+	{
+		MarkReady(Controller->ManeuverSlot, ETrafficManeuverWake::Signalled);
+	}
+}
+
+bool FTrafficManeuverScheduler::HasManeuver(const AVehicleAIController* Controller) const
+{
+	return Controller && Slots.IsValidIndex(Controller->ManeuverSlot);
+}
+
+void FTrafficManeuverScheduler::Suspend(int32 SlotIndex, const FTrafficManeuverAwaiter& Awaiter)
+{
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Wait = Awaiter.Wait;
+	Slot.bRight = Awaiter.bRight;
+
+	if (Awaiter.Wait == ETrafficManeuverWait::Gap)
+	{
+		GapWaiters.Add(SlotIndex);
+	}
+
+	if (Awaiter.Timeout > 0.0f)
+	{
+		Wheel.Schedule(Awaiter.Timeout, { SlotIndex, Slot.Generation });
+	}
+}
+
+void FTrafficManeuverScheduler::MarkReady(int32 SlotIndex, ETrafficManeuverWake Wake)
+{
+	FSlot& Slot = Slots[SlotIndex];
+	if (Slot.Wait == ETrafficManeuverWait::None)
+	{
+		return;
+	}
+
+	Unlink(SlotIndex);
+	Slot.Handle.promise().Wake = Wake;
+	Ready.Add(SlotIndex);
+}
+
+void FTrafficManeuverScheduler::ResumeReady()
+{
+	// Devam eden manevra yeni olay bekleyebilir veya başka yuvayı hazırlayabilir - kopya üzerinde çalış
+	Swap(Ready, Resuming);
+	LastResumeCount = Resuming.Num();
+
+	for (const int32 SlotIndex : Resuming)
+	{
+		// Bu döngüde iptal edilip yeniden başlatılan yuva zaten çalıştı ve yeni olayını bekliyor
+		if (Slots[SlotIndex].Handle && Slots[SlotIndex].Wait == ETrafficManeuverWait::None)
+		{
+			Resume(SlotIndex);
+		}
+	}
+	Resuming.Reset();
+}
+
+void FTrafficManeuverScheduler::Resume(int32 SlotIndex)
+{
+	FTrafficManeuverTask::FHandle Handle = Slots[SlotIndex].Handle;
+	Handle.resume();
+
+	if (Handle.done())
+	{
+		Free(SlotIndex);
+	}
+}
+
+void FTrafficManeuverScheduler::Unlink(int32 SlotIndex)
+{
+	FSlot& Slot = Slots[SlotIndex];
+	if (Slot.Wait == ETrafficManeuverWait::Gap)
+	{
+		GapWaiters.RemoveSingleSwap(SlotIndex, false);
+	}
+
+	Slot.Wait = ETrafficManeuverWait::None;
+	++Slot.Generation;
+}
+
+void FTrafficManeuverScheduler::Free(int32 SlotIndex)
+{
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.Handle.destroy();
+	Slot.Handle = nullptr;
+	Slot.Wait = ETrafficManeuverWait::None;
+	++Slot.Generation;
+
+	if (Slot.Controller && Slot.Controller->ManeuverSlot == SlotIndex)
+	{
+		Slot.Controller->ManeuverSlot = INDEX_NONE;
+	}
+	Slot.Controller = nullptr;
+
+	FreeSlots.Add(SlotIndex);
+	--NumActive;
+}
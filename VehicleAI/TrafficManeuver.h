@@ -0,0 +1,295 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <coroutine>
+#include "TrafficTimingWheel.h"
+
+class AVehicleAIController;
+class FTrafficManeuverScheduler;
+
+/** Askıdaki manevranın beklediği olay. */
+enum class ETrafficManeuverWait : uint8
+{
+	/** Beklemiyor (çalışıyor veya devam etmeye hazır). */
+	None,
+
+	/** Yan şeritte boşluk (doluluk tahmininde araç yok). */
+	Gap,
+
+	/** Şerit offset'i hedefe ulaştı (sollama profili dahil). */
+	OffsetReached,
+
+	/** Sadece süre (zaman aşımı = beklenen sonuç). */
+	Delay,
+};
+
+/** Manevranın neden devam ettirildiği. */
+enum class ETrafficManeuverWake : uint8
+{
+	/** Beklenen olay gerçekleşti. */
+	Signalled,
+
+	/** Zaman aşımı (Delay için normal sonuç). */
+	TimedOut,
+};
+
+/**
+ * Devam ettirilebilir manevra görevi (C++20 coroutine dönüş tipi).
+ *
+ * Manevra adımları (boşluk bekle, sinyal ver, kay, doğrula) tek fonksiyonda sırayla yazılır;
+ * her co_await aracı olaya kadar askıya alır. Askıdaki manevra hiçbir şey çalıştırmaz: sadece
+ * olay (FTrafficManeuverScheduler::Signal, boşluk testi) veya zaman aşımı devam ettirir.
+ * Görev başlangıçta askıdadır; FTrafficManeuverScheduler::Start ile çalıştırılır.
+ */
+class FTrafficManeuverTask
+{
+public:
+	struct promise_type
+	{
+		FTrafficManeuverScheduler* Scheduler = nullptr;
+		int32 Slot = INDEX_NONE;
+		ETrafficManeuverWake Wake = ETrafficManeuverWake::Signalled;
+
+		FTrafficManeuverTask get_return_object() { return FTrafficManeuverTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; } // Çerçeveyi zamanlayıcı yok eder
+		void return_void() {}
+		void unhandled_exception() { check(false); }
+
+		/** Çerçeveler boyut sınıfına göre havuzdan gelir (kararlı durumda heap tahsisi yok). Sadece oyun thread'i. */
+		static void* operator new(SIZE_T Size);
+		static void operator delete(void* Ptr, SIZE_T Size);
+	};
+
+	using FHandle = std::coroutine_handle<promise_type>;
+
+	FTrafficManeuverTask() = default;
+	FTrafficManeuverTask(FTrafficManeuverTask&& Other) : Handle(Other.Handle) { Other.Handle = nullptr; }
+	FTrafficManeuverTask& operator=(FTrafficManeuverTask&& Other)
+	{
+		if (this != &Other)
+		{
+			Destroy();
+			Handle = Other.Handle;
+			Other.Handle = nullptr;
+		}
+		return *this;
+	}
+	FTrafficManeuverTask(const FTrafficManeuverTask&) = delete;
+	FTrafficManeuverTask& operator=(const FTrafficManeuverTask&) = delete;
+	~FTrafficManeuverTask() { Destroy(); }
+
+	bool IsValid() const { return (bool)Handle; }
+
+	/**
+	 * Çerçeve havuzundaki boş çerçeveleri belleğe geri verir (kullanımdaki çerçeveler etkilenmez).
+	 * Havuz tüm dünyaların zamanlayıcılarınca paylaşılır; FTrafficManeuverScheduler::Reset çağırır,
+	 * böylece subsystem kapanınca havuz boşalır. Sadece oyun thread'i.
+	 */
+	static void TrimFramePool();
+
+	/** Havuzda bekleyen boş çerçeve sayısı. */
+	static int32 GetPooledFrameCount();
+
+	/** Çerçevenin sahipliğini bırakır (zamanlayıcı alır). */
+	FHandle Release()
+	{
+		FHandle Result = Handle;
+		Handle = nullptr;
+		return Result;
+	}
+
+private:
+	explicit FTrafficManeuverTask(FHandle InHandle) : Handle(InHandle) {}
+
+	void Destroy()
+	{
+		if (Handle)
+		{
+			Handle.destroy();
+			Handle = nullptr;
+		}
+	}
+
+	FHandle Handle;
+};
+
+/**
+ * co_await ile manevrayı olaya veya zaman aşımına kadar askıya alır.
+ * Sonuç ETrafficManeuverWake'dir.
+ */
+struct FTrafficManeuverAwaiter
+{
+	ETrafficManeuverWait Wait = ETrafficManeuverWait::None;
+	float Timeout = 0.0f;
+	bool bRight = false;
+	FTrafficManeuverTask::FHandle Handle;
+
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(FTrafficManeuverTask::FHandle InHandle);
+	ETrafficManeuverWake await_resume() const noexcept { return Handle.promise().Wake; }
+};
+
+namespace TrafficManeuver
+{
+	/** Yan şerit boşalana kadar bekle (Timeout <= 0 = süresiz). */
+	inline FTrafficManeuverAwaiter WaitForGap(bool bRight, float Timeout)
+	{
+		FTrafficManeuverAwaiter Awaiter;
+		Awaiter.Wait = ETrafficManeuverWait::Gap;
+		Awaiter.Timeout = Timeout;
+		Awaiter.bRight = bRight;
+		return Awaiter;
+	}
+
+	/** Şerit offset'i hedefe ulaşana kadar bekle (Timeout <= 0 = süresiz). */
+	inline FTrafficManeuverAwaiter WaitForOffset(float Timeout)
+	{
+		FTrafficManeuverAwaiter Awaiter;
+		Awaiter.Wait = ETrafficManeuverWait::OffsetReached;
+		Awaiter.Timeout = Timeout;
+		return Awaiter;
+	}
+
+	/** Seconds saniye bekle. */
+	inline FTrafficManeuverAwaiter Delay(float Seconds)
+	{
+		FTrafficManeuverAwaiter Awaiter;
+		Awaiter.Wait = ETrafficManeuverWait::Delay;
+		Awaiter.Timeout = FMath::Max(Seconds, KINDA_SMALL_NUMBER);
+		return Awaiter;
+	}
+}
+
+/**
+ * Araç başına en fazla bir manevrayı çalıştıran zamanlayıcı (UTrafficSubsystem sahibidir).
+ *
+ * Askıdaki manevra sadece beklediği olayın listesinde durur: zaman aşımları paylaşılan timing
+ * wheel'de, boşluk bekleyenler tek listede, offset bekleyenler hiçbir listede (controller
+ * ulaştığında Signal çağırır). Devam ettirme sadece Update'te ve sadece olay gelen manevralar
+ * için yapılır; binlerce askıdaki manevra kare başına olay sayısı kadar resume maliyeti getirir.
+ *
+ * Boşluk olayı yoktur: doluluk tahmini her kare yeniden kurulduğu için değişiklik bildirimi
+ * üretmez, bu yüzden boşluk bekleyenler Update'te her kare tek tek sorgulanır (bekleyen başına
+ * bir doluluk sorgusu, resume yok). Maliyeti -ManeuverBenchmark ölçer. Sadece oyun thread'inden
+ * kullanılır.
+ */
+class YOURGAMENAME_API FTrafficManeuverScheduler
+{
+public:
+	/**
+	 * @param NumWheelSlots Zaman aşımı çarkı yuva sayısı (2'nin kuvveti)
+	 * @param WheelTickInterval Çark adımı (saniye)
+	 */
+	void Initialize(int32 NumWheelSlots, float WheelTickInterval);
+
+	/** Tüm manevraları çalıştırmadan yok eder. */
+	void Reset();
+
+	/**
+	 * Controller'ın manevrasını başlatır (varsa eskisi iptal edilir). Görev ilk co_await'e
+	 * kadar hemen çalışır, böylece ilk adım (ör. profil kurulumu) bu karede uygulanır.
+	 *
+	 * @return Manevra askıya alındıysa true (ilk adımda bittiyse false)
+	 */
+	bool Start(AVehicleAIController* Controller, FTrafficManeuverTask&& Task);
+
+	/** Controller'ın manevrasını çalıştırmadan yok eder (EndPlay, uzak alana indirme). */
+	void Cancel(AVehicleAIController* Controller);
+
+	/** Controller için olay bildirir; manevrası bu olayı bekliyorsa bir sonraki Update'te devam eder. */
+	void Signal(const AVehicleAIController* Controller, ETrafficManeuverWait Event);
+
+	/** Controller'ın manevrası var mı. */
+	bool HasManeuver(const AVehicleAIController* Controller) const;
+
+	/**
+	 * Zaman aşımlarını ilerletir, boşluk bekleyenleri test eder ve olay gelen manevraları
+	 * devam ettirir. IsGapAvailable(const AVehicleAIController*, bool bRight) her kare her
+	 * boşluk bekleyen manevra için bir kez çağrılır (yoklama; bkz. sınıf açıklaması).
+	 */
+	template<typename GapFuncType>
+	void Update(float DeltaTime, GapFuncType&& IsGapAvailable)
+	{
+		Wheel.Advance(DeltaTime, [this](const FTimeout& Timeout)
+		{
+			if (Slots.IsValidIndex(Timeout.Slot) && Slots[Timeout.Slot].Generation == Timeout.Generation)
+			{
+				MarkReady(Timeout.Slot, ETrafficManeuverWake::TimedOut);
+			}
+		});
+
+		for (int32 Index = GapWaiters.Num() - 1; Index >= 0; --Index)
+		{
+			const FSlot& Slot = Slots[GapWaiters[Index]];
+			if (IsGapAvailable(Slot.Controller, Slot.bRight))
+			{
+				MarkReady(GapWaiters[Index], ETrafficManeuverWake::Signalled);
+			}
+		}
+
+		ResumeReady();
+	}
+
+	/** Çalışan (askıdaki) manevra sayısı. */
+	int32 Num() const { return NumActive; }
+
+	/** Son Update'te devam ettirilen manevra sayısı. */
+	int32 GetLastResumeCount() const { return LastResumeCount; }
+
+	/** Boşluk bekleyen (her kare sorgulanan) manevra sayısı. */
+	int32 GetGapWaiterCount() const { return GapWaiters.Num(); }
+
+private:
+	friend struct FTrafficManeuverAwaiter;
+
+	struct FSlot
+	{
+		FTrafficManeuverTask::FHandle Handle;
+		AVehicleAIController* Controller = nullptr;
+		ETrafficManeuverWait Wait = ETrafficManeuverWait::None;
+		bool bRight = false;
+
+		/** Her devam ettirmede ve iptalde artar; çarktaki eski zaman aşımları bununla elenir. */
+		uint32 Generation = 0;
+	};
+
+	struct FTimeout
+	{
+		int32 Slot = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	/** Awaiter'dan: manevrayı olay listesine alır. */
+	void Suspend(int32 SlotIndex, const FTrafficManeuverAwaiter& Awaiter);
+
+	/** Manevrayı bekleme listesinden çıkarır ve devam listesine ekler. */
+	void MarkReady(int32 SlotIndex, ETrafficManeuverWake Wake);
+
+	/** Devam listesindeki manevraları çalıştırır, biteni serbest bırakır. */
+	void ResumeReady();
+
+	/** Çalıştırır; bittiyse yuvayı serbest bırakır. */
+	void Resume(int32 SlotIndex);
+
+	/** Bekleme listelerinden çıkarır (çark girdisi nesille elenir). */
+	void Unlink(int32 SlotIndex);
+
+	/** Çerçeveyi yok eder ve yuvayı boş listeye verir. */
+	void Free(int32 SlotIndex);
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	/** Boşluk bekleyen yuvalar. */
+	TArray<int32> GapWaiters;
+
+	/** Bu Update'te devam edecek yuvalar (olay sırasıyla) ve çalıştırma kopyası. */
+	TArray<int32> Ready;
+	TArray<int32> Resuming;
+
+	TTrafficTimingWheel<FTimeout> Wheel;
+
+	int32 NumActive = 0;
+	int32 LastResumeCount = 0;
+};
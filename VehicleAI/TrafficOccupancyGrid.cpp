@@ -0,0 +1,72 @@
+#include "TrafficOccupancyGrid.h"
+
+namespace
+{
+	/** Kutunun eksene izdüşümünün yarı boyu. */
+	FORCEINLINE float ProjectHalfExtent(const FTrafficOccupant& Box, const FVector2D& Axis)
+	{
+		const FVector2D Right(-Box.Forward.Y, Box.Forward.X);
+		return Box.HalfLength * FMath::Abs(FVector2D::DotProduct(Box.Forward, Axis))
+			+ Box.HalfWidth * FMath::Abs(FVector2D::DotProduct(Right, Axis));
+	}
+}
+
+bool FTrafficOccupant::Overlaps(const FTrafficOccupant& A, const FTrafficOccupant& B)
+{
+	const FVector2D Delta(B.Location.X - A.Location.X, B.Location.Y - A.Location.Y);
+	const FVector2D Axes[4] =
+	{
+		A.Forward,
+		FVector2D(-A.Forward.Y, A.Forward.X),
+		B.Forward,
+		FVector2D(-B.Forward.Y, B.Forward.X),
+	};
+
+	// Ayırma ekseni: herhangi bir eksende izdüşümler ayrıksa kesişme yok
+	for (const FVector2D& Axis : Axes)
+	{
+		if (FMath::Abs(FVector2D::DotProduct(Delta, Axis)) > ProjectHalfExtent(A, Axis) + ProjectHalfExtent(B, Axis))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FTrafficOccupancyGrid::Initialize(float InCellSize, int32 InNumBuckets, float InLayerInterval, float InHorizon)
+{
+	LayerInterval = FMath::Max(InLayerInterval, KINDA_SMALL_NUMBER);
+
+	// Katman 0 = şimdiki konumlar
+	const int32 DesiredLayers = FMath::Max(FMath::FloorToInt(InHorizon / LayerInterval) + 1, 1);
+	const int32 NumLayers = FMath::Min(DesiredLayers, MaxLayers);
+	if (DesiredLayers > MaxLayers)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Doluluk ufku %d katmanla sınırlandı (%.2f sn)"), MaxLayers, (MaxLayers - 1) * LayerInterval);
+	}
+
+	Layers.Reset();
+	Layers.SetNum(NumLayers);
+	for (FTrafficSpatialHash& Layer : Layers)
+	{
+		Layer.Initialize(InCellSize, InNumBuckets);
+	}
+
+	Reset();
+}
+
+void FTrafficOccupancyGrid::Reset()
+{
+	for (FTrafficSpatialHash& Layer : Layers)
+	{
+		Layer.Reset();
+	}
+	Occupants.Reset();
+	NumItems = 0;
+	MaxExtent = 0.0f;
+}
+
+int32 FTrafficOccupancyGrid::GetLayerForTime(float Time) const
+{
+	return FMath::Clamp(FMath::RoundToInt(Time / LayerInterval), 0, Layers.Num() - 1);
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "TrafficSpatialHash.h"
+#include "TrafficAllocationTracker.h"
+
+/**
+ * Bir aracın bir zaman katmanındaki tahmini kapladığı alan (2D yönlü kutu).
+ */
+struct FTrafficOccupant
+{
+	/** Kutunun merkezi. */
+	FVector Location = FVector::ZeroVector;
+
+	/** Yatay ileri yönü (birim vektör). */
+	FVector2D Forward = FVector2D(1.0f, 0.0f);
+
+	/** Yarı uzunluk ve yarı genişlik (birim). */
+	float HalfLength = 0.0f;
+	float HalfWidth = 0.0f;
+
+	/** Öğe kimliği (INDEX_NONE = bu katmanda yok). */
+	int32 ItemId = INDEX_NONE;
+
+	/** Sorgularda filtrelemek için grup (ör. şerit ID'si). */
+	int32 Group = INDEX_NONE;
+
+	/** İki kutu kesişiyor mu (2D ayırma ekseni testi). */
+	static bool Overlaps(const FTrafficOccupant& A, const FTrafficOccupant& B);
+};
+
+/**
+ * Kısa ufuklu, zaman katmanlı doluluk tahmini.
+ *
+ * Her adımda bir kez tüm araçların şimdiki ve 0 - Horizon saniye sonraki tahmini
+ * konumlarından kurulur (katman başına bir FTrafficSpatialHash). Tahmin araç başına,
+ * katmanlar katman başına paralel kurulur. Kurulduktan sonra salt okunurdur:
+ * yan sensör, tahmini çakışma frenlemesi ve diğer güvenlik kontrolleri kendi
+ * sorgularını yapmak yerine bu yapıyı okur.
+ */
+class YOURGAMENAME_API FTrafficOccupancyGrid
+{
+public:
+	/**
+	 * @param InCellSize Hücre boyu (birim)
+	 * @param InNumBuckets Katman başına kova sayısı (2'nin kuvveti)
+	 * @param InLayerInterval Katmanlar arası süre (saniye)
+	 * @param InHorizon Son katmanın zamanı (saniye)
+	 */
+	void Initialize(float InCellSize, int32 InNumBuckets, float InLayerInterval, float InHorizon);
+
+	/** Öğeleri temizler (bellek korunur). */
+	void Reset();
+
+	int32 GetNumLayers() const { return Layers.Num(); }
+	int32 GetNumItems() const { return NumItems; }
+	float GetLayerInterval() const { return LayerInterval; }
+	float GetLayerTime(int32 Layer) const { return Layer * LayerInterval; }
+
+	/** Zamana en yakın katman (ufkun dışı son katmana sıkıştırılır). */
+	int32 GetLayerForTime(float Time) const;
+
+	/** Öğenin katmandaki tahmini (nullptr = öğe bu katmanda yok). */
+	const FTrafficOccupant* GetOccupant(int32 Layer, int32 ItemId) const
+	{
+		const FTrafficOccupant& Occupant = Occupants[Layer * NumItems + ItemId];
+		return Occupant.ItemId != INDEX_NONE ? &Occupant : nullptr;
+	}
+
+	/**
+	 * Izgarayı kurar. Predict(ItemIndex, TArrayView<FTrafficOccupant> Layers) her öğe için
+	 * bir kez (paralel) çağrılır ve öğenin tüm katmanlardaki kutusunu doldurur; false = öğe yok.
+	 * Predict paylaşılan durumu sadece okumalıdır.
+	 */
+	template<typename PredictFuncType>
+	void Build(int32 InNumItems, PredictFuncType&& Predict)
+	{
+		NumItems = InNumItems;
+		const int32 NumLayers = Layers.Num();
+		Occupants.SetNumUninitialized(NumLayers * NumItems, false);
+
+		// ParallelFor'un görev verisi motora ait, izlenmez; gövdeler izlenir
+		TRAFFIC_IGNORE_ALLOCATIONS();
+
+		// 1) Araç başına tahmin (katmanlar öğe için ardışık değil, katman içinde bitişik)
+		ParallelFor(NumItems, [this, NumLayers, &Predict](int32 ItemIndex)
+		{
+			TRAFFIC_TRACK_ALLOCATIONS();
+
+			FTrafficOccupant ItemLayers[MaxLayers];
+			const bool bValid = Predict(ItemIndex, TArrayView<FTrafficOccupant>(ItemLayers, NumLayers));
+			for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+			{
+				FTrafficOccupant& Occupant = Occupants[Layer * NumItems + ItemIndex];
+				Occupant = ItemLayers[Layer];
+				Occupant.ItemId = bValid ? ItemIndex : INDEX_NONE;
+			}
+		});
+
+		// En büyük kutu yarıçapı (sorgu yarıçapı için)
+		MaxExtent = 0.0f;
+		for (int32 ItemIndex = 0; ItemIndex < NumItems; ++ItemIndex)
+		{
+			const FTrafficOccupant& Occupant = Occupants[ItemIndex];
+			if (Occupant.ItemId != INDEX_NONE)
+			{
+				MaxExtent = FMath::Max(MaxExtent, FMath::Sqrt(FMath::Square(Occupant.HalfLength) + FMath::Square(Occupant.HalfWidth)));
+			}
+		}
+
+		// 2) Katman başına hash
+		ParallelFor(NumLayers, [this](int32 Layer)
+		{
+			TRAFFIC_TRACK_ALLOCATIONS();
+
+			FTrafficSpatialHash& Hash = Layers[Layer];
+			Hash.Reset();
+			const FTrafficOccupant* LayerOccupants = Occupants.GetData() + Layer * NumItems;
+			for (int32 ItemIndex = 0; ItemIndex < NumItems; ++ItemIndex)
+			{
+				if (LayerOccupants[ItemIndex].ItemId != INDEX_NONE)
+				{
+					Hash.Add(ItemIndex, LayerOccupants[ItemIndex].Location);
+				}
+			}
+			Hash.Build();
+		});
+	}
+
+	/**
+	 * Katmanda Box ile kesişen her öğe için Func(const FTrafficOccupant&) çağırır.
+	 * Box.ItemId dışlanır (sorgulayan aracın kendisi).
+	 */
+	template<typename FuncType>
+	void ForEachOverlap(int32 Layer, const FTrafficOccupant& Box, FuncType&& Func) const
+	{
+		if (!Layers.IsValidIndex(Layer))
+		{
+			return;
+		}
+
+		const FTrafficOccupant* LayerOccupants = Occupants.GetData() + Layer * NumItems;
+		const float Radius = FMath::Sqrt(FMath::Square(Box.HalfLength) + FMath::Square(Box.HalfWidth)) + MaxExtent;
+		Layers[Layer].ForEachInRadius(Box.Location, Radius, [&Box, LayerOccupants, &Func](int32 ItemIndex, const FVector&)
+		{
+			const FTrafficOccupant& Occupant = LayerOccupants[ItemIndex];
+			if (ItemIndex != Box.ItemId && FTrafficOccupant::Overlaps(Box, Occupant))
+			{
+				Func(Occupant);
+			}
+		});
+	}
+
+	/** En fazla katman sayısı (tahmin sırasında araç başına yığında tutulur). */
+	static constexpr int32 MaxLayers = 16;
+
+private:
+	/** Katman başına spatial hash (öğe = araç indeksi). */
+	TArray<FTrafficSpatialHash> Layers;
+
+	/** Tahminler: [katman * NumItems + öğe]. */
+	TArray<FTrafficOccupant> Occupants;
+
+	int32 NumItems = 0;
+	float LayerInterval = 0.5f;
+
+	/** Kurulan öğelerin en büyük kutu yarıçapı. */
+	float MaxExtent = 0.0f;
+};
@@ -0,0 +1,190 @@
+#include "TrafficOvertakePlanner.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	/** Yanal süre adayları (BaseLaneChangeDuration katları). */
+	constexpr float DurationScales[FTrafficOvertakePlanner::NumDurations] = { 1.0f, 1.5f, 2.0f, 3.0f };
+
+	/** Hız profili adayları (MaxAcceleration oranı). */
+	constexpr float AccelerationScales[FTrafficOvertakePlanner::NumSpeedProfiles] = { 0.0f, 0.5f, 1.0f };
+
+	/** Maliyet ağırlıkları. */
+	constexpr float ProgressWeight = 1.0f;
+	constexpr float LateralWeight = 0.3f;
+	constexpr float AccelerationWeight = 0.2f;
+	constexpr float ClearanceWeight = 1.0f;
+
+	/** Sağdan sollama ek maliyeti (soldan sollama tercih edilir). */
+	constexpr float RightSideCost = 0.25f;
+
+	constexpr int32 NumGroups = FTrafficOvertakePlanner::NumCandidates / 4;
+
+	FORCEINLINE int32 CandidateIndex(int32 Target, int32 Duration, int32 SpeedProfile)
+	{
+		return (Target * FTrafficOvertakePlanner::NumDurations + Duration) * FTrafficOvertakePlanner::NumSpeedProfiles + SpeedProfile;
+	}
+
+	/** Hız profilinin t anındaki katedilen mesafesi (MaxSpeed'e ulaşınca sabit hız). */
+	FORCEINLINE float ProfileDistance(float Speed, float Acceleration, float MaxSpeed, float Time)
+	{
+		if (Acceleration <= 0.0f || Speed >= MaxSpeed)
+		{
+			return Speed * Time;
+		}
+
+		const float TimeToMax = (MaxSpeed - Speed) / Acceleration;
+		if (Time <= TimeToMax)
+		{
+			return Speed * Time + 0.5f * Acceleration * Time * Time;
+		}
+		return Speed * TimeToMax + 0.5f * Acceleration * TimeToMax * TimeToMax + MaxSpeed * (Time - TimeToMax);
+	}
+}
+
+FTrafficOvertakePlan FTrafficOvertakePlanner::Plan(const FTrafficOvertakeRequest& Request, const FTrafficOvertakeObstacles& Obstacles, float Horizon, float LateralClearance)
+{
+	// Aday örnekleri SoA: [örnek][aday] (4'lü gruplar hizalı yüklenir)
+	alignas(16) float CandidateDistance[NumSamples][NumCandidates];
+	alignas(16) float CandidateOffset[NumSamples][NumCandidates];
+	alignas(16) float Penalty[NumCandidates];
+	int32 BlockedMasks[NumGroups];
+	float StaticCost[NumCandidates];
+	float SampleTimes[NumSamples];
+
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		SampleTimes[Sample] = Horizon * (float)(Sample + 1) / (float)NumSamples;
+	}
+
+	const float MaxSpeed = FMath::Max(Request.MaxSpeed, 1.0f);
+
+	// Kafesi kur: hedef x yanal süre x hız profili
+	for (int32 Target = 0; Target < NumTargets; ++Target)
+	{
+		const bool bValidTarget = Request.TargetLaneIds[Target] != INDEX_NONE;
+		const float TargetOffset = Request.TargetOffsets[Target];
+
+		for (int32 DurationIndex = 0; DurationIndex < NumDurations; ++DurationIndex)
+		{
+			const float Duration = FMath::Max(Request.BaseLaneChangeDuration * DurationScales[DurationIndex], KINDA_SMALL_NUMBER);
+
+			for (int32 SpeedIndex = 0; SpeedIndex < NumSpeedProfiles; ++SpeedIndex)
+			{
+				const int32 Candidate = CandidateIndex(Target, DurationIndex, SpeedIndex);
+				const float Acceleration = Request.MaxAcceleration * AccelerationScales[SpeedIndex];
+
+				for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+				{
+					const float Time = SampleTimes[Sample];
+					CandidateDistance[Sample][Candidate] = Request.Distance + ProfileDistance(Request.Speed, Acceleration, MaxSpeed, Time);
+					CandidateOffset[Sample][Candidate] = FMath::Lerp(Request.LaneOffset, TargetOffset, FTrafficOvertakeManeuver::LateralBlend(Time / Duration));
+				}
+
+				if (!bValidTarget)
+				{
+					StaticCost[Candidate] = MAX_flt;
+					continue;
+				}
+
+				// İlerleme (ufuk boyunca ortalama hız), yanal sertlik ve ivme
+				const float AverageSpeed = ProfileDistance(Request.Speed, Acceleration, MaxSpeed, Horizon) / Horizon;
+				float Cost = ProgressWeight * (MaxSpeed - AverageSpeed) / MaxSpeed
+					+ LateralWeight / DurationScales[DurationIndex]
+					+ AccelerationWeight * AccelerationScales[SpeedIndex];
+
+				if (!Request.bReturn && TargetOffset > Request.LaneOffset)
+				{
+					Cost += RightSideCost;
+				}
+
+				StaticCost[Candidate] = Cost;
+			}
+		}
+	}
+
+	// Toplu puanlama: her örnek ve araç için 4 aday birlikte
+	// Yanal olarak aynı şeritteyken boyuna mesafe HardGap'ten azsa çarpışma (aday elenir),
+	// SoftGap'ten azsa (zaman aralığı) mesafe açığı kadar ceza
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float LateralLimit = VectorSetFloat1(LateralClearance);
+
+	VectorRegister4Float PenaltyGroups[NumGroups];
+	VectorRegister4Float BlockedGroups[NumGroups];
+	for (int32 Group = 0; Group < NumGroups; ++Group)
+	{
+		PenaltyGroups[Group] = Zero;
+		BlockedGroups[Group] = Zero;
+	}
+
+	const float FollowingGap = Request.Speed * Request.TimeHeadway;
+
+	for (int32 Obstacle = 0; Obstacle < Obstacles.Num; ++Obstacle)
+	{
+		const float HardGap = 0.5f * (Request.VehicleLength + Obstacles.VehicleLength[Obstacle]) + Request.MinimumGap;
+		const VectorRegister4Float HardGapVector = VectorSetFloat1(HardGap);
+		const VectorRegister4Float SoftGapVector = VectorSetFloat1(HardGap + FollowingGap);
+		const VectorRegister4Float ObstacleOffset = VectorSetFloat1(Obstacles.LaneOffset[Obstacle]);
+
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			const VectorRegister4Float ObstacleDistance = VectorSetFloat1(Obstacles.Distance[Obstacle] + Obstacles.Speed[Obstacle] * SampleTimes[Sample]);
+
+			for (int32 Group = 0; Group < NumGroups; ++Group)
+			{
+				const VectorRegister4Float LongitudinalGap = VectorAbs(VectorSubtract(VectorLoadAligned(&CandidateDistance[Sample][Group * 4]), ObstacleDistance));
+				const VectorRegister4Float LateralGap = VectorAbs(VectorSubtract(VectorLoadAligned(&CandidateOffset[Sample][Group * 4]), ObstacleOffset));
+
+				const VectorRegister4Float SameLane = VectorCompareLT(LateralGap, LateralLimit);
+				const VectorRegister4Float Collision = VectorBitwiseAnd(SameLane, VectorCompareLT(LongitudinalGap, HardGapVector));
+				const VectorRegister4Float Intrusion = VectorMax(VectorSubtract(SoftGapVector, LongitudinalGap), Zero);
+
+				BlockedGroups[Group] = VectorBitwiseOr(BlockedGroups[Group], Collision);
+				PenaltyGroups[Group] = VectorAdd(PenaltyGroups[Group], VectorBitwiseAnd(SameLane, Intrusion));
+			}
+		}
+	}
+
+	for (int32 Group = 0; Group < NumGroups; ++Group)
+	{
+		VectorStoreAligned(PenaltyGroups[Group], &Penalty[Group * 4]);
+		BlockedMasks[Group] = VectorMaskBits(BlockedGroups[Group]);
+	}
+
+	// En iyi uygun aday (ceza araç boyu ve örnek sayısına göre normalize)
+	const float PenaltyScale = ClearanceWeight / (FMath::Max(Request.VehicleLength, 1.0f) * NumSamples);
+
+	FTrafficOvertakePlan Result;
+	float BestCost = MAX_flt;
+	for (int32 Candidate = 0; Candidate < NumCandidates; ++Candidate)
+	{
+		if (StaticCost[Candidate] == MAX_flt || (BlockedMasks[Candidate / 4] & (1 << (Candidate % 4))) != 0)
+		{
+			continue;
+		}
+
+		++Result.NumFeasible;
+
+		const float Cost = StaticCost[Candidate] + Penalty[Candidate] * PenaltyScale;
+		if (Cost < BestCost)
+		{
+			BestCost = Cost;
+			Result.Candidate = Candidate;
+		}
+	}
+
+	if (Result.Candidate != INDEX_NONE)
+	{
+		const int32 Target = Result.Candidate / (NumDurations * NumSpeedProfiles);
+		const int32 DurationIndex = (Result.Candidate / NumSpeedProfiles) % NumDurations;
+		const int32 SpeedIndex = Result.Candidate % NumSpeedProfiles;
+
+		Result.Maneuver.StartOffset = Request.LaneOffset;
+		Result.Maneuver.TargetOffset = Request.TargetOffsets[Target];
+		Result.Maneuver.Duration = FMath::Max(Request.BaseLaneChangeDuration * DurationScales[DurationIndex], KINDA_SMALL_NUMBER);
+		Result.Maneuver.StartSpeed = Request.Speed;
+		Result.Maneuver.Acceleration = Request.MaxAcceleration * AccelerationScales[SpeedIndex];
+	}
+
+	return Result;
+}
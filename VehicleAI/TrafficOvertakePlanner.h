@@ -0,0 +1,222 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AVehicleAIController;
+
+/**
+ * Sollama manevrası: yanal offset profili + hız profili.
+ * FTrafficOvertakePlanner'ın seçtiği adaydır; AVehicleAIController şerit offset'ini
+ * sabit LaneChangeSpeed yerine bu profile göre ilerletir.
+ */
+struct FTrafficOvertakeManeuver
+{
+	/** Manevra başındaki şerit offset'i (birim). */
+	float StartOffset = 0.0f;
+
+	/** Hedef şerit offset'i (birim). */
+	float TargetOffset = 0.0f;
+
+	/** Yanal geçiş süresi (saniye, 0 = manevra yok). */
+	float Duration = 0.0f;
+
+	/** Geçen süre (saniye). Yan sensör engel görürken ilerlemez. */
+	float Elapsed = 0.0f;
+
+	/** Manevra başındaki hız (cm/s). */
+	float StartSpeed = 0.0f;
+
+	/** Hız profili ivmesi (cm/s²). Manevra boyunca hedef hız StartSpeed + Acceleration * Elapsed ile sınırlanır. */
+	float Acceleration = 0.0f;
+
+	bool IsActive() const { return Duration > 0.0f; }
+
+	/** Profilin şu anki offset'i. */
+	float GetOffset() const
+	{
+		return FMath::Lerp(StartOffset, TargetOffset, LateralBlend(Elapsed / Duration));
+	}
+
+	/** Manevra boyunca izin verilen en yüksek hedef hız (cm/s). */
+	float GetSpeedLimit() const
+	{
+		return StartSpeed + Acceleration * Elapsed;
+	}
+
+	/** Yanal profil (quintic smoothstep: başta ve sonda yanal hız ve ivme sıfır). */
+	static FORCEINLINE float LateralBlend(float Alpha)
+	{
+		Alpha = FMath::Clamp(Alpha, 0.0f, 1.0f);
+		return Alpha * Alpha * Alpha * (Alpha * (Alpha * 6.0f - 15.0f) + 10.0f);
+	}
+};
+
+/**
+ * Planlama isteği. Oyun thread'inde controller'dan doldurulur, paralel planlamada sadece okunur.
+ * Mesafeler aracın şerit (spline) koordinatındadır: boyuna mesafe + yanal offset.
+ */
+struct FTrafficOvertakeRequest
+{
+	/** İsteyen controller (sonuç oyun thread'inde uygulanır). */
+	AVehicleAIController* Controller = nullptr;
+
+	/** Aracın şeridi. */
+	int32 LaneId = INDEX_NONE;
+
+	/** Aday hedef şeritler (sol, sağ; dönüşte sadece dönülecek şerit). INDEX_NONE = yok. */
+	int32 TargetLaneIds[2] = { INDEX_NONE, INDEX_NONE };
+
+	/** Hedef şeritlerin offset'leri (birim). */
+	float TargetOffsets[2] = { 0.0f, 0.0f };
+
+	/** true = sollama sonrası eski şeride dönüş (lider kontrolü yapılmaz). */
+	bool bReturn = false;
+
+	/** Dönüşte sollanan liderin kimliği (0 = bilinmiyor). Lider geride kalmadan dönüş planlanmaz. */
+	uint32 LeaderId = 0;
+
+	float Distance = 0.0f;
+	float Speed = 0.0f;
+	float LaneOffset = 0.0f;
+	float MaxSpeed = 0.0f;
+	float MaxAcceleration = 0.0f;
+	float VehicleLength = 0.0f;
+	float MinimumGap = 0.0f;
+	float TimeHeadway = 0.0f;
+
+	/** Sabit LaneChangeSpeed ile bir şerit geçişinin süresi (saniye). Yanal süre adayları bunun katlarıdır. */
+	float BaseLaneChangeDuration = 1.0f;
+
+	/** Lider bu hızın (MaxSpeed oranı) altındaysa sollanır. */
+	float OvertakeSpeedRatio = 0.0f;
+
+	/** Liderin en fazla uzaklığı (birim). */
+	float OvertakeLookahead = 0.0f;
+};
+
+/**
+ * Planlama sonucu.
+ */
+struct FTrafficOvertakePlan
+{
+	/** Seçilen aday (INDEX_NONE = sollamaya gerek yok veya uygun aday yok). */
+	int32 Candidate = INDEX_NONE;
+
+	/** Uygun aday sayısı. */
+	int32 NumFeasible = 0;
+
+	/** Sollanan liderin kimliği (sollamada; dönüş isteğine taşınır). */
+	uint32 LeaderId = 0;
+
+	FTrafficOvertakeManeuver Maneuver;
+};
+
+/**
+ * Tahmini doluluk: planlamada dikkate alınan araçlar (SoA).
+ * Her araç kendi şeridinde sabit hızla ilerler varsayılır (ufuk birkaç saniye).
+ *
+ * Kapasite dolunca Reference'a (isteyenin konumu) en uzak kayıt daha yakın araçla
+ * değiştirilir: ekleme sırasından bağımsız olarak en yakın MaxObstacles araç tutulur.
+ */
+struct FTrafficOvertakeObstacles
+{
+	static constexpr int32 MaxObstacles = 32;
+
+	int32 Num = 0;
+
+	/** Yakınlığın ölçüldüğü boyuna mesafe (isteyenin konumu). */
+	float Reference = 0.0f;
+
+	/** Kendi şeridinde öndeki en yakın araç (lider kontrolü için; MAX_flt = yok). */
+	float LeaderDistance = MAX_flt;
+	float LeaderSpeed = 0.0f;
+	uint32 LeaderId = 0;
+
+	uint32 Id[MaxObstacles];
+	float Distance[MaxObstacles];
+	float Speed[MaxObstacles];
+	float LaneOffset[MaxObstacles];
+	float VehicleLength[MaxObstacles];
+
+	bool IsFull() const { return Num >= MaxObstacles; }
+
+	bool HasLeader() const { return LeaderDistance < MAX_flt; }
+
+	void Add(uint32 InId, float InDistance, float InSpeed, float InLaneOffset, float InVehicleLength)
+	{
+		int32 Slot = Num;
+		if (IsFull())
+		{
+			// Dolu: sadece en uzak kayıttan yakınsa onun yerine geçer
+			if (FMath::Abs(InDistance - Reference) >= FMath::Abs(Distance[Farthest] - Reference))
+			{
+				return;
+			}
+			Slot = Farthest;
+		}
+		else
+		{
+			++Num;
+		}
+
+		Id[Slot] = InId;
+		Distance[Slot] = InDistance;
+		Speed[Slot] = InSpeed;
+		LaneOffset[Slot] = InLaneOffset;
+		VehicleLength[Slot] = InVehicleLength;
+
+		if (IsFull())
+		{
+			UpdateFarthest();
+		}
+	}
+
+private:
+	/** Dolu tamponda Reference'a en uzak kaydın indeksi. */
+	int32 Farthest = 0;
+
+	void UpdateFarthest()
+	{
+		Farthest = 0;
+		for (int32 Index = 1; Index < Num; ++Index)
+		{
+			if (FMath::Abs(Distance[Index] - Reference) > FMath::Abs(Distance[Farthest] - Reference))
+			{
+				Farthest = Index;
+			}
+		}
+	}
+};
+
+/**
+ * Sollama yörünge kafesi (lattice) planlayıcısı.
+ *
+ * Her istek için sabit bir aday kümesi üretilir: hedef şerit (sol / sağ) x yanal süre x
+ * hız profili. Adaylar ufuk boyunca NumSamples anda örneklenir ve yakındaki araçların
+ * tahmini konumlarıyla karşılaştırılır. Puanlama 4 adayı birlikte işleyen vektör
+ * komutlarıyla yapılır (VectorRegister4Float); tahsis yapmaz ve thread-safe'tir,
+ * UTrafficSubsystem istekleri ParallelFor ile toplu planlar.
+ *
+ * Uygun aday (hiçbir örnekte çarpışma boşluğuna girmeyen) yoksa plan boş döner.
+ */
+class YOURGAMENAME_API FTrafficOvertakePlanner
+{
+public:
+	static constexpr int32 NumTargets = 2;
+	static constexpr int32 NumDurations = 4;
+	static constexpr int32 NumSpeedProfiles = 3;
+	static constexpr int32 NumCandidates = NumTargets * NumDurations * NumSpeedProfiles;
+	static constexpr int32 NumSamples = 8;
+
+	static_assert(NumCandidates % 4 == 0, "Adaylar 4'lü vektör gruplarına bölünmeli");
+
+	/**
+	 * Adayları puanlar ve en iyi uygun adayı seçer.
+	 *
+	 * @param Request İstek
+	 * @param Obstacles Yakındaki araçlar (isteyen hariç)
+	 * @param Horizon Tahmin ufku (saniye)
+	 * @param LateralClearance Bu yanal mesafeden (birim) yakın araçlar aynı şeritte sayılır
+	 */
+	static FTrafficOvertakePlan Plan(const FTrafficOvertakeRequest& Request, const FTrafficOvertakeObstacles& Obstacles, float Horizon, float LateralClearance);
+};
@@ -0,0 +1,659 @@
+#include "TrafficPedestrianCrowd.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "TrafficAllocationTracker.h"
+#include "TrafficSpatialHash.h"
+
+namespace
+{
+	/** Dizilerden çıkan yayanın işareti (CompactLayout'ta atılır). */
+	constexpr uint16 DeadSidewalk = MAX_uint16;
+
+	FORCEINLINE int32 EncodeTransfer(int32 CrosswalkId, bool bExit, int32 Side)
+	{
+		return (CrosswalkId << 2) | (bExit ? 2 : 0) | Side;
+	}
+
+	/** Diziyi Destinations'a göre Scratch'e dağıtır ve takas eder (kapasite korunur). */
+	template<typename T>
+	void ScatterInto(TArray<T>& Array, TArray<T>& Scratch, const TArray<int32>& Destinations, int32 NewNum)
+	{
+		Scratch.SetNumUninitialized(NewNum, false);
+		for (int32 Index = 0; Index < Destinations.Num(); ++Index)
+		{
+			if (Destinations[Index] != INDEX_NONE)
+			{
+				Scratch[Destinations[Index]] = Array[Index];
+			}
+		}
+		Swap(Array, Scratch);
+	}
+
+	/** Diziyi Order sırasına göre yeniden düzenler (sadece yerleşim değişince). */
+	template<typename T>
+	void ApplyOrder(TArray<T>& Array, const TArray<int32>& Order)
+	{
+		TArray<T> Ordered;
+		Ordered.SetNumUninitialized(Order.Num());
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			Ordered[Index] = Array[Order[Index]];
+		}
+		Array = MoveTemp(Ordered);
+	}
+}
+
+void FTrafficPedestrianCrowd::Initialize(const FTrafficPedestrianSettings& InSettings, int32 Seed)
+{
+	Settings = InSettings;
+	Settings.SeparationRadius = FMath::Max(Settings.SeparationRadius, 1.0f);
+	Settings.MinChunkSize = FMath::Max(Settings.MinChunkSize, 1);
+	Settings.SlotsPerRow = FMath::Max(Settings.SlotsPerRow, 1);
+	Random.Initialize(Seed);
+}
+
+void FTrafficPedestrianCrowd::Reset()
+{
+	Sidewalks.Empty();
+	Crosswalks.Empty();
+	Ids.Empty();
+	SidewalkIds.Empty();
+	Distances.Empty();
+	LateralOffsets.Empty();
+	Speeds.Empty();
+	Directions.Empty();
+	WalkSpeeds.Empty();
+	PreferredOffsets.Empty();
+	Locations.Empty();
+	NextDistances.Empty();
+	NextLateralOffsets.Empty();
+	NextSpeeds.Empty();
+	NextDirections.Empty();
+	NextTransfers.Empty();
+	LayoutDestinations.Empty();
+	ScratchIds.Empty();
+	ScratchSidewalkIds.Empty();
+	ScratchLocations.Empty();
+	bLayoutDirty = false;
+	bTransfersPending = false;
+	NumWaitingTotal = 0;
+	StepCounter = 0;
+}
+
+int32 FTrafficPedestrianCrowd::AddSidewalk(TArray<FVector>&& InSamplePoints, float InSampleSpacing, float InLength, float InWidth, bool bInClosedLoop)
+{
+	// SidewalkIds 16-bit
+	if (InSamplePoints.Num() < 2 || InSampleSpacing <= 0.0f || Sidewalks.Num() >= MAX_uint16)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 SidewalkId = Sidewalks.AddDefaulted();
+	FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkId];
+	Sidewalk.SamplePoints = MoveTemp(InSamplePoints);
+	Sidewalk.SampleSpacing = InSampleSpacing;
+	Sidewalk.Length = InLength;
+	Sidewalk.HalfWidth = FMath::Max(InWidth * 0.5f, 0.0f);
+	Sidewalk.bClosedLoop = bInClosedLoop;
+	Sidewalk.FirstPedestrian = Ids.Num();
+
+	// Segment sağ yönleri bir kez hesaplanır - adımda normalize yok
+	const int32 NumSegments = Sidewalk.SamplePoints.Num() - 1;
+	Sidewalk.SegmentRights.SetNumUninitialized(NumSegments);
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const FVector2D Forward = FVector2D(Sidewalk.SamplePoints[Segment + 1] - Sidewalk.SamplePoints[Segment]).GetSafeNormal();
+		Sidewalk.SegmentRights[Segment] = FVector2D(-Forward.Y, Forward.X);
+	}
+
+	return SidewalkId;
+}
+
+uint32 FTrafficPedestrianCrowd::AddPedestrian(int32 SidewalkId, float Distance)
+{
+	if (!Sidewalks.IsValidIndex(SidewalkId))
+	{
+		return 0;
+	}
+
+	const FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkId];
+	const float ClampedDistance = FMath::Clamp(Distance, 0.0f, Sidewalk.Length);
+	const int8 Direction = Random.RandHelper(2) == 0 ? 1 : -1;
+	const float PreferredOffset = Random.FRandRange(Settings.MinPreferredOffset, Settings.MaxPreferredOffset) * Sidewalk.HalfWidth;
+	const float WalkSpeed = Random.FRandRange(Settings.MinWalkSpeed, Settings.MaxWalkSpeed);
+
+	const uint32 PedestrianId = NextPedestrianId++;
+	AppendPedestrian(PedestrianId, SidewalkId, ClampedDistance, PreferredOffset * Direction, WalkSpeed, Direction, WalkSpeed, PreferredOffset);
+
+	bLayoutDirty = true;
+	return PedestrianId;
+}
+
+void FTrafficPedestrianCrowd::AppendPedestrian(uint32 PedestrianId, int32 SidewalkId, float Distance, float LateralOffset, float Speed, int8 Direction, float WalkSpeed, float PreferredOffset)
+{
+	Ids.Add(PedestrianId);
+	SidewalkIds.Add((uint16)SidewalkId);
+	Distances.Add(Distance);
+	LateralOffsets.Add(LateralOffset);
+	Speeds.Add(Speed);
+	Directions.Add(Direction);
+	WalkSpeeds.Add(WalkSpeed);
+	PreferredOffsets.Add(PreferredOffset);
+	Locations.Add(GetSidewalkLocation(Sidewalks[SidewalkId], Distance, LateralOffset));
+}
+
+int32 FTrafficPedestrianCrowd::AddCrosswalk(int32 SidewalkA, float DistanceA, int32 SidewalkB, float DistanceB, float Width, int32 SlotsPerSide)
+{
+	if (!Sidewalks.IsValidIndex(SidewalkA) || !Sidewalks.IsValidIndex(SidewalkB) || SlotsPerSide <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	DistanceA = FMath::Clamp(DistanceA, 0.0f, Sidewalks[SidewalkA].Length);
+	DistanceB = FMath::Clamp(DistanceB, 0.0f, Sidewalks[SidewalkB].Length);
+
+	// Geçiş şeridi: iki kaldırımın orta çizgisi arasında düz çizgi
+	const FVector Start = GetSidewalkLocation(Sidewalks[SidewalkA], DistanceA, 0.0f);
+	const FVector End = GetSidewalkLocation(Sidewalks[SidewalkB], DistanceB, 0.0f);
+	const float Length = FVector::Dist(Start, End);
+	const float SampleSpacing = Sidewalks[SidewalkA].SampleSpacing;
+	const int32 NumSamples = FMath::Max(FMath::CeilToInt(Length / SampleSpacing), 1) + 1;
+
+	TArray<FVector> SamplePoints;
+	SamplePoints.Reserve(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		SamplePoints.Add(FMath::Lerp(Start, End, FMath::Min(SampleIndex * SampleSpacing / FMath::Max(Length, 1.0f), 1.0f)));
+	}
+
+	const int32 CrossingSidewalkId = AddSidewalk(MoveTemp(SamplePoints), SampleSpacing, Length, Width, false);
+	if (CrossingSidewalkId == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 CrosswalkId = Crosswalks.AddDefaulted();
+	FTrafficCrosswalk& Crosswalk = Crosswalks[CrosswalkId];
+	Crosswalk.CrossingSidewalkId = CrossingSidewalkId;
+	Crosswalk.SidewalkIds[0] = SidewalkA;
+	Crosswalk.SidewalkIds[1] = SidewalkB;
+	Crosswalk.SidewalkDistances[0] = DistanceA;
+	Crosswalk.SidewalkDistances[1] = DistanceB;
+	Crosswalk.SlotsPerSide = SlotsPerSide;
+	Crosswalk.Slots.SetNum(SlotsPerSide * 2);
+
+	Sidewalks[CrossingSidewalkId].CrosswalkId = CrosswalkId;
+
+	FTrafficSidewalkCrossing CrossingA;
+	CrossingA.Distance = DistanceA;
+	CrossingA.CrosswalkId = CrosswalkId;
+	CrossingA.Side = 0;
+	Sidewalks[SidewalkA].Crossings.Add(CrossingA);
+
+	FTrafficSidewalkCrossing CrossingB;
+	CrossingB.Distance = DistanceB;
+	CrossingB.CrosswalkId = CrosswalkId;
+	CrossingB.Side = 1;
+	Sidewalks[SidewalkB].Crossings.Add(CrossingB);
+
+	return CrosswalkId;
+}
+
+int32 FTrafficPedestrianCrowd::SetCrosswalkOpen(int32 CrosswalkId, bool bOpen)
+{
+	if (!Crosswalks.IsValidIndex(CrosswalkId))
+	{
+		return 0;
+	}
+
+	FTrafficCrosswalk& Crosswalk = Crosswalks[CrosswalkId];
+	Crosswalk.bOpen = bOpen;
+	if (!bOpen)
+	{
+		return 0;
+	}
+
+	// Toplu bırakma: her uçtaki bekleyenler geçiş şeridinin o ucundan karşıya yürür
+	const float CrossingLength = Sidewalks[Crosswalk.CrossingSidewalkId].Length;
+	int32 NumReleased = 0;
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		const int8 Direction = Side == 0 ? 1 : -1;
+		const float Distance = Side == 0 ? 0.0f : CrossingLength;
+
+		for (int32 SlotIndex = 0; SlotIndex < Crosswalk.NumWaiting[Side]; ++SlotIndex)
+		{
+			FTrafficWaitingPedestrian& Slot = Crosswalk.Slots[Side * Crosswalk.SlotsPerSide + SlotIndex];
+			AppendPedestrian(Slot.Id, Crosswalk.CrossingSidewalkId, Distance, Slot.PreferredOffset * Direction, 0.0f, Direction, Slot.WalkSpeed, Slot.PreferredOffset);
+			Slot.Id = 0;
+		}
+
+		NumReleased += Crosswalk.NumWaiting[Side];
+		Crosswalk.NumWaiting[Side] = 0;
+	}
+
+	if (NumReleased > 0)
+	{
+		NumWaitingTotal -= NumReleased;
+		bTransfersPending = true;
+	}
+	return NumReleased;
+}
+
+bool FTrafficPedestrianCrowd::WantsToCross(uint32 PedestrianId, int32 CrosswalkId) const
+{
+	const uint32 Hash = (PedestrianId * 2654435761u) ^ ((uint32)CrosswalkId * 40503u) ^ (StepCounter * 97u);
+	return (float)((Hash >> 8) & 0xFFFF) < Settings.CrossingChance * 65536.0f;
+}
+
+void FTrafficPedestrianCrowd::RebuildLayout()
+{
+	const int32 NumPedestrians = Ids.Num();
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumPedestrians);
+	for (int32 Index = 0; Index < NumPedestrians; ++Index)
+	{
+		Order[Index] = Index;
+	}
+
+	Algo::Sort(Order, [this](int32 A, int32 B)
+	{
+		return SidewalkIds[A] != SidewalkIds[B] ? SidewalkIds[A] < SidewalkIds[B] : Distances[A] < Distances[B];
+	});
+
+	ApplyOrder(Ids, Order);
+	ApplyOrder(SidewalkIds, Order);
+	ApplyOrder(Distances, Order);
+	ApplyOrder(LateralOffsets, Order);
+	ApplyOrder(Speeds, Order);
+	ApplyOrder(Directions, Order);
+	ApplyOrder(WalkSpeeds, Order);
+	ApplyOrder(PreferredOffsets, Order);
+	ApplyOrder(Locations, Order);
+
+	for (FTrafficSidewalk& Sidewalk : Sidewalks)
+	{
+		Sidewalk.NumPedestrians = 0;
+	}
+	for (const uint16 SidewalkId : SidewalkIds)
+	{
+		++Sidewalks[SidewalkId].NumPedestrians;
+	}
+
+	int32 FirstPedestrian = 0;
+	for (FTrafficSidewalk& Sidewalk : Sidewalks)
+	{
+		Sidewalk.FirstPedestrian = FirstPedestrian;
+		FirstPedestrian += Sidewalk.NumPedestrians;
+	}
+
+	bLayoutDirty = false;
+	bTransfersPending = false;
+}
+
+void FTrafficPedestrianCrowd::CompactLayout()
+{
+	const int32 NumEntries = Ids.Num();
+
+	for (FTrafficSidewalk& Sidewalk : Sidewalks)
+	{
+		Sidewalk.NumPedestrians = 0;
+	}
+	for (const uint16 SidewalkId : SidewalkIds)
+	{
+		if (SidewalkId != DeadSidewalk)
+		{
+			++Sidewalks[SidewalkId].NumPedestrians;
+		}
+	}
+
+	int32 NumAlive = 0;
+	for (FTrafficSidewalk& Sidewalk : Sidewalks)
+	{
+		Sidewalk.FirstPedestrian = NumAlive;
+		NumAlive += Sidewalk.NumPedestrians;
+		Sidewalk.NumPedestrians = 0;
+	}
+
+	// Kararlı counting sort: kaldırım içindeki sıra korunur, eklenenler kaldırımın sonuna düşer
+	LayoutDestinations.SetNumUninitialized(NumEntries, false);
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		const uint16 SidewalkId = SidewalkIds[Index];
+		if (SidewalkId == DeadSidewalk)
+		{
+			LayoutDestinations[Index] = INDEX_NONE;
+			continue;
+		}
+
+		FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkId];
+		LayoutDestinations[Index] = Sidewalk.FirstPedestrian + Sidewalk.NumPedestrians++;
+	}
+
+	// Adımın Next dizileri bu noktada boştur, aynı türden diziler için geçici olarak kullanılır
+	ScatterInto(Ids, ScratchIds, LayoutDestinations, NumAlive);
+	ScatterInto(SidewalkIds, ScratchSidewalkIds, LayoutDestinations, NumAlive);
+	ScatterInto(Distances, NextDistances, LayoutDestinations, NumAlive);
+	ScatterInto(LateralOffsets, NextDistances, LayoutDestinations, NumAlive);
+	ScatterInto(Speeds, NextDistances, LayoutDestinations, NumAlive);
+	ScatterInto(WalkSpeeds, NextDistances, LayoutDestinations, NumAlive);
+	ScatterInto(PreferredOffsets, NextDistances, LayoutDestinations, NumAlive);
+	ScatterInto(Directions, NextDirections, LayoutDestinations, NumAlive);
+	ScatterInto(Locations, ScratchLocations, LayoutDestinations, NumAlive);
+
+	for (const FTrafficSidewalk& Sidewalk : Sidewalks)
+	{
+		SortSidewalk(Sidewalk);
+	}
+
+	bTransfersPending = false;
+}
+
+void FTrafficPedestrianCrowd::ApplyTransfers()
+{
+	const int32 NumPedestrians = NextTransfers.Num();
+	bool bLayoutChanged = false;
+
+	for (int32 Index = 0; Index < NumPedestrians; ++Index)
+	{
+		const int32 Transfer = NextTransfers[Index];
+		if (Transfer == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FTrafficCrosswalk& Crosswalk = Crosswalks[Transfer >> 2];
+		const bool bExit = (Transfer & 2) != 0;
+		const int32 Side = Transfer & 1;
+
+		if (bExit)
+		{
+			// Karşı kaldırıma var: yön kimlikten seçilir
+			const int8 Direction = ((Ids[Index] * 2654435761u) >> 16) & 1 ? 1 : -1;
+			AppendPedestrian(Ids[Index], Crosswalk.SidewalkIds[Side], Crosswalk.SidewalkDistances[Side], PreferredOffsets[Index] * Direction,
+				Speeds[Index], Direction, WalkSpeeds[Index], PreferredOffsets[Index]);
+		}
+		else if (Crosswalk.bOpen)
+		{
+			// Yaya yeşili: beklemeden geçiş şeridine gir
+			const int8 Direction = Side == 0 ? 1 : -1;
+			const float Distance = Side == 0 ? 0.0f : Sidewalks[Crosswalk.CrossingSidewalkId].Length;
+			AppendPedestrian(Ids[Index], Crosswalk.CrossingSidewalkId, Distance, PreferredOffsets[Index] * Direction,
+				Speeds[Index], Direction, WalkSpeeds[Index], PreferredOffsets[Index]);
+		}
+		else if (Crosswalk.NumWaiting[Side] < Crosswalk.SlotsPerSide)
+		{
+			// Yuva al: bağlantı noktasının gerisinde satırlar halinde, kaldırım genişliğine yayılmış ızgara
+			const int32 SlotIndex = Crosswalk.NumWaiting[Side]++;
+			const FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkIds[Index]];
+			const int32 Row = SlotIndex / Settings.SlotsPerRow;
+			const int32 Column = SlotIndex % Settings.SlotsPerRow;
+			const float SlotDistance = FMath::Clamp(Distances[Index] - Directions[Index] * Row * Settings.SlotRowSpacing, 0.0f, Sidewalk.Length);
+			const float SlotOffset = Sidewalk.HalfWidth * ((2.0f * Column + 1.0f) / Settings.SlotsPerRow - 1.0f);
+
+			FTrafficWaitingPedestrian& Slot = Crosswalk.Slots[Side * Crosswalk.SlotsPerSide + SlotIndex];
+			Slot.Id = Ids[Index];
+			Slot.WalkSpeed = WalkSpeeds[Index];
+			Slot.PreferredOffset = PreferredOffsets[Index];
+			Slot.Location = GetSidewalkLocation(Sidewalk, SlotDistance, SlotOffset);
+			++NumWaitingTotal;
+		}
+		else
+		{
+			// Yuva yok: yürümeye devam
+			continue;
+		}
+
+		SidewalkIds[Index] = DeadSidewalk;
+		bLayoutChanged = true;
+	}
+
+	if (bLayoutChanged)
+	{
+		CompactLayout();
+	}
+}
+
+void FTrafficPedestrianCrowd::Step(float DeltaTime, int32 MaxTasks)
+{
+	if (bLayoutDirty)
+	{
+		// Yerleşim sadece yaya eklenince değişir, kararlı durum değildir
+		TRAFFIC_IGNORE_ALLOCATIONS();
+		RebuildLayout();
+	}
+	else if (bTransfersPending)
+	{
+		CompactLayout();
+	}
+
+	++StepCounter;
+
+	const int32 NumPedestrians = Ids.Num();
+	if (NumPedestrians == 0 || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	NextDistances.SetNumUninitialized(NumPedestrians, false);
+	NextLateralOffsets.SetNumUninitialized(NumPedestrians, false);
+	NextSpeeds.SetNumUninitialized(NumPedestrians, false);
+	NextDirections.SetNumUninitialized(NumPedestrians, false);
+	NextTransfers.SetNumUninitialized(NumPedestrians, false);
+
+	const int32 NumChunks = FMath::Clamp(FMath::DivideAndRoundUp(NumPedestrians, Settings.MinChunkSize), 1, FMath::Max(MaxTasks, 1));
+	const EParallelForFlags Flags = NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None;
+
+	// ParallelFor'un görev verisi motora ait, izlenmez; parça gövdeleri izlenir
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	// 1) Parçalar önceki adımı okur, sonraki adıma yazar
+	ParallelFor(NumChunks, [this, NumPedestrians, NumChunks, DeltaTime](int32 Chunk)
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		const int32 Begin = (int32)((int64)NumPedestrians * Chunk / NumChunks);
+		const int32 End = (int32)((int64)NumPedestrians * (Chunk + 1) / NumChunks);
+		IntegrateRange(Begin, End, DeltaTime);
+	}, Flags);
+
+	Swap(Distances, NextDistances);
+	Swap(LateralOffsets, NextLateralOffsets);
+	Swap(Speeds, NextSpeeds);
+	Swap(Directions, NextDirections);
+
+	// Geçit olayları nadir ve yerleşimi değiştirir - seri
+	if (Crosswalks.Num() > 0)
+	{
+		ApplyTransfers();
+	}
+
+	// 2) Kaldırımlar birbirinden bağımsız sıralanır (aynı görev sınırı ile)
+	const int32 NumSidewalks = Sidewalks.Num();
+	const int32 NumSortTasks = FMath::Min(NumChunks, NumSidewalks);
+	ParallelFor(NumSortTasks, [this, NumSidewalks, NumSortTasks](int32 Task)
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		const int32 Begin = (int32)((int64)NumSidewalks * Task / NumSortTasks);
+		const int32 End = (int32)((int64)NumSidewalks * (Task + 1) / NumSortTasks);
+		for (int32 SidewalkId = Begin; SidewalkId < End; ++SidewalkId)
+		{
+			SortSidewalk(Sidewalks[SidewalkId]);
+		}
+	}, Flags);
+}
+
+void FTrafficPedestrianCrowd::IntegrateRange(int32 Begin, int32 End, float DeltaTime)
+{
+	const float Radius = Settings.SeparationRadius;
+	const float RadiusSquared = Radius * Radius;
+	const float InvRadiusSquared = 1.0f / RadiusSquared;
+	const float HalfRadius = Radius * 0.5f;
+	const float SpeedBlend = FMath::Min(Settings.SpeedResponse * DeltaTime, 1.0f);
+	const float MaxLateralStep = Settings.LateralSpeed * DeltaTime;
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		const FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkIds[Index]];
+		const float Distance = Distances[Index];
+		const float Offset = LateralOffsets[Index];
+		const int8 Direction = Directions[Index];
+
+		float TargetSpeed = WalkSpeeds[Index];
+		float Push = 0.0f;
+
+		auto Separate = [&](int32 Other)
+		{
+			const float Longitudinal = Distances[Other] - Distance;
+			const float Lateral = LateralOffsets[Other] - Offset;
+			const float DistSquared = Longitudinal * Longitudinal + Lateral * Lateral;
+			if (DistSquared >= RadiusSquared)
+			{
+				return;
+			}
+
+			// Komşudan uzağa yanal itiş (tam hizadaysa simetri indeks sırası ile kırılır)
+			const float Overlap = 1.0f - DistSquared * InvRadiusSquared;
+			const bool bOtherOnRight = Lateral > 0.0f || (Lateral == 0.0f && Other > Index);
+			Push += bOtherOnRight ? -Overlap : Overlap;
+
+			// Aynı yönde, önde ve hizadaki yaya geçilemez; yanal itiş yana açılınca sınır kalkar
+			if (Directions[Other] == Direction && Longitudinal * Direction > 0.0f && FMath::Abs(Lateral) < HalfRadius)
+			{
+				TargetSpeed = FMath::Min(TargetSpeed, Speeds[Other]);
+			}
+		};
+
+		// Komşular dizide bitişik: aynı kaldırımda mesafe farkı Radius'tan küçük olanlar
+		const int32 SidewalkEnd = Sidewalk.FirstPedestrian + Sidewalk.NumPedestrians;
+		for (int32 Other = Index + 1; Other < SidewalkEnd && Distances[Other] - Distance < Radius; ++Other)
+		{
+			Separate(Other);
+		}
+		for (int32 Other = Index - 1; Other >= Sidewalk.FirstPedestrian && Distance - Distances[Other] < Radius; --Other)
+		{
+			Separate(Other);
+		}
+
+		const float Speed = Speeds[Index] + (TargetSpeed - Speeds[Index]) * SpeedBlend;
+
+		const float DesiredOffset = PreferredOffsets[Index] * Direction + Push * Settings.SeparationStrength;
+		const float NewOffset = FMath::Clamp(Offset + FMath::Clamp(DesiredOffset - Offset, -MaxLateralStep, MaxLateralStep), -Sidewalk.HalfWidth, Sidewalk.HalfWidth);
+
+		float NewDistance = Distance + Direction * Speed * DeltaTime;
+		int8 NewDirection = Direction;
+		int32 Transfer = INDEX_NONE;
+
+		// Geçit bağlantısından geçen ve karşıya geçmek isteyen yaya bağlantı noktasında durur
+		for (const FTrafficSidewalkCrossing& Crossing : Sidewalk.Crossings)
+		{
+			const bool bPassed = Direction > 0
+				? Distance < Crossing.Distance && NewDistance >= Crossing.Distance
+				: Distance > Crossing.Distance && NewDistance <= Crossing.Distance;
+			if (bPassed && WantsToCross(Ids[Index], Crossing.CrosswalkId))
+			{
+				Transfer = EncodeTransfer(Crossing.CrosswalkId, false, Crossing.Side);
+				NewDistance = Crossing.Distance;
+				break;
+			}
+		}
+
+		// Bağlantıda duran yaya aşağıdaki koşullara girmez (mesafe kaldırım içinde)
+		if (Sidewalk.CrosswalkId != INDEX_NONE && (Direction > 0 ? NewDistance >= Sidewalk.Length : NewDistance <= 0.0f))
+		{
+			// Geçiş şeridinin sonu: karşı kaldırıma geç
+			Transfer = EncodeTransfer(Sidewalk.CrosswalkId, true, Direction > 0 ? 1 : 0);
+		}
+		else if (Sidewalk.bClosedLoop)
+		{
+			if (NewDistance >= Sidewalk.Length)
+			{
+				NewDistance -= Sidewalk.Length;
+			}
+			else if (NewDistance < 0.0f)
+			{
+				NewDistance += Sidewalk.Length;
+			}
+		}
+		else if (NewDistance > Sidewalk.Length)
+		{
+			// Kaldırım sonunda geri dön
+			NewDistance = 2.0f * Sidewalk.Length - NewDistance;
+			NewDirection = -1;
+		}
+		else if (NewDistance < 0.0f)
+		{
+			NewDistance = -NewDistance;
+			NewDirection = 1;
+		}
+		NewDistance = FMath::Clamp(NewDistance, 0.0f, Sidewalk.Length);
+
+		NextDistances[Index] = NewDistance;
+		NextLateralOffsets[Index] = NewOffset;
+		NextSpeeds[Index] = Speed;
+		NextDirections[Index] = NewDirection;
+		NextTransfers[Index] = Transfer;
+		Locations[Index] = GetSidewalkLocation(Sidewalk, NewDistance, NewOffset);
+	}
+}
+
+void FTrafficPedestrianCrowd::SortSidewalk(const FTrafficSidewalk& Sidewalk)
+{
+	// Insertion sort - neredeyse sıralı dizide O(n); döngü başına saran yaya tek geçişte taşınır
+	const int32 Begin = Sidewalk.FirstPedestrian;
+	const int32 End = Begin + Sidewalk.NumPedestrians;
+	for (int32 Index = Begin + 1; Index < End; ++Index)
+	{
+		for (int32 Current = Index; Current > Begin && Distances[Current - 1] > Distances[Current]; --Current)
+		{
+			SwapPedestrians(Current - 1, Current);
+		}
+	}
+}
+
+void FTrafficPedestrianCrowd::SwapPedestrians(int32 A, int32 B)
+{
+	// SidewalkIds aynı kaldırımda eşit, takas gerekmez
+	Swap(Ids[A], Ids[B]);
+	Swap(Distances[A], Distances[B]);
+	Swap(LateralOffsets[A], LateralOffsets[B]);
+	Swap(Speeds[A], Speeds[B]);
+	Swap(Directions[A], Directions[B]);
+	Swap(WalkSpeeds[A], WalkSpeeds[B]);
+	Swap(PreferredOffsets[A], PreferredOffsets[B]);
+	Swap(Locations[A], Locations[B]);
+}
+
+void FTrafficPedestrianCrowd::AddToSpatialHash(FTrafficSpatialHash& SpatialHash) const
+{
+	for (int32 Index = 0; Index < Locations.Num(); ++Index)
+	{
+		SpatialHash.Add(ToItemId(Index), Locations[Index]);
+	}
+}
+
+bool FTrafficPedestrianCrowd::GetPedestrianTransform(int32 PedestrianIndex, FVector& OutLocation, FRotator& OutRotation) const
+{
+	if (!Ids.IsValidIndex(PedestrianIndex))
+	{
+		return false;
+	}
+
+	const FTrafficSidewalk& Sidewalk = Sidewalks[SidewalkIds[PedestrianIndex]];
+	const int32 Segment = FMath::Clamp(FMath::FloorToInt(Distances[PedestrianIndex] / Sidewalk.SampleSpacing), 0, Sidewalk.SamplePoints.Num() - 2);
+
+	OutLocation = Locations[PedestrianIndex];
+	OutRotation = ((Sidewalk.SamplePoints[Segment + 1] - Sidewalk.SamplePoints[Segment]) * Directions[PedestrianIndex]).Rotation();
+	return true;
+}
+
+FVector FTrafficPedestrianCrowd::GetSidewalkLocation(const FTrafficSidewalk& Sidewalk, float Distance, float LateralOffset)
+{
+	const float SamplePosition = Distance / Sidewalk.SampleSpacing;
+	const int32 Segment = FMath::Clamp(FMath::FloorToInt(SamplePosition), 0, Sidewalk.SamplePoints.Num() - 2);
+	const FVector Center = FMath::Lerp(Sidewalk.SamplePoints[Segment], Sidewalk.SamplePoints[Segment + 1], FMath::Clamp(SamplePosition - Segment, 0.0f, 1.0f));
+	const FVector2D& Right = Sidewalk.SegmentRights[Segment];
+	return Center + FVector(Right.X, Right.Y, 0.0f) * LateralOffset;
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+class FTrafficSpatialHash;
+
+/**
+ * Kaldırımın bir yaya geçidine bağlandığı nokta.
+ */
+struct FTrafficSidewalkCrossing
+{
+	/** Bağlantının kaldırım üzerindeki mesafesi (birim). */
+	float Distance = 0.0f;
+
+	int32 CrosswalkId = INDEX_NONE;
+
+	/** Geçidin bu kaldırımdaki ucu (0 = geçiş şeridinin başı, 1 = sonu). */
+	uint8 Side = 0;
+};
+
+/**
+ * Kaldırım şeridi.
+ * Yayalar kaldırımın orta çizgisine göre boyuna mesafe + yanal offset ile tutulur;
+ * dünya konumu örnek noktaları arasında doğrusal aradeğerleme ile bulunur (spline sorgusu yok).
+ */
+struct FTrafficSidewalk
+{
+	/** Orta çizgi boyunca SampleSpacing aralıklı dünya konumları. */
+	TArray<FVector> SamplePoints;
+
+	/** Örnek segmentlerinin yatay sağ yönü (SamplePoints.Num() - 1 eleman). */
+	TArray<FVector2D> SegmentRights;
+
+	float SampleSpacing = 1000.0f;
+
+	/** Kaldırım uzunluğu (birim). */
+	float Length = 0.0f;
+
+	/** Yarı genişlik (birim). Yanal offset [-HalfWidth, HalfWidth] aralığındadır. */
+	float HalfWidth = 150.0f;
+
+	/** Kapalı döngü mü (yayalar sonda başa sarar, değilse geri döner). */
+	bool bClosedLoop = false;
+
+	/** Bu kaldırım bir geçidin yolu kesen şeridiyse geçit ID'si (uca varan yaya karşı kaldırıma geçer). */
+	int32 CrosswalkId = INDEX_NONE;
+
+	/** Kaldırımdan çıkan geçitler (az sayıda, sırasız). */
+	TArray<FTrafficSidewalkCrossing> Crossings;
+
+	/** Kaldırımdaki yayaların dizilerdeki aralığı [FirstPedestrian, FirstPedestrian + NumPedestrians). */
+	int32 FirstPedestrian = 0;
+	int32 NumPedestrians = 0;
+};
+
+/**
+ * Geçitte bekleme yuvasındaki yaya.
+ * Bekleyen yaya aktif dizilerden çıkarılır; ışık değişene kadar hiçbir adımda işlenmez.
+ */
+struct FTrafficWaitingPedestrian
+{
+	/** Kalıcı yaya kimliği (0 = boş yuva). */
+	uint32 Id = 0;
+
+	float WalkSpeed = 0.0f;
+	float PreferredOffset = 0.0f;
+
+	/** Yuvanın dünya konumu (kaldırımda, geçidin başında ızgara). */
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Yaya geçidi: iki kaldırımı yolun karşısından bağlayan geçiş şeridi.
+ * Geçit kapalıyken bağlantı noktasına varan ve geçmek isteyen yaya o uçtaki sabit
+ * yuvalardan birini alır; geçit açılınca (SetCrosswalkOpen) tüm bekleyenler tek seferde
+ * geçiş şeridine bırakılır ve yuvalar boşalır. Yuva kalmadıysa yaya yürümeye devam eder.
+ */
+struct FTrafficCrosswalk
+{
+	/** Yolu kesen geçiş şeridi (kaldırım ID'si, açık uçlu). */
+	int32 CrossingSidewalkId = INDEX_NONE;
+
+	/** Uçlardaki kaldırımlar ve bağlantı mesafeleri (0 = geçiş şeridinin başı). */
+	int32 SidewalkIds[2] = { INDEX_NONE, INDEX_NONE };
+	float SidewalkDistances[2] = { 0.0f, 0.0f };
+
+	/** Yayalar geçebilir (yaya yeşili). */
+	bool bOpen = false;
+
+	/** Uç başına yuva sayısı. */
+	int32 SlotsPerSide = 0;
+
+	/** Yuvalar: [uç * SlotsPerSide + i]; her uçta dolu yuvalar baştan bitişiktir. */
+	TArray<FTrafficWaitingPedestrian> Slots;
+
+	/** Uç başına bekleyen yaya sayısı. */
+	int32 NumWaiting[2] = { 0, 0 };
+};
+
+/**
+ * Yaya kalabalığı ayarları.
+ */
+struct FTrafficPedestrianSettings
+{
+	/** Bu mesafeden (birim) yakın yayalar birbirini iter. */
+	float SeparationRadius = 80.0f;
+
+	/** Ayrılma itişinin yanal hedefe etkisi (birim, tam çakışmada). */
+	float SeparationStrength = 60.0f;
+
+	/** Yanal hareket hızı (cm/s). */
+	float LateralSpeed = 60.0f;
+
+	/** Hızın hedef hıza yaklaşma oranı (1/s). */
+	float SpeedResponse = 2.0f;
+
+	/** Yürüme hızı aralığı (cm/s). Her yayaya eklenirken rastgele atanır. */
+	float MinWalkSpeed = 100.0f;
+	float MaxWalkSpeed = 160.0f;
+
+	/**
+	 * Yürüme yönüne göre tercih edilen yanal offset aralığı (HalfWidth oranı).
+	 * Yayalar sağda yürümeye eğilimlidir; rastgele offset tek sıra (conga) yürümeyi önler.
+	 */
+	float MinPreferredOffset = -0.3f;
+	float MaxPreferredOffset = 0.8f;
+
+	/** Bir geçit bağlantısından geçen yayanın karşıya geçme olasılığı. */
+	float CrossingChance = 0.5f;
+
+	/** Bekleme yuvası ızgarasının satır aralığı (birim) ve satır başına yuva. */
+	float SlotRowSpacing = 60.0f;
+	int32 SlotsPerRow = 4;
+
+	/** Bir paralel görevin en az yaya sayısı (küçük kalabalıkta görev dağıtma maliyeti kazançtan büyük). */
+	int32 MinChunkSize = 512;
+};
+
+/**
+ * Kaldırım şeritlerinde veri yönelimli yaya kalabalığı.
+ *
+ * Durum yapıların dizisi değil, alan başına dizilerde (SoA) tutulur: kaldırım ID'si,
+ * mesafe, yanal offset, hız. Diziler kaldırıma göre gruplu ve kaldırım içinde mesafeye
+ * göre sıralıdır; bu yüzden yerel ayrılma (separation) için ayrı bir spatial yapı gerekmez,
+ * bir yayanın komşuları dizide hemen önündeki ve arkasındaki yayalardır.
+ *
+ * Adım sabit boyutlu parçalar (chunk) halinde paralel çalışır. Parçalar önceki adımın
+ * dizilerini okuyup sonraki adımın dizilerine yazar (çift tampon), böylece parça sınırındaki
+ * komşular yarışsız okunur. Yayaların fizik bileşeni yoktur: dünya konumları araçların
+ * spatial hash'ine (AddToSpatialHash) eklenir ve araç tarafı sorguları aynı broadphase'i kullanır.
+ *
+ * Geçitte bekleyen yayalar dizilerden çıkarılıp geçidin yuvalarında tutulur; geçit açılana
+ * kadar hiçbir adımda işlenmezler.
+ *
+ * Kararlı durumda adım heap tahsisi yapmaz. Sadece oyun thread'inden çağrılır.
+ */
+class YOURGAMENAME_API FTrafficPedestrianCrowd
+{
+public:
+	/** Rastgele yürüme hızı, offset ve yön için tohum. */
+	void Initialize(const FTrafficPedestrianSettings& InSettings, int32 Seed);
+
+	/** Tüm kaldırımları ve yayaları siler. */
+	void Reset();
+
+	/**
+	 * Kaldırım ekler.
+	 *
+	 * @param InSamplePoints Orta çizgi boyunca InSampleSpacing aralıklı dünya konumları (en az 2)
+	 * @param InLength Kaldırım uzunluğu (birim)
+	 * @param InWidth Kaldırım genişliği (birim)
+	 * @return Kaldırım ID'si (INDEX_NONE = geçersiz)
+	 */
+	int32 AddSidewalk(TArray<FVector>&& InSamplePoints, float InSampleSpacing, float InLength, float InWidth, bool bInClosedLoop);
+
+	/**
+	 * Kaldırıma yaya ekler. Yürüme hızı, tercih edilen offset ve yön rastgele atanır.
+	 * Diziler bir sonraki adımın başında yeniden gruplanır.
+	 *
+	 * @return Kalıcı yaya kimliği (0 = eklenemedi)
+	 */
+	uint32 AddPedestrian(int32 SidewalkId, float Distance);
+
+	/**
+	 * İki kaldırım noktası arasında yaya geçidi ekler (aradaki düz çizgi geçiş şeridi olur).
+	 *
+	 * @param SlotsPerSide Uç başına bekleme yuvası
+	 * @return Geçit ID'si (INDEX_NONE = geçersiz kaldırım)
+	 */
+	int32 AddCrosswalk(int32 SidewalkA, float DistanceA, int32 SidewalkB, float DistanceB, float Width, int32 SlotsPerSide);
+
+	/**
+	 * Geçidi açar veya kapatır. Açılışta iki uçtaki tüm bekleyenler tek seferde geçiş şeridine
+	 * eklenir (diziler bir sonraki adımın başında yerleşir).
+	 *
+	 * @return Bırakılan yaya sayısı
+	 */
+	int32 SetCrosswalkOpen(int32 CrosswalkId, bool bOpen);
+
+	const FTrafficCrosswalk* GetCrosswalk(int32 CrosswalkId) const { return Crosswalks.IsValidIndex(CrosswalkId) ? &Crosswalks[CrosswalkId] : nullptr; }
+	int32 GetNumCrosswalks() const { return Crosswalks.Num(); }
+
+	/** Tüm geçitlerde bekleyen yaya sayısı (aktif dizilerde değiller, Num()'a dahil değil). */
+	int32 GetNumWaiting() const { return NumWaitingTotal; }
+
+	/**
+	 * Kalabalığı bir adım ilerletir.
+	 *
+	 * @param MaxTasks Paralel görev sayısı sınırı (1 = tek çekirdek, ölçüm için)
+	 */
+	void Step(float DeltaTime, int32 MaxTasks = MAX_int32);
+
+	/** Yayaların konumlarını spatial hash'e ekler (öğe = ToItemId(yaya indeksi)). Build çağıranındır. */
+	void AddToSpatialHash(FTrafficSpatialHash& SpatialHash) const;
+
+	int32 Num() const { return Ids.Num(); }
+	int32 GetNumSidewalks() const { return Sidewalks.Num(); }
+	const FTrafficSidewalk* GetSidewalk(int32 SidewalkId) const { return Sidewalks.IsValidIndex(SidewalkId) ? &Sidewalks[SidewalkId] : nullptr; }
+
+	/** Yaya indeksleri her adımda değişebilir (sıralama); kalıcı kimlik için GetIds. */
+	TConstArrayView<uint32> GetIds() const { return Ids; }
+	TConstArrayView<FVector> GetLocations() const { return Locations; }
+
+	/** Yayanın dünya konumu ve yürüme yönü. */
+	bool GetPedestrianTransform(int32 PedestrianIndex, FVector& OutLocation, FRotator& OutRotation) const;
+
+	/** Yayalar spatial hash'te negatif öğe kimliği ile tutulur (araçlar kayıt indeksi ile). */
+	static FORCEINLINE int32 ToItemId(int32 PedestrianIndex) { return -(PedestrianIndex + 1); }
+	static FORCEINLINE bool IsPedestrianItem(int32 ItemId) { return ItemId < 0; }
+	static FORCEINLINE int32 ToPedestrianIndex(int32 ItemId) { return -ItemId - 1; }
+
+private:
+	/** Eklenen yayaları kaldırımlara göre gruplar ve mesafeye göre sıralar. */
+	void RebuildLayout();
+
+	/**
+	 * Kaldırım değiştiren yayalardan sonra yerleşimi düzeltir: çıkanlar (DeadSidewalk) atılır,
+	 * dizilere eklenenler kaldırımlarının sonuna taşınıp yerine sıralanır. Tahsis yok, O(n).
+	 */
+	void CompactLayout();
+
+	/** Adımda geçit bağlantısına veya geçiş şeridi sonuna varan yayaları işler. */
+	void ApplyTransfers();
+
+	/** Dizilerin sonuna yaya ekler (yerleşim CompactLayout veya RebuildLayout ile düzelir). */
+	void AppendPedestrian(uint32 PedestrianId, int32 SidewalkId, float Distance, float LateralOffset, float Speed, int8 Direction, float WalkSpeed, float PreferredOffset);
+
+	/** Yaya bu bağlantıdan karşıya geçmek istiyor mu (kimlik, geçit ve adımdan türetilen deterministik seçim). */
+	bool WantsToCross(uint32 PedestrianId, int32 CrosswalkId) const;
+
+	/** Parçadaki yayaların hız, mesafe ve offset'ini hesaplar (Current -> Next). */
+	void IntegrateRange(int32 Begin, int32 End, float DeltaTime);
+
+	/** Kaldırımın aralığını mesafeye göre sıralar (kareler arası sıra neredeyse hiç değişmez). */
+	void SortSidewalk(const FTrafficSidewalk& Sidewalk);
+
+	/** Dizilerde iki komşu yayayı yer değiştirir. */
+	void SwapPedestrians(int32 A, int32 B);
+
+	/** Kaldırım koordinatından dünya konumu. */
+	static FVector GetSidewalkLocation(const FTrafficSidewalk& Sidewalk, float Distance, float LateralOffset);
+
+	FTrafficPedestrianSettings Settings;
+	FRandomStream Random;
+
+	TArray<FTrafficSidewalk> Sidewalks;
+	TArray<FTrafficCrosswalk> Crosswalks;
+
+	// Yaya durumu (SoA, kaldırıma göre gruplu, kaldırım içinde mesafeye göre artan)
+	TArray<uint32> Ids;
+	TArray<uint16> SidewalkIds;
+	TArray<float> Distances;
+	TArray<float> LateralOffsets;
+	TArray<float> Speeds;
+
+	/** Yürüme yönü: +1 = mesafe artar, -1 = azalır. */
+	TArray<int8> Directions;
+
+	/** Hedef yürüme hızı (cm/s). */
+	TArray<float> WalkSpeeds;
+
+	/** Yürüme yönüne göre tercih edilen offset (birim; dünya offset'i = PreferredOffset * Direction). */
+	TArray<float> PreferredOffsets;
+
+	/** Adım sonundaki dünya konumları. */
+	TArray<FVector> Locations;
+
+	// Çift tampon: adım bu dizilere yazar, sonra takas edilir
+	TArray<float> NextDistances;
+	TArray<float> NextLateralOffsets;
+	TArray<float> NextSpeeds;
+	TArray<int8> NextDirections;
+
+	/** Adımda geçit olayı: (CrosswalkId << 2) | (çıkış << 1) | uç, INDEX_NONE = yok. */
+	TArray<int32> NextTransfers;
+
+	// CompactLayout'un yeniden kullanılan geçici dizileri
+	TArray<int32> LayoutDestinations;
+	TArray<uint32> ScratchIds;
+	TArray<uint16> ScratchSidewalkIds;
+	TArray<FVector> ScratchLocations;
+
+	/** Bir sonraki adımda gruplanacak yeni yayalar var. */
+	bool bLayoutDirty = false;
+
+	/** Geçitten bırakılan yayalar dizilerin sonunda, yerleşim bekliyor. */
+	bool bTransfersPending = false;
+
+	int32 NumWaitingTotal = 0;
+	uint32 StepCounter = 0;
+
+	uint32 NextPedestrianId = 1;
+};
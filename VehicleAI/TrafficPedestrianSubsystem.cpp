@@ -0,0 +1,369 @@
+#include "TrafficPedestrianSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "TrafficAllocationTracker.h"
+#include "TrafficLight.h"
+#include "TrafficSpatialHash.h"
+#include "TrafficSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Traffic Pedestrians"), STAT_TrafficPedestrians, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pedestrians"), STAT_TrafficPedestrianCount, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Waiting Pedestrians"), STAT_TrafficWaitingPedestrians, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Pedestrian Braking"), STAT_TrafficPedestrianBraking, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicles Braking For Pedestrians"), STAT_TrafficPedestrianBrakingVehicles, STATGROUP_Traffic);
+
+namespace
+{
+	/** Yaya yürüme hızı, offset ve yön tohumu (aynı kaldırım ve ekleme sırası = aynı kalabalık). */
+	constexpr int32 PedestrianSeed = 1;
+
+	/** Fren hacmi yarıçapına eklenen yaya yarıçapı (birim). */
+	constexpr float PedestrianRadius = 40.0f;
+
+	/** Fren hacminde araç yarı genişliği (LaneWidth oranı; doluluk tahminiyle aynı). */
+	constexpr float OccupantWidthRatio = 0.4f;
+}
+
+UTrafficPedestrianSubsystem::UTrafficPedestrianSubsystem()
+{
+	PedestrianSeparationRadius = 80.0f;
+	CrosswalkWidth = 400.0f;
+	CrosswalkWaitingSlots = 16;
+	EmergencyBrakingReactionTime = 0.25f;
+	PedestrianBrakingRevision = 0;
+}
+
+void UTrafficPedestrianSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Config değerleri burada yüklenmiş olur
+	FTrafficPedestrianSettings PedestrianSettings;
+	PedestrianSettings.SeparationRadius = PedestrianSeparationRadius;
+	PedestrianCrowd.Initialize(PedestrianSettings, PedestrianSeed);
+}
+
+void UTrafficPedestrianSubsystem::PostInitialize()
+{
+	Super::PostInitialize();
+
+	// Trafik alt sistemi bu alt sisteme bağımlı (Initialize'da kurar); ters yönde sadece referans alınır
+	TrafficSubsystem = GetWorld()->GetSubsystem<UTrafficSubsystem>();
+}
+
+void UTrafficPedestrianSubsystem::Deinitialize()
+{
+	// Devam eden trafik adımı kalabalığı kullanıyor olabilir
+	WaitForTrafficStep();
+	PendingCrosswalkPhases.Empty();
+
+	for (const FCrosswalkSignal& Signal : CrosswalkSignals)
+	{
+		if (ATrafficLight* Light = Signal.Light.Get())
+		{
+			Light->OnLightStateChanged.Remove(Signal.StateChangedHandle);
+		}
+	}
+	CrosswalkSignals.Empty();
+	PedestrianCrowd.Reset();
+	SidewalkLookup.Empty();
+	PedestrianBraking.Empty();
+	PedestrianBrakingRevision = 0;
+	TrafficSubsystem = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UTrafficPedestrianSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// UTrafficSubsystem ile aynı dünyalar
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrafficPedestrianSubsystem::WaitForTrafficStep()
+{
+	if (TrafficSubsystem)
+	{
+		TrafficSubsystem->FinishPipelinedStep();
+	}
+}
+
+int32 UTrafficPedestrianSubsystem::FindOrAddSidewalk(USplineComponent* Spline, float Offset, float Width)
+{
+	WaitForTrafficStep();
+
+	if (!Spline || !TrafficSubsystem)
+	{
+		return INDEX_NONE;
+	}
+
+	const TPair<const USplineComponent*, int32> Key(Spline, FMath::RoundToInt(Offset));
+	if (const int32* ExistingSidewalkId = SidewalkLookup.Find(Key))
+	{
+		return *ExistingSidewalkId;
+	}
+
+	// Şeritlerle aynı örnekleme - adımda spline sorgusu yok
+	const float SampleSpacing = TrafficSubsystem->GetSampleSpacing();
+	const float Length = Spline->GetSplineLength();
+	const int32 NumSamples = FMath::CeilToInt(Length / SampleSpacing) + 1;
+	TArray<FVector> SamplePoints;
+	SamplePoints.Reserve(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float SampleDistance = FMath::Min(SampleIndex * SampleSpacing, Length);
+		const FVector Location = Spline->GetLocationAtDistanceAlongSpline(SampleDistance, ESplineCoordinateSpace::World);
+		const FVector Right = Spline->GetRightVectorAtDistanceAlongSpline(SampleDistance, ESplineCoordinateSpace::World);
+		SamplePoints.Add(Location + Right * Offset);
+	}
+
+	const int32 SidewalkId = PedestrianCrowd.AddSidewalk(MoveTemp(SamplePoints), SampleSpacing, Length, Width, Spline->IsClosedLoop());
+	if (SidewalkId == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Kaldırım eklenemedi: %s"), *Spline->GetPathName());
+		return INDEX_NONE;
+	}
+
+	SidewalkLookup.Add(Key, SidewalkId);
+	return SidewalkId;
+}
+
+uint32 UTrafficPedestrianSubsystem::AddPedestrian(int32 SidewalkId, float Distance)
+{
+	WaitForTrafficStep();
+
+	if (TrafficSubsystem)
+	{
+		TrafficSubsystem->InvalidateSpatialState();
+	}
+	return PedestrianCrowd.AddPedestrian(SidewalkId, Distance);
+}
+
+int32 UTrafficPedestrianSubsystem::AddCrosswalk(int32 SidewalkA, float DistanceA, int32 SidewalkB, float DistanceB, ATrafficLight* Light)
+{
+	WaitForTrafficStep();
+
+	if (!Light)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 CrosswalkId = PedestrianCrowd.AddCrosswalk(SidewalkA, DistanceA, SidewalkB, DistanceB, CrosswalkWidth, CrosswalkWaitingSlots);
+	if (CrosswalkId == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Yaya geçidi eklenemedi: kaldırım %d - %d"), SidewalkA, SidewalkB);
+		return INDEX_NONE;
+	}
+
+	// Işık başına tek abonelik; faz olayı o ışığın tüm geçitlerini birlikte günceller
+	FCrosswalkSignal* Signal = CrosswalkSignals.FindByPredicate([Light](const FCrosswalkSignal& Existing)
+	{
+		return Existing.Light == Light;
+	});
+	if (!Signal)
+	{
+		Signal = &CrosswalkSignals.AddDefaulted_GetRef();
+		Signal->Light = Light;
+		Signal->StateChangedHandle = Light->OnLightStateChanged.AddUObject(this, &UTrafficPedestrianSubsystem::OnCrosswalkLightStateChanged);
+	}
+	Signal->CrosswalkIds.Add(CrosswalkId);
+
+	PedestrianCrowd.SetCrosswalkOpen(CrosswalkId, Light->GetCurrentState() == ETrafficLightState::Red);
+	return CrosswalkId;
+}
+
+const FTrafficPedestrianCrowd& UTrafficPedestrianSubsystem::GetPedestrianCrowd()
+{
+	WaitForTrafficStep();
+	return PedestrianCrowd;
+}
+
+void UTrafficPedestrianSubsystem::StepCrowd(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficPedestrians);
+	PedestrianCrowd.Step(DeltaTime);
+
+	SET_DWORD_STAT(STAT_TrafficPedestrianCount, PedestrianCrowd.Num());
+	SET_DWORD_STAT(STAT_TrafficWaitingPedestrians, PedestrianCrowd.GetNumWaiting());
+}
+
+void UTrafficPedestrianSubsystem::ApplyPendingCrosswalkPhases()
+{
+	for (const FPendingCrosswalkPhase& Phase : PendingCrosswalkPhases)
+	{
+		OnCrosswalkLightStateChanged(Phase.Light.Get(), Phase.State);
+	}
+	PendingCrosswalkPhases.Reset();
+}
+
+void UTrafficPedestrianSubsystem::OnCrosswalkLightStateChanged(ATrafficLight* TrafficLight, ETrafficLightState NewState)
+{
+	// Bekleyen yayalar adım görevindeki kalabalığa bırakılamaz - faz adım bitince uygulanır
+	if (TrafficSubsystem && TrafficSubsystem->IsStepRunning())
+	{
+		PendingCrosswalkPhases.Add({ TrafficLight, NewState });
+		return;
+	}
+
+	const FCrosswalkSignal* Signal = CrosswalkSignals.FindByPredicate([TrafficLight](const FCrosswalkSignal& Existing)
+	{
+		return Existing.Light == TrafficLight;
+	});
+	if (!Signal)
+	{
+		return;
+	}
+
+	// Araç kırmızısı = yaya yeşili
+	const bool bOpen = NewState == ETrafficLightState::Red;
+	int32 NumReleased = 0;
+	for (const int32 CrosswalkId : Signal->CrosswalkIds)
+	{
+		NumReleased += PedestrianCrowd.SetCrosswalkOpen(CrosswalkId, bOpen);
+	}
+
+	// Bırakılan yayalar bu karenin spatial hash'inde ve fren testinde de yer alsın
+	if (NumReleased > 0 && TrafficSubsystem)
+	{
+		TrafficSubsystem->InvalidateSpatialState();
+	}
+}
+
+bool UTrafficPedestrianSubsystem::GetBrakingEnvelope(const AVehicleAIController* Controller, FTrafficBrakingEnvelope& OutEnvelope) const
+{
+	if (!Controller || !TrafficSubsystem || !TrafficSubsystem->GetControllers().IsValidIndex(Controller->RegistryIndex))
+	{
+		return false;
+	}
+
+	const APawn* Pawn = Controller->GetPawn();
+	if (!Pawn)
+	{
+		return false;
+	}
+
+	// Hacim hızla uzar: duruş mesafesi (v² / 2a) + tepki süresinde katedilen mesafe
+	const FVector Forward = Pawn->GetActorForwardVector().GetSafeNormal2D();
+	const float HalfLength = Controller->GetArchetype().CarFollowing.VehicleLength * 0.5f;
+	const float SweepLength = FMath::Max(Controller->CalculateBrakingDistance() + Controller->CurrentSpeed * EmergencyBrakingReactionTime, 0.0f);
+
+	OutEnvelope.NumPoints = 0;
+	OutEnvelope.Radius = TrafficSubsystem->GetLaneWidth() * OccupantWidthRatio + PedestrianRadius;
+	OutEnvelope.AddPoint(Pawn->GetActorLocation() + Forward * HalfLength);
+
+	// Şeride bağlı araç: eksen şerit örneklerini izler (virajda kapsül yolla birlikte döner)
+	const FTrafficLane* Lane = Controller->IsLaneBound() ? TrafficSubsystem->GetLane(Controller->LaneId) : nullptr;
+	if (Lane && SweepLength > 0.0f)
+	{
+		const float LateralOffset = Controller->CurrentLaneOffset - Lane->LaneOffset;
+		const float FrontDistance = Controller->DistanceAlongLane + HalfLength;
+		const int32 NumSegments = FMath::Clamp(FMath::CeilToInt(SweepLength / TrafficSubsystem->GetSampleSpacing()), 1, FTrafficBrakingEnvelope::MaxPoints - 1);
+
+		for (int32 Segment = 1; Segment <= NumSegments; ++Segment)
+		{
+			// Açık şeridin sonundan sonra son yönde düz devam edilir
+			float Distance = FrontDistance + SweepLength * Segment / NumSegments;
+			float Overrun = 0.0f;
+			if (!Lane->bClosedLoop && Distance > Lane->Length)
+			{
+				Overrun = Distance - Lane->Length;
+				Distance = Lane->Length;
+			}
+
+			FVector LaneLocation;
+			FRotator LaneRotation;
+			if (!TrafficSubsystem->GetLaneTransform(Controller->LaneId, Distance, LaneLocation, LaneRotation))
+			{
+				OutEnvelope.NumPoints = 1;
+				break;
+			}
+
+			const FVector LaneForward = LaneRotation.Vector().GetSafeNormal2D();
+			const FVector LaneRight(-LaneForward.Y, LaneForward.X, 0.0f);
+			OutEnvelope.AddPoint(LaneLocation + LaneRight * LateralOffset + LaneForward * Overrun);
+		}
+	}
+
+	if (OutEnvelope.NumPoints == 1)
+	{
+		OutEnvelope.AddPoint(OutEnvelope.Points[0] + Forward * SweepLength);
+	}
+	return true;
+}
+
+bool UTrafficPedestrianSubsystem::IsBrakingForPedestrian(const AVehicleAIController* Controller)
+{
+	if (!Controller || !TrafficSubsystem || !TrafficSubsystem->GetControllers().IsValidIndex(Controller->RegistryIndex))
+	{
+		return false;
+	}
+
+	BuildPedestrianBraking();
+	return PedestrianBraking.IsValidIndex(Controller->RegistryIndex) && PedestrianBraking[Controller->RegistryIndex] != 0;
+}
+
+void UTrafficPedestrianSubsystem::BuildPedestrianBraking()
+{
+	// Yaya konumları adım görevinde yazılıyor olabilir; adımı bitirmek durum sayacını da ilerletir
+	WaitForTrafficStep();
+
+	const uint32 Revision = TrafficSubsystem->GetStateRevision();
+	if (PedestrianBrakingRevision == Revision)
+	{
+		return;
+	}
+
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_TrafficPedestrianBraking);
+
+	PedestrianBrakingRevision = Revision;
+	const TArrayView<AVehicleAIController* const> Controllers = TrafficSubsystem->GetControllers();
+	PedestrianBraking.SetNumZeroed(Controllers.Num(), false);
+
+	// Aktif yaya yoksa (hepsi bekleme yuvalarında veya kalabalık boş) test edilecek bir şey yok
+	if (PedestrianCrowd.Num() == 0)
+	{
+		SET_DWORD_STAT(STAT_TrafficPedestrianBrakingVehicles, 0);
+		return;
+	}
+
+	const FTrafficSpatialHash& SpatialHash = TrafficSubsystem->GetSpatialHash();
+
+	// ParallelFor'un görev verisi motora ait, izlenmez; gövdeler izlenir
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	// Her araç kendi kapsülünü kurar ve kapsülü çevreleyen daire ile hash'teki yayaları sorgular
+	ParallelFor(Controllers.Num(), [this, Controllers, &SpatialHash](int32 Index)
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		FTrafficBrakingEnvelope Envelope;
+		if (!GetBrakingEnvelope(Controllers[Index], Envelope))
+		{
+			return;
+		}
+
+		FVector Center;
+		float QueryRadius;
+		Envelope.GetBoundingCircle(Center, QueryRadius);
+
+		bool bHit = false;
+		SpatialHash.ForEachInRadius(Center, QueryRadius, [&Envelope, &bHit](int32 ItemId, const FVector& Location)
+		{
+			if (!bHit && FTrafficPedestrianCrowd::IsPedestrianItem(ItemId) && Envelope.Contains(Location))
+			{
+				bHit = true;
+			}
+		});
+
+		PedestrianBraking[Index] = bHit ? 1 : 0;
+	});
+
+	int32 NumBraking = 0;
+	for (const uint8 bBraking : PedestrianBraking)
+	{
+		NumBraking += bBraking;
+	}
+	SET_DWORD_STAT(STAT_TrafficPedestrianBrakingVehicles, NumBraking);
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrafficPedestrianCrowd.h"
+#include "VehicleAIController.h" // ETrafficLightState enum'u için
+#include "TrafficPedestrianSubsystem.generated.h"
+
+class ATrafficLight;
+class USplineComponent;
+class UTrafficSubsystem;
+
+/**
+ * Aracın acil fren hacmi: ön tampondan duruş mesafesi kadar ileri süpürülen yatay kapsül.
+ * Hıza göre analitik hesaplanır (CurrentSpeed, CalculateBrakingDistance); çalışma zamanında
+ * boyu değişen collision bileşeni yoktur. Şeride bağlı araçta eksen şerit örneklerinden
+ * geçen kırık çizgidir (virajı izler), diğerlerinde aracın ileri yönünde tek doğru parçası.
+ */
+struct FTrafficBrakingEnvelope
+{
+	/** En fazla eksen noktası. */
+	static constexpr int32 MaxPoints = 10;
+
+	/** Kapsül ekseni: ilk nokta ön tampon. */
+	FVector Points[MaxPoints];
+	int32 NumPoints = 0;
+
+	/** Kapsül yarıçapı (araç yarı genişliği + yaya payı). */
+	float Radius = 0.0f;
+
+	void AddPoint(const FVector& Point)
+	{
+		if (NumPoints < MaxPoints)
+		{
+			Points[NumPoints++] = Point;
+		}
+	}
+
+	/** Kapsülü çevreleyen yatay daire (hash sorgusu için). */
+	void GetBoundingCircle(FVector& OutCenter, float& OutRadius) const
+	{
+		FBox2D Bounds(ForceInit);
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			Bounds += FVector2D(Points[Index]);
+		}
+
+		const FVector2D Center = Bounds.GetCenter();
+		OutCenter = FVector(Center, NumPoints > 0 ? Points[0].Z : 0.0f);
+		OutRadius = Bounds.GetExtent().Size() + Radius;
+	}
+
+	/** Nokta kapsülün içinde mi (2D nokta - kırık çizgi mesafesi). */
+	bool Contains(const FVector& Point) const
+	{
+		const float RadiusSquared = FMath::Square(Radius);
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			const FVector& Start = Points[Index];
+			const FVector& End = Points[FMath::Min(Index + 1, NumPoints - 1)];
+			const FVector2D Axis(End.X - Start.X, End.Y - Start.Y);
+			const FVector2D ToPoint(Point.X - Start.X, Point.Y - Start.Y);
+			const float LengthSquared = Axis.SizeSquared();
+			const float Alpha = LengthSquared > KINDA_SMALL_NUMBER ? FMath::Clamp(FVector2D::DotProduct(ToPoint, Axis) / LengthSquared, 0.0f, 1.0f) : 0.0f;
+			if ((ToPoint - Axis * Alpha).SizeSquared() <= RadiusSquared)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+/**
+ * Yaya alt sistemi.
+ * Kaldırım yayalarını (FTrafficPedestrianCrowd), ışıklı yaya geçitlerini ve araçların acil fren
+ * hacimlerini yönetir. Kalabalık UTrafficSubsystem'in adımında (gerekirse worker'da) ilerletilir
+ * ve yaya konumları araç spatial hash'ine eklenir; şerit ve controller verisi trafik alt
+ * sisteminden salt okunur görünümlerle alınır.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficPedestrianSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficPedestrianSubsystem();
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void PostInitialize() override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ============================================
+	// YAYALAR
+	// ============================================
+
+	/**
+	 * Spline'a paralel kaldırımı döndürür, yoksa oluşturur.
+	 *
+	 * @param Spline Kaldırımın takip ettiği spline (ör. yol spline'ı)
+	 * @param Offset Orta çizginin spline'a dik offset'i (birim)
+	 * @param Width Kaldırım genişliği (birim)
+	 * @return Kaldırım ID'si (INDEX_NONE = geçersiz spline)
+	 */
+	int32 FindOrAddSidewalk(USplineComponent* Spline, float Offset, float Width);
+
+	/**
+	 * Kaldırıma yaya ekler (aktör yok; yürüme hızı ve tercih edilen offset rastgele).
+	 *
+	 * @return Kalıcı yaya kimliği (0 = eklenemedi)
+	 */
+	uint32 AddPedestrian(int32 SidewalkId, float Distance);
+
+	/**
+	 * İki kaldırım arasına ışıklı yaya geçidi ekler. Yayalar aracın ışığı kırmızıyken geçer:
+	 * ışık OnLightStateChanged ile kırmızıya döndüğünde bekleme yuvalarındaki tüm yayalar tek
+	 * olayda bırakılır. Bekleyen yayaların kare başına maliyeti yoktur (yoklama yok).
+	 *
+	 * @param Light Geçidin kestiği şeridin trafik ışığı
+	 * @return Geçit ID'si (INDEX_NONE = geçersiz kaldırım veya ışık)
+	 */
+	int32 AddCrosswalk(int32 SidewalkA, float DistanceA, int32 SidewalkB, float DistanceB, ATrafficLight* Light);
+
+	/**
+	 * Yaya kalabalığı. Yaya konumları araç spatial hash'ine de eklenir
+	 * (FTrafficPedestrianCrowd::ToItemId); ayrı fizik veya broadphase yoktur.
+	 */
+	const FTrafficPedestrianCrowd& GetPedestrianCrowd();
+
+	// ============================================
+	// ACİL FREN
+	// ============================================
+
+	/**
+	 * Aracın acil fren hacmi (bu karenin hızıyla). Uzunluk CalculateBrakingDistance()
+	 * artı EmergencyBrakingReactionTime boyunca katedilen mesafedir; şeride bağlı araçta
+	 * bu mesafe şerit boyunca ölçülür.
+	 *
+	 * @return Araç kayıtlı değilse veya pawn'ı yoksa false
+	 */
+	bool GetBrakingEnvelope(const AVehicleAIController* Controller, FTrafficBrakingEnvelope& OutEnvelope) const;
+
+	/**
+	 * Aracın fren hacminde yaya var mı. Karede ilk sorguda tüm araçların hacimleri tek
+	 * ParallelFor ile paylaşılan spatial hash'teki yayalara karşı test edilir; sonra salt okunurdur.
+	 * Sadece oyun thread'inden.
+	 */
+	bool IsBrakingForPedestrian(const AVehicleAIController* Controller);
+
+	// ============================================
+	// TRAFİK ADIMI
+	// ============================================
+
+	/** Kalabalığı bir adım ilerletir. Trafik adımından çağrılır (boru hattında worker görevinde). */
+	void StepCrowd(float DeltaTime);
+
+	/** Yaya konumlarını trafik spatial hash'ine ekler (öğe = FTrafficPedestrianCrowd::ToItemId). */
+	void AddToSpatialHash(FTrafficSpatialHash& SpatialHash) const { PedestrianCrowd.AddToSpatialHash(SpatialHash); }
+
+	/** Adım çalışırken gelen geçit ışığı fazlarını uygular (adım tamamlandıktan sonra, oyun thread'inde). */
+	void ApplyPendingCrosswalkPhases();
+
+protected:
+	/** Bu mesafeden (birim) yakın yayalar birbirinden yana açılır. */
+	UPROPERTY(Config)
+	float PedestrianSeparationRadius;
+
+	/** Yaya geçidi genişliği (birim). */
+	UPROPERTY(Config)
+	float CrosswalkWidth;
+
+	/** Geçidin her ucundaki bekleme yuvası sayısı. Dolunca gelen yayalar beklemeden yürümeye devam eder. */
+	UPROPERTY(Config)
+	int32 CrosswalkWaitingSlots;
+
+	/** Acil fren hacmine eklenen tepki süresi (saniye): hacim duruş mesafesi + CurrentSpeed * bu süre kadar uzar. */
+	UPROPERTY(Config)
+	float EmergencyBrakingReactionTime;
+
+private:
+	/** Kalabalık worker'daki trafik adımında yazılıyor olabilir; değiştirmeden veya okumadan önce beklenir. */
+	void WaitForTrafficStep();
+
+	/** Tüm araçların fren hacimlerini yayalara karşı test eder (trafik durumu başına en fazla bir kez). */
+	void BuildPedestrianBraking();
+
+	/** Geçit ışığının fazı değişti: yaya yeşilinde geçitler açılır ve bekleyenler topluca bırakılır. */
+	void OnCrosswalkLightStateChanged(ATrafficLight* TrafficLight, ETrafficLightState NewState);
+
+	/** Kalabalığı adımlayan ve spatial hash'i paylaşan trafik alt sistemi. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTrafficSubsystem> TrafficSubsystem;
+
+	/** Kaldırım yayaları (SoA). */
+	FTrafficPedestrianCrowd PedestrianCrowd;
+
+	/** Fren hacminde yaya olan araçlar (Controllers indeksi ile, 1 = fren). */
+	TArray<uint8> PedestrianBraking;
+
+	/** Fren testinin yapıldığı trafik durumu (UTrafficSubsystem::GetStateRevision; 0 = hiç yapılmadı). */
+	uint32 PedestrianBrakingRevision;
+
+	/** (Spline, offset cm) -> kaldırım ID'si. */
+	TMap<TPair<const USplineComponent*, int32>, int32> SidewalkLookup;
+
+	/** Işık başına kontrol ettiği geçitler ve faz olayı aboneliği. */
+	struct FCrosswalkSignal
+	{
+		TWeakObjectPtr<ATrafficLight> Light;
+		FDelegateHandle StateChangedHandle;
+		TArray<int32> CrosswalkIds;
+	};
+	TArray<FCrosswalkSignal> CrosswalkSignals;
+
+	/** Adım çalışırken gelen geçit ışığı fazları. */
+	struct FPendingCrosswalkPhase
+	{
+		TWeakObjectPtr<ATrafficLight> Light;
+		ETrafficLightState State;
+	};
+	TArray<FPendingCrosswalkPhase> PendingCrosswalkPhases;
+};
@@ -0,0 +1,153 @@
+#include "TrafficRecorder.h"
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Serialization/Archive.h"
+
+FTrafficRecorder::FTrafficRecorder()
+	: WriteIndex(0)
+	, ReadIndex(0)
+	, FrameEvent(nullptr)
+	, Thread(nullptr)
+	, bStopRequested(false)
+	, DroppedFrames(0)
+	, BytesWritten(0)
+{
+}
+
+FTrafficRecorder::~FTrafficRecorder()
+{
+	Stop();
+}
+
+bool FTrafficRecorder::Start(const FString& FilePath, int32 RingCapacity, int32 FramesPerChunk)
+{
+	Stop();
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kaydı dosyası açılamadı: %s"), *FilePath);
+		return false;
+	}
+
+	// Yazıcı dosya başlığını hemen üretir
+	RecordingWriter = MakeUnique<FTrafficRecordingWriter>(FramesPerChunk);
+	BytesWritten = 0;
+	WriteOutput();
+
+	// Bir yuva boş kalır (dolu / boş ayrımı için)
+	Ring.Reset();
+	Ring.SetNum(FMath::Max(RingCapacity, 2) + 1);
+	WriteIndex = 0;
+	ReadIndex = 0;
+	DroppedFrames = 0;
+
+	bStopRequested = false;
+	FrameEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("TrafficRecorder"), 0, TPri_BelowNormal);
+
+	return Thread != nullptr;
+}
+
+void FTrafficRecorder::Stop()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	bStopRequested = true;
+	FrameEvent->Trigger();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(FrameEvent);
+	FrameEvent = nullptr;
+
+	// Thread bitti - kalan kareler ve yarım chunk oyun thread'inde yazılır
+	DrainFrames();
+	RecordingWriter->Finish();
+	WriteOutput();
+
+	FileWriter->Close();
+	FileWriter.Reset();
+	RecordingWriter.Reset();
+
+	if (DroppedFrames > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kaydı: %d kare düşürüldü (disk yetişemedi)"), DroppedFrames);
+	}
+}
+
+FTrafficRecordingFrame* FTrafficRecorder::BeginFrame()
+{
+	if (!Thread)
+	{
+		return nullptr;
+	}
+
+	const uint32 Write = WriteIndex.Load(EMemoryOrder::Relaxed);
+	const uint32 NextWrite = (Write + 1) % Ring.Num();
+	if (NextWrite == ReadIndex.Load())
+	{
+		++DroppedFrames;
+		return nullptr;
+	}
+
+	FTrafficRecordingFrame& Frame = Ring[Write];
+	Frame.Reset();
+	return &Frame;
+}
+
+void FTrafficRecorder::CommitFrame()
+{
+	const uint32 Write = WriteIndex.Load(EMemoryOrder::Relaxed);
+	WriteIndex.Store((Write + 1) % Ring.Num());
+	FrameEvent->Trigger();
+}
+
+uint32 FTrafficRecorder::Run()
+{
+	while (!bStopRequested)
+	{
+		FrameEvent->Wait(100);
+		DrainFrames();
+	}
+	return 0;
+}
+
+void FTrafficRecorder::DrainFrames()
+{
+	uint32 Read = ReadIndex.Load(EMemoryOrder::Relaxed);
+	while (Read != WriteIndex.Load())
+	{
+		FTrafficRecordingFrame& Frame = Ring[Read];
+
+		// Okuyucu kimlikle ikili arama yapar
+		Frame.Vehicles.Sort([](const FTrafficRecordedVehicle& A, const FTrafficRecordedVehicle& B)
+		{
+			return A.TrafficId < B.TrafficId;
+		});
+
+		RecordingWriter->AddFrame(Frame);
+
+		// Yuvayı üreticiye geri ver
+		Read = (Read + 1) % Ring.Num();
+		ReadIndex.Store(Read);
+
+		WriteOutput();
+	}
+}
+
+void FTrafficRecorder::WriteOutput()
+{
+	RecordingWriter->ConsumeOutput(PendingOutput);
+	if (PendingOutput.Num() > 0)
+	{
+		FileWriter->Serialize(PendingOutput.GetData(), PendingOutput.Num());
+		BytesWritten += PendingOutput.Num();
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "TrafficRecording.h"
+
+class FArchive;
+class FEvent;
+class FRunnableThread;
+
+/**
+ * Trafik kaydedicisi.
+ * Oyun thread'i her adımda bir kare doldurur (BeginFrame / CommitFrame); kareler sınırlı
+ * tek üretici / tek tüketici halka tamponundan arka plan thread'ine geçer. Kuantizasyon,
+ * delta kodlama ve dosya yazımı tamamen arka plan thread'inde yapılır.
+ *
+ * Halka doluysa (disk yetişemiyorsa) kare düşürülür ve sayılır; oyun thread'i asla beklemez.
+ * Halka yuvaları yeniden kullanılır - kararlı durumda kare başına heap tahsisi yoktur.
+ */
+class YOURGAMENAME_API FTrafficRecorder : public FRunnable
+{
+public:
+	FTrafficRecorder();
+	virtual ~FTrafficRecorder() override;
+
+	/**
+	 * Kaydı başlatır.
+	 *
+	 * @param FilePath Kayıt dosyası
+	 * @param RingCapacity Halka tamponundaki kare sayısı
+	 * @param FramesPerChunk Chunk başına kare (anahtar kare aralığı)
+	 * @return Dosya açılamadıysa false
+	 */
+	bool Start(const FString& FilePath, int32 RingCapacity, int32 FramesPerChunk);
+
+	/** Kaydı bitirir: kalan kareler yazılır ve dosya kapatılır. */
+	void Stop();
+
+	bool IsRecording() const { return Thread != nullptr; }
+
+	/**
+	 * Yazılabilir bir sonraki kareyi döndürür (temizlenmiş). Halka doluysa nullptr.
+	 * Sadece oyun thread'inden çağrılmalı.
+	 */
+	FTrafficRecordingFrame* BeginFrame();
+
+	/** BeginFrame ile alınan kareyi arka plan thread'ine yayınlar. */
+	void CommitFrame();
+
+	/** Halka dolu olduğu için düşürülen kare sayısı. */
+	int32 GetDroppedFrameCount() const { return DroppedFrames; }
+
+	/** Yazılan toplam byte. */
+	int64 GetBytesWritten() const { return BytesWritten.Load(); }
+
+	// FRunnable
+	virtual uint32 Run() override;
+
+private:
+	/** Bekleyen kareleri kodlar; tamamlanan chunk'ları diske yazar. */
+	void DrainFrames();
+
+	/** Yazıcıda biriken çıktıyı diske yazar. */
+	void WriteOutput();
+
+	/** Kare halkası (yuvalar yeniden kullanılır). */
+	TArray<FTrafficRecordingFrame> Ring;
+
+	/** Üretici (oyun thread'i) bir sonraki yazma konumu. */
+	TAtomic<uint32> WriteIndex;
+
+	/** Tüketici (kayıt thread'i) bir sonraki okuma konumu. */
+	TAtomic<uint32> ReadIndex;
+
+	/** Yeni kare yayınlandığında tetiklenir. */
+	FEvent* FrameEvent;
+
+	FRunnableThread* Thread;
+	TAtomic<bool> bStopRequested;
+
+	/** Kayıt thread'i tarafından kullanılır. */
+	TUniquePtr<FArchive> FileWriter;
+	TUniquePtr<FTrafficRecordingWriter> RecordingWriter;
+	TArray<uint8> PendingOutput;
+
+	int32 DroppedFrames;
+	TAtomic<int64> BytesWritten;
+};
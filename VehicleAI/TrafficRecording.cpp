@@ -0,0 +1,501 @@
+#include "TrafficRecording.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	/** Delta alan maskesi bitleri (FQuantizedVehicle alan sırası). */
+	constexpr int32 NumQuantizedFields = 8;
+
+	FORCEINLINE void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add((uint8)(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add((uint8)Value);
+	}
+
+	FORCEINLINE void WriteVarInt(TArray<uint8>& Out, int32 Value)
+	{
+		// ZigZag: küçük negatif deltalar da tek byte
+		WriteVarUInt(Out, ((uint32)Value << 1) ^ (uint32)(Value >> 31));
+	}
+
+	template<typename T>
+	FORCEINLINE void WriteRaw(TArray<uint8>& Out, const T& Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	FORCEINLINE bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Cursor >= End)
+			{
+				return false;
+			}
+			const uint8 Byte = *Cursor++;
+			OutValue |= (uint32)(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FORCEINLINE bool ReadVarInt(const uint8*& Cursor, const uint8* End, int32& OutValue)
+	{
+		uint32 Encoded;
+		if (!ReadVarUInt(Cursor, End, Encoded))
+		{
+			return false;
+		}
+		OutValue = (int32)(Encoded >> 1) ^ -(int32)(Encoded & 1);
+		return true;
+	}
+
+	template<typename T>
+	FORCEINLINE bool ReadRaw(const uint8*& Cursor, const uint8* End, T& OutValue)
+	{
+		if (End - Cursor < (int64)sizeof(T))
+		{
+			return false;
+		}
+		FMemory::Memcpy(&OutValue, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return true;
+	}
+}
+
+// ============================================
+// KODLAYICI
+// ============================================
+
+void FTrafficRecordingCodec::BeginChunk()
+{
+	PreviousVehicles.Reset();
+	PreviousLights.Reset();
+	bChunkStart = true;
+}
+
+void FTrafficRecordingCodec::Quantize(const FTrafficRecordedVehicle& Vehicle, FQuantizedVehicle& Out)
+{
+	using namespace TrafficRecording;
+
+	Out.X = FMath::RoundToInt(Vehicle.Location.X / LocationQuantum);
+	Out.Y = FMath::RoundToInt(Vehicle.Location.Y / LocationQuantum);
+	Out.Z = FMath::RoundToInt(Vehicle.Location.Z / LocationQuantum);
+	Out.Yaw = FRotator::CompressAxisToShort(Vehicle.Yaw);
+	Out.CurrentSpeed = FMath::RoundToInt(Vehicle.CurrentSpeed / SpeedQuantum);
+	Out.TargetSpeed = FMath::RoundToInt(Vehicle.TargetSpeed / SpeedQuantum);
+	Out.LaneOffset = FMath::RoundToInt(Vehicle.LaneOffset / SpeedQuantum);
+	Out.State = (int32)Vehicle.Behavior | ((int32)Vehicle.Flags << 8);
+}
+
+void FTrafficRecordingCodec::Dequantize(uint32 TrafficId, const FQuantizedVehicle& Quantized, FTrafficRecordedVehicle& Out)
+{
+	using namespace TrafficRecording;
+
+	Out.TrafficId = TrafficId;
+	Out.Location = FVector(Quantized.X, Quantized.Y, Quantized.Z) * LocationQuantum;
+	Out.Yaw = FRotator::DecompressAxisFromShort((uint16)Quantized.Yaw);
+	Out.CurrentSpeed = Quantized.CurrentSpeed * SpeedQuantum;
+	Out.TargetSpeed = Quantized.TargetSpeed * SpeedQuantum;
+	Out.LaneOffset = Quantized.LaneOffset * SpeedQuantum;
+	Out.Behavior = (EVehicleBehavior)(Quantized.State & 0xFF);
+	Out.Flags = (uint8)(Quantized.State >> 8);
+}
+
+void FTrafficRecordingCodec::EncodeFrame(const FTrafficRecordingFrame& Frame, TArray<uint8>& Out)
+{
+	WriteRaw(Out, Frame.StepIndex);
+	WriteRaw(Out, Frame.Time);
+
+	// Işık tanımları: chunk başında hepsi, sonra sadece yeniler
+	for (const FTrafficRecordedLightInfo& Info : Frame.NewLights)
+	{
+		KnownLights.Add(Info);
+	}
+
+	const bool bWriteAllLights = bChunkStart;
+	const int32 NumLightInfos = bWriteAllLights ? KnownLights.Num() : Frame.NewLights.Num();
+	WriteVarUInt(Out, NumLightInfos);
+	for (int32 Index = KnownLights.Num() - NumLightInfos; Index < KnownLights.Num(); ++Index)
+	{
+		const FTrafficRecordedLightInfo& Info = KnownLights[Index];
+		WriteRaw(Out, Info.LightId);
+
+		const FTCHARToUTF8 Utf8Name(*Info.Name);
+		WriteVarUInt(Out, Utf8Name.Length());
+		Out.Append(reinterpret_cast<const uint8*>(Utf8Name.Get()), Utf8Name.Length());
+
+		WriteVarInt(Out, FMath::RoundToInt(Info.Location.X));
+		WriteVarInt(Out, FMath::RoundToInt(Info.Location.Y));
+		WriteVarInt(Out, FMath::RoundToInt(Info.Location.Z));
+	}
+
+	// Işık durumları: sadece değişenler
+	TArray<const FTrafficRecordedLight*, TInlineAllocator<64>> ChangedLights;
+	for (const FTrafficRecordedLight& Light : Frame.Lights)
+	{
+		ETrafficLightState& Previous = PreviousLights.FindOrAdd(Light.LightId, (ETrafficLightState)0xFF);
+		if (Previous != Light.State)
+		{
+			Previous = Light.State;
+			ChangedLights.Add(&Light);
+		}
+	}
+
+	WriteVarUInt(Out, ChangedLights.Num());
+	for (const FTrafficRecordedLight* Light : ChangedLights)
+	{
+		WriteVarUInt(Out, Light->LightId);
+		Out.Add((uint8)Light->State);
+	}
+
+	// Araçlar: kimlik deltası + değişen alan maskesi + alan deltaları
+	WriteVarUInt(Out, Frame.Vehicles.Num());
+	uint32 PreviousId = 0;
+	for (const FTrafficRecordedVehicle& Vehicle : Frame.Vehicles)
+	{
+		WriteVarInt(Out, (int32)(Vehicle.TrafficId - PreviousId));
+		PreviousId = Vehicle.TrafficId;
+
+		FQuantizedVehicle Current;
+		Quantize(Vehicle, Current);
+
+		// Yeni araç (veya chunk başı): sıfıra göre delta
+		FQuantizedVehicle& Previous = PreviousVehicles.FindOrAdd(Vehicle.TrafficId);
+
+		const int32* CurrentFields = &Current.X;
+		const int32* PreviousFields = &Previous.X;
+
+		uint8 Mask = 0;
+		for (int32 Field = 0; Field < NumQuantizedFields; ++Field)
+		{
+			if (CurrentFields[Field] != PreviousFields[Field])
+			{
+				Mask |= 1 << Field;
+			}
+		}
+
+		Out.Add(Mask);
+		for (int32 Field = 0; Field < NumQuantizedFields; ++Field)
+		{
+			if (Mask & (1 << Field))
+			{
+				WriteVarInt(Out, CurrentFields[Field] - PreviousFields[Field]);
+			}
+		}
+
+		Previous = Current;
+	}
+
+	bChunkStart = false;
+}
+
+bool FTrafficRecordingCodec::DecodeFrame(const uint8*& Cursor, const uint8* End, FTrafficRecordingFrame& OutFrame)
+{
+	OutFrame.Reset();
+
+	if (!ReadRaw(Cursor, End, OutFrame.StepIndex) || !ReadRaw(Cursor, End, OutFrame.Time))
+	{
+		return false;
+	}
+
+	uint32 NumLightInfos;
+	if (!ReadVarUInt(Cursor, End, NumLightInfos))
+	{
+		return false;
+	}
+
+	for (uint32 Index = 0; Index < NumLightInfos; ++Index)
+	{
+		FTrafficRecordedLightInfo Info;
+		uint32 NameLength;
+		if (!ReadRaw(Cursor, End, Info.LightId) || !ReadVarUInt(Cursor, End, NameLength) || End - Cursor < (int64)NameLength)
+		{
+			return false;
+		}
+
+		Info.Name = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Cursor), NameLength));
+		Cursor += NameLength;
+
+		int32 X, Y, Z;
+		if (!ReadVarInt(Cursor, End, X) || !ReadVarInt(Cursor, End, Y) || !ReadVarInt(Cursor, End, Z))
+		{
+			return false;
+		}
+		Info.Location = FVector(X, Y, Z);
+
+		// Chunk başında tekrar yazılan tanımlar bir kez tutulur
+		if (!KnownLights.ContainsByPredicate([&Info](const FTrafficRecordedLightInfo& Known) { return Known.LightId == Info.LightId; }))
+		{
+			KnownLights.Add(Info);
+		}
+		OutFrame.NewLights.Add(MoveTemp(Info));
+	}
+
+	uint32 NumChangedLights;
+	if (!ReadVarUInt(Cursor, End, NumChangedLights))
+	{
+		return false;
+	}
+
+	for (uint32 Index = 0; Index < NumChangedLights; ++Index)
+	{
+		uint32 LightId;
+		uint8 State;
+		if (!ReadVarUInt(Cursor, End, LightId) || !ReadRaw(Cursor, End, State))
+		{
+			return false;
+		}
+		PreviousLights.Add((uint16)LightId, (ETrafficLightState)State);
+	}
+
+	// Karedeki ışık durumları: değişmeyenler dahil tümü
+	OutFrame.Lights.Reserve(PreviousLights.Num());
+	for (const TPair<uint16, ETrafficLightState>& Pair : PreviousLights)
+	{
+		FTrafficRecordedLight& Light = OutFrame.Lights.AddDefaulted_GetRef();
+		Light.LightId = Pair.Key;
+		Light.State = Pair.Value;
+	}
+
+	uint32 NumVehicles;
+	if (!ReadVarUInt(Cursor, End, NumVehicles))
+	{
+		return false;
+	}
+
+	OutFrame.Vehicles.SetNum(NumVehicles);
+	uint32 PreviousId = 0;
+	for (uint32 Index = 0; Index < NumVehicles; ++Index)
+	{
+		int32 IdDelta;
+		uint8 Mask;
+		if (!ReadVarInt(Cursor, End, IdDelta) || !ReadRaw(Cursor, End, Mask))
+		{
+			return false;
+		}
+
+		const uint32 TrafficId = PreviousId + (uint32)IdDelta;
+		PreviousId = TrafficId;
+
+		FQuantizedVehicle& Previous = PreviousVehicles.FindOrAdd(TrafficId);
+		int32* Fields = &Previous.X;
+		for (int32 Field = 0; Field < NumQuantizedFields; ++Field)
+		{
+			if (Mask & (1 << Field))
+			{
+				int32 Delta;
+				if (!ReadVarInt(Cursor, End, Delta))
+				{
+					return false;
+				}
+				Fields[Field] += Delta;
+			}
+		}
+
+		Dequantize(TrafficId, Previous, OutFrame.Vehicles[Index]);
+	}
+
+	bChunkStart = false;
+	return true;
+}
+
+// ============================================
+// YAZICI
+// ============================================
+
+FTrafficRecordingWriter::FTrafficRecordingWriter(int32 InFramesPerChunk)
+	: FramesInChunk(0)
+	, FramesPerChunk(FMath::Max(InFramesPerChunk, 1))
+{
+	WriteRaw(Output, TrafficRecording::FileMagic);
+	WriteRaw(Output, TrafficRecording::Version);
+	Codec.BeginChunk();
+}
+
+void FTrafficRecordingWriter::AddFrame(const FTrafficRecordingFrame& Frame)
+{
+	Codec.EncodeFrame(Frame, ChunkPayload);
+	if (++FramesInChunk >= FramesPerChunk)
+	{
+		Finish();
+	}
+}
+
+void FTrafficRecordingWriter::Finish()
+{
+	if (FramesInChunk == 0)
+	{
+		return;
+	}
+
+	WriteRaw(Output, TrafficRecording::ChunkMagic);
+	WriteRaw(Output, (uint32)FramesInChunk);
+	WriteRaw(Output, (uint32)ChunkPayload.Num());
+	Output.Append(ChunkPayload);
+
+	ChunkPayload.Reset();
+	FramesInChunk = 0;
+	Codec.BeginChunk();
+}
+
+void FTrafficRecordingWriter::ConsumeOutput(TArray<uint8>& Out)
+{
+	// Takas: iki tampon da kapasitesini korur
+	Swap(Out, Output);
+	Output.Reset();
+}
+
+bool FTrafficRecordingWriter::SaveToFile(const FString& FilePath) const
+{
+	return FFileHelper::SaveArrayToFile(Output, *FilePath);
+}
+
+// ============================================
+// OKUYUCU
+// ============================================
+
+bool FTrafficRecordingReader::Open(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kaydı okunamadı: %s"), *FilePath);
+		return false;
+	}
+
+	return OpenFromMemory(Data);
+}
+
+bool FTrafficRecordingReader::OpenFromMemory(const TArray<uint8>& Data)
+{
+	Frames.Reset();
+	Lights.Reset();
+
+	const uint8* Cursor = Data.GetData();
+	const uint8* End = Cursor + Data.Num();
+
+	uint32 Magic = 0;
+	uint32 FileVersion = 0;
+	if (!ReadRaw(Cursor, End, Magic) || !ReadRaw(Cursor, End, FileVersion)
+		|| Magic != TrafficRecording::FileMagic || FileVersion != TrafficRecording::Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Geçersiz trafik kaydı formatı"));
+		return false;
+	}
+
+	FTrafficRecordingCodec Codec;
+
+	while (Cursor < End)
+	{
+		uint32 ChunkMagic = 0;
+		uint32 FrameCount = 0;
+		uint32 PayloadSize = 0;
+		if (!ReadRaw(Cursor, End, ChunkMagic) || !ReadRaw(Cursor, End, FrameCount) || !ReadRaw(Cursor, End, PayloadSize)
+			|| ChunkMagic != TrafficRecording::ChunkMagic || End - Cursor < (int64)PayloadSize)
+		{
+			// Yarım kalmış son chunk (ör. çökme) - okunabilen kısım korunur
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kaydında bozuk chunk, %d kare okundu"), Frames.Num());
+			break;
+		}
+
+		const uint8* ChunkEnd = Cursor + PayloadSize;
+		Codec.BeginChunk();
+
+		for (uint32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+		{
+			FTrafficRecordingFrame& Frame = Frames.AddDefaulted_GetRef();
+			if (!Codec.DecodeFrame(Cursor, ChunkEnd, Frame))
+			{
+				Frames.Pop(false);
+				break;
+			}
+
+			for (const FTrafficRecordedLightInfo& Info : Frame.NewLights)
+			{
+				if (!Lights.ContainsByPredicate([&Info](const FTrafficRecordedLightInfo& Known) { return Known.LightId == Info.LightId; }))
+				{
+					Lights.Add(Info);
+				}
+			}
+		}
+
+		Cursor = ChunkEnd;
+	}
+
+	return true;
+}
+
+TArray<uint32> FTrafficRecordingReader::GetVehicleIds() const
+{
+	TSet<uint32> Ids;
+	for (const FTrafficRecordingFrame& Frame : Frames)
+	{
+		for (const FTrafficRecordedVehicle& Vehicle : Frame.Vehicles)
+		{
+			Ids.Add(Vehicle.TrafficId);
+		}
+	}
+
+	TArray<uint32> Result = Ids.Array();
+	Result.Sort();
+	return Result;
+}
+
+const FTrafficRecordedVehicle* FTrafficRecordingReader::FindVehicle(int32 FrameIndex, uint32 TrafficId) const
+{
+	if (!Frames.IsValidIndex(FrameIndex))
+	{
+		return nullptr;
+	}
+
+	// Kare içinde kimliğe göre artan sırada
+	const TArray<FTrafficRecordedVehicle>& Vehicles = Frames[FrameIndex].Vehicles;
+	const int32 Index = Algo::LowerBoundBy(Vehicles, TrafficId, &FTrafficRecordedVehicle::TrafficId);
+	return Vehicles.IsValidIndex(Index) && Vehicles[Index].TrafficId == TrafficId ? &Vehicles[Index] : nullptr;
+}
+
+bool FTrafficRecordingReader::GetTrack(uint32 TrafficId, TArray<FTrafficTrackPoint>& OutTrack) const
+{
+	OutTrack.Reset();
+
+	for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+	{
+		if (const FTrafficRecordedVehicle* Vehicle = FindVehicle(FrameIndex, TrafficId))
+		{
+			FTrafficTrackPoint& Point = OutTrack.AddDefaulted_GetRef();
+			Point.FrameIndex = FrameIndex;
+			Point.Time = Frames[FrameIndex].Time;
+			Point.State = *Vehicle;
+		}
+	}
+
+	return OutTrack.Num() > 0;
+}
+
+bool FTrafficRecordingReader::GetLightState(int32 FrameIndex, uint16 LightId, ETrafficLightState& OutState) const
+{
+	if (!Frames.IsValidIndex(FrameIndex))
+	{
+		return false;
+	}
+
+	for (const FTrafficRecordedLight& Light : Frames[FrameIndex].Lights)
+	{
+		if (Light.LightId == LightId)
+		{
+			OutState = Light.State;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VehicleAIController.h" // EVehicleBehavior, ETrafficLightState
+
+/**
+ * Trafik kaydı dosya formatı.
+ *
+ * Dosya: [Magic 'TRFC'][Version] ardından bağımsız çözülebilir chunk'lar.
+ * Chunk: [Magic 'CHNK'][FrameCount][PayloadSize][Payload]
+ * Her chunk'ın ilk karesi anahtar karedir (tüm alanlar sıfıra göre delta), sonraki
+ * kareler aynı aracın bir önceki karedeki kuantize durumuna göre delta kodlanır.
+ * Değişmeyen alanlar yazılmaz; duran bir araç kare başına ~2 byte tutar.
+ */
+namespace TrafficRecording
+{
+	constexpr uint32 FileMagic = 0x43465254; // 'TRFC'
+	constexpr uint32 ChunkMagic = 0x4B4E4843; // 'CHNK'
+	constexpr uint32 Version = 1;
+
+	/** Konum kuantizasyon adımı (cm). */
+	constexpr float LocationQuantum = 1.0f;
+
+	/** Hız ve şerit offset'i kuantizasyon adımı (cm/s, cm). */
+	constexpr float SpeedQuantum = 1.0f;
+
+	/** FTrafficRecordedVehicle::Flags bitleri. */
+	constexpr uint8 FlagPanicking = 1 << 0;
+	constexpr uint8 FlagFarField = 1 << 1;
+}
+
+/**
+ * Bir aracın bir adımdaki kaydedilen durumu.
+ */
+struct FTrafficRecordedVehicle
+{
+	/** Kalıcı araç kimliği (uzak / yakın alan geçişlerinde korunur). */
+	uint32 TrafficId = 0;
+
+	FVector Location = FVector::ZeroVector;
+
+	/** Yaw (derece). */
+	float Yaw = 0.0f;
+
+	float CurrentSpeed = 0.0f;
+	float TargetSpeed = 0.0f;
+	float LaneOffset = 0.0f;
+
+	EVehicleBehavior Behavior = EVehicleBehavior::Normal;
+
+	/** TrafficRecording::Flag* bitleri. */
+	uint8 Flags = 0;
+};
+
+/**
+ * Bir trafik ışığının bir adımdaki durumu.
+ */
+struct FTrafficRecordedLight
+{
+	/** Kayıt içi ışık kimliği (FTrafficRecordedLightInfo::LightId). */
+	uint16 LightId = 0;
+
+	ETrafficLightState State = ETrafficLightState::Green;
+};
+
+/**
+ * Kayıttaki bir trafik ışığının tanımı (ilk görüldüğü karede yazılır).
+ */
+struct FTrafficRecordedLightInfo
+{
+	uint16 LightId = 0;
+	FString Name;
+	FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Bir simülasyon adımının kaydı.
+ * Kayıt sırasında Vehicles TrafficId'ye göre artan sıradadır.
+ */
+struct FTrafficRecordingFrame
+{
+	/** Simülasyon adım sayacı. */
+	int32 StepIndex = 0;
+
+	/** Dünya zamanı (saniye). */
+	double Time = 0.0;
+
+	TArray<FTrafficRecordedVehicle> Vehicles;
+
+	/** Tüm ışıkların durumu (kodlayıcı sadece değişenleri yazar). */
+	TArray<FTrafficRecordedLight> Lights;
+
+	/** Bu karede ilk kez görülen ışıklar. */
+	TArray<FTrafficRecordedLightInfo> NewLights;
+
+	void Reset()
+	{
+		Vehicles.Reset();
+		Lights.Reset();
+		NewLights.Reset();
+	}
+};
+
+/**
+ * Kare kodlayıcı / çözücü.
+ * Delta referansı (önceki kuantize durumlar) chunk boyunca tutulur, BeginChunk ile sıfırlanır.
+ * Kayıt ve okuma tarafı aynı sınıfı kullanır.
+ */
+class YOURGAMENAME_API FTrafficRecordingCodec
+{
+public:
+	/** Yeni chunk: delta referansını sıfırlar (sonraki kare anahtar kare olur). */
+	void BeginChunk();
+
+	/** Kareyi Out'un sonuna kodlar. */
+	void EncodeFrame(const FTrafficRecordingFrame& Frame, TArray<uint8>& Out);
+
+	/**
+	 * Cursor'dan bir kare çözer.
+	 *
+	 * @return Veri bozuksa veya bittiyse false
+	 */
+	bool DecodeFrame(const uint8*& Cursor, const uint8* End, FTrafficRecordingFrame& OutFrame);
+
+private:
+	/** Aracın kuantize durumu (delta referansı). */
+	struct FQuantizedVehicle
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		int32 Z = 0;
+		int32 Yaw = 0;
+		int32 CurrentSpeed = 0;
+		int32 TargetSpeed = 0;
+		int32 LaneOffset = 0;
+		int32 State = 0; // Behavior | Flags << 8
+	};
+
+	// Alanlar değişim maskesi ile dizi gibi taranır
+	static_assert(sizeof(FQuantizedVehicle) == 8 * sizeof(int32), "FQuantizedVehicle must be tightly packed int32 fields");
+
+	static void Quantize(const FTrafficRecordedVehicle& Vehicle, FQuantizedVehicle& Out);
+	static void Dequantize(uint32 TrafficId, const FQuantizedVehicle& Quantized, FTrafficRecordedVehicle& Out);
+
+	TMap<uint32, FQuantizedVehicle> PreviousVehicles;
+	TMap<uint16, ETrafficLightState> PreviousLights;
+
+	/** Görülen tüm ışık tanımları (her chunk başında yeniden yazılır - chunk'lar bağımsız). */
+	TArray<FTrafficRecordedLightInfo> KnownLights;
+
+	bool bChunkStart = true;
+};
+
+/**
+ * Kareleri dosya formatına (başlık + chunk'lar) dönüştürür.
+ * Çıktı bellekte birikir; akış halinde yazan çağırıcı (FTrafficRecorder) tamamlanan
+ * chunk'ları ConsumeOutput ile alıp diske yazar.
+ */
+class YOURGAMENAME_API FTrafficRecordingWriter
+{
+public:
+	/** Dosya başlığını yazar. */
+	explicit FTrafficRecordingWriter(int32 InFramesPerChunk = 64);
+
+	/** Kareyi kodlar (araçlar TrafficId'ye göre artan sırada olmalı). Chunk dolunca çıktıya eklenir. */
+	void AddFrame(const FTrafficRecordingFrame& Frame);
+
+	/** Yarım kalan chunk'ı çıktıya ekler. */
+	void Finish();
+
+	/** Biriken çıktıyı Out'a taşır (Out'un önceki içeriği silinir). */
+	void ConsumeOutput(TArray<uint8>& Out);
+
+	/** Tüm çıktıyı dosyaya yazar (Finish çağrılmış olmalı). */
+	bool SaveToFile(const FString& FilePath) const;
+
+private:
+	FTrafficRecordingCodec Codec;
+	TArray<uint8> ChunkPayload;
+	TArray<uint8> Output;
+	int32 FramesInChunk;
+	int32 FramesPerChunk;
+};
+
+/**
+ * Kaydedilmiş bir iz noktası (GetTrack sonucu).
+ */
+struct FTrafficTrackPoint
+{
+	int32 FrameIndex = 0;
+	double Time = 0.0;
+	FTrafficRecordedVehicle State;
+};
+
+/**
+ * Kayıt okuyucu.
+ * Dosyayı tamamen çözer ve kareler / araç izleri üzerinde sorgu sağlar.
+ * Dünya veya aktör gerektirmez (headless analiz, commandlet, harici araçlar).
+ */
+class YOURGAMENAME_API FTrafficRecordingReader
+{
+public:
+	/**
+	 * Kaydı yükler.
+	 *
+	 * @return Dosya okunamadıysa veya format geçersizse false
+	 */
+	bool Open(const FString& FilePath);
+
+	/** Bellekteki kayıt verisini yükler. */
+	bool OpenFromMemory(const TArray<uint8>& Data);
+
+	int32 GetFrameCount() const { return Frames.Num(); }
+
+	const FTrafficRecordingFrame& GetFrame(int32 FrameIndex) const { return Frames[FrameIndex]; }
+
+	/** Kayıtta görülen tüm araç kimlikleri (artan sırada). */
+	TArray<uint32> GetVehicleIds() const;
+
+	/**
+	 * Aracın kaydedildiği tüm karelerdeki durumunu döndürür.
+	 *
+	 * @return Araç hiç kaydedilmediyse false
+	 */
+	bool GetTrack(uint32 TrafficId, TArray<FTrafficTrackPoint>& OutTrack) const;
+
+	/** Aracın belirli bir karedeki durumu (yoksa nullptr). */
+	const FTrafficRecordedVehicle* FindVehicle(int32 FrameIndex, uint32 TrafficId) const;
+
+	/** Işığın belirli bir karedeki durumu. */
+	bool GetLightState(int32 FrameIndex, uint16 LightId, ETrafficLightState& OutState) const;
+
+	const TArray<FTrafficRecordedLightInfo>& GetLights() const { return Lights; }
+
+private:
+	TArray<FTrafficRecordingFrame> Frames;
+	TArray<FTrafficRecordedLightInfo> Lights;
+};
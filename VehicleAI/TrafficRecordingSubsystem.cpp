@@ -0,0 +1,664 @@
+#include "TrafficRecordingSubsystem.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "TrafficArchetype.h"
+#include "TrafficCheckpoint.h"
+#include "TrafficLight.h"
+#include "TrafficSubsystem.h"
+#include "Vehicle.h"
+#include "VehicleAIController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Traffic Recording Capture"), STAT_TrafficRecordingCapture, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recording Dropped Frames"), STAT_TrafficRecordingDroppedFrames, STATGROUP_Traffic);
+
+UTrafficRecordingSubsystem::UTrafficRecordingSubsystem()
+{
+	RecordingRingCapacity = 16;
+	RecordingFramesPerChunk = 64;
+}
+
+void UTrafficRecordingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TrafficSubsystem = Collection.InitializeDependency<UTrafficSubsystem>();
+	if (TrafficSubsystem)
+	{
+		StepReadyHandle = TrafficSubsystem->OnStepReady.AddUObject(this, &UTrafficRecordingSubsystem::HandleStepReady);
+	}
+}
+
+void UTrafficRecordingSubsystem::Deinitialize()
+{
+	StopRecording();
+
+	if (TrafficSubsystem)
+	{
+		TrafficSubsystem->OnStepReady.Remove(StepReadyHandle);
+		TrafficSubsystem = nullptr;
+	}
+	StepReadyHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UTrafficRecordingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// UTrafficSubsystem ile aynı dünyalar
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UTrafficRecordingSubsystem::StartRecording(const FString& FilePath)
+{
+	RecordedLightIds.Reset();
+
+	if (!Recorder.Start(FilePath, RecordingRingCapacity, RecordingFramesPerChunk))
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Trafik kaydı başladı: %s"), *FilePath);
+	return true;
+}
+
+void UTrafficRecordingSubsystem::StopRecording()
+{
+	if (!Recorder.IsRecording())
+	{
+		return;
+	}
+
+	Recorder.Stop();
+	UE_LOG(LogTemp, Log, TEXT("Trafik kaydı bitti: %lld byte, %d kare düşürüldü"), Recorder.GetBytesWritten(), Recorder.GetDroppedFrameCount());
+}
+
+void UTrafficRecordingSubsystem::HandleStepReady(UTrafficSubsystem* InTrafficSubsystem)
+{
+	if (!Recorder.IsRecording())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TrafficRecordingCapture);
+
+	// Oyun thread'inde sadece ham kopya; kuantizasyon ve kodlama kayıt thread'inde
+	FTrafficRecordingFrame* Frame = Recorder.BeginFrame();
+	if (!Frame)
+	{
+		SET_DWORD_STAT(STAT_TrafficRecordingDroppedFrames, Recorder.GetDroppedFrameCount());
+		return;
+	}
+
+	CaptureFrame(*Frame);
+	Recorder.CommitFrame();
+}
+
+void UTrafficRecordingSubsystem::CaptureFrame(FTrafficRecordingFrame& OutFrame)
+{
+	if (!TrafficSubsystem)
+	{
+		return;
+	}
+
+	// Worker'daki adım görünüm alınırken beklenir
+	const TArrayView<const FTrafficLane> Lanes = TrafficSubsystem->GetLanes();
+	const TArrayView<AVehicleAIController* const> Controllers = TrafficSubsystem->GetControllers();
+	const TArrayView<const FFarFieldVehicleClass> FarFieldClasses = TrafficSubsystem->GetFarFieldClasses();
+
+	UWorld* World = GetWorld();
+	OutFrame.StepIndex = TrafficSubsystem->GetStepIndex();
+	OutFrame.Time = World ? World->GetTimeSeconds() : 0.0;
+	OutFrame.Vehicles.Reserve(Controllers.Num() + TrafficSubsystem->GetFarFieldVehicleCount());
+
+	// Yakın alan: tüm kayıtlı controller'lar (şeride bağlı olmasalar da)
+	for (const AVehicleAIController* Controller : Controllers)
+	{
+		const APawn* Pawn = Controller->GetPawn();
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		FTrafficRecordedVehicle& Vehicle = OutFrame.Vehicles.AddDefaulted_GetRef();
+		Vehicle.TrafficId = Controller->TrafficId;
+		Vehicle.Location = Pawn->GetActorLocation();
+		Vehicle.Yaw = Pawn->GetActorRotation().Yaw;
+		Vehicle.CurrentSpeed = Controller->CurrentSpeed;
+		Vehicle.TargetSpeed = Controller->TargetSpeed;
+		Vehicle.LaneOffset = Controller->CurrentLaneOffset;
+		Vehicle.Behavior = Controller->CurrentVehicleBehavior;
+		Vehicle.Flags = Controller->bIsPanicking ? TrafficRecording::FlagPanicking : 0;
+	}
+
+	// Uzak alan: konum ve yön şerit örnek noktalarından (spline sorgusu yok)
+	for (int32 LaneId = 0; LaneId < Lanes.Num(); ++LaneId)
+	{
+		const FTrafficLane& Lane = Lanes[LaneId];
+		if (Lane.FarField.Num() == 0 || Lane.SamplePoints.Num() < 2)
+		{
+			continue;
+		}
+
+		for (int32 Index = 0; Index < Lane.FarField.Num(); ++Index)
+		{
+			const FFarFieldVehicle& FarVehicle = Lane.FarField[Index];
+			const float Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, Lane.Length);
+
+			FTrafficRecordedVehicle& Vehicle = OutFrame.Vehicles.AddDefaulted_GetRef();
+			FRotator Rotation;
+			TrafficSubsystem->GetLaneTransform(LaneId, Distance, Vehicle.Location, Rotation);
+			Vehicle.TrafficId = Lane.FarFieldIds[Index];
+			Vehicle.Yaw = Rotation.Yaw;
+			Vehicle.CurrentSpeed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+			Vehicle.TargetSpeed = FarFieldClasses.IsValidIndex(FarVehicle.ClassIndex)
+				? FTrafficArchetypeTable::Get(FarFieldClasses[FarVehicle.ClassIndex].ArchetypeIndex).MaxSpeed
+				: Vehicle.CurrentSpeed;
+			Vehicle.LaneOffset = Lane.LaneOffset;
+			Vehicle.Flags = TrafficRecording::FlagFarField;
+		}
+	}
+
+	// Işıklar: kimlik ilk görüldüğünde atanır ve tanımı kareye eklenir
+	for (const TWeakObjectPtr<ATrafficLight>& LightPtr : TrafficSubsystem->GetTrafficLights())
+	{
+		const ATrafficLight* Light = LightPtr.Get();
+		if (!Light)
+		{
+			continue;
+		}
+
+		uint16 LightId;
+		if (const uint16* ExistingId = RecordedLightIds.Find(LightPtr))
+		{
+			LightId = *ExistingId;
+		}
+		else
+		{
+			LightId = (uint16)RecordedLightIds.Num();
+			RecordedLightIds.Add(LightPtr, LightId);
+
+			FTrafficRecordedLightInfo& Info = OutFrame.NewLights.AddDefaulted_GetRef();
+			Info.LightId = LightId;
+			Info.Name = Light->GetName();
+			Info.Location = Light->GetActorLocation();
+		}
+
+		FTrafficRecordedLight& RecordedLight = OutFrame.Lights.AddDefaulted_GetRef();
+		RecordedLight.LightId = LightId;
+		RecordedLight.State = Light->GetCurrentState();
+	}
+}
+
+bool UTrafficRecordingSubsystem::SaveCheckpoint(TArray<uint8>& OutData)
+{
+	if (!TrafficSubsystem)
+	{
+		return false;
+	}
+
+	UTrafficSubsystem& Traffic = *TrafficSubsystem;
+	Traffic.FinishPipelinedStep();
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	const float WorldTime = World->GetTimeSeconds();
+
+	// Kayıt sıfırdan doldurulur: dolgu byte'ları da sabit (aynı durum = aynı dosya)
+	auto AddVehicleRecord = [&Traffic, WorldTime](TArray<FTrafficCheckpointVehicle>& Records, const AVehicleAIController* Controller, int32 LaneId)
+	{
+		const APawn* ControlledPawn = Controller->GetPawn();
+		const int32 ClassIndex = ControlledPawn ? Traffic.FindOrAddFarFieldClass(ControlledPawn->GetClass()) : INDEX_NONE;
+		if (ClassIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		FTrafficCheckpointVehicle& Vehicle = Records.AddZeroed_GetRef();
+		Vehicle.TrafficId = Controller->TrafficId;
+		Vehicle.LaneId = LaneId;
+		Vehicle.Distance = LaneId != INDEX_NONE ? Controller->DistanceAlongLane : 0.0f;
+		Vehicle.CurrentSpeed = Controller->CurrentSpeed;
+		Vehicle.TargetSpeed = Controller->TargetSpeed;
+		Vehicle.CurrentLaneOffset = Controller->CurrentLaneOffset;
+		Vehicle.TargetLaneOffset = Controller->TargetLaneOffset;
+		Vehicle.PanicRemaining = Controller->bIsPanicking ? FMath::Max(Controller->PanicEndTime - WorldTime, KINDA_SMALL_NUMBER) : 0.0f;
+		Vehicle.Location = ControlledPawn->GetActorLocation();
+		const FQuat Rotation = ControlledPawn->GetActorQuat();
+		Vehicle.Rotation[0] = Rotation.X;
+		Vehicle.Rotation[1] = Rotation.Y;
+		Vehicle.Rotation[2] = Rotation.Z;
+		Vehicle.Rotation[3] = Rotation.W;
+		Vehicle.PanicEscapeDirection = FVector3f(Controller->PanicEscapeDirection);
+		Vehicle.ClassIndex = (uint16)ClassIndex;
+		Vehicle.Behavior = (uint8)Controller->CurrentVehicleBehavior;
+		return true;
+	};
+
+	auto SortById = [](const FTrafficCheckpointVehicle& A, const FTrafficCheckpointVehicle& B)
+	{
+		return A.TrafficId < B.TrafficId;
+	};
+
+	// Yakın alan: şeride bağlı araçlar, kimliğe göre sıralı (kayıt sırasından bağımsız çıktı)
+	TArray<FTrafficCheckpointVehicle> Vehicles;
+	TArray<int32, TInlineAllocator<64>> NumNearField;
+	Vehicles.Reserve(Traffic.GetNearFieldVehicleCount());
+	NumNearField.SetNumZeroed(Traffic.Lanes.Num());
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		for (const AVehicleAIController* Controller : Traffic.Lanes[LaneId].Vehicles)
+		{
+			NumNearField[LaneId] += AddVehicleRecord(Vehicles, Controller, LaneId) ? 1 : 0;
+		}
+	}
+	Vehicles.Sort(SortById);
+
+	// Şeride bağlı olmayan kayıtlı araçlar: konum ve dönüş kaydı (geri yüklemede kimlikle eşlenir)
+	TArray<FTrafficCheckpointVehicle> FreeVehicles;
+	for (const AVehicleAIController* Controller : Traffic.Controllers)
+	{
+		if (Controller->LaneId == INDEX_NONE)
+		{
+			AddVehicleRecord(FreeVehicles, Controller, INDEX_NONE);
+		}
+	}
+	FreeVehicles.Sort(SortById);
+
+	const int32 NumFarField = Traffic.GetFarFieldVehicleCount();
+	OutData.Reserve(1024 + Traffic.Lanes.Num() * sizeof(FTrafficCheckpointLane) + NumFarField * (sizeof(FFarFieldVehicle) + sizeof(uint32))
+		+ (Vehicles.Num() + FreeVehicles.Num()) * sizeof(FTrafficCheckpointVehicle) + Traffic.TrafficLights.Num() * sizeof(FTrafficCheckpointLight));
+
+	FTrafficCheckpointWriter Writer(OutData);
+
+	FTrafficCheckpointGlobals Globals;
+	Globals.NextTrafficId = Traffic.NextTrafficId;
+	Globals.StepIndex = Traffic.StepIndex;
+	Globals.FarFieldTimeAccumulator = Traffic.FarFieldTimeAccumulator;
+	Globals.NumLanes = Traffic.Lanes.Num();
+	Writer.AddBlock(TrafficCheckpoint::GlobalsTag, FTrafficCheckpointGlobals::Version, &Globals, 1);
+
+	Writer.BeginBlock(TrafficCheckpoint::LanesTag, FTrafficCheckpointLane::Version, sizeof(FTrafficCheckpointLane));
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		const FTrafficLane& Lane = Traffic.Lanes[LaneId];
+		FTrafficCheckpointLane Record;
+		Record.Length = Lane.Length;
+		Record.ClosureDistance = Lane.ClosureDistance;
+		Record.NumFarField = Lane.FarField.Num();
+		Record.NumNearField = NumNearField[LaneId];
+		Writer.Append(&Record, 1);
+	}
+	Writer.EndBlock();
+
+	// Uzak alan: şerit dizileri olduğu gibi (ara kopya yok)
+	Writer.BeginBlock(TrafficCheckpoint::FarFieldTag, TrafficCheckpoint::FarFieldVersion, sizeof(FFarFieldVehicle));
+	for (const FTrafficLane& Lane : Traffic.Lanes)
+	{
+		Writer.Append(Lane.FarField.GetData(), Lane.FarField.Num());
+	}
+	Writer.EndBlock();
+
+	Writer.BeginBlock(TrafficCheckpoint::FarFieldIdsTag, TrafficCheckpoint::FarFieldIdsVersion, sizeof(uint32));
+	for (const FTrafficLane& Lane : Traffic.Lanes)
+	{
+		Writer.Append(Lane.FarFieldIds.GetData(), Lane.FarFieldIds.Num());
+	}
+	Writer.EndBlock();
+
+	Writer.AddBlock(TrafficCheckpoint::NearFieldTag, FTrafficCheckpointVehicle::Version, Vehicles.GetData(), Vehicles.Num());
+	Writer.AddBlock(TrafficCheckpoint::FreeVehiclesTag, FTrafficCheckpointVehicle::Version, FreeVehicles.GetData(), FreeVehicles.Num());
+
+	// Işıklar: kayıt sırasıyla, faz zamanı şimdiye göre
+	Writer.BeginBlock(TrafficCheckpoint::LightsTag, FTrafficCheckpointLight::Version, sizeof(FTrafficCheckpointLight));
+	for (const TWeakObjectPtr<ATrafficLight>& LightPtr : Traffic.TrafficLights)
+	{
+		const ATrafficLight* Light = LightPtr.Get();
+		if (!Light)
+		{
+			continue;
+		}
+
+		FTrafficCheckpointLight Record;
+		FMemory::Memzero(Record);
+		Record.Location = Light->GetActorLocation();
+		Record.GreenDuration = Light->GetPhaseDuration(ETrafficLightState::Green);
+		Record.YellowDuration = Light->GetPhaseDuration(ETrafficLightState::Yellow);
+		Record.RedDuration = Light->GetPhaseDuration(ETrafficLightState::Red);
+		Record.PhaseElapsed = Light->GetPhaseElapsedTime();
+		Record.TimerRemaining = Light->GetPhaseTimeRemaining();
+		Record.State = (uint8)Light->GetCurrentState();
+		Writer.Append(&Record, 1);
+	}
+	Writer.EndBlock();
+
+	// Sınıf tablosu en son: yakın alan araçları yukarıda yeni sınıf ekleyebilir
+	Writer.BeginBlock(TrafficCheckpoint::ClassesTag, TrafficCheckpoint::ClassesVersion, sizeof(ANSICHAR));
+	for (const FFarFieldVehicleClass& VehicleClass : Traffic.FarFieldClasses)
+	{
+		const FTCHARToUTF8 Utf8Path(*VehicleClass.VehicleClass->GetPathName());
+		const ANSICHAR Terminator = 0;
+		Writer.Append(reinterpret_cast<const ANSICHAR*>(Utf8Path.Get()), Utf8Path.Length());
+		Writer.Append(&Terminator, 1);
+	}
+	Writer.EndBlock();
+
+	return true;
+}
+
+bool UTrafficRecordingSubsystem::RestoreCheckpoint(TArrayView<const uint8> Data)
+{
+	if (!TrafficSubsystem)
+	{
+		return false;
+	}
+
+	UTrafficSubsystem& Traffic = *TrafficSubsystem;
+	Traffic.FinishPipelinedStep();
+
+	UWorld* World = GetWorld();
+	FTrafficCheckpointReader Reader;
+	if (!World || !Reader.OpenFromMemory(Data))
+	{
+		return false;
+	}
+
+	TArrayView<const FTrafficCheckpointGlobals> Globals;
+	TArrayView<const FTrafficCheckpointLane> LaneRecords;
+	TArrayView<const FFarFieldVehicle> FarField;
+	TArrayView<const uint32> FarFieldIds;
+	TArrayView<const FTrafficCheckpointVehicle> Vehicles;
+	TArrayView<const FTrafficCheckpointVehicle> FreeVehicles;
+	TArrayView<const FTrafficCheckpointLight> LightRecords;
+	TArrayView<const ANSICHAR> ClassPaths;
+	if (!Reader.GetBlock(TrafficCheckpoint::GlobalsTag, FTrafficCheckpointGlobals::Version, Globals) || Globals.Num() != 1
+		|| !Reader.GetBlock(TrafficCheckpoint::LanesTag, FTrafficCheckpointLane::Version, LaneRecords)
+		|| !Reader.GetBlock(TrafficCheckpoint::FarFieldTag, TrafficCheckpoint::FarFieldVersion, FarField)
+		|| !Reader.GetBlock(TrafficCheckpoint::FarFieldIdsTag, TrafficCheckpoint::FarFieldIdsVersion, FarFieldIds)
+		|| !Reader.GetBlock(TrafficCheckpoint::NearFieldTag, FTrafficCheckpointVehicle::Version, Vehicles)
+		|| !Reader.GetBlock(TrafficCheckpoint::FreeVehiclesTag, FTrafficCheckpointVehicle::Version, FreeVehicles)
+		|| !Reader.GetBlock(TrafficCheckpoint::LightsTag, FTrafficCheckpointLight::Version, LightRecords)
+		|| !Reader.GetBlock(TrafficCheckpoint::ClassesTag, TrafficCheckpoint::ClassesVersion, ClassPaths))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: eksik veya uyumsuz sürümde blok"));
+		return false;
+	}
+
+	// Doğrulama (durum değiştirilmeden önce): şerit ID'leri ve ışık sırası bu dünyayla aynı olmalı
+	if (LaneRecords.Num() != Traffic.Lanes.Num() || Globals[0].NumLanes != Traffic.Lanes.Num() || FarField.Num() != FarFieldIds.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: şerit sayısı uyuşmuyor (%d / %d)"), LaneRecords.Num(), Traffic.Lanes.Num());
+		return false;
+	}
+
+	int32 NumFarField = 0;
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		if (!FMath::IsNearlyEqual(LaneRecords[LaneId].Length, Traffic.Lanes[LaneId].Length, 1.0f) || LaneRecords[LaneId].NumFarField < 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: şerit %d uzunluğu uyuşmuyor"), LaneId);
+			return false;
+		}
+		NumFarField += LaneRecords[LaneId].NumFarField;
+	}
+	if (NumFarField != FarField.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: uzak alan sayısı uyuşmuyor"));
+		return false;
+	}
+
+	TArray<ATrafficLight*, TInlineAllocator<64>> Lights;
+	for (const TWeakObjectPtr<ATrafficLight>& LightPtr : Traffic.TrafficLights)
+	{
+		if (ATrafficLight* Light = LightPtr.Get())
+		{
+			Lights.Add(Light);
+		}
+	}
+	if (Lights.Num() != LightRecords.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: ışık sayısı uyuşmuyor (%d / %d)"), LightRecords.Num(), Lights.Num());
+		return false;
+	}
+	for (int32 Index = 0; Index < Lights.Num(); ++Index)
+	{
+		if (!FVector::PointsAreNear(Lights[Index]->GetActorLocation(), FVector(LightRecords[Index].Location), 1.0f))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: ışık %d konumu uyuşmuyor (%s)"), Index, *Lights[Index]->GetName());
+			return false;
+		}
+	}
+
+	// Sınıflar kayıttaki sırayla (uzak alan ClassIndex değerleri dönüştürülmeden kopyalanabilsin)
+	TArray<TSubclassOf<AVehicle>, TInlineAllocator<16>> Classes;
+	for (int32 Start = 0; Start < ClassPaths.Num();)
+	{
+		const int32 PathLength = FCStringAnsi::Strnlen(ClassPaths.GetData() + Start, ClassPaths.Num() - Start);
+		const FString Path(FUTF8ToTCHAR(ClassPaths.GetData() + Start, PathLength));
+		UClass* VehicleClass = LoadClass<AVehicle>(nullptr, *Path);
+		if (!VehicleClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: araç sınıfı yüklenemedi: %s"), *Path);
+			return false;
+		}
+		// Tekrarlanan sınıf FindOrAddFarFieldClass'ta birleşir ve kayıttaki indeksler kayardı
+		if (Classes.Contains(VehicleClass))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: araç sınıfı tekrarlanıyor: %s"), *Path);
+			return false;
+		}
+		Classes.Add(VehicleClass);
+		Start += PathLength + 1;
+	}
+	if (Classes.Num() > MAX_uint8 + 1)
+	{
+		return false;
+	}
+	TArray<int32, TInlineAllocator<64>> NumNearField;
+	NumNearField.SetNumZeroed(Traffic.Lanes.Num());
+	for (const FTrafficCheckpointVehicle& Vehicle : Vehicles)
+	{
+		if (!Traffic.Lanes.IsValidIndex(Vehicle.LaneId) || !Classes.IsValidIndex(Vehicle.ClassIndex))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: geçersiz araç kaydı (%u)"), Vehicle.TrafficId);
+			return false;
+		}
+		++NumNearField[Vehicle.LaneId];
+	}
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		if (NumNearField[LaneId] != LaneRecords[LaneId].NumNearField)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: şerit %d yakın alan sayısı uyuşmuyor (%d / %d)"), LaneId, NumNearField[LaneId], LaneRecords[LaneId].NumNearField);
+			return false;
+		}
+	}
+
+	// Şeride bağlı olmayan araçlar bu dünyada zaten kayıtlı olmalı: aynı kimlik ve sınıfla eşlenir.
+	// Eşleşmeyen kayıtlar ve kayıtta olmayan controller'lar geri alınamaz - uyarı ile bırakılır.
+	TMap<uint32, AVehicleAIController*> FreeControllers;
+	for (AVehicleAIController* Controller : Traffic.Controllers)
+	{
+		if (Controller->LaneId == INDEX_NONE && Controller->GetPawn())
+		{
+			FreeControllers.Add(Controller->TrafficId, Controller);
+		}
+	}
+	TArray<TPair<AVehicleAIController*, const FTrafficCheckpointVehicle*>> FreeMatches;
+	int32 NumUnmatchedFree = 0;
+	for (int32 Index = 0; Index < FreeVehicles.Num(); ++Index)
+	{
+		const FTrafficCheckpointVehicle& Vehicle = FreeVehicles[Index];
+		if (Vehicle.LaneId != INDEX_NONE || !Classes.IsValidIndex(Vehicle.ClassIndex) || (Index > 0 && Vehicle.TrafficId <= FreeVehicles[Index - 1].TrafficId))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: geçersiz şeritsiz araç kaydı (%u)"), Vehicle.TrafficId);
+			return false;
+		}
+
+		AVehicleAIController* Controller = nullptr;
+		if (FreeControllers.RemoveAndCopyValue(Vehicle.TrafficId, Controller) && Controller->GetPawn()->GetClass() == Classes[Vehicle.ClassIndex].Get())
+		{
+			FreeMatches.Emplace(Controller, &Vehicle);
+		}
+		else
+		{
+			++NumUnmatchedFree;
+		}
+	}
+
+	// Uzak alan kayıtları olduğu gibi kopyalanır ve worker'da sınırsız indekslenir (BuildQueue):
+	// sınıf, şerit ve önden arkaya sıra burada doğrulanır
+	int32 FarCheckOffset = 0;
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		const int32 Count = LaneRecords[LaneId].NumFarField;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FFarFieldVehicle& FarVehicle = FarField[FarCheckOffset + Index];
+			const bool bOrdered = Index == 0 || FarVehicle.QuantizedDistance <= FarField[FarCheckOffset + Index - 1].QuantizedDistance;
+			if (FarVehicle.LaneId != LaneId || !Classes.IsValidIndex(FarVehicle.ClassIndex) || !bOrdered || FarFieldIds[FarCheckOffset + Index] == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: şerit %d uzak alan kaydı %d geçersiz (%u)"), LaneId, Index, FarFieldIds[FarCheckOffset + Index]);
+				return false;
+			}
+		}
+		FarCheckOffset += Count;
+	}
+
+	// Mevcut şeride bağlı aktörler kaldırılır (kayıt silme şerit dizisini değiştirir - önce topla)
+	TArray<AVehicleAIController*> Existing;
+	for (const FTrafficLane& Lane : Traffic.Lanes)
+	{
+		Existing.Append(Lane.Vehicles);
+	}
+	for (AVehicleAIController* Controller : Existing)
+	{
+		Traffic.DestroyNearFieldVehicle(Controller);
+	}
+
+	Traffic.FarFieldClasses.Reset();
+	for (const TSubclassOf<AVehicle>& VehicleClass : Classes)
+	{
+		Traffic.FindOrAddFarFieldClass(VehicleClass);
+	}
+
+	// Uzak alan: şerit başına tek kopyalama
+	int32 FarOffset = 0;
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		FTrafficLane& Lane = Traffic.Lanes[LaneId];
+		const int32 Count = LaneRecords[LaneId].NumFarField;
+
+		Lane.FarField.SetNumUninitialized(Count, false);
+		Lane.FarFieldIds.SetNumUninitialized(Count, false);
+		FMemory::Memcpy(Lane.FarField.GetData(), FarField.GetData() + FarOffset, Count * sizeof(FFarFieldVehicle));
+		FMemory::Memcpy(Lane.FarFieldIds.GetData(), FarFieldIds.GetData() + FarOffset, Count * sizeof(uint32));
+		FarOffset += Count;
+
+		Lane.ClosureDistance = LaneRecords[LaneId].ClosureDistance;
+	}
+
+	// Yakın alan: spawn, sonra aktör kaydedilen konum ve dönüşe taşınır
+	int32 NumFailed = 0;
+	for (const FTrafficCheckpointVehicle& Vehicle : Vehicles)
+	{
+		AVehicleAIController* Controller = Traffic.SpawnLaneVehicle(Vehicle.LaneId, Vehicle.ClassIndex, Vehicle.Distance, Vehicle.CurrentSpeed, Vehicle.TrafficId);
+		if (!Controller)
+		{
+			++NumFailed;
+			continue;
+		}
+
+		Controller->GetPawn()->SetActorLocationAndRotation(FVector(Vehicle.Location), FQuat(Vehicle.Rotation[0], Vehicle.Rotation[1], Vehicle.Rotation[2], Vehicle.Rotation[3]), false, nullptr, ETeleportType::TeleportPhysics);
+		Controller->TargetSpeed = Vehicle.TargetSpeed;
+		Controller->CurrentLaneOffset = Vehicle.CurrentLaneOffset;
+		Controller->TargetLaneOffset = Vehicle.TargetLaneOffset;
+
+		if (Vehicle.PanicRemaining > 0.0f)
+		{
+			Controller->PanicEscapeDirection = FVector(Vehicle.PanicEscapeDirection);
+			Traffic.SchedulePanic(Controller, Vehicle.PanicRemaining);
+		}
+		Controller->SetBehavior((EVehicleBehavior)Vehicle.Behavior);
+	}
+
+	// Şeritsiz araçlar: mevcut aktör kaydedilen konuma ve duruma taşınır
+	for (const TPair<AVehicleAIController*, const FTrafficCheckpointVehicle*>& Match : FreeMatches)
+	{
+		AVehicleAIController* Controller = Match.Key;
+		const FTrafficCheckpointVehicle& Vehicle = *Match.Value;
+
+		Controller->GetPawn()->SetActorLocationAndRotation(FVector(Vehicle.Location), FQuat(Vehicle.Rotation[0], Vehicle.Rotation[1], Vehicle.Rotation[2], Vehicle.Rotation[3]), false, nullptr, ETeleportType::TeleportPhysics);
+		Controller->CurrentSpeed = Vehicle.CurrentSpeed;
+		Controller->TargetSpeed = Vehicle.TargetSpeed;
+		Controller->CurrentLaneOffset = Vehicle.CurrentLaneOffset;
+		Controller->TargetLaneOffset = Vehicle.TargetLaneOffset;
+
+		if (Vehicle.PanicRemaining > 0.0f)
+		{
+			Controller->PanicEscapeDirection = FVector(Vehicle.PanicEscapeDirection);
+			Traffic.SchedulePanic(Controller, Vehicle.PanicRemaining);
+		}
+		else if (Controller->bIsPanicking)
+		{
+			// Çarktaki bitiş girdisi nesil farkıyla yok sayılır
+			++Controller->PanicGeneration;
+			Controller->DisablePanicMode();
+		}
+		Controller->SetBehavior((EVehicleBehavior)Vehicle.Behavior);
+	}
+
+	for (int32 Index = 0; Index < Lights.Num(); ++Index)
+	{
+		const FTrafficCheckpointLight& Record = LightRecords[Index];
+		Lights[Index]->RestorePhase((ETrafficLightState)Record.State, Record.GreenDuration, Record.YellowDuration, Record.RedDuration, Record.PhaseElapsed, Record.TimerRemaining);
+	}
+
+	// Sayaçlar en son: spawn edilen controller'lar BeginPlay'de kimlik alır
+	Traffic.NextTrafficId = Globals[0].NextTrafficId;
+	Traffic.StepIndex = Globals[0].StepIndex;
+	Traffic.FarFieldTimeAccumulator = Globals[0].FarFieldTimeAccumulator;
+
+	Traffic.bSpatialHashValid = false;
+	Traffic.bOccupancyGridValid = false;
+	++Traffic.StateRevision;
+
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: %d yakın alan aracı spawn edilemedi"), NumFailed);
+	}
+	if (NumUnmatchedFree > 0 || FreeControllers.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası: %d şeritsiz araç kaydı eşlenmedi, %d şeritsiz araç kayıtta yok (geri alınmadı)"), NumUnmatchedFree, FreeControllers.Num());
+	}
+
+	return true;
+}
+
+bool UTrafficRecordingSubsystem::SaveCheckpointToFile(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	if (!SaveCheckpoint(Data) || !FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası yazılamadı: %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Trafik kontrol noktası yazıldı: %s (%d byte)"), *FilePath, Data.Num());
+	return true;
+}
+
+bool UTrafficRecordingSubsystem::LoadCheckpointFromFile(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik kontrol noktası okunamadı: %s"), *FilePath);
+		return false;
+	}
+
+	return RestoreCheckpoint(Data);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrafficRecorder.h"
+#include "TrafficRecordingSubsystem.generated.h"
+
+class ATrafficLight;
+class UTrafficSubsystem;
+
+/**
+ * Trafik kayıt ve kontrol noktası alt sistemi.
+ * UTrafficSubsystem'in her adımını (OnStepReady) kayıt halkasına yazar; kodlama ve dosyaya
+ * yazma FTrafficRecorder'ın arka plan thread'indedir. Kayıt simülasyon durumunu sadece okur;
+ * kontrol noktası geri yükleme trafik alt sisteminin durumunu baştan kurar.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficRecordingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficRecordingSubsystem();
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ============================================
+	// KAYIT
+	// ============================================
+
+	/**
+	 * Her adımda tüm araçların (yakın + uzak alan) ve ışıkların durumunu dosyaya kaydetmeye başlar.
+	 * Kodlama ve yazma arka plan thread'inde yapılır; okumak için FTrafficRecordingReader.
+	 *
+	 * @param FilePath Kayıt dosyası (ör. Saved/Traffic/Session.trec)
+	 * @return Kayıt başladıysa true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Recording")
+	bool StartRecording(const FString& FilePath);
+
+	/** Kaydı bitirir ve dosyayı kapatır. */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Recording")
+	void StopRecording();
+
+	UFUNCTION(BlueprintCallable, Category = "Traffic Recording")
+	bool IsRecording() const { return Recorder.IsRecording(); }
+
+	/**
+	 * Bu adımın durumunu kareye kopyalar (kayıt ve headless karşılaştırma aynı veriyi kullanır).
+	 * Araçlar sıralı değildir; yazmadan önce TrafficId'ye göre sıralanmalıdır.
+	 */
+	void CaptureFrame(FTrafficRecordingFrame& OutFrame);
+
+	// ============================================
+	// KONTROL NOKTASI
+	// ============================================
+
+	/**
+	 * Tüm trafik durumunu sürümlü ikili bloklara yazar (FTrafficCheckpointWriter): sayaçlar,
+	 * şeritler, uzak alan dizileri (şeritlerden doğrudan), şeride bağlı yakın alan araçları,
+	 * şeride bağlı olmayan kayıtlı araçların konum ve dönüşü ve ışık fazları. Çalışan manevralar,
+	 * yayalar ve bölge hayaletleri kaydedilmez.
+	 *
+	 * @return Dünya yoksa false
+	 */
+	bool SaveCheckpoint(TArray<uint8>& OutData);
+
+	/**
+	 * Kontrol noktasını geri yükler. Dünya aynı senaryoyla kurulmuş olmalıdır (şeritler ve ışıklar
+	 * aynı sırada kayıtlı). Şeride bağlı aktörler yok edilip kayıttakiler spawn edilir; uzak alan
+	 * dizileri şerit başına tek kopyalama ile yazılır. Şeride bağlı olmayan aktörlerin sahibi
+	 * trafik alt sistemi değildir: aynı TrafficId ve sınıfla kayıtlı olan controller kaydedilen duruma taşınır,
+	 * eşleşmeyenler uyarıyla olduğu gibi bırakılır.
+	 *
+	 * @return Format, şeritler, ışıklar veya sınıflar uyuşmazsa false (durum değişmez)
+	 */
+	bool RestoreCheckpoint(TArrayView<const uint8> Data);
+
+	UFUNCTION(BlueprintCallable, Category = "Traffic Checkpoint")
+	bool SaveCheckpointToFile(const FString& FilePath);
+
+	UFUNCTION(BlueprintCallable, Category = "Traffic Checkpoint")
+	bool LoadCheckpointFromFile(const FString& FilePath);
+
+protected:
+	/** Kayıt halka tamponundaki kare sayısı. Disk yetişemezse bu kadar kare beklenir, sonra düşürülür. */
+	UPROPERTY(Config)
+	int32 RecordingRingCapacity;
+
+	/** Kayıt chunk'ı başına kare (anahtar kare aralığı). */
+	UPROPERTY(Config)
+	int32 RecordingFramesPerChunk;
+
+private:
+	/** Adım sonunda çağrılır; kayıt açıksa bu adımın durumunu kayıt halkasına yazar. */
+	void HandleStepReady(UTrafficSubsystem* InTrafficSubsystem);
+
+	/** Kaydedilen trafik alt sistemi. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTrafficSubsystem> TrafficSubsystem;
+
+	/** OnStepReady aboneliği. */
+	FDelegateHandle StepReadyHandle;
+
+	FTrafficRecorder Recorder;
+
+	/** Kayıttaki ışık kimlikleri (ilk görüldüğünde atanır). */
+	TMap<TWeakObjectPtr<ATrafficLight>, uint16> RecordedLightIds;
+};
@@ -0,0 +1,911 @@
+#include "TrafficRegion.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "IPAddress.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "TrafficSubsystem.h"
+#include "Vehicle.h"
+
+namespace
+{
+	/** Mesaj başlığı ("TRGN"). */
+	constexpr uint32 MessageMagic = 0x4E475254;
+
+	/** Mesaj başına en fazla byte (bozuk uzunluk önekine karşı). */
+	constexpr int32 MaxMessageBytes = 64 * 1024 * 1024;
+
+	/** Soket tampon boyu: tüm komşulara gönderim, alım başlamadan tamponlara sığmalı. */
+	constexpr int32 SocketBufferBytes = 4 * 1024 * 1024;
+
+	constexpr uint8 HandoffNearField = 1 << 0;
+	constexpr uint8 HandoffPanicking = 1 << 1;
+
+	FORCEINLINE void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add((uint8)(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add((uint8)Value);
+	}
+
+	template<typename T>
+	FORCEINLINE void WriteRaw(TArray<uint8>& Out, const T& Value)
+	{
+		Out.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	FORCEINLINE bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Cursor >= End)
+			{
+				return false;
+			}
+			const uint8 Byte = *Cursor++;
+			OutValue |= (uint32)(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename T>
+	FORCEINLINE bool ReadRaw(const uint8*& Cursor, const uint8* End, T& OutValue)
+	{
+		if (End - Cursor < (int64)sizeof(T))
+		{
+			return false;
+		}
+		FMemory::Memcpy(&OutValue, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return true;
+	}
+
+	bool SendAll(FSocket* Socket, const uint8* Data, int32 Count)
+	{
+		while (Count > 0)
+		{
+			int32 BytesSent = 0;
+			if (!Socket->Send(Data, Count, BytesSent) || BytesSent <= 0)
+			{
+				return false;
+			}
+			Data += BytesSent;
+			Count -= BytesSent;
+		}
+		return true;
+	}
+
+	bool ReceiveAll(FSocket* Socket, uint8* Data, int32 Count, float Timeout)
+	{
+		while (Count > 0)
+		{
+			if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(Timeout)))
+			{
+				return false;
+			}
+
+			int32 BytesRead = 0;
+			if (!Socket->Recv(Data, Count, BytesRead) || BytesRead <= 0)
+			{
+				// Karşı süreç kapandı
+				return false;
+			}
+			Data += BytesRead;
+			Count -= BytesRead;
+		}
+		return true;
+	}
+
+	TSharedRef<FInternetAddr> MakeLoopbackAddress(ISocketSubsystem* SocketSubsystem, int32 Port)
+	{
+		TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+		Address->SetLoopbackAddress();
+		Address->SetPort(Port);
+		return Address;
+	}
+}
+
+// ============================================
+// BÖLME
+// ============================================
+
+void FTrafficRegionPartition::InitializeUniform(int32 NumRegions, float InMinX, float InMaxX)
+{
+	MinX = InMinX;
+	MaxX = InMaxX;
+	Epoch = 0;
+
+	Cuts.Reset();
+	for (int32 Index = 1; Index < NumRegions; ++Index)
+	{
+		Cuts.Add(FMath::Lerp(MinX, MaxX, (float)Index / (float)NumRegions));
+	}
+}
+
+int32 FTrafficRegionPartition::GetRegion(const FVector& Location) const
+{
+	return Algo::UpperBound(Cuts, (float)Location.X);
+}
+
+int32 FTrafficRegionPartition::GetOwner(const FVector& Location, int32 LocalRegion, float Margin) const
+{
+	const float X = (float)Location.X;
+	if (X >= GetLowerBound(LocalRegion) - Margin && X < GetUpperBound(LocalRegion) + Margin)
+	{
+		return LocalRegion;
+	}
+	return GetRegion(Location);
+}
+
+int32 FTrafficRegionPartition::GetGhostRegion(const FVector& Location, int32 LocalRegion, float Width) const
+{
+	const float X = (float)Location.X;
+	if (LocalRegion > 0 && X < Cuts[LocalRegion - 1] + Width)
+	{
+		return LocalRegion - 1;
+	}
+	if (LocalRegion < Cuts.Num() && X >= Cuts[LocalRegion] - Width)
+	{
+		return LocalRegion + 1;
+	}
+	return INDEX_NONE;
+}
+
+bool FTrafficRegionPartition::Rebalance(const TArray<int32>& Loads, float Threshold, int32 MinImbalance)
+{
+	const int32 NumRegions = Num();
+	if (NumRegions < 2 || Loads.Num() != NumRegions)
+	{
+		return false;
+	}
+
+	int32 Hot = 0;
+	int32 MinLoad = Loads[0];
+	for (int32 Index = 1; Index < NumRegions; ++Index)
+	{
+		if (Loads[Index] > Loads[Hot])
+		{
+			Hot = Index;
+		}
+		MinLoad = FMath::Min(MinLoad, Loads[Index]);
+	}
+
+	const int32 HotLoad = Loads[Hot];
+	if (HotLoad - MinLoad < MinImbalance || (float)HotLoad < Threshold * (float)FMath::Max(MinLoad, 1))
+	{
+		return false;
+	}
+
+	// Yük sadece komşuya geçebilir (bölgeler bitişik): daha hafif olanı seç
+	int32 Neighbour = Hot > 0 ? Hot - 1 : Hot + 1;
+	if (Hot > 0 && Hot < NumRegions - 1 && Loads[Hot + 1] < Loads[Hot - 1])
+	{
+		Neighbour = Hot + 1;
+	}
+
+	const int32 Transfer = (HotLoad - Loads[Neighbour]) / 2;
+	const float Lower = FMath::Max(GetLowerBound(Hot), MinX);
+	const float Upper = FMath::Min(GetUpperBound(Hot), MaxX);
+	if (Transfer <= 0 || Upper - Lower <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	// Transfer <= HotLoad / 2: sınır en fazla bölgenin ortasına kadar kayar, sıra bozulmaz
+	const float Shift = (Upper - Lower) * (float)Transfer / (float)HotLoad;
+	if (Neighbour < Hot)
+	{
+		Cuts[Hot - 1] = Lower + Shift;
+	}
+	else
+	{
+		Cuts[Hot] = Upper - Shift;
+	}
+
+	++Epoch;
+	return true;
+}
+
+// ============================================
+// DEVİR
+// ============================================
+
+void FTrafficRegionHandoff::ExtractTransfers(UTrafficSubsystem& Traffic, const FTrafficRegionPartition& Partition, int32 LocalRegion, float HandoffMargin, float GhostWidth, TArray<FTrafficRegionOutbox>& Outboxes)
+{
+	Traffic.FinishPipelinedStep();
+	check(Outboxes.Num() == Partition.Num());
+
+	const float WorldTime = Traffic.GetWorld() ? Traffic.GetWorld()->GetTimeSeconds() : 0.0f;
+	TArray<AVehicleAIController*, TInlineAllocator<16>> NearHandoffs;
+
+	for (int32 LaneId = 0; LaneId < Traffic.Lanes.Num(); ++LaneId)
+	{
+		FTrafficLane& Lane = Traffic.Lanes[LaneId];
+
+		// Yakın alan: konum pawn'dan
+		for (AVehicleAIController* Controller : Lane.Vehicles)
+		{
+			const APawn* ControlledPawn = Controller->GetPawn();
+			if (!ControlledPawn)
+			{
+				continue;
+			}
+
+			const FVector Location = ControlledPawn->GetActorLocation();
+			const int32 Owner = Partition.GetOwner(Location, LocalRegion, HandoffMargin);
+			if (Owner != LocalRegion)
+			{
+				FTrafficHandoffVehicle& Handoff = Outboxes[Owner].Handoffs.AddDefaulted_GetRef();
+				Handoff.TrafficId = Controller->TrafficId;
+				Handoff.LaneId = LaneId;
+				Handoff.Distance = Controller->DistanceAlongLane;
+				Handoff.Speed = Controller->CurrentSpeed;
+				Handoff.CurrentLaneOffset = Controller->CurrentLaneOffset;
+				Handoff.TargetLaneOffset = Controller->TargetLaneOffset;
+				Handoff.PanicRemaining = Controller->bIsPanicking ? FMath::Max(Controller->PanicEndTime - WorldTime, KINDA_SMALL_NUMBER) : 0.0f;
+				Handoff.PanicEscapeDirection = Controller->PanicEscapeDirection;
+				Handoff.bNearField = true;
+				Handoff.VehicleClass = ControlledPawn->GetClass();
+				NearHandoffs.Add(Controller);
+				continue;
+			}
+
+			const int32 GhostRegion = Partition.GetGhostRegion(Location, LocalRegion, GhostWidth);
+			if (GhostRegion != INDEX_NONE)
+			{
+				FTrafficGhostVehicle& Ghost = Outboxes[GhostRegion].Ghosts.AddDefaulted_GetRef();
+				Ghost.TrafficId = Controller->TrafficId;
+				Ghost.LaneId = LaneId;
+				Ghost.Distance = Controller->DistanceAlongLane;
+				Ghost.Speed = Controller->CurrentSpeed;
+				Ghost.VehicleLength = Controller->GetCarFollowingParams().VehicleLength;
+			}
+		}
+
+		// Uzak alan: konum örnek noktalarından, kalanlar yerinde sıkıştırılır (sıra korunur)
+		int32 WriteIndex = 0;
+		const int32 NumFar = Lane.FarField.Num();
+		for (int32 Index = 0; Index < NumFar; ++Index)
+		{
+			const FFarFieldVehicle FarVehicle = Lane.FarField[Index];
+			const uint32 TrafficId = Lane.FarFieldIds[Index];
+			const float Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, Lane.Length);
+
+			FVector Location;
+			FRotator Rotation;
+			if (Traffic.GetLaneTransform(LaneId, Distance, Location, Rotation))
+			{
+				const FFarFieldVehicleClass& VehicleClass = Traffic.FarFieldClasses[FarVehicle.ClassIndex];
+				const int32 Owner = Partition.GetOwner(Location, LocalRegion, HandoffMargin);
+				if (Owner != LocalRegion)
+				{
+					FTrafficHandoffVehicle& Handoff = Outboxes[Owner].Handoffs.AddDefaulted_GetRef();
+					Handoff.TrafficId = TrafficId;
+					Handoff.LaneId = LaneId;
+					Handoff.Distance = Distance;
+					Handoff.Speed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+					Handoff.VehicleClass = VehicleClass.VehicleClass;
+					continue;
+				}
+
+				const int32 GhostRegion = Partition.GetGhostRegion(Location, LocalRegion, GhostWidth);
+				if (GhostRegion != INDEX_NONE)
+				{
+					FTrafficGhostVehicle& Ghost = Outboxes[GhostRegion].Ghosts.AddDefaulted_GetRef();
+					Ghost.TrafficId = TrafficId;
+					Ghost.LaneId = LaneId;
+					Ghost.Distance = Distance;
+					Ghost.Speed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+					Ghost.VehicleLength = FTrafficArchetypeTable::Get(VehicleClass.ArchetypeIndex).CarFollowing.VehicleLength;
+				}
+			}
+
+			Lane.FarField[WriteIndex] = FarVehicle;
+			Lane.FarFieldIds[WriteIndex] = TrafficId;
+			++WriteIndex;
+		}
+
+		Lane.FarField.SetNum(WriteIndex, false);
+		Lane.FarFieldIds.SetNum(WriteIndex, false);
+	}
+
+	// Aktörler şerit taramasından sonra yok edilir (kayıt silme Lane.Vehicles'ı değiştirir)
+	for (AVehicleAIController* Controller : NearHandoffs)
+	{
+		Traffic.DestroyNearFieldVehicle(Controller);
+	}
+}
+
+bool FTrafficRegionHandoff::InsertVehicle(UTrafficSubsystem& Traffic, const FTrafficHandoffVehicle& Handoff)
+{
+	Traffic.FinishPipelinedStep();
+
+	if (!Traffic.Lanes.IsValidIndex(Handoff.LaneId) || Handoff.TrafficId == 0)
+	{
+		return false;
+	}
+
+	const int32 ClassIndex = Traffic.FindOrAddFarFieldClass(Handoff.VehicleClass);
+	if (ClassIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FTrafficLane& Lane = Traffic.Lanes[Handoff.LaneId];
+	if (!Handoff.bNearField)
+	{
+		FFarFieldVehicle FarVehicle;
+		FarVehicle.LaneId = (uint16)Handoff.LaneId;
+		FarVehicle.QuantizedDistance = FFarFieldVehicle::QuantizeDistance(Handoff.Distance, Lane.Length);
+		FarVehicle.QuantizedSpeed = FFarFieldVehicle::QuantizeSpeed(Handoff.Speed);
+		FarVehicle.ClassIndex = (uint8)ClassIndex;
+
+		UTrafficSubsystem::InsertFarFieldVehicle(Lane, FarVehicle, Handoff.TrafficId);
+		return true;
+	}
+
+	AVehicleAIController* Controller = Traffic.SpawnLaneVehicle(Handoff.LaneId, ClassIndex, Handoff.Distance, Handoff.Speed, Handoff.TrafficId);
+	if (!Controller)
+	{
+		return false;
+	}
+
+	Controller->CurrentLaneOffset = Handoff.CurrentLaneOffset;
+	Controller->TargetLaneOffset = Handoff.TargetLaneOffset;
+
+	// Panik kalan süresiyle devam eder (bitiş bu sürecin çarkına eklenir)
+	if (Handoff.PanicRemaining > 0.0f && (Controller->GetCapabilities() & (uint8)ETrafficCapability::Panic))
+	{
+		Controller->PanicEscapeDirection = Handoff.PanicEscapeDirection;
+		Traffic.SchedulePanic(Controller, Handoff.PanicRemaining);
+	}
+
+	return true;
+}
+
+void FTrafficRegionHandoff::SetGhosts(UTrafficSubsystem& Traffic, const TArray<FTrafficGhostVehicle>& Ghosts)
+{
+	Traffic.FinishPipelinedStep();
+
+	for (FTrafficLane& Lane : Traffic.Lanes)
+	{
+		Lane.Ghosts.Reset();
+	}
+
+	for (const FTrafficGhostVehicle& Ghost : Ghosts)
+	{
+		if (!Traffic.Lanes.IsValidIndex(Ghost.LaneId))
+		{
+			continue;
+		}
+
+		// Hayalet kendi hızıyla sabit gider (bir sonraki değişime kadar AdvanceGhosts ilerletir)
+		FLaneFollower& Entry = Traffic.Lanes[Ghost.LaneId].Ghosts.AddDefaulted_GetRef();
+		Entry.Distance = Ghost.Distance;
+		Entry.Speed = Ghost.Speed;
+		Entry.DesiredSpeed = Ghost.Speed;
+		Entry.Params.VehicleLength = Ghost.VehicleLength;
+	}
+
+	for (FTrafficLane& Lane : Traffic.Lanes)
+	{
+		if (Lane.Ghosts.Num() > 1)
+		{
+			Lane.Ghosts.Sort([](const FLaneFollower& A, const FLaneFollower& B)
+			{
+				return A.Distance > B.Distance;
+			});
+		}
+	}
+}
+
+void FTrafficRegionHandoff::SetTrafficIdPartition(UTrafficSubsystem& Traffic, int32 Region, int32 NumRegions)
+{
+	Traffic.FinishPipelinedStep();
+
+	check(NumRegions > 0 && Region >= 0 && Region < NumRegions);
+
+	// Taban senaryo kimliklerinin üstündeki ilk NumRegions katı (her süreçte aynı)
+	const uint32 Stride = (uint32)NumRegions;
+	const uint32 Base = (Traffic.NextTrafficId + Stride - 1) / Stride * Stride;
+	Traffic.NextTrafficId = Base + (uint32)Region;
+	Traffic.TrafficIdStride = Stride;
+}
+
+// ============================================
+// DÜĞÜM
+// ============================================
+
+FTrafficRegionNode::~FTrafficRegionNode()
+{
+	Shutdown();
+}
+
+bool FTrafficRegionNode::Initialize(int32 InRegion, const FTrafficRegionPartition& InPartition, int32 BasePort, float TimeoutSeconds)
+{
+	Shutdown();
+
+	const int32 NumRegions = InPartition.Num();
+	if (InRegion < 0 || InRegion >= NumRegions)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Geçersiz bölge: %d (%d bölge)"), InRegion, NumRegions);
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Bölge %d: soket alt sistemi yok"), InRegion);
+		return false;
+	}
+
+	Region = InRegion;
+	Partition = InPartition;
+	PendingPartition.Reset();
+	Timeout = TimeoutSeconds;
+	Peers.Init(nullptr, NumRegions);
+	Outboxes.SetNum(NumRegions);
+	Loads.Init(0, NumRegions);
+	NumSent = 0;
+	NumReceived = 0;
+	NumRebalances = 0;
+	BytesSent = 0;
+
+	// Büyük bölgeler bize bağlanır - kendi bağlantılarımızdan önce dinlemeye başla (kilitlenme olmaz)
+	FSocket* ListenSocket = nullptr;
+	if (Region < NumRegions - 1)
+	{
+		ListenSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("TrafficRegionListen"), false);
+		if (!ListenSocket)
+		{
+			return false;
+		}
+
+		ListenSocket->SetReuseAddr(true);
+		if (!ListenSocket->Bind(*MakeLoopbackAddress(SocketSubsystem, BasePort + Region)) || !ListenSocket->Listen(NumRegions))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d: %d portu dinlenemedi"), Region, BasePort + Region);
+			SocketSubsystem->DestroySocket(ListenSocket);
+			return false;
+		}
+	}
+
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	bool bConnected = true;
+
+	// Küçük bölgelere bağlan (süreci henüz dinlemiyorsa tekrar dene); ilk 4 byte kendi bölgemiz
+	for (int32 Peer = 0; Peer < Region && bConnected; ++Peer)
+	{
+		const TSharedRef<FInternetAddr> Address = MakeLoopbackAddress(SocketSubsystem, BasePort + Peer);
+		while (!Peers[Peer])
+		{
+			FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("TrafficRegionPeer"), false);
+			if (Socket && Socket->Connect(*Address) && SendAll(Socket, reinterpret_cast<const uint8*>(&Region), sizeof(Region)))
+			{
+				Peers[Peer] = Socket;
+				break;
+			}
+
+			if (Socket)
+			{
+				SocketSubsystem->DestroySocket(Socket);
+			}
+
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				bConnected = false;
+				break;
+			}
+			FPlatformProcess::Sleep(0.05f);
+		}
+	}
+
+	// Büyük bölgelerin bağlantılarını kabul et
+	for (int32 NumAccepted = 0; bConnected && NumAccepted < NumRegions - 1 - Region;)
+	{
+		const double Remaining = Deadline - FPlatformTime::Seconds();
+		bool bPending = false;
+		if (Remaining <= 0.0 || !ListenSocket->WaitForPendingConnection(bPending, FTimespan::FromSeconds(Remaining)))
+		{
+			bConnected = false;
+			break;
+		}
+		if (!bPending)
+		{
+			continue;
+		}
+
+		FSocket* Socket = ListenSocket->Accept(TEXT("TrafficRegionPeer"));
+		int32 PeerRegion = INDEX_NONE;
+		if (Socket && ReceiveAll(Socket, reinterpret_cast<uint8*>(&PeerRegion), sizeof(PeerRegion), Timeout)
+			&& PeerRegion > Region && PeerRegion < NumRegions && !Peers[PeerRegion])
+		{
+			Peers[PeerRegion] = Socket;
+			++NumAccepted;
+		}
+		else if (Socket)
+		{
+			SocketSubsystem->DestroySocket(Socket);
+		}
+	}
+
+	if (ListenSocket)
+	{
+		SocketSubsystem->DestroySocket(ListenSocket);
+	}
+
+	if (!bConnected)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Bölge %d: komşulara %.0f saniyede bağlanılamadı"), Region, TimeoutSeconds);
+		Shutdown();
+		return false;
+	}
+
+	for (FSocket* Socket : Peers)
+	{
+		if (Socket)
+		{
+			int32 ActualSize = 0;
+			Socket->SetNoDelay(true);
+			Socket->SetSendBufferSize(SocketBufferBytes, ActualSize);
+			Socket->SetReceiveBufferSize(SocketBufferBytes, ActualSize);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Bölge %d / %d bağlandı (port %d)"), Region, NumRegions, BasePort + Region);
+	return true;
+}
+
+void FTrafficRegionNode::Shutdown()
+{
+	ISocketSubsystem* SocketSubsystem = Peers.Num() > 0 ? ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM) : nullptr;
+	for (FSocket*& Socket : Peers)
+	{
+		if (Socket)
+		{
+			Socket->Close();
+			if (SocketSubsystem)
+			{
+				SocketSubsystem->DestroySocket(Socket);
+			}
+			Socket = nullptr;
+		}
+	}
+	Peers.Reset();
+}
+
+void FTrafficRegionNode::ClaimVehicles(UTrafficSubsystem* TrafficSubsystem)
+{
+	// Her süreç tüm şehri kurdu: yabancı araçları sil, sahipleri kendi kopyasını tutar
+	for (FTrafficRegionOutbox& Outbox : Outboxes)
+	{
+		Outbox.Reset();
+	}
+	FTrafficRegionHandoff::ExtractTransfers(*TrafficSubsystem, Partition, Region, 0.0f, 0.0f, Outboxes);
+	for (FTrafficRegionOutbox& Outbox : Outboxes)
+	{
+		Outbox.Reset();
+	}
+
+	// Bundan sonra bu süreçte doğan araçların kimlikleri diğer bölgelerinkiyle çakışmaz
+	FTrafficRegionHandoff::SetTrafficIdPartition(*TrafficSubsystem, Region, Partition.Num());
+}
+
+bool FTrafficRegionNode::Exchange(UTrafficSubsystem* TrafficSubsystem, int32 Step)
+{
+	check(IsInGameThread());
+
+	for (FTrafficRegionOutbox& Outbox : Outboxes)
+	{
+		Outbox.Reset();
+	}
+	FTrafficRegionHandoff::ExtractTransfers(*TrafficSubsystem, Partition, Region, HandoffMargin, GhostWidth, Outboxes);
+
+	const int32 Load = TrafficSubsystem->GetNearFieldVehicleCount() + TrafficSubsystem->GetFarFieldVehicleCount();
+	Loads[Region] = Load;
+
+	// Lider önceki değişimde hesapladığı bölmeyi bu mesajlarla yayınlar; herkes bu değişimin sonunda geçer
+	TOptional<FTrafficRegionPartition> NewPartition = MoveTemp(PendingPartition);
+	PendingPartition.Reset();
+
+	// Önce tüm komşulara gönder, sonra al (mesajlar soket tamponlarına sığar)
+	for (int32 Peer = 0; Peer < Peers.Num(); ++Peer)
+	{
+		if (Peer == Region)
+		{
+			continue;
+		}
+
+		WriteMessage(SendBuffer, Step, Load, NewPartition.IsSet() ? &NewPartition.GetValue() : nullptr, Outboxes[Peer]);
+		if (!SendMessage(Peers[Peer], SendBuffer))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d: bölge %d'e gönderilemedi (adım %d)"), Region, Peer, Step);
+			return false;
+		}
+		NumSent += Outboxes[Peer].Handoffs.Num();
+	}
+
+	ReceivedHandoffs.Reset();
+	ReceivedGhosts.Reset();
+
+	for (int32 Peer = 0; Peer < Peers.Num(); ++Peer)
+	{
+		if (Peer == Region)
+		{
+			continue;
+		}
+
+		int32 PeerLoad = 0;
+		TOptional<FTrafficRegionPartition> PeerPartition;
+		if (!ReceiveMessage(Peers[Peer], ReceiveBuffer) || !ReadMessage(ReceiveBuffer, Step, PeerLoad, PeerPartition))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Bölge %d: bölge %d'den mesaj alınamadı (adım %d)"), Region, Peer, Step);
+			return false;
+		}
+
+		Loads[Peer] = PeerLoad;
+		if (PeerPartition.IsSet())
+		{
+			NewPartition = MoveTemp(PeerPartition);
+		}
+	}
+
+	for (const FTrafficHandoffVehicle& Handoff : ReceivedHandoffs)
+	{
+		if (FTrafficRegionHandoff::InsertVehicle(*TrafficSubsystem, Handoff))
+		{
+			++NumReceived;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Bölge %d: devredilen araç %u eklenemedi"), Region, Handoff.TrafficId);
+		}
+	}
+
+	FTrafficRegionHandoff::SetGhosts(*TrafficSubsystem, ReceivedGhosts);
+
+	if (NewPartition.IsSet() && NewPartition->Epoch != Partition.Epoch)
+	{
+		Partition = MoveTemp(NewPartition.GetValue());
+		++NumRebalances;
+		UE_LOG(LogTemp, Verbose, TEXT("Bölge %d: yeni bölme %u (adım %d)"), Region, Partition.Epoch, Step);
+	}
+
+	// Lider: tüm yükler bu değişimde toplandı, yeni bölme bir sonraki değişimde yayınlanır
+	if (Region == 0 && RebalanceInterval > 0 && Step > 0 && Step % RebalanceInterval == 0)
+	{
+		FTrafficRegionPartition Candidate = Partition;
+		if (Candidate.Rebalance(Loads, RebalanceThreshold, RebalanceMinImbalance))
+		{
+			PendingPartition = MoveTemp(Candidate);
+		}
+	}
+
+	return true;
+}
+
+void FTrafficRegionNode::WriteMessage(TArray<uint8>& Out, int32 Step, int32 Load, const FTrafficRegionPartition* NewPartition, const FTrafficRegionOutbox& Outbox) const
+{
+	Out.Reset();
+	WriteRaw(Out, MessageMagic);
+	WriteRaw(Out, Step);
+	WriteRaw(Out, Load);
+
+	WriteRaw(Out, (uint8)(NewPartition ? 1 : 0));
+	if (NewPartition)
+	{
+		WriteRaw(Out, NewPartition->Epoch);
+		WriteRaw(Out, NewPartition->MinX);
+		WriteRaw(Out, NewPartition->MaxX);
+		WriteVarUInt(Out, NewPartition->Cuts.Num());
+		for (const float Cut : NewPartition->Cuts)
+		{
+			WriteRaw(Out, Cut);
+		}
+	}
+
+	// Sınıf indeksleri süreçlere özel: sınıflar yol adıyla tabloya yazılır
+	TArray<UClass*, TInlineAllocator<8>> Classes;
+	for (const FTrafficHandoffVehicle& Handoff : Outbox.Handoffs)
+	{
+		Classes.AddUnique(Handoff.VehicleClass.Get());
+	}
+
+	WriteVarUInt(Out, Classes.Num());
+	for (const UClass* Class : Classes)
+	{
+		const FTCHARToUTF8 Utf8Path(Class ? *Class->GetPathName() : TEXT(""));
+		WriteVarUInt(Out, Utf8Path.Length());
+		Out.Append(reinterpret_cast<const uint8*>(Utf8Path.Get()), Utf8Path.Length());
+	}
+
+	WriteVarUInt(Out, Outbox.Handoffs.Num());
+	for (const FTrafficHandoffVehicle& Handoff : Outbox.Handoffs)
+	{
+		const uint8 Flags = (Handoff.bNearField ? HandoffNearField : 0) | (Handoff.PanicRemaining > 0.0f ? HandoffPanicking : 0);
+
+		WriteRaw(Out, Handoff.TrafficId);
+		WriteVarUInt(Out, (uint32)Handoff.LaneId);
+		WriteRaw(Out, Handoff.Distance);
+		WriteRaw(Out, Handoff.Speed);
+		WriteVarUInt(Out, Classes.IndexOfByKey(Handoff.VehicleClass.Get()));
+		WriteRaw(Out, Flags);
+
+		if (Flags & HandoffNearField)
+		{
+			WriteRaw(Out, Handoff.CurrentLaneOffset);
+			WriteRaw(Out, Handoff.TargetLaneOffset);
+		}
+
+		if (Flags & HandoffPanicking)
+		{
+			WriteRaw(Out, Handoff.PanicRemaining);
+			WriteRaw(Out, FVector3f(Handoff.PanicEscapeDirection));
+		}
+	}
+
+	WriteVarUInt(Out, Outbox.Ghosts.Num());
+	for (const FTrafficGhostVehicle& Ghost : Outbox.Ghosts)
+	{
+		WriteRaw(Out, Ghost.TrafficId);
+		WriteVarUInt(Out, (uint32)Ghost.LaneId);
+		WriteRaw(Out, Ghost.Distance);
+		WriteRaw(Out, Ghost.Speed);
+		WriteRaw(Out, Ghost.VehicleLength);
+	}
+}
+
+bool FTrafficRegionNode::ReadMessage(const TArray<uint8>& Data, int32 Step, int32& OutLoad, TOptional<FTrafficRegionPartition>& OutPartition)
+{
+	const uint8* Cursor = Data.GetData();
+	const uint8* End = Cursor + Data.Num();
+
+	uint32 Magic;
+	int32 MessageStep;
+	uint8 bHasPartition;
+	if (!ReadRaw(Cursor, End, Magic) || Magic != MessageMagic
+		|| !ReadRaw(Cursor, End, MessageStep) || !ReadRaw(Cursor, End, OutLoad)
+		|| !ReadRaw(Cursor, End, bHasPartition))
+	{
+		return false;
+	}
+
+	// Kilitli adım: komşu aynı adımda olmalı
+	if (MessageStep != Step)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Bölge %d: adım uyuşmazlığı (beklenen %d, gelen %d)"), Region, Step, MessageStep);
+		return false;
+	}
+
+	if (bHasPartition)
+	{
+		FTrafficRegionPartition& NewPartition = OutPartition.Emplace();
+		uint32 NumCuts;
+		if (!ReadRaw(Cursor, End, NewPartition.Epoch) || !ReadRaw(Cursor, End, NewPartition.MinX) || !ReadRaw(Cursor, End, NewPartition.MaxX)
+			|| !ReadVarUInt(Cursor, End, NumCuts) || NumCuts != (uint32)Partition.Cuts.Num())
+		{
+			return false;
+		}
+
+		NewPartition.Cuts.SetNumUninitialized(NumCuts);
+		for (float& Cut : NewPartition.Cuts)
+		{
+			if (!ReadRaw(Cursor, End, Cut))
+			{
+				return false;
+			}
+		}
+	}
+
+	uint32 NumClasses;
+	if (!ReadVarUInt(Cursor, End, NumClasses))
+	{
+		return false;
+	}
+
+	TArray<TSubclassOf<AVehicle>, TInlineAllocator<8>> Classes;
+	for (uint32 Index = 0; Index < NumClasses; ++Index)
+	{
+		uint32 PathLength;
+		if (!ReadVarUInt(Cursor, End, PathLength) || End - Cursor < (int64)PathLength)
+		{
+			return false;
+		}
+
+		const FString Path(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Cursor), PathLength));
+		Cursor += PathLength;
+		Classes.Add(Path.IsEmpty() ? nullptr : LoadClass<AVehicle>(nullptr, *Path));
+	}
+
+	uint32 NumHandoffs;
+	if (!ReadVarUInt(Cursor, End, NumHandoffs))
+	{
+		return false;
+	}
+
+	for (uint32 Index = 0; Index < NumHandoffs; ++Index)
+	{
+		FTrafficHandoffVehicle& Handoff = ReceivedHandoffs.AddDefaulted_GetRef();
+		uint32 LaneId, ClassIndex;
+		uint8 Flags;
+		if (!ReadRaw(Cursor, End, Handoff.TrafficId) || !ReadVarUInt(Cursor, End, LaneId)
+			|| !ReadRaw(Cursor, End, Handoff.Distance) || !ReadRaw(Cursor, End, Handoff.Speed)
+			|| !ReadVarUInt(Cursor, End, ClassIndex) || ClassIndex >= NumClasses || !ReadRaw(Cursor, End, Flags))
+		{
+			return false;
+		}
+
+		Handoff.LaneId = (int32)LaneId;
+		Handoff.VehicleClass = Classes[ClassIndex];
+		Handoff.bNearField = (Flags & HandoffNearField) != 0;
+
+		if (Handoff.bNearField && (!ReadRaw(Cursor, End, Handoff.CurrentLaneOffset) || !ReadRaw(Cursor, End, Handoff.TargetLaneOffset)))
+		{
+			return false;
+		}
+
+		if (Flags & HandoffPanicking)
+		{
+			FVector3f EscapeDirection;
+			if (!ReadRaw(Cursor, End, Handoff.PanicRemaining) || !ReadRaw(Cursor, End, EscapeDirection))
+			{
+				return false;
+			}
+			Handoff.PanicEscapeDirection = FVector(EscapeDirection);
+		}
+	}
+
+	uint32 NumGhosts;
+	if (!ReadVarUInt(Cursor, End, NumGhosts))
+	{
+		return false;
+	}
+
+	for (uint32 Index = 0; Index < NumGhosts; ++Index)
+	{
+		FTrafficGhostVehicle& Ghost = ReceivedGhosts.AddDefaulted_GetRef();
+		uint32 LaneId;
+		if (!ReadRaw(Cursor, End, Ghost.TrafficId) || !ReadVarUInt(Cursor, End, LaneId)
+			|| !ReadRaw(Cursor, End, Ghost.Distance) || !ReadRaw(Cursor, End, Ghost.Speed) || !ReadRaw(Cursor, End, Ghost.VehicleLength))
+		{
+			return false;
+		}
+		Ghost.LaneId = (int32)LaneId;
+	}
+
+	return Cursor == End;
+}
+
+bool FTrafficRegionNode::SendMessage(FSocket* Socket, const TArray<uint8>& Data)
+{
+	const int32 Length = Data.Num();
+	if (!SendAll(Socket, reinterpret_cast<const uint8*>(&Length), sizeof(Length)) || !SendAll(Socket, Data.GetData(), Length))
+	{
+		return false;
+	}
+
+	BytesSent += sizeof(Length) + Length;
+	return true;
+}
+
+bool FTrafficRegionNode::ReceiveMessage(FSocket* Socket, TArray<uint8>& OutData)
+{
+	int32 Length = 0;
+	if (!ReceiveAll(Socket, reinterpret_cast<uint8*>(&Length), sizeof(Length), Timeout) || Length < 0 || Length > MaxMessageBytes)
+	{
+		return false;
+	}
+
+	OutData.SetNumUninitialized(Length, false);
+	return ReceiveAll(Socket, OutData.GetData(), Length, Timeout);
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AVehicle;
+class FSocket;
+class UTrafficSubsystem;
+
+/**
+ * Bölge sınırını geçip komşu bölgenin sürecine devredilen araç.
+ * Şerit ID'leri tüm süreçlerde ortaktır (aynı senaryo, aynı şerit oluşturma sırası);
+ * şehirde ayrı rota yoktur, aracın rotası şerididir.
+ */
+struct FTrafficHandoffVehicle
+{
+	/** Kalıcı araç kimliği (süreçler arasında korunur). */
+	uint32 TrafficId = 0;
+
+	int32 LaneId = INDEX_NONE;
+
+	/** Şerit üzerindeki mesafe (birim). */
+	float Distance = 0.0f;
+
+	/** Hız (cm/s). */
+	float Speed = 0.0f;
+
+	/** Yakın alan: şerit offset'leri (şerit değiştirme ortasında devredilebilir). */
+	float CurrentLaneOffset = 0.0f;
+	float TargetLaneOffset = 0.0f;
+
+	/** Kalan panik süresi (saniye, 0 = panik yok) ve kaçış yönü. */
+	float PanicRemaining = 0.0f;
+	FVector PanicEscapeDirection = FVector::ZeroVector;
+
+	/** true = aktör olarak spawn edilir, false = uzak alana eklenir. */
+	bool bNearField = false;
+
+	TSubclassOf<AVehicle> VehicleClass;
+};
+
+/**
+ * Komşu bölgenin sınıra yakın aracı. Alan bölgede şerit kuyruğuna salt okunur lider olarak
+ * girer (takip eden araçlar sınırda boşluğa değil gerçek araca göre yavaşlar); her değişimde yenilenir.
+ */
+struct FTrafficGhostVehicle
+{
+	uint32 TrafficId = 0;
+	int32 LaneId = INDEX_NONE;
+	float Distance = 0.0f;
+	float Speed = 0.0f;
+	float VehicleLength = 0.0f;
+};
+
+/** Bir komşu bölgeye bu adımda gönderilecek devirler ve hayaletler. */
+struct FTrafficRegionOutbox
+{
+	TArray<FTrafficHandoffVehicle> Handoffs;
+	TArray<FTrafficGhostVehicle> Ghosts;
+
+	void Reset()
+	{
+		Handoffs.Reset();
+		Ghosts.Reset();
+	}
+};
+
+/**
+ * Şehrin dünya X ekseninde şeritlere bölünmesi. Bölge i = [Cuts[i - 1], Cuts[i]);
+ * ilk ve son bölge sonsuza uzanır. Tüm süreçler aynı bölmeyi kullanır; lider süreç
+ * (bölge 0) yeniden dengeleyip yeni sınırları Epoch ile yayınlar.
+ */
+struct YOURGAMENAME_API FTrafficRegionPartition
+{
+	/** Bölge sınırları (artan, bölge sayısı - 1 adet). */
+	TArray<float> Cuts;
+
+	/** Şehrin X aralığı (dengelemede kenar bölgelerin genişliği için). */
+	float MinX = 0.0f;
+	float MaxX = 0.0f;
+
+	/** Her yeniden dengelemede artar. */
+	uint32 Epoch = 0;
+
+	int32 Num() const { return Cuts.Num() + 1; }
+
+	/** [InMinX, InMaxX] aralığını NumRegions eşit parçaya böler. */
+	void InitializeUniform(int32 NumRegions, float InMinX, float InMaxX);
+
+	/** Konumun bölgesi. */
+	int32 GetRegion(const FVector& Location) const;
+
+	/**
+	 * Konumun sahibi: LocalRegion'ın sınırlarından Margin kadar dışarı taşmayan konumlar
+	 * LocalRegion'da kalır (sınırda gidip gelen araç her adımda devredilmesin).
+	 */
+	int32 GetOwner(const FVector& Location, int32 LocalRegion, float Margin) const;
+
+	/**
+	 * LocalRegion'daki konum komşu sınıra Width mesafedeyse komşu bölge, değilse INDEX_NONE.
+	 */
+	int32 GetGhostRegion(const FVector& Location, int32 LocalRegion, float Width) const;
+
+	/**
+	 * En yüklü bölge ile daha hafif komşusu arasındaki sınırı, yük farkının yarısı komşuya
+	 * geçecek kadar kaydırır (bölge içinde düzgün yoğunluk varsayımı; tekrarlanan dengeleme yakınsar).
+	 *
+	 * @param Loads Bölge başına araç sayısı
+	 * @param Threshold En yüklü / en hafif oranı bunu aşarsa dengelenir
+	 * @param MinImbalance Farkı bundan küçük (araç) yükler dengelenmez (gürültü)
+	 * @return Sınır değiştiyse true (Epoch artar)
+	 */
+	bool Rebalance(const TArray<int32>& Loads, float Threshold, int32 MinImbalance);
+
+private:
+	float GetLowerBound(int32 Region) const { return Region > 0 ? Cuts[Region - 1] : -FLT_MAX; }
+	float GetUpperBound(int32 Region) const { return Region < Cuts.Num() ? Cuts[Region] : FLT_MAX; }
+};
+
+/**
+ * Bölge sınırında trafik alt sistemine araç girişi ve çıkışı (FTrafficRegionNode kullanır).
+ * Şeritleri ve araç kimliklerini doğrudan değiştirir; hayaletlerin adım adım ilerletilmesi
+ * trafik alt sisteminin adımındadır. Sadece oyun thread'inden, önce çalışan adım beklenir.
+ */
+class YOURGAMENAME_API FTrafficRegionHandoff
+{
+public:
+	/**
+	 * Bölgeye ait olmayan şeride bağlı araçları (Partition'a göre başka bölgede, sınırdan
+	 * HandoffMargin kadar içeride) kaldırır ve sahip bölgenin kutusuna devir olarak yazar; komşu
+	 * sınıra GhostWidth mesafedeki araçları komşunun kutusuna hayalet olarak ekler.
+	 * Outboxes bölge sayısı kadar olmalıdır.
+	 */
+	static void ExtractTransfers(UTrafficSubsystem& Traffic, const FTrafficRegionPartition& Partition, int32 LocalRegion, float HandoffMargin, float GhostWidth, TArray<FTrafficRegionOutbox>& Outboxes);
+
+	/**
+	 * Komşu bölgeden devredilen aracı ekler: kimlik, şerit konumu, hız, offset'ler ve kalan
+	 * panik korunur. Yakın alan araçları aktör olarak spawn edilir (çalışan manevra taşınmaz).
+	 *
+	 * @return Şerit veya sınıf geçersizse false
+	 */
+	static bool InsertVehicle(UTrafficSubsystem& Traffic, const FTrafficHandoffVehicle& Handoff);
+
+	/** Komşu bölgelerin sınır araçlarını şerit kuyruklarına salt okunur lider olarak koyar (öncekilerin yerine). */
+	static void SetGhosts(UTrafficSubsystem& Traffic, const TArray<FTrafficGhostVehicle>& Ghosts);
+
+	/**
+	 * Bundan sonra atanan kimlikleri bölgeye ayırır: Region'ın yeni kimlikleri NumRegions'a göre
+	 * Region'a denktir (Id = Taban + Region + k * NumRegions). Taban, tüm süreçlerde aynı olan
+	 * senaryo kimliklerinin üstündedir; böylece bir bölgenin atadığı kimlik başka bölgeninkiyle
+	 * ve devredilen araçlarınkiyle çakışmaz. Tüm süreçler aynı senaryoyu kurduktan sonra çağrılır.
+	 */
+	static void SetTrafficIdPartition(UTrafficSubsystem& Traffic, int32 Region, int32 NumRegions);
+};
+
+/**
+ * Çok süreçli bölge simülasyonunda bir sürecin düğümü.
+ *
+ * Her süreç bir bölgenin araçlarını simüle eder. Adımlar kilitli adımdır (lockstep): her adımdan
+ * sonra her komşuya tek mesaj gönderilir ve her komşudan tek mesaj beklenir. Mesaj, sınırı geçen
+ * araçların devirlerini, sınıra yakın araçların hayaletlerini, gönderenin yükünü ve (lider ise)
+ * yeni bölmeyi taşır. Süreçler yerel makinede TCP loopback ile tam örgü bağlanır
+ * (bölge i BasePort + i'yi dinler, küçük bölgelere bağlanır). Sadece oyun thread'inden.
+ */
+class YOURGAMENAME_API FTrafficRegionNode
+{
+public:
+	~FTrafficRegionNode();
+
+	/** Yeniden dengeleme ayarları (sadece lider kullanır). */
+	int32 RebalanceInterval = 60;
+	float RebalanceThreshold = 1.5f;
+	int32 RebalanceMinImbalance = 8;
+
+	/** Sınırdan bu mesafedeki (birim) araçlar komşuya hayalet olarak gönderilir. */
+	float GhostWidth = 5000.0f;
+
+	/** Araç komşu bölgeye bu kadar (birim) girince devredilir. */
+	float HandoffMargin = 200.0f;
+
+	/**
+	 * Komşulara bağlanır (tüm süreçler TimeoutSeconds içinde başlamalıdır).
+	 *
+	 * @return Tüm bağlantılar kurulduysa true
+	 */
+	bool Initialize(int32 InRegion, const FTrafficRegionPartition& InPartition, int32 BasePort, float TimeoutSeconds);
+
+	/** Bağlantıları kapatır. */
+	void Shutdown();
+
+	/**
+	 * Tüm süreçler aynı senaryoyu kurduktan sonra: bu bölgeye ait olmayan araçlar kaldırılır
+	 * (sahibi kendi kopyasını tutar, devir gerekmez) ve yeni kimlikler bölgeye ayrılır.
+	 */
+	void ClaimVehicles(UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * Adım sonrası değişim: devirleri ve hayaletleri gönderir, komşulardan alınanları uygular,
+	 * bölme değiştiyse yenisine geçer.
+	 *
+	 * @return Bir komşu zaman aşımına uğradıysa veya bozuk mesaj geldiyse false
+	 */
+	bool Exchange(UTrafficSubsystem* TrafficSubsystem, int32 Step);
+
+	int32 GetRegion() const { return Region; }
+	const FTrafficRegionPartition& GetPartition() const { return Partition; }
+
+	/** Gönderilen / alınan devir sayısı, bu adımda alınan hayaletler, dengeleme sayısı ve gönderilen byte. */
+	int32 GetNumSent() const { return NumSent; }
+	int32 GetNumReceived() const { return NumReceived; }
+	int32 GetNumGhosts() const { return ReceivedGhosts.Num(); }
+	int32 GetNumRebalances() const { return NumRebalances; }
+	int64 GetBytesSent() const { return BytesSent; }
+
+private:
+	/** Mesajı yazar: başlık, (varsa) yeni bölme, sınıf tablosu, devirler, hayaletler. */
+	void WriteMessage(TArray<uint8>& Out, int32 Step, int32 Load, const FTrafficRegionPartition* NewPartition, const FTrafficRegionOutbox& Outbox) const;
+
+	/** Mesajı okur; devirler ve hayaletler listelere eklenir. */
+	bool ReadMessage(const TArray<uint8>& Data, int32 Step, int32& OutLoad, TOptional<FTrafficRegionPartition>& OutPartition);
+
+	/** Uzunluk önekli mesaj gönderir / alır (bloklayan). */
+	bool SendMessage(FSocket* Socket, const TArray<uint8>& Data);
+	bool ReceiveMessage(FSocket* Socket, TArray<uint8>& OutData);
+
+	int32 Region = INDEX_NONE;
+	FTrafficRegionPartition Partition;
+
+	/** Lider: bir sonraki değişimde yayınlanacak bölme. */
+	TOptional<FTrafficRegionPartition> PendingPartition;
+
+	/** Komşu başına soket (kendi indeksi nullptr). */
+	TArray<FSocket*> Peers;
+
+	/** Komşu başına giden kutular ve bölge yükleri. */
+	TArray<FTrafficRegionOutbox> Outboxes;
+	TArray<int32> Loads;
+
+	/** Bu adımda alınanlar. */
+	TArray<FTrafficHandoffVehicle> ReceivedHandoffs;
+	TArray<FTrafficGhostVehicle> ReceivedGhosts;
+
+	/** Mesaj tamponları. */
+	TArray<uint8> SendBuffer;
+	TArray<uint8> ReceiveBuffer;
+
+	float Timeout = 30.0f;
+
+	int32 NumSent = 0;
+	int32 NumReceived = 0;
+	int32 NumRebalances = 0;
+	int64 BytesSent = 0;
+};
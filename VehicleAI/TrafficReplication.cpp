@@ -0,0 +1,502 @@
+#include "TrafficReplication.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "TrafficSubsystem.h" // STATGROUP_Traffic
+
+DECLARE_CYCLE_STAT(TEXT("Traffic Replication Build"), STAT_TrafficReplicationBuild, STATGROUP_Traffic);
+
+namespace
+{
+	/** Şeride bağlı olmayan araçların konum adımı (cm) ve bit sayıları (X/Y ±13 km, Z ±3 km). */
+	constexpr float LocationQuantum = 10.0f;
+	constexpr int32 LocationXYBits = 28;
+	constexpr int32 LocationZBits = 16;
+
+	/** Bu farktan (birim) büyük tahmin hataları yumuşatılmaz, doğrudan atlanır (şerit sonu, ışınlama). */
+	constexpr float MaxCorrectionDistance = 500.0f;
+
+	/** Gönderim kayıtlarının temizlenme aralığı (saniye). */
+	constexpr float PruneInterval = 5.0f;
+
+	FORCEINLINE uint32 QuantizeUnsigned(float Value, float Quantum, int32 NumBits)
+	{
+		return (uint32)FMath::Clamp(FMath::RoundToInt(Value / Quantum), 0, (1 << NumBits) - 1);
+	}
+
+	/** İşaretli değeri NumBits'lik aralığa kaydırır. */
+	FORCEINLINE uint32 QuantizeSigned(float Value, float Quantum, int32 NumBits)
+	{
+		const int32 Bias = 1 << (NumBits - 1);
+		return (uint32)FMath::Clamp(FMath::RoundToInt(Value / Quantum) + Bias, 0, (1 << NumBits) - 1);
+	}
+
+	FORCEINLINE float DequantizeSigned(uint32 Quantized, float Quantum, int32 NumBits)
+	{
+		return (float)((int32)Quantized - (1 << (NumBits - 1))) * Quantum;
+	}
+
+	/** SerializeIntPacked'in yazdığı bit sayısı (7 bit veri + 1 devam biti gruplar). */
+	FORCEINLINE int32 GetPackedIntBits(uint32 Value)
+	{
+		const int32 ValueBits = FMath::Max(1, 32 - (int32)FMath::CountLeadingZeros(Value));
+		return FMath::DivideAndRoundUp(ValueBits, 7) * 8;
+	}
+
+	/** Bir araç kaydının bit sayısı (devam biti dahil). */
+	int32 GetVehicleBits(const FTrafficReplicatedVehicle& Vehicle, uint32 PreviousId)
+	{
+		int32 NumBits = 1 + GetPackedIntBits(Vehicle.TrafficId - PreviousId) + 2 + TrafficReplication::SpeedBits;
+		if (Vehicle.LaneId != INDEX_NONE)
+		{
+			NumBits += TrafficReplication::LaneBits + TrafficReplication::DistanceBits;
+		}
+		else
+		{
+			NumBits += LocationXYBits * 2 + LocationZBits + 8;
+		}
+		return NumBits;
+	}
+}
+
+FTrafficReplicationSettings::FTrafficReplicationSettings()
+{
+	// Yakın: her pakette, orta: saniyede 2, uzak: 2 saniyede bir
+	Rings.Emplace(5000.0f, 0.1f);
+	Rings.Emplace(15000.0f, 0.5f);
+	Rings.Emplace(40000.0f, 2.0f);
+
+	SendRate = 10.0f;
+	MaxPacketBytes = 1000;
+	StaleTimeout = 5.0f;
+	CorrectionTime = 0.25f;
+}
+
+// ============================================
+// KODLAYICI
+// ============================================
+
+void FTrafficReplicationCodec::WriteHeader(FBitWriter& Writer, float ServerTime)
+{
+	Writer << ServerTime;
+}
+
+bool FTrafficReplicationCodec::ReadHeader(FBitReader& Reader, float& OutServerTime)
+{
+	Reader << OutServerTime;
+	return !Reader.IsError();
+}
+
+void FTrafficReplicationCodec::WriteVehicle(FBitWriter& Writer, const FTrafficReplicatedVehicle& Vehicle, uint32 PreviousId)
+{
+	Writer.WriteBit(1);
+
+	uint32 IdDelta = Vehicle.TrafficId - PreviousId;
+	Writer.SerializeIntPacked(IdDelta);
+
+	const bool bLaneBound = Vehicle.LaneId != INDEX_NONE;
+	Writer.WriteBit((Vehicle.Flags & TrafficReplication::FlagPanicking) ? 1 : 0);
+	Writer.WriteBit(bLaneBound ? 1 : 0);
+
+	uint32 Speed = QuantizeUnsigned(Vehicle.Speed, TrafficReplication::SpeedQuantum, TrafficReplication::SpeedBits);
+	Writer.SerializeInt(Speed, 1u << TrafficReplication::SpeedBits);
+
+	if (bLaneBound)
+	{
+		uint32 LaneId = (uint32)Vehicle.LaneId;
+		uint32 Distance = QuantizeUnsigned(Vehicle.Distance, TrafficReplication::DistanceQuantum, TrafficReplication::DistanceBits);
+		Writer.SerializeInt(LaneId, 1u << TrafficReplication::LaneBits);
+		Writer.SerializeInt(Distance, 1u << TrafficReplication::DistanceBits);
+	}
+	else
+	{
+		uint32 X = QuantizeSigned(Vehicle.Location.X, LocationQuantum, LocationXYBits);
+		uint32 Y = QuantizeSigned(Vehicle.Location.Y, LocationQuantum, LocationXYBits);
+		uint32 Z = QuantizeSigned(Vehicle.Location.Z, LocationQuantum, LocationZBits);
+		uint8 Yaw = FRotator::CompressAxisToByte(Vehicle.Yaw);
+		Writer.SerializeInt(X, 1u << LocationXYBits);
+		Writer.SerializeInt(Y, 1u << LocationXYBits);
+		Writer.SerializeInt(Z, 1u << LocationZBits);
+		Writer << Yaw;
+	}
+}
+
+void FTrafficReplicationCodec::WriteEnd(FBitWriter& Writer)
+{
+	Writer.WriteBit(0);
+}
+
+void FTrafficReplicationCodec::WriteRemoval(FBitWriter& Writer, uint32 TrafficId, uint32 PreviousId)
+{
+	Writer.WriteBit(1);
+
+	uint32 IdDelta = TrafficId - PreviousId;
+	Writer.SerializeIntPacked(IdDelta);
+}
+
+bool FTrafficReplicationCodec::ReadRemoval(FBitReader& Reader, uint32& OutTrafficId, uint32 PreviousId)
+{
+	if (!Reader.ReadBit() || Reader.IsError())
+	{
+		return false;
+	}
+
+	uint32 IdDelta = 0;
+	Reader.SerializeIntPacked(IdDelta);
+	OutTrafficId = PreviousId + IdDelta;
+
+	return !Reader.IsError();
+}
+
+bool FTrafficReplicationCodec::ReadVehicle(FBitReader& Reader, FTrafficReplicatedVehicle& OutVehicle, uint32 PreviousId)
+{
+	if (!Reader.ReadBit() || Reader.IsError())
+	{
+		return false;
+	}
+
+	uint32 IdDelta = 0;
+	Reader.SerializeIntPacked(IdDelta);
+	OutVehicle.TrafficId = PreviousId + IdDelta;
+
+	OutVehicle.Flags = Reader.ReadBit() ? TrafficReplication::FlagPanicking : 0;
+	const bool bLaneBound = Reader.ReadBit() != 0;
+
+	uint32 Speed = 0;
+	Reader.SerializeInt(Speed, 1u << TrafficReplication::SpeedBits);
+	OutVehicle.Speed = (float)Speed * TrafficReplication::SpeedQuantum;
+
+	if (bLaneBound)
+	{
+		uint32 LaneId = 0;
+		uint32 Distance = 0;
+		Reader.SerializeInt(LaneId, 1u << TrafficReplication::LaneBits);
+		Reader.SerializeInt(Distance, 1u << TrafficReplication::DistanceBits);
+		OutVehicle.LaneId = (int32)LaneId;
+		OutVehicle.Distance = (float)Distance * TrafficReplication::DistanceQuantum;
+		OutVehicle.Location = FVector::ZeroVector;
+		OutVehicle.Yaw = 0.0f;
+	}
+	else
+	{
+		uint32 X = 0;
+		uint32 Y = 0;
+		uint32 Z = 0;
+		uint8 Yaw = 0;
+		Reader.SerializeInt(X, 1u << LocationXYBits);
+		Reader.SerializeInt(Y, 1u << LocationXYBits);
+		Reader.SerializeInt(Z, 1u << LocationZBits);
+		Reader << Yaw;
+		OutVehicle.LaneId = INDEX_NONE;
+		OutVehicle.Distance = 0.0f;
+		OutVehicle.Location = FVector(
+			DequantizeSigned(X, LocationQuantum, LocationXYBits),
+			DequantizeSigned(Y, LocationQuantum, LocationXYBits),
+			DequantizeSigned(Z, LocationQuantum, LocationZBits));
+		OutVehicle.Yaw = FRotator::DecompressAxisFromByte(Yaw);
+	}
+
+	return !Reader.IsError();
+}
+
+// ============================================
+// SUNUCU KANALI
+// ============================================
+
+bool FTrafficReplicationChannel::Tick(float DeltaTime, const FTrafficReplicationSettings& Settings)
+{
+	const float SendInterval = 1.0f / FMath::Max(Settings.SendRate, 1.0f);
+
+	SendAccumulator += DeltaTime;
+	if (SendAccumulator < SendInterval)
+	{
+		return false;
+	}
+
+	// Kaçırılan gönderimler biriktirilmez (düşük kare hızında patlama olmasın)
+	SendAccumulator = FMath::Fmod(SendAccumulator, SendInterval);
+	return true;
+}
+
+int32 FTrafficReplicationChannel::BuildPacket(const FTrafficReplicationSnapshot& Snapshot, const FVector& ViewLocation, const FTrafficReplicationSettings& Settings,
+	FBitWriter& Writer, TArray<int32>& OutNewLanes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficReplicationBuild);
+
+	OutNewLanes.Reset();
+	Candidates.Reset();
+	RelevantIds.Reset();
+
+	const float Now = Snapshot.Time;
+	const TArray<FTrafficRelevancyRing>& Rings = Settings.Rings;
+	const float SendInterval = 1.0f / FMath::Max(Settings.SendRate, 1.0f);
+
+	// İstemcinin silmiş olabileceği araçlar unutulur (tekrar girdiklerinde yeni sayılır)
+	if (Now - LastPruneTime > PruneInterval)
+	{
+		LastPruneTime = Now;
+		for (TMap<uint32, float>::TIterator It = LastSentTimes.CreateIterator(); It; ++It)
+		{
+			if (Now - It.Value() > Settings.StaleTimeout)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if (Rings.Num() > 0)
+	{
+		const float InnerRadius = FMath::Max(Rings[0].Radius, 1.0f);
+
+		Snapshot.SpatialHash.ForEachInRadius(ViewLocation, Rings.Last().Radius, [&](int32 SnapshotIndex, const FVector& Location)
+		{
+			const FTrafficReplicatedVehicle& Vehicle = Snapshot.Vehicles[SnapshotIndex];
+			const float Distance = FVector::Dist2D(Location, ViewLocation);
+			RelevantIds.Add(Vehicle.TrafficId);
+
+			int32 Ring = 0;
+			while (Ring < Rings.Num() - 1 && Distance > Rings[Ring].Radius)
+			{
+				++Ring;
+			}
+
+			const float Interval = FMath::Max(Rings[Ring].UpdateInterval, SendInterval);
+			const float* LastSent = LastSentTimes.Find(Vehicle.TrafficId);
+
+			// Hiç gönderilmemiş araçlar aynı halkadaki diğerlerinden önce gelir
+			const float Elapsed = LastSent ? Now - *LastSent : Interval * 4.0f;
+
+			// Bir sonraki pakete kadar beklemek aralığı yarım paketten fazla aşacaksa şimdi gönder
+			if (Elapsed + SendInterval * 0.5f < Interval)
+			{
+				return;
+			}
+
+			// Gecikme oranı arttıkça ve istemciye yaklaştıkça öncelik artar
+			Candidates.Add({ SnapshotIndex, (Elapsed / Interval) / (1.0f + Distance / InnerRadius) });
+		});
+	}
+
+	// İstemcinin bildiği ama artık ilgide olmayan araçlar (kaldırıldı veya son halkadan çıktı) silinir
+	for (TMap<uint32, float>::TIterator It = LastSentTimes.CreateIterator(); It; ++It)
+	{
+		if (!RelevantIds.Contains(It.Key()))
+		{
+			PendingRemovals.Add(It.Key(), TrafficReplication::RemovalRepeats);
+			It.RemoveCurrent();
+		}
+	}
+
+	// Tekrar ilgiye giren araç yeni araç olarak gönderilir; eski silme aynı pakette onu silmesin
+	Removals.Reset();
+	for (TMap<uint32, int32>::TIterator It = PendingRemovals.CreateIterator(); It; ++It)
+	{
+		if (RelevantIds.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+		else
+		{
+			Removals.Add(It.Key());
+		}
+	}
+	Removals.Sort();
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.Priority > B.Priority;
+	});
+
+	// Silmeler önce (bütçenin en fazla yarısı); sığmayanlar bir sonraki pakete kalır
+	const int32 BudgetBits = Settings.MaxPacketBytes * 8 - 32 - 2;
+	int32 UsedBits = 0;
+	int32 NumRemovals = 0;
+	for (uint32 PreviousRemoval = 0; NumRemovals < Removals.Num(); ++NumRemovals)
+	{
+		const int32 RemovalBits = 1 + GetPackedIntBits(Removals[NumRemovals] - PreviousRemoval);
+		if (UsedBits + RemovalBits > BudgetBits / 2)
+		{
+			break;
+		}
+		UsedBits += RemovalBits;
+		PreviousRemoval = Removals[NumRemovals];
+	}
+	Removals.SetNum(NumRemovals, false);
+
+	// Bütçeye sığan en öncelikliler seçilir. Kimlik farkı kimlik sırasına bağlı olduğundan
+	// boyut tam kimlikle (üst sınır) hesaplanır, yazım sonra kimlik sırasıyla yapılır.
+	int32 NumSelected = 0;
+	for (; NumSelected < Candidates.Num(); ++NumSelected)
+	{
+		const int32 VehicleBits = GetVehicleBits(Snapshot.Vehicles[Candidates[NumSelected].SnapshotIndex], 0);
+		if (UsedBits + VehicleBits > BudgetBits)
+		{
+			break;
+		}
+		UsedBits += VehicleBits;
+	}
+	Candidates.SetNum(NumSelected, false);
+
+	Candidates.Sort([&Snapshot](const FCandidate& A, const FCandidate& B)
+	{
+		return Snapshot.Vehicles[A.SnapshotIndex].TrafficId < Snapshot.Vehicles[B.SnapshotIndex].TrafficId;
+	});
+
+	FTrafficReplicationCodec::WriteHeader(Writer, Now);
+
+	uint32 PreviousId = 0;
+	for (const FCandidate& Candidate : Candidates)
+	{
+		const FTrafficReplicatedVehicle& Vehicle = Snapshot.Vehicles[Candidate.SnapshotIndex];
+		FTrafficReplicationCodec::WriteVehicle(Writer, Vehicle, PreviousId);
+		PreviousId = Vehicle.TrafficId;
+
+		LastSentTimes.Add(Vehicle.TrafficId, Now);
+
+		// Şerit tanımı güvenilir kanaldan bir kez gönderilir
+		if (Vehicle.LaneId != INDEX_NONE && !KnownLanes.Contains(Vehicle.LaneId))
+		{
+			KnownLanes.Add(Vehicle.LaneId);
+			OutNewLanes.Add(Vehicle.LaneId);
+		}
+	}
+
+	FTrafficReplicationCodec::WriteEnd(Writer);
+
+	uint32 PreviousRemoval = 0;
+	for (const uint32 TrafficId : Removals)
+	{
+		FTrafficReplicationCodec::WriteRemoval(Writer, TrafficId, PreviousRemoval);
+		PreviousRemoval = TrafficId;
+
+		int32& RemainingRepeats = PendingRemovals.FindChecked(TrafficId);
+		if (--RemainingRepeats <= 0)
+		{
+			PendingRemovals.Remove(TrafficId);
+		}
+	}
+	RemovalsSent += Removals.Num();
+
+	FTrafficReplicationCodec::WriteEnd(Writer);
+
+	BytesSent += Writer.GetNumBytes();
+	++PacketsSent;
+
+	return Candidates.Num();
+}
+
+void FTrafficReplicationChannel::Reset()
+{
+	LastSentTimes.Reset();
+	PendingRemovals.Reset();
+	RelevantIds.Reset();
+	Removals.Reset();
+	KnownLanes.Reset();
+	Candidates.Reset();
+	SendAccumulator = 0.0f;
+	LastPruneTime = 0.0f;
+	BytesSent = 0;
+	RemovalsSent = 0;
+	PacketsSent = 0;
+}
+
+// ============================================
+// İSTEMCİ ÖNBELLEĞİ
+// ============================================
+
+bool FTrafficReplicationProxyCache::ReadPacket(FBitReader& Reader, double LocalTime)
+{
+	float ServerTime = 0.0f;
+	if (!FTrafficReplicationCodec::ReadHeader(Reader, ServerTime))
+	{
+		return false;
+	}
+
+	FTrafficReplicatedVehicle State;
+	uint32 PreviousId = 0;
+	while (FTrafficReplicationCodec::ReadVehicle(Reader, State, PreviousId))
+	{
+		PreviousId = State.TrafficId;
+
+		FTrafficProxyVehicle* Proxy = Vehicles.Find(State.TrafficId);
+		if (!Proxy)
+		{
+			Proxy = &Vehicles.Add(State.TrafficId);
+			Proxy->ExtrapolatedDistance = State.Distance;
+		}
+		else if (ServerTime <= Proxy->ServerTime)
+		{
+			// Güvenilmez kanal: sırasız gelen eski durum
+			continue;
+		}
+		else if (State.LaneId != INDEX_NONE && State.LaneId == Proxy->State.LaneId)
+		{
+			// Tahmin ile yeni durum arasındaki fark CorrectionTime içinde kapatılır
+			const float Correction = Proxy->ExtrapolatedDistance - State.Distance;
+			Proxy->CorrectionOffset = FMath::Abs(Correction) <= MaxCorrectionDistance ? Correction : 0.0f;
+		}
+		else
+		{
+			Proxy->CorrectionOffset = 0.0f;
+		}
+
+		Proxy->State = State;
+		Proxy->ServerTime = ServerTime;
+		Proxy->ReceiveTime = LocalTime;
+	}
+
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	// Silmeler: sırasız gelen eski paket, sonradan yeniden eklenen aracı silmez
+	uint32 TrafficId = 0;
+	PreviousId = 0;
+	while (FTrafficReplicationCodec::ReadRemoval(Reader, TrafficId, PreviousId))
+	{
+		PreviousId = TrafficId;
+
+		const FTrafficProxyVehicle* Proxy = Vehicles.Find(TrafficId);
+		if (Proxy && Proxy->ServerTime < ServerTime)
+		{
+			Vehicles.Remove(TrafficId);
+		}
+	}
+
+	return !Reader.IsError();
+}
+
+void FTrafficReplicationProxyCache::Update(double LocalTime, const FTrafficReplicationSettings& Settings, FLaneResolver ResolveLane)
+{
+	for (TMap<uint32, FTrafficProxyVehicle>::TIterator It = Vehicles.CreateIterator(); It; ++It)
+	{
+		FTrafficProxyVehicle& Proxy = It.Value();
+		const float Age = (float)(LocalTime - Proxy.ReceiveTime);
+		if (Age > Settings.StaleTimeout)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FTrafficReplicatedVehicle& State = Proxy.State;
+		if (State.LaneId != INDEX_NONE)
+		{
+			// Son hızla şerit boyunca ilerlet
+			const float Blend = Settings.CorrectionTime > 0.0f ? FMath::Max(0.0f, 1.0f - Age / Settings.CorrectionTime) : 0.0f;
+			Proxy.ExtrapolatedDistance = State.Distance + State.Speed * Age + Proxy.CorrectionOffset * Blend;
+
+			// Şerit tanımı henüz gelmediyse son transform korunur
+			if (ResolveLane(State.LaneId, Proxy.ExtrapolatedDistance, Proxy.Location, Proxy.Rotation))
+			{
+				Proxy.bHasTransform = true;
+			}
+		}
+		else
+		{
+			// Şeritsiz araç: yön boyunca düz
+			Proxy.Rotation = FRotator(0.0f, State.Yaw, 0.0f);
+			Proxy.Location = State.Location + Proxy.Rotation.Vector() * State.Speed * Age;
+			Proxy.bHasTransform = true;
+		}
+	}
+}
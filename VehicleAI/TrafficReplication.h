@@ -0,0 +1,325 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrafficSpatialHash.h"
+#include "TrafficReplication.generated.h"
+
+class FBitReader;
+class FBitWriter;
+class USplineComponent;
+
+/**
+ * Trafik replikasyonu kuantizasyon sabitleri.
+ * Şeride bağlı bir araç ~8 byte ile gönderilir (tam transform + hız ~40 byte).
+ */
+namespace TrafficReplication
+{
+	/** Şerit mesafesi adımı (cm). DistanceBits ile en fazla ~10 km şerit. */
+	constexpr float DistanceQuantum = 1.0f;
+	constexpr int32 DistanceBits = 20;
+
+	/** Hız adımı (cm/s). SpeedBits ile en fazla ~20000 cm/s (720 km/h). */
+	constexpr float SpeedQuantum = 5.0f;
+	constexpr int32 SpeedBits = 12;
+
+	/** Şerit ID'si bit sayısı (FFarFieldVehicle::LaneId ile aynı aralık). */
+	constexpr int32 LaneBits = 16;
+
+	constexpr uint8 FlagPanicking = 1 << 0;
+	constexpr uint8 FlagFarField = 1 << 1;
+
+	/** Silme kaydı kaç pakette tekrarlanır (güvenilmez kanal; hepsi kaybolursa StaleTimeout siler). */
+	constexpr int32 RemovalRepeats = 3;
+}
+
+/**
+ * İstemci merkezli ilgi halkası.
+ * Halkadaki araçlar en fazla UpdateInterval saniyede bir gönderilir.
+ */
+USTRUCT(BlueprintType)
+struct FTrafficRelevancyRing
+{
+	GENERATED_BODY()
+
+	FTrafficRelevancyRing() = default;
+
+	FTrafficRelevancyRing(float InRadius, float InUpdateInterval)
+		: Radius(InRadius)
+		, UpdateInterval(InUpdateInterval)
+	{
+	}
+
+	/** Halka dış yarıçapı (birim). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "0.0"))
+	float Radius = 5000.0f;
+
+	/** Bu halkadaki bir aracın iki gönderimi arasındaki en kısa süre (saniye). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "0.0"))
+	float UpdateInterval = 0.1f;
+};
+
+/**
+ * Trafik replikasyon ayarları.
+ */
+USTRUCT(BlueprintType)
+struct YOURGAMENAME_API FTrafficReplicationSettings
+{
+	GENERATED_BODY()
+
+	FTrafficReplicationSettings();
+
+	/** İlgi halkaları (yarıçapa göre artan). Son halkanın dışındaki araçlar gönderilmez. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication")
+	TArray<FTrafficRelevancyRing> Rings;
+
+	/** İstemci başına saniyedeki paket sayısı. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "1.0"))
+	float SendRate;
+
+	/** Paket başına en fazla byte (MTU altında kalmalı). Sığmayan araçlar bir sonraki pakete kalır (öncelikleri artar). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "16"))
+	int32 MaxPacketBytes;
+
+	/** Bu süre (saniye) güncelleme almayan istemci araçları silinir (silme kayıtları kaybolursa son çare). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "0.0"))
+	float StaleTimeout;
+
+	/** Yeni güncelleme ile tahmin arasındaki farkın yumuşatılma süresi (saniye). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication", meta = (ClampMin = "0.0"))
+	float CorrectionTime;
+};
+
+/**
+ * İstemciye bildirilen şerit tanımı (sunucu şerit ID'si -> spline + offset).
+ * Spline net adreslenebilir olduğu için istemci kendi şeridini FindOrAddLane ile bulur.
+ */
+USTRUCT()
+struct FTrafficReplicatedLane
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 LaneId = INDEX_NONE;
+
+	UPROPERTY()
+	USplineComponent* Spline = nullptr;
+
+	UPROPERTY()
+	float LaneOffset = 0.0f;
+};
+
+/**
+ * Replikasyon için bir aracın durumu.
+ * Şeride bağlı araçlar şerit + mesafe + hız olarak, diğerleri konum + yön + hız olarak gönderilir.
+ */
+struct FTrafficReplicatedVehicle
+{
+	uint32 TrafficId = 0;
+
+	/** Sunucu şerit ID'si (INDEX_NONE = şeride bağlı değil). */
+	int32 LaneId = INDEX_NONE;
+
+	/** Şerit üzerindeki mesafe (birim). */
+	float Distance = 0.0f;
+
+	/** Hız (cm/s). */
+	float Speed = 0.0f;
+
+	/** Dünya konumu (ilgi sorgusu için her zaman, şeride bağlı değilse pakette de). */
+	FVector Location = FVector::ZeroVector;
+
+	float Yaw = 0.0f;
+
+	/** TrafficReplication::Flag* */
+	uint8 Flags = 0;
+};
+
+/**
+ * Bir adımdaki tüm araçların replikasyon görüntüsü.
+ * UTrafficSubsystem tarafından karede bir kez kurulur ve tüm istemci kanallarınca paylaşılır.
+ */
+struct FTrafficReplicationSnapshot
+{
+	/** Sunucu zamanı (saniye). */
+	float Time = 0.0f;
+
+	TArray<FTrafficReplicatedVehicle> Vehicles;
+
+	/** Vehicles konumlarının spatial hash'i (öğe = Vehicles indeksi). */
+	FTrafficSpatialHash SpatialHash;
+};
+
+/**
+ * Bit seviyesinde araç kodlayıcı.
+ * Paket: zaman (32 bit), her araç için 1 devam biti + kayıt, 0 bit; ardından silinen
+ * (kaldırılan veya ilgi dışına çıkan) her kimlik için 1 devam biti + kimlik, 0 bit.
+ * Her iki listede kimlikler artan sırada yazılır ve bir öncekine göre fark olarak paketlenir.
+ */
+class YOURGAMENAME_API FTrafficReplicationCodec
+{
+public:
+	static void WriteHeader(FBitWriter& Writer, float ServerTime);
+	static bool ReadHeader(FBitReader& Reader, float& OutServerTime);
+
+	/** Devam biti dahil bir araç yazar. */
+	static void WriteVehicle(FBitWriter& Writer, const FTrafficReplicatedVehicle& Vehicle, uint32 PreviousId);
+
+	/** Liste sonu (araçlar ve silmeler ayrı ayrı biter). */
+	static void WriteEnd(FBitWriter& Writer);
+
+	/** Devam biti dahil bir silme kaydı yazar. */
+	static void WriteRemoval(FBitWriter& Writer, uint32 TrafficId, uint32 PreviousId);
+
+	/**
+	 * Sıradaki silme kaydını okur.
+	 *
+	 * @return Liste bittiyse veya okuma hatasında false
+	 */
+	static bool ReadRemoval(FBitReader& Reader, uint32& OutTrafficId, uint32 PreviousId);
+
+	/**
+	 * Sıradaki aracı okur.
+	 *
+	 * @return Paket bittiyse veya okuma hatasında false
+	 */
+	static bool ReadVehicle(FBitReader& Reader, FTrafficReplicatedVehicle& OutVehicle, uint32 PreviousId);
+};
+
+/**
+ * Sunucu tarafında bir istemcinin replikasyon kanalı.
+ * Her gönderimde istemcinin görüş noktasına göre ilgi halkalarındaki araçlar seçilir,
+ * gönderim zamanı gelenler önceliğe (bekleme süresi / mesafe) göre sıralanıp
+ * paket bütçesi dolana kadar yazılır.
+ */
+class YOURGAMENAME_API FTrafficReplicationChannel
+{
+public:
+	/**
+	 * Gönderim saatini ilerletir.
+	 *
+	 * @return Bu karede paket gönderilmeliyse true
+	 */
+	bool Tick(float DeltaTime, const FTrafficReplicationSettings& Settings);
+
+	/**
+	 * Paketi oluşturur.
+	 *
+	 * İstemcinin bildiği ama artık ilgi halkalarında olmayan (kaldırılmış veya uzaklaşmış) araçlar
+	 * silme kaydı olarak RemovalRepeats pakette tekrarlanır.
+	 *
+	 * @param OutNewLanes İstemcinin henüz bilmediği, bu pakette kullanılan şeritler (güvenilir kanaldan gönderilmeli)
+	 * @return Pakete yazılan araç sayısı
+	 */
+	int32 BuildPacket(const FTrafficReplicationSnapshot& Snapshot, const FVector& ViewLocation, const FTrafficReplicationSettings& Settings,
+		FBitWriter& Writer, TArray<int32>& OutNewLanes);
+
+	/** Şimdiye kadar gönderilen toplam byte. */
+	int64 GetBytesSent() const { return BytesSent; }
+
+	/** Şimdiye kadar gönderilen paket sayısı. */
+	int32 GetPacketsSent() const { return PacketsSent; }
+
+	/** Şimdiye kadar yazılan silme kaydı sayısı (tekrarlar dahil). */
+	int64 GetRemovalsSent() const { return RemovalsSent; }
+
+	void Reset();
+
+private:
+	struct FCandidate
+	{
+		int32 SnapshotIndex;
+		float Priority;
+	};
+
+	/** Araç kimliği -> son gönderim zamanı (sunucu zamanı). İstemcinin bildiği araçlar. */
+	TMap<uint32, float> LastSentTimes;
+
+	/** Silinen araç kimliği -> kalan tekrar sayısı. */
+	TMap<uint32, int32> PendingRemovals;
+
+	/** Bu paketteki ilgi halkalarında olan kimlikler (gönderimler arasında bellek korunur). */
+	TSet<uint32> RelevantIds;
+
+	/** Bu pakete yazılacak silmeler (kimlik sırasıyla). */
+	TArray<uint32> Removals;
+
+	/** İstemciye bildirilmiş şeritler. */
+	TSet<int32> KnownLanes;
+
+	/** Aday listesi (gönderimler arasında bellek korunur). */
+	TArray<FCandidate> Candidates;
+
+	float SendAccumulator = 0.0f;
+	float LastPruneTime = 0.0f;
+	int64 BytesSent = 0;
+	int64 RemovalsSent = 0;
+	int32 PacketsSent = 0;
+};
+
+/**
+ * İstemci tarafı trafik vekil aracı.
+ */
+struct FTrafficProxyVehicle
+{
+	/** Son alınan durum. */
+	FTrafficReplicatedVehicle State;
+
+	/** Durumun sunucu zamanı (sırasız gelen eski paketler atlanır). */
+	float ServerTime = 0.0f;
+
+	/** Durumun alındığı yerel zaman. */
+	double ReceiveTime = 0.0;
+
+	/** Yumuşatılan şerit mesafesi farkı (birim), CorrectionTime içinde sıfıra iner. */
+	float CorrectionOffset = 0.0f;
+
+	/** Transform en az bir kez çözüldü mü (şerit tanımı gelmeden önce false). */
+	bool bHasTransform = false;
+
+	/** Son Update'teki tahmini transform. */
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Son Update'teki tahmini şerit mesafesi. */
+	float ExtrapolatedDistance = 0.0f;
+};
+
+/**
+ * İstemci tarafında alınan trafik durumları.
+ * Güncellemeler arasında araçlar son hızlarıyla şerit boyunca ilerletilir.
+ */
+class YOURGAMENAME_API FTrafficReplicationProxyCache
+{
+public:
+	/** Şerit ID'si + mesafe -> dünya transform'u (istemcinin şerit eşlemesi). */
+	using FLaneResolver = TFunctionRef<bool(int32 LaneId, float Distance, FVector& OutLocation, FRotator& OutRotation)>;
+
+	/**
+	 * Paketi okur ve vekilleri günceller; silme kayıtlarındaki vekiller hemen kaldırılır.
+	 *
+	 * @return Paket geçerliyse true
+	 */
+	bool ReadPacket(FBitReader& Reader, double LocalTime);
+
+	/** Vekilleri LocalTime'a göre ilerletir ve süresi dolanları siler. */
+	void Update(double LocalTime, const FTrafficReplicationSettings& Settings, FLaneResolver ResolveLane);
+
+	/** Vekil aracı döndürür (nullptr = bilinmiyor). */
+	const FTrafficProxyVehicle* Find(uint32 TrafficId) const { return Vehicles.Find(TrafficId); }
+
+	int32 Num() const { return Vehicles.Num(); }
+
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (const TPair<uint32, FTrafficProxyVehicle>& Pair : Vehicles)
+		{
+			Func(Pair.Value);
+		}
+	}
+
+	void Reset() { Vehicles.Reset(); }
+
+private:
+	TMap<uint32, FTrafficProxyVehicle> Vehicles;
+};
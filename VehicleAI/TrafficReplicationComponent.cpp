@@ -0,0 +1,155 @@
+#include "TrafficReplicationComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "TrafficReplicationSubsystem.h"
+#include "TrafficSubsystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Replication Bytes Sent"), STAT_TrafficReplicationBytes, STATGROUP_Traffic);
+
+UTrafficReplicationComponent::UTrafficReplicationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	// Araçlar bu karede hareket ettikten sonra
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	SetIsReplicatedByDefault(true);
+
+	ServerElapsedTime = 0.0f;
+}
+
+void UTrafficReplicationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	UWorld* World = GetWorld();
+	UTrafficSubsystem* TrafficSubsystem = World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (!PlayerController || !TrafficSubsystem)
+	{
+		return;
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		// Dinleyen sunucunun kendi oyuncusu gerçek simülasyonu görür
+		if (!PlayerController->IsLocalController())
+		{
+			TickServer(DeltaTime, TrafficSubsystem);
+		}
+	}
+	else if (PlayerController->IsLocalController())
+	{
+		TickClient(TrafficSubsystem);
+	}
+}
+
+void UTrafficReplicationComponent::TickServer(float DeltaTime, UTrafficSubsystem* TrafficSubsystem)
+{
+	ServerElapsedTime += DeltaTime;
+
+	if (!Channel.Tick(DeltaTime, Settings))
+	{
+		return;
+	}
+
+	APlayerController* PlayerController = CastChecked<APlayerController>(GetOwner());
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	UTrafficReplicationSubsystem* ReplicationSubsystem = GetWorld()->GetSubsystem<UTrafficReplicationSubsystem>();
+	if (!ReplicationSubsystem)
+	{
+		return;
+	}
+
+	const FTrafficReplicationSnapshot& Snapshot = ReplicationSubsystem->GetSnapshot();
+
+	FBitWriter Writer(Settings.MaxPacketBytes * 8, true);
+	const int64 BytesBefore = Channel.GetBytesSent();
+	Channel.BuildPacket(Snapshot, ViewLocation, Settings, Writer, NewLaneIds);
+
+	if (NewLaneIds.Num() > 0)
+	{
+		TArray<FTrafficReplicatedLane> NewLanes;
+		NewLanes.Reserve(NewLaneIds.Num());
+		for (const int32 LaneId : NewLaneIds)
+		{
+			const FTrafficLane* Lane = TrafficSubsystem->GetLane(LaneId);
+			if (Lane && Lane->Spline.IsValid())
+			{
+				FTrafficReplicatedLane& NewLane = NewLanes.AddDefaulted_GetRef();
+				NewLane.LaneId = LaneId;
+				NewLane.Spline = Lane->Spline.Get();
+				NewLane.LaneOffset = Lane->LaneOffset;
+			}
+		}
+		ClientRegisterLanes(NewLanes);
+	}
+
+	ClientReceiveTraffic(*Writer.GetBuffer(), (int32)Writer.GetNumBits());
+
+	INC_DWORD_STAT_BY(STAT_TrafficReplicationBytes, (uint32)(Channel.GetBytesSent() - BytesBefore));
+}
+
+void UTrafficReplicationComponent::TickClient(UTrafficSubsystem* TrafficSubsystem)
+{
+	ProxyCache.Update(GetWorld()->GetTimeSeconds(), Settings, [this, TrafficSubsystem](int32 LaneId, float Distance, FVector& OutLocation, FRotator& OutRotation)
+	{
+		const int32* LocalLaneId = ServerToLocalLanes.Find(LaneId);
+		return LocalLaneId && TrafficSubsystem->GetLaneTransform(*LocalLaneId, Distance, OutLocation, OutRotation);
+	});
+}
+
+void UTrafficReplicationComponent::ClientRegisterLanes_Implementation(const TArray<FTrafficReplicatedLane>& NewLanes)
+{
+	UTrafficSubsystem* TrafficSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (!TrafficSubsystem)
+	{
+		return;
+	}
+
+	for (const FTrafficReplicatedLane& NewLane : NewLanes)
+	{
+		// Spline istemcide yüklü değilse şerit atlanır, araçları çözülmeden kalır
+		const int32 LocalLaneId = TrafficSubsystem->FindOrAddLane(NewLane.Spline, NewLane.LaneOffset);
+		if (LocalLaneId != INDEX_NONE)
+		{
+			ServerToLocalLanes.Add(NewLane.LaneId, LocalLaneId);
+		}
+	}
+}
+
+void UTrafficReplicationComponent::ClientReceiveTraffic_Implementation(const TArray<uint8>& Data, int32 NumBits)
+{
+	if (NumBits < 0 || NumBits > Data.Num() * 8)
+	{
+		return;
+	}
+
+	FBitReader Reader(Data.GetData(), NumBits);
+	if (!ProxyCache.ReadPacket(Reader, GetWorld()->GetTimeSeconds()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik replikasyon paketi okunamadı (%d bit)"), NumBits);
+	}
+}
+
+bool UTrafficReplicationComponent::GetProxyVehicleTransform(int32 TrafficId, FTransform& OutTransform) const
+{
+	const FTrafficProxyVehicle* Proxy = ProxyCache.Find((uint32)TrafficId);
+	if (!Proxy || !Proxy->bHasTransform)
+	{
+		return false;
+	}
+
+	OutTransform = FTransform(Proxy->Rotation, Proxy->Location);
+	return true;
+}
+
+float UTrafficReplicationComponent::GetBytesPerSecond() const
+{
+	return ServerElapsedTime > 0.0f ? (float)Channel.GetBytesSent() / ServerElapsedTime : 0.0f;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TrafficReplication.h"
+#include "TrafficReplicationComponent.generated.h"
+
+class UTrafficSubsystem;
+
+/**
+ * Trafik replikasyon kanalı (oyuncu başına).
+ * PlayerController'a eklenir. Sunucuda istemcinin görüş noktasına göre ilgi halkalarındaki
+ * araçları bit seviyesinde paketleyip güvenilmez RPC ile gönderir; istemcide gelen durumları
+ * tutar ve güncellemeler arasında araçları şerit boyunca ilerletir.
+ *
+ * Trafik aktörleri (AVehicle) replike edilmez; istemci vekil araçları
+ * GetProxyVehicleTransform / ForEachProxyVehicle ile çizer (ör. instanced mesh).
+ */
+UCLASS(ClassGroup = (Traffic), meta = (BlueprintSpawnableComponent))
+class YOURGAMENAME_API UTrafficReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficReplicationComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** İlgi halkaları, gönderim hızı ve paket bütçesi. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Replication")
+	FTrafficReplicationSettings Settings;
+
+	// ============================================
+	// İSTEMCİ
+	// ============================================
+
+	/** İstemcideki vekil araç sayısı. */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Replication")
+	int32 GetProxyVehicleCount() const { return ProxyCache.Num(); }
+
+	/**
+	 * Vekil aracın tahmini transform'u.
+	 *
+	 * @return Araç bilinmiyorsa veya şerit tanımı henüz gelmediyse false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Replication")
+	bool GetProxyVehicleTransform(int32 TrafficId, FTransform& OutTransform) const;
+
+	/** Transform'u çözülmüş her vekil araç için Func(const FTrafficProxyVehicle&) çağırır. */
+	template<typename FuncType>
+	void ForEachProxyVehicle(FuncType&& Func) const
+	{
+		ProxyCache.ForEach([&Func](const FTrafficProxyVehicle& Proxy)
+		{
+			if (Proxy.bHasTransform)
+			{
+				Func(Proxy);
+			}
+		});
+	}
+
+	// ============================================
+	// SUNUCU
+	// ============================================
+
+	/** Bu istemciye gönderilen ortalama byte / saniye. */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Replication")
+	float GetBytesPerSecond() const;
+
+protected:
+	/** Yeni şerit tanımları (güvenilir, paketten önce veya hemen sonra gelir). */
+	UFUNCTION(Client, Reliable)
+	void ClientRegisterLanes(const TArray<FTrafficReplicatedLane>& NewLanes);
+
+	/** Bit paketli trafik durumu (güvenilmez; kayıp paketlerin yerini bir sonraki alır). */
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveTraffic(const TArray<uint8>& Data, int32 NumBits);
+
+private:
+	void TickServer(float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+	void TickClient(UTrafficSubsystem* TrafficSubsystem);
+
+	FTrafficReplicationChannel Channel;
+	FTrafficReplicationProxyCache ProxyCache;
+
+	/** Sunucu şerit ID'si -> istemci şerit ID'si. */
+	TMap<int32, int32> ServerToLocalLanes;
+
+	/** Pakette ilk kez kullanılan şeritler (gönderimler arasında bellek korunur). */
+	TArray<int32> NewLaneIds;
+
+	/** Sunucu tarafında kanalın açık olduğu süre (saniye). */
+	float ServerElapsedTime;
+};
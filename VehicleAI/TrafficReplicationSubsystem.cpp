@@ -0,0 +1,121 @@
+#include "TrafficReplicationSubsystem.h"
+#include "Engine/World.h"
+#include "TrafficSubsystem.h"
+#include "VehicleAIController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Traffic Replication Snapshot"), STAT_TrafficReplicationSnapshot, STATGROUP_Traffic);
+
+namespace
+{
+	/** Replikasyon spatial hash'inin kova sayısı. */
+	constexpr int32 SnapshotHashBuckets = 4096;
+}
+
+UTrafficReplicationSubsystem::UTrafficReplicationSubsystem()
+{
+	ReplicationCellSize = 10000.0f; // 100 metre
+	SnapshotRevision = 0;
+}
+
+void UTrafficReplicationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TrafficSubsystem = Collection.InitializeDependency<UTrafficSubsystem>();
+
+	// Config değerleri burada yüklenmiş olur
+	Snapshot.SpatialHash.Initialize(ReplicationCellSize, SnapshotHashBuckets);
+}
+
+void UTrafficReplicationSubsystem::Deinitialize()
+{
+	Snapshot.Vehicles.Empty();
+	Snapshot.SpatialHash.Reset();
+	SnapshotRevision = 0;
+	TrafficSubsystem = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UTrafficReplicationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// UTrafficSubsystem ile aynı dünyalar
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const FTrafficReplicationSnapshot& UTrafficReplicationSubsystem::GetSnapshot()
+{
+	if (!TrafficSubsystem)
+	{
+		return Snapshot;
+	}
+
+	// Uzak alan adım görevinde yazılıyor olabilir (görünüm adımı bekler)
+	const TArrayView<const FTrafficLane> Lanes = TrafficSubsystem->GetLanes();
+	if (SnapshotRevision == TrafficSubsystem->GetStateRevision())
+	{
+		return Snapshot;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TrafficReplicationSnapshot);
+
+	SnapshotRevision = TrafficSubsystem->GetStateRevision();
+
+	const TArrayView<AVehicleAIController* const> Controllers = TrafficSubsystem->GetControllers();
+	UWorld* World = GetWorld();
+	Snapshot.Time = World ? World->GetTimeSeconds() : 0.0f;
+	Snapshot.Vehicles.Reset();
+	Snapshot.Vehicles.Reserve(Controllers.Num() + TrafficSubsystem->GetFarFieldVehicleCount());
+
+	// Yakın alan: şeride bağlı olanlar şerit + mesafe, diğerleri (panik, şerit dışı) konum olarak gönderilir
+	for (const AVehicleAIController* Controller : Controllers)
+	{
+		const APawn* Pawn = Controller->GetPawn();
+		if (!Pawn)
+		{
+			continue;
+		}
+
+		FTrafficReplicatedVehicle& Vehicle = Snapshot.Vehicles.AddDefaulted_GetRef();
+		Vehicle.TrafficId = Controller->TrafficId;
+		Vehicle.LaneId = Controller->LaneId;
+		Vehicle.Distance = Controller->DistanceAlongLane;
+		Vehicle.Speed = Controller->CurrentSpeed;
+		Vehicle.Location = Pawn->GetActorLocation();
+		Vehicle.Yaw = Pawn->GetActorRotation().Yaw;
+		Vehicle.Flags = Controller->bIsPanicking ? TrafficReplication::FlagPanicking : 0;
+	}
+
+	// Uzak alan: zaten şerit + mesafe + hız temsilinde
+	for (int32 LaneId = 0; LaneId < Lanes.Num(); ++LaneId)
+	{
+		const FTrafficLane& Lane = Lanes[LaneId];
+		for (int32 Index = 0; Index < Lane.FarField.Num(); ++Index)
+		{
+			const FFarFieldVehicle& FarVehicle = Lane.FarField[Index];
+
+			FTrafficReplicatedVehicle& Vehicle = Snapshot.Vehicles.AddDefaulted_GetRef();
+			Vehicle.TrafficId = Lane.FarFieldIds[Index];
+			Vehicle.LaneId = LaneId;
+			Vehicle.Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, Lane.Length);
+			Vehicle.Speed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+			Vehicle.Flags = TrafficReplication::FlagFarField;
+
+			FRotator Rotation;
+			if (TrafficSubsystem->GetLaneTransform(LaneId, Vehicle.Distance, Vehicle.Location, Rotation))
+			{
+				Vehicle.Yaw = Rotation.Yaw;
+			}
+		}
+	}
+
+	// İstemci başına ilgi sorgusu tüm araçları taramasın
+	Snapshot.SpatialHash.Reset();
+	for (int32 Index = 0; Index < Snapshot.Vehicles.Num(); ++Index)
+	{
+		Snapshot.SpatialHash.Add(Index, Snapshot.Vehicles[Index].Location);
+	}
+	Snapshot.SpatialHash.Build();
+
+	return Snapshot;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrafficReplication.h"
+#include "TrafficReplicationSubsystem.generated.h"
+
+class UTrafficSubsystem;
+
+/**
+ * Trafik replikasyon alt sistemi.
+ * UTrafficSubsystem'in şeritlerinden ve controller'larından karede en fazla bir kez replikasyon
+ * görüntüsü kurar; sunucudaki tüm istemci kanalları (UTrafficReplicationComponent) aynı görüntüyü
+ * ve spatial hash'i paylaşır. Simülasyon durumuna sadece salt okunur görünümlerle erişir.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficReplicationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficReplicationSubsystem();
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Bu adımdaki tüm araçların (yakın + uzak alan) replikasyon görüntüsü.
+	 * Trafik durumu değişmedikçe (UTrafficSubsystem::GetStateRevision) yeniden kurulmaz.
+	 */
+	const FTrafficReplicationSnapshot& GetSnapshot();
+
+protected:
+	/** Replikasyon spatial hash'inin hücre boyu (birim). İlgi halkaları büyük olduğu için araç hash'inden iri. */
+	UPROPERTY(Config)
+	float ReplicationCellSize;
+
+private:
+	/** Görüntünün okunduğu trafik alt sistemi. */
+	UPROPERTY(Transient)
+	TObjectPtr<UTrafficSubsystem> TrafficSubsystem;
+
+	/** Replikasyon görüntüsü (ilk istekte kurulur). */
+	FTrafficReplicationSnapshot Snapshot;
+
+	/** Görüntünün kurulduğu trafik durumu (0 = hiç kurulmadı). */
+	uint32 SnapshotRevision;
+};
@@ -0,0 +1,316 @@
+#include "TrafficScenario.h"
+#include "Components/SplineComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "TrafficLight.h"
+#include "TrafficSubsystem.h"
+#include "Vehicle.h"
+
+namespace
+{
+	/** [x, y, z] dizisini okur. */
+	bool ReadVector(const TSharedPtr<FJsonObject>& Object, const FString& Field, FVector& OutVector)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values;
+		if (!Object->TryGetArrayField(Field, Values) || Values->Num() != 3)
+		{
+			return false;
+		}
+
+		OutVector = FVector((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber(), (*Values)[2]->AsNumber());
+		return true;
+	}
+
+	ETrafficLightState ParseLightState(const FString& Name)
+	{
+		if (Name == TEXT("Red"))
+		{
+			return ETrafficLightState::Red;
+		}
+		if (Name == TEXT("Yellow"))
+		{
+			return ETrafficLightState::Yellow;
+		}
+		return ETrafficLightState::Green;
+	}
+
+	float GetNumber(const TSharedPtr<FJsonObject>& Object, const FString& Field, float Default)
+	{
+		double Value;
+		return Object->TryGetNumberField(Field, Value) ? (float)Value : Default;
+	}
+}
+
+bool FTrafficScenario::LoadFromFile(const FString& FilePath)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Senaryo okunamadı: %s"), *FilePath);
+		return false;
+	}
+
+	return LoadFromString(JsonText);
+}
+
+bool FTrafficScenario::LoadFromString(const FString& JsonText)
+{
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Senaryo JSON'u geçersiz"));
+		return false;
+	}
+
+	Seed = (int32)GetNumber(Root, TEXT("Seed"), 0.0f);
+	DeltaTime = GetNumber(Root, TEXT("DeltaTime"), 1.0f / 30.0f);
+	NumSteps = (int32)GetNumber(Root, TEXT("Steps"), 600.0f);
+	Root->TryGetStringField(TEXT("VehicleClass"), VehicleClass);
+
+	Splines.Reset();
+	Lights.Reset();
+	Vehicles.Reset();
+
+	const TArray<TSharedPtr<FJsonValue>>* SplineValues;
+	if (Root->TryGetArrayField(TEXT("Splines"), SplineValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *SplineValues)
+		{
+			const TSharedPtr<FJsonObject> Object = Value->AsObject();
+			FTrafficScenarioSpline& Spline = Splines.AddDefaulted_GetRef();
+			Object->TryGetStringField(TEXT("Name"), Spline.Name);
+			Object->TryGetBoolField(TEXT("ClosedLoop"), Spline.bClosedLoop);
+
+			const TArray<TSharedPtr<FJsonValue>>* Points;
+			if (Object->TryGetArrayField(TEXT("Points"), Points))
+			{
+				for (const TSharedPtr<FJsonValue>& Point : *Points)
+				{
+					const TArray<TSharedPtr<FJsonValue>>& Coordinates = Point->AsArray();
+					if (Coordinates.Num() == 3)
+					{
+						Spline.Points.Emplace(Coordinates[0]->AsNumber(), Coordinates[1]->AsNumber(), Coordinates[2]->AsNumber());
+					}
+				}
+			}
+
+			if (Spline.Points.Num() < 2)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Senaryo yolu %s en az 2 nokta içermeli"), *Spline.Name);
+				return false;
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* LightValues;
+	if (Root->TryGetArrayField(TEXT("Lights"), LightValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *LightValues)
+		{
+			const TSharedPtr<FJsonObject> Object = Value->AsObject();
+			FTrafficScenarioLight& Light = Lights.AddDefaulted_GetRef();
+			Object->TryGetStringField(TEXT("Name"), Light.Name);
+			ReadVector(Object, TEXT("Location"), Light.Location);
+			Light.Rotation.Yaw = GetNumber(Object, TEXT("Yaw"), 0.0f);
+			Light.GreenDuration = GetNumber(Object, TEXT("Green"), Light.GreenDuration);
+			Light.YellowDuration = GetNumber(Object, TEXT("Yellow"), Light.YellowDuration);
+			Light.RedDuration = GetNumber(Object, TEXT("Red"), Light.RedDuration);
+
+			FString StateName;
+			if (Object->TryGetStringField(TEXT("InitialState"), StateName))
+			{
+				Light.InitialState = ParseLightState(StateName);
+			}
+
+			FString IntersectionName;
+			if (Object->TryGetStringField(TEXT("IntersectionId"), IntersectionName))
+			{
+				Light.IntersectionId = FName(*IntersectionName);
+			}
+			Light.ApproachIndex = (int32)GetNumber(Object, TEXT("ApproachIndex"), 0.0f);
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* VehicleValues;
+	if (Root->TryGetArrayField(TEXT("Vehicles"), VehicleValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *VehicleValues)
+		{
+			const TSharedPtr<FJsonObject> Object = Value->AsObject();
+			FTrafficScenarioVehicle& Vehicle = Vehicles.AddDefaulted_GetRef();
+			Object->TryGetStringField(TEXT("Spline"), Vehicle.Spline);
+			Vehicle.LaneOffset = GetNumber(Object, TEXT("LaneOffset"), 0.0f);
+			Vehicle.Distance = GetNumber(Object, TEXT("Distance"), 0.0f);
+			Vehicle.Speed = GetNumber(Object, TEXT("Speed"), 0.0f);
+			Object->TryGetBoolField(TEXT("FarField"), Vehicle.bFarField);
+		}
+	}
+
+	// Tohumdan rastgele araçlar (büyük ölçekli zamanlama testleri)
+	const TSharedPtr<FJsonObject>* GenerateObject;
+	if (Root->TryGetObjectField(TEXT("Generate"), GenerateObject) && Splines.Num() > 0)
+	{
+		const TSharedPtr<FJsonObject>& Generate = *GenerateObject;
+		const int32 Count = (int32)GetNumber(Generate, TEXT("Count"), 0.0f);
+		const float MinSpeed = GetNumber(Generate, TEXT("MinSpeed"), 0.0f);
+		const float MaxSpeed = GetNumber(Generate, TEXT("MaxSpeed"), 1000.0f);
+		bool bGenerateFarField = false;
+		Generate->TryGetBoolField(TEXT("FarField"), bGenerateFarField);
+
+		TArray<float> LaneOffsets;
+		const TArray<TSharedPtr<FJsonValue>>* OffsetValues;
+		if (Generate->TryGetArrayField(TEXT("LaneOffsets"), OffsetValues))
+		{
+			for (const TSharedPtr<FJsonValue>& Offset : *OffsetValues)
+			{
+				LaneOffsets.Add((float)Offset->AsNumber());
+			}
+		}
+		if (LaneOffsets.Num() == 0)
+		{
+			LaneOffsets.Add(0.0f);
+		}
+
+		// Spline uzunluğu spawn'dan önce bilinmediği için mesafe nokta dizisi uzunluğundan (kirişler) tahmin edilir
+		FRandomStream Random(Seed);
+		Vehicles.Reserve(Vehicles.Num() + Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FTrafficScenarioSpline& Spline = Splines[Random.RandHelper(Splines.Num())];
+
+			float ChordLength = 0.0f;
+			for (int32 Point = 1; Point < Spline.Points.Num(); ++Point)
+			{
+				ChordLength += FVector::Dist(Spline.Points[Point - 1], Spline.Points[Point]);
+			}
+
+			FTrafficScenarioVehicle& Vehicle = Vehicles.AddDefaulted_GetRef();
+			Vehicle.Spline = Spline.Name;
+			Vehicle.LaneOffset = LaneOffsets[Random.RandHelper(LaneOffsets.Num())];
+			Vehicle.Distance = Random.FRandRange(0.0f, ChordLength);
+			Vehicle.Speed = Random.FRandRange(MinSpeed, MaxSpeed);
+			Vehicle.bFarField = bGenerateFarField;
+		}
+	}
+
+	return true;
+}
+
+int32 FTrafficScenario::Spawn(UWorld* World) const
+{
+	UTrafficSubsystem* TrafficSubsystem = World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (!TrafficSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Senaryo kurulamadı: UTrafficSubsystem yok"));
+		return 0;
+	}
+
+	// Tohum: senaryoda rastgelelik kullanan her şey aynı diziyi görür
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// Yollar
+	TMap<FString, USplineComponent*> SplinesByName;
+	for (const FTrafficScenarioSpline& SplineDesc : Splines)
+	{
+		AActor* Holder = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		USplineComponent* Spline = NewObject<USplineComponent>(Holder, FName(*SplineDesc.Name));
+		Holder->SetRootComponent(Spline);
+		Spline->RegisterComponent();
+
+		Spline->ClearSplinePoints(false);
+		for (const FVector& Point : SplineDesc.Points)
+		{
+			Spline->AddSplinePoint(Point, ESplineCoordinateSpace::World, false);
+		}
+		Spline->SetClosedLoop(SplineDesc.bClosedLoop, false);
+		Spline->UpdateSpline();
+
+		SplinesByName.Add(SplineDesc.Name, Spline);
+	}
+
+	// Işıklar: BeginPlay'den önce zamanlama atanır
+	for (const FTrafficScenarioLight& LightDesc : Lights)
+	{
+		const FTransform Transform(LightDesc.Rotation, LightDesc.Location);
+		ATrafficLight* Light = World->SpawnActorDeferred<ATrafficLight>(ATrafficLight::StaticClass(), Transform);
+		if (Light)
+		{
+			Light->InitializeTiming(LightDesc.GreenDuration, LightDesc.YellowDuration, LightDesc.RedDuration,
+				LightDesc.InitialState, LightDesc.IntersectionId, LightDesc.ApproachIndex);
+			Light->FinishSpawning(Transform);
+		}
+	}
+
+	TSubclassOf<AVehicle> VehicleClassToSpawn = AVehicle::StaticClass();
+	if (!VehicleClass.IsEmpty())
+	{
+		if (UClass* LoadedClass = LoadClass<AVehicle>(nullptr, *VehicleClass))
+		{
+			VehicleClassToSpawn = LoadedClass;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Senaryo araç sınıfı bulunamadı: %s, AVehicle kullanılıyor"), *VehicleClass);
+		}
+	}
+
+	const AVehicle* VehicleDefaults = VehicleClassToSpawn->GetDefaultObject<AVehicle>();
+	const TSubclassOf<AVehicleAIController> ControllerClass = VehicleDefaults->AIControllerClass
+		? VehicleDefaults->AIControllerClass
+		: TSubclassOf<AVehicleAIController>(AVehicleAIController::StaticClass());
+
+	// Araçlar (listedeki sırayla - kimlikler deterministik)
+	int32 NumSpawned = 0;
+	for (const FTrafficScenarioVehicle& VehicleDesc : Vehicles)
+	{
+		USplineComponent* const* SplinePtr = SplinesByName.Find(VehicleDesc.Spline);
+		if (!SplinePtr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Senaryo aracı bilinmeyen yolda: %s"), *VehicleDesc.Spline);
+			continue;
+		}
+
+		USplineComponent* Spline = *SplinePtr;
+		const float Distance = FMath::Clamp(VehicleDesc.Distance, 0.0f, Spline->GetSplineLength());
+
+		if (VehicleDesc.bFarField)
+		{
+			const int32 LaneId = TrafficSubsystem->FindOrAddLane(Spline, VehicleDesc.LaneOffset);
+			if (TrafficSubsystem->AddFarFieldVehicle(LaneId, Distance, VehicleDesc.Speed, VehicleClassToSpawn))
+			{
+				++NumSpawned;
+			}
+			continue;
+		}
+
+		const FVector Location = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World)
+			+ Spline->GetRightVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World) * VehicleDesc.LaneOffset;
+		const FRotator Rotation = Spline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+
+		AVehicle* Vehicle = World->SpawnActor<AVehicle>(VehicleClassToSpawn, Location, Rotation, SpawnParams);
+		AVehicleAIController* Controller = Vehicle ? World->SpawnActor<AVehicleAIController>(ControllerClass, Location, Rotation, SpawnParams) : nullptr;
+		if (!Controller)
+		{
+			if (Vehicle)
+			{
+				Vehicle->Destroy();
+			}
+			continue;
+		}
+
+		Controller->Possess(Vehicle);
+		Controller->PlaceOnLane(Spline, VehicleDesc.LaneOffset, Distance, VehicleDesc.Speed);
+		++NumSpawned;
+	}
+
+	return NumSpawned;
+}
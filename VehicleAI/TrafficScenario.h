@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VehicleAIController.h" // ETrafficLightState
+
+class AVehicle;
+class USplineComponent;
+class UWorld;
+
+/**
+ * Senaryodaki bir yol (spline).
+ */
+struct FTrafficScenarioSpline
+{
+	FString Name;
+
+	/** Dünya koordinatlarında spline noktaları. */
+	TArray<FVector> Points;
+
+	bool bClosedLoop = false;
+};
+
+/**
+ * Senaryodaki bir trafik ışığı.
+ */
+struct FTrafficScenarioLight
+{
+	FString Name;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	float GreenDuration = 10.0f;
+	float YellowDuration = 3.0f;
+	float RedDuration = 8.0f;
+	ETrafficLightState InitialState = ETrafficLightState::Green;
+
+	FName IntersectionId;
+	int32 ApproachIndex = 0;
+};
+
+/**
+ * Senaryodaki bir araç.
+ */
+struct FTrafficScenarioVehicle
+{
+	/** FTrafficScenarioSpline::Name. */
+	FString Spline;
+
+	float LaneOffset = 0.0f;
+	float Distance = 0.0f;
+	float Speed = 0.0f;
+
+	/** true ise aktör spawn edilmez, doğrudan uzak alana eklenir. */
+	bool bFarField = false;
+};
+
+/**
+ * Headless trafik senaryosu (JSON).
+ * Yollar, ışıklar, araç listesi ve tohum (seed) içerir; aynı senaryo ve tohum
+ * aynı adım süresiyle her çalıştırmada aynı sonucu üretir.
+ *
+ * Büyük ölçekli testler için "Generate" bölümü tohumdan rastgele araç üretir:
+ * { "Count": 10000, "LaneOffsets": [-300, 0, 300], "MinSpeed": 0, "MaxSpeed": 1000, "FarField": true }
+ */
+struct YOURGAMENAME_API FTrafficScenario
+{
+	int32 Seed = 0;
+
+	/** Sabit adım süresi (saniye). */
+	float DeltaTime = 1.0f / 30.0f;
+
+	/** Varsayılan adım sayısı (komut satırı ile değiştirilebilir). */
+	int32 NumSteps = 600;
+
+	/** Spawn edilecek araç sınıfı (boş = AVehicle). */
+	FString VehicleClass;
+
+	TArray<FTrafficScenarioSpline> Splines;
+	TArray<FTrafficScenarioLight> Lights;
+	TArray<FTrafficScenarioVehicle> Vehicles;
+
+	/**
+	 * Senaryoyu JSON dosyasından yükler.
+	 *
+	 * @return Dosya okunamadıysa veya JSON geçersizse false
+	 */
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Senaryoyu JSON metninden yükler. */
+	bool LoadFromString(const FString& JsonText);
+
+	/**
+	 * Senaryoyu dünyaya kurar: yollar, ışıklar ve araçlar spawn edilir.
+	 * Spawn sırası sabittir, böylece araç kimlikleri (TrafficId) çalıştırmalar arasında aynı kalır.
+	 *
+	 * @param World Hedef dünya (BeginPlay çağrılmış olmalı)
+	 * @return Yakın alan araç sayısı + uzak alan araç sayısı
+	 */
+	int32 Spawn(UWorld* World) const;
+};
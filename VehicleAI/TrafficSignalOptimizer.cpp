@@ -0,0 +1,64 @@
+#include "TrafficSignalOptimizer.h"
+
+FSignalIntersectionTiming FTrafficSignalOptimizer::Optimize(const FSignalIntersectionDemand& Demand, const FTrafficSignalOptimizerSettings& Settings)
+{
+	FSignalIntersectionTiming Timing;
+	Timing.IntersectionId = Demand.IntersectionId;
+
+	const int32 NumApproaches = Demand.Approaches.Num();
+	if (NumApproaches == 0 || Settings.SaturationFlow <= 0.0f)
+	{
+		return Timing;
+	}
+
+	// Kayıp zaman: her fazın sarı süresi
+	float LostTime = 0.0f;
+	for (const FSignalApproachDemand& Approach : Demand.Approaches)
+	{
+		LostTime += Approach.YellowDuration;
+	}
+
+	// Akış oranları: geliş oranı + mevcut kuyruğun bir döngüde boşaltılması
+	const float CycleForQueue = FMath::Max(Demand.CurrentCycleLength, Settings.MinCycleLength);
+	TArray<float, TInlineAllocator<8>> FlowRatios;
+	float TotalFlowRatio = 0.0f;
+	for (const FSignalApproachDemand& Approach : Demand.Approaches)
+	{
+		const float Flow = Approach.ArrivalRate + Approach.QueueLength / CycleForQueue;
+		const float FlowRatio = Flow / Settings.SaturationFlow;
+		FlowRatios.Add(FlowRatio);
+		TotalFlowRatio += FlowRatio;
+	}
+
+	// Doygunluğa yakın talepte formül sonsuza gider - üst sınır
+	const float ClampedFlowRatio = FMath::Min(TotalFlowRatio, 0.95f);
+
+	// Webster optimum döngü süresi
+	float CycleLength = (1.5f * LostTime + 5.0f) / (1.0f - ClampedFlowRatio);
+	const float MinCycleForGreens = LostTime + NumApproaches * Settings.MinGreenDuration;
+	CycleLength = FMath::Clamp(CycleLength, FMath::Max(Settings.MinCycleLength, MinCycleForGreens), FMath::Max(Settings.MaxCycleLength, MinCycleForGreens));
+
+	// Efektif yeşil süre: minimumlar dağıtıldıktan sonra kalan, akış oranına göre paylaşılır
+	const float EffectiveGreen = CycleLength - LostTime;
+	const float DistributableGreen = EffectiveGreen - NumApproaches * Settings.MinGreenDuration;
+
+	Timing.CycleLength = CycleLength;
+	Timing.GreenDurations.SetNum(NumApproaches);
+	Timing.RedDurations.SetNum(NumApproaches);
+
+	for (int32 Index = 0; Index < NumApproaches; ++Index)
+	{
+		// Talep yoksa eşit paylaştır
+		const float Share = TotalFlowRatio > KINDA_SMALL_NUMBER
+			? FlowRatios[Index] / TotalFlowRatio
+			: 1.0f / NumApproaches;
+
+		const float Green = Settings.MinGreenDuration + DistributableGreen * Share;
+		Timing.GreenDurations[Index] = Green;
+
+		// Kırmızı = diğer yaklaşımların yeşil + sarı süreleri
+		Timing.RedDurations[Index] = CycleLength - Green - Demand.Approaches[Index].YellowDuration;
+	}
+
+	return Timing;
+}
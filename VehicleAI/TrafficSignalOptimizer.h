@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bir kavşak yaklaşımının (approach) talep örneği.
+ * Oyun thread'inde TriggerBox sayaçlarından kopyalanır, optimizasyon worker thread'de yapılır.
+ */
+struct FSignalApproachDemand
+{
+	/** Son örnekleme aralığındaki geliş oranı (araç/saniye). */
+	float ArrivalRate = 0.0f;
+
+	/** Şu an TriggerBox içinde bekleyen araç sayısı. */
+	int32 QueueLength = 0;
+
+	/** Sarı ışık süresi (saniye) - kayıp zaman olarak sayılır. */
+	float YellowDuration = 3.0f;
+};
+
+/**
+ * Bir kavşağın tüm yaklaşımlarının talebi.
+ * Yaklaşımlar faz sırasındadır (ATrafficLight::ApproachIndex).
+ */
+struct FSignalIntersectionDemand
+{
+	FName IntersectionId;
+
+	/** Mevcut döngü süresi (saniye). */
+	float CurrentCycleLength = 0.0f;
+
+	TArray<FSignalApproachDemand> Approaches;
+};
+
+/**
+ * Optimizasyon sonucu: her yaklaşım için yeni yeşil ve kırmızı süreleri.
+ * Tüm yaklaşımlar aynı döngü süresini paylaşır.
+ */
+struct FSignalIntersectionTiming
+{
+	FName IntersectionId;
+
+	/** Döngü süresi (saniye). */
+	float CycleLength = 0.0f;
+
+	TArray<float> GreenDurations;
+	TArray<float> RedDurations;
+
+	bool IsValid() const { return GreenDurations.Num() > 0; }
+};
+
+/**
+ * Optimizasyon ayarları.
+ */
+struct FTrafficSignalOptimizerSettings
+{
+	/** Doygunluk akışı (araç/saniye) - yeşilde bir yaklaşımdan geçebilecek en fazla araç. */
+	float SaturationFlow = 0.5f;
+
+	/** En kısa yeşil süre (saniye). */
+	float MinGreenDuration = 5.0f;
+
+	/** En kısa döngü süresi (saniye). */
+	float MinCycleLength = 30.0f;
+
+	/** En uzun döngü süresi (saniye). */
+	float MaxCycleLength = 120.0f;
+};
+
+/**
+ * Adaptif sinyal zamanlama (Webster yöntemi).
+ *
+ * Her yaklaşım için akış oranı: y_i = q_i / s
+ * Optimum döngü: C0 = (1.5 * L + 5) / (1 - Y), Y = Σ y_i, L = kayıp zaman (sarı süreler)
+ * Yeşil dağılımı: g_i = (C0 - L) * y_i / Y
+ *
+ * Saf hesaplama - UObject erişimi yok, worker thread'de güvenle çalışır.
+ */
+struct YOURGAMENAME_API FTrafficSignalOptimizer
+{
+	/**
+	 * Kavşak için yeni faz sürelerini hesaplar.
+	 *
+	 * @param Demand Yaklaşım talepleri
+	 * @param Settings Sınırlar ve doygunluk akışı
+	 * @return Yeni zamanlama (yaklaşım yoksa geçersiz)
+	 */
+	static FSignalIntersectionTiming Optimize(const FSignalIntersectionDemand& Demand, const FTrafficSignalOptimizerSettings& Settings);
+};
@@ -0,0 +1,301 @@
+#include "TrafficSignalSubsystem.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "TrafficLight.h"
+
+UTrafficSignalSubsystem::UTrafficSignalSubsystem()
+{
+	OptimizationInterval = 30.0f;
+	SaturationFlow = 0.5f; // 1800 araç/saat
+	MinGreenDuration = 5.0f;
+	MinCycleLength = 30.0f;
+	MaxCycleLength = 120.0f;
+	TimeSinceOptimization = 0.0f;
+	bSynchronousOptimization = false;
+}
+
+void UTrafficSignalSubsystem::Deinitialize()
+{
+	// Worker thread'in bitmesini bekle (sonuç artık uygulanmayacak)
+	if (OptimizationResult.IsValid())
+	{
+		OptimizationResult.Wait();
+		OptimizationResult = TFuture<TArray<FSignalIntersectionTiming>>();
+	}
+
+	for (TPair<FName, FTrafficIntersection>& Pair : Intersections)
+	{
+		for (const TWeakObjectPtr<ATrafficLight>& Approach : Pair.Value.Approaches)
+		{
+			if (ATrafficLight* Light = Approach.Get())
+			{
+				Light->OnLightStateChanged.RemoveAll(this);
+			}
+		}
+	}
+
+	Intersections.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UTrafficSignalSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrafficSignalSubsystem, STATGROUP_Tickables);
+}
+
+bool UTrafficSignalSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrafficSignalSubsystem::Tick(float DeltaTime)
+{
+	// Worker thread sonucu hazırsa bir sonraki döngü sınırı için beklet
+	if (OptimizationResult.IsValid() && OptimizationResult.IsReady())
+	{
+		TArray<FSignalIntersectionTiming> Timings = OptimizationResult.Get();
+		OptimizationResult = TFuture<TArray<FSignalIntersectionTiming>>();
+
+		for (FSignalIntersectionTiming& Timing : Timings)
+		{
+			FTrafficIntersection* Intersection = Intersections.Find(Timing.IntersectionId);
+
+			// Örnekleme sonrası yaklaşım eklendi / çıkarıldıysa sonuç geçersiz
+			if (Intersection && Timing.IsValid() && Timing.GreenDurations.Num() == Intersection->Approaches.Num())
+			{
+				Intersection->PendingTiming = MoveTemp(Timing);
+			}
+		}
+	}
+
+	TimeSinceOptimization += DeltaTime;
+	if (TimeSinceOptimization >= OptimizationInterval && !OptimizationResult.IsValid())
+	{
+		StartOptimization();
+		TimeSinceOptimization = 0.0f;
+	}
+}
+
+void UTrafficSignalSubsystem::RegisterTrafficLight(ATrafficLight* TrafficLight)
+{
+	if (!TrafficLight || TrafficLight->GetIntersectionId().IsNone())
+	{
+		return;
+	}
+
+	FTrafficIntersection& Intersection = Intersections.FindOrAdd(TrafficLight->GetIntersectionId());
+	Intersection.IntersectionId = TrafficLight->GetIntersectionId();
+
+	// Faz sırasına göre ekle
+	int32 InsertIndex = 0;
+	while (InsertIndex < Intersection.Approaches.Num())
+	{
+		const ATrafficLight* Existing = Intersection.Approaches[InsertIndex].Get();
+		if (Existing && Existing->GetApproachIndex() > TrafficLight->GetApproachIndex())
+		{
+			break;
+		}
+		++InsertIndex;
+	}
+	Intersection.Approaches.Insert(TrafficLight, InsertIndex);
+
+	// Yaklaşım sayısı değişti - bekleyen zamanlama artık geçersiz
+	Intersection.PendingTiming = FSignalIntersectionTiming();
+
+	TrafficLight->OnLightStateChanged.AddUObject(this, &UTrafficSignalSubsystem::HandleLightStateChanged);
+}
+
+void UTrafficSignalSubsystem::UnregisterTrafficLight(ATrafficLight* TrafficLight)
+{
+	if (!TrafficLight)
+	{
+		return;
+	}
+
+	TrafficLight->OnLightStateChanged.RemoveAll(this);
+
+	FTrafficIntersection* Intersection = Intersections.Find(TrafficLight->GetIntersectionId());
+	if (!Intersection)
+	{
+		return;
+	}
+
+	Intersection->Approaches.Remove(TrafficLight);
+	Intersection->PendingTiming = FSignalIntersectionTiming();
+
+	if (Intersection->Approaches.Num() == 0)
+	{
+		Intersections.Remove(TrafficLight->GetIntersectionId());
+	}
+}
+
+void UTrafficSignalSubsystem::StartOptimization()
+{
+	// Oyun thread'inde sayaçları kopyala - worker thread UObject'lere dokunmaz
+	TArray<FSignalIntersectionDemand> Demands;
+	Demands.Reserve(Intersections.Num());
+
+	for (const TPair<FName, FTrafficIntersection>& Pair : Intersections)
+	{
+		const FTrafficIntersection& Intersection = Pair.Value;
+
+		FSignalIntersectionDemand& Demand = Demands.AddDefaulted_GetRef();
+		Demand.IntersectionId = Intersection.IntersectionId;
+
+		for (const TWeakObjectPtr<ATrafficLight>& Approach : Intersection.Approaches)
+		{
+			ATrafficLight* Light = Approach.Get();
+			if (!Light)
+			{
+				// Yok edilmiş ışık: örnek eksik, bu kavşak atlanır
+				Demand.Approaches.Reset();
+				break;
+			}
+
+			FSignalApproachDemand& ApproachDemand = Demand.Approaches.AddDefaulted_GetRef();
+			ApproachDemand.ArrivalRate = Light->ConsumeArrivalCount() / FMath::Max(TimeSinceOptimization, KINDA_SMALL_NUMBER);
+			ApproachDemand.QueueLength = Light->GetQueueCount();
+			ApproachDemand.YellowDuration = Light->GetPhaseDuration(ETrafficLightState::Yellow);
+
+			if (Demand.CurrentCycleLength <= 0.0f)
+			{
+				Demand.CurrentCycleLength = Light->GetPhaseDuration(ETrafficLightState::Green)
+					+ Light->GetPhaseDuration(ETrafficLightState::Yellow)
+					+ Light->GetPhaseDuration(ETrafficLightState::Red);
+			}
+		}
+	}
+
+	FTrafficSignalOptimizerSettings Settings;
+	Settings.SaturationFlow = SaturationFlow;
+	Settings.MinGreenDuration = MinGreenDuration;
+	Settings.MinCycleLength = MinCycleLength;
+	Settings.MaxCycleLength = MaxCycleLength;
+
+	OptimizationResult = Async(EAsyncExecution::ThreadPool, [Demands = MoveTemp(Demands), Settings]()
+	{
+		TArray<FSignalIntersectionTiming> Timings;
+		Timings.Reserve(Demands.Num());
+		for (const FSignalIntersectionDemand& Demand : Demands)
+		{
+			Timings.Add(FTrafficSignalOptimizer::Optimize(Demand, Settings));
+		}
+		return Timings;
+	});
+
+	// Deterministik mod: sonuç bir sonraki Tick'te kesin hazır
+	if (bSynchronousOptimization)
+	{
+		OptimizationResult.Wait();
+	}
+}
+
+void UTrafficSignalSubsystem::HandleLightStateChanged(ATrafficLight* TrafficLight, ETrafficLightState NewState)
+{
+	if (NewState != ETrafficLightState::Green)
+	{
+		return;
+	}
+
+	FTrafficIntersection* Intersection = Intersections.Find(TrafficLight->GetIntersectionId());
+	if (!Intersection || Intersection->Approaches.Num() == 0 || Intersection->Approaches[0].Get() != TrafficLight)
+	{
+		return;
+	}
+
+	if (!Intersection->PendingTiming.IsValid())
+	{
+		return;
+	}
+
+	// Önce temizle: ApplyCycleTiming yeniden Green yayınlayabilir
+	const FSignalIntersectionTiming Timing = MoveTemp(Intersection->PendingTiming);
+	Intersection->PendingTiming = FSignalIntersectionTiming();
+
+	// Döngü sınırı: yaklaşımlar sırayla yeşil alacak şekilde yeniden fazlanır
+	float GreenStartDelay = 0.0f;
+	for (int32 Index = 0; Index < Intersection->Approaches.Num(); ++Index)
+	{
+		ATrafficLight* Light = Intersection->Approaches[Index].Get();
+		if (!Light)
+		{
+			continue;
+		}
+
+		Light->ApplyCycleTiming(Timing.GreenDurations[Index], Timing.RedDurations[Index], GreenStartDelay);
+		GreenStartDelay += Timing.GreenDurations[Index] + Light->GetPhaseDuration(ETrafficLightState::Yellow);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Kavşak %s yeni döngü: %.1f saniye"), *Timing.IntersectionId.ToString(), Timing.CycleLength);
+}
+
+void UTrafficSignalSubsystem::AccumulateMetrics(const FTrafficIntersection& Intersection, int32& OutDepartures, double& OutDelay, float& OutElapsed)
+{
+	for (const TWeakObjectPtr<ATrafficLight>& Approach : Intersection.Approaches)
+	{
+		if (const ATrafficLight* Light = Approach.Get())
+		{
+			OutDepartures += Light->GetTotalDepartures();
+			OutDelay += Light->GetTotalDelay();
+			OutElapsed = FMath::Max(OutElapsed, Light->GetMetricsElapsedTime());
+		}
+	}
+}
+
+FTrafficSignalMetrics UTrafficSignalSubsystem::GetIntersectionMetrics(FName IntersectionId) const
+{
+	FTrafficSignalMetrics Metrics;
+
+	const FTrafficIntersection* Intersection = Intersections.Find(IntersectionId);
+	if (!Intersection)
+	{
+		return Metrics;
+	}
+
+	double TotalDelay = 0.0;
+	AccumulateMetrics(*Intersection, Metrics.Departures, TotalDelay, Metrics.ElapsedTime);
+
+	Metrics.Throughput = Metrics.ElapsedTime > 0.0f ? Metrics.Departures / Metrics.ElapsedTime * 3600.0f : 0.0f;
+	Metrics.AverageDelay = Metrics.Departures > 0 ? (float)(TotalDelay / Metrics.Departures) : 0.0f;
+	return Metrics;
+}
+
+FTrafficSignalMetrics UTrafficSignalSubsystem::GetTotalMetrics() const
+{
+	FTrafficSignalMetrics Metrics;
+	double TotalDelay = 0.0;
+
+	for (const TPair<FName, FTrafficIntersection>& Pair : Intersections)
+	{
+		AccumulateMetrics(Pair.Value, Metrics.Departures, TotalDelay, Metrics.ElapsedTime);
+	}
+
+	Metrics.Throughput = Metrics.ElapsedTime > 0.0f ? Metrics.Departures / Metrics.ElapsedTime * 3600.0f : 0.0f;
+	Metrics.AverageDelay = Metrics.Departures > 0 ? (float)(TotalDelay / Metrics.Departures) : 0.0f;
+	return Metrics;
+}
+
+void UTrafficSignalSubsystem::ResetMetrics()
+{
+	for (const TPair<FName, FTrafficIntersection>& Pair : Intersections)
+	{
+		for (const TWeakObjectPtr<ATrafficLight>& Approach : Pair.Value.Approaches)
+		{
+			if (ATrafficLight* Light = Approach.Get())
+			{
+				Light->ResetMetrics();
+			}
+		}
+	}
+}
+
+void UTrafficSignalSubsystem::LogMetrics() const
+{
+	for (const TPair<FName, FTrafficIntersection>& Pair : Intersections)
+	{
+		const FTrafficSignalMetrics Metrics = GetIntersectionMetrics(Pair.Key);
+		UE_LOG(LogTemp, Log, TEXT("Kavşak %s: %d araç, verim %.0f araç/saat, ortalama bekleme %.2f saniye (%.0f saniye ölçüm)"),
+			*Pair.Key.ToString(), Metrics.Departures, Metrics.Throughput, Metrics.AverageDelay, Metrics.ElapsedTime);
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "TrafficSignalOptimizer.h"
+#include "VehicleAIController.h" // ETrafficLightState enum'u için
+#include "TrafficSignalSubsystem.generated.h"
+
+class ATrafficLight;
+
+/**
+ * Sinyal verim ve bekleme metrikleri.
+ * Adaptif zamanlamanın etkisini ölçmek için kullanılır (headless senaryolarda da).
+ */
+USTRUCT(BlueprintType)
+struct YOURGAMENAME_API FTrafficSignalMetrics
+{
+	GENERATED_BODY()
+
+	/** Ölçüm süresince TriggerBox'lardan çıkan toplam araç. */
+	UPROPERTY(BlueprintReadOnly, Category = "Traffic Signal Metrics")
+	int32 Departures = 0;
+
+	/** Verim (araç/saat). */
+	UPROPERTY(BlueprintReadOnly, Category = "Traffic Signal Metrics")
+	float Throughput = 0.0f;
+
+	/** Araç başına ortalama bekleme (saniye). Kuyruk integrali / ayrılan araç (Little yasası). */
+	UPROPERTY(BlueprintReadOnly, Category = "Traffic Signal Metrics")
+	float AverageDelay = 0.0f;
+
+	/** Ölçüm süresi (saniye). */
+	UPROPERTY(BlueprintReadOnly, Category = "Traffic Signal Metrics")
+	float ElapsedTime = 0.0f;
+};
+
+/**
+ * Kavşak: aynı IntersectionId'ye sahip ışıklar, faz sırasında.
+ */
+struct FTrafficIntersection
+{
+	FName IntersectionId;
+
+	/** Yaklaşımlar (ApproachIndex sırasında). Approaches[0] döngüyü başlatır. */
+	TArray<TWeakObjectPtr<ATrafficLight>> Approaches;
+
+	/** Worker thread'den gelen, bir sonraki döngü sınırında uygulanacak zamanlama. */
+	FSignalIntersectionTiming PendingTiming;
+};
+
+/**
+ * Adaptif sinyal zamanlama alt sistemi.
+ * Işıkların TriggerBox kuyruk sayaçlarını periyodik olarak örnekler, faz sürelerini
+ * worker thread'de (FTrafficSignalOptimizer) yeniden hesaplar ve sonucu her kavşağın
+ * döngü sınırında (ilk yaklaşımın yeşile geçişi) uygular.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficSignalSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficSignalSubsystem();
+
+	// UTickableWorldSubsystem
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Işığı kavşağına ekler (IntersectionId None ise ışık adaptif değildir).
+	 */
+	void RegisterTrafficLight(ATrafficLight* TrafficLight);
+
+	/**
+	 * Işığı kavşağından çıkarır.
+	 */
+	void UnregisterTrafficLight(ATrafficLight* TrafficLight);
+
+	/**
+	 * Bir kavşağın metriklerini döndürür.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Signal Metrics")
+	FTrafficSignalMetrics GetIntersectionMetrics(FName IntersectionId) const;
+
+	/**
+	 * Tüm kavşakların toplam metriklerini döndürür.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Signal Metrics")
+	FTrafficSignalMetrics GetTotalMetrics() const;
+
+	/**
+	 * Tüm ışıkların metriklerini sıfırlar (ısınma süresinden sonra ölçüme başlamak için).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Signal Metrics")
+	void ResetMetrics();
+
+	/**
+	 * Her kavşağın metriklerini log'a yazar.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Traffic Signal Metrics")
+	void LogMetrics() const;
+
+	/**
+	 * true ise optimizasyon sonucu beklenir (aynı karede hazır olur). Sonuç worker thread'in
+	 * bitiş zamanına bağlı kalmaz - deterministik headless çalıştırmalar için.
+	 */
+	void SetSynchronousOptimization(bool bSynchronous) { bSynchronousOptimization = bSynchronous; }
+
+protected:
+	/** Optimizasyon aralığı (saniye). */
+	UPROPERTY(Config)
+	float OptimizationInterval;
+
+	/** Doygunluk akışı (araç/saniye). */
+	UPROPERTY(Config)
+	float SaturationFlow;
+
+	/** En kısa yeşil süre (saniye). */
+	UPROPERTY(Config)
+	float MinGreenDuration;
+
+	/** En kısa döngü süresi (saniye). */
+	UPROPERTY(Config)
+	float MinCycleLength;
+
+	/** En uzun döngü süresi (saniye). */
+	UPROPERTY(Config)
+	float MaxCycleLength;
+
+private:
+	/** Sayaçları örnekler ve optimizasyonu worker thread'de başlatır. */
+	void StartOptimization();
+
+	/** Döngü sınırını yakalar: ilk yaklaşım yeşile geçtiğinde bekleyen zamanlama uygulanır. */
+	void HandleLightStateChanged(ATrafficLight* TrafficLight, ETrafficLightState NewState);
+
+	/** Metrikleri verilen ışıklar üzerinden toplar. */
+	static void AccumulateMetrics(const FTrafficIntersection& Intersection, int32& OutDepartures, double& OutDelay, float& OutElapsed);
+
+	/** Kavşaklar (IntersectionId -> kavşak). */
+	TMap<FName, FTrafficIntersection> Intersections;
+
+	/** Devam eden optimizasyonun sonucu. */
+	TFuture<TArray<FSignalIntersectionTiming>> OptimizationResult;
+
+	/** Son optimizasyondan bu yana geçen süre. */
+	float TimeSinceOptimization;
+
+	/** Optimizasyon sonucu başlatıldığı karede beklensin mi. */
+	bool bSynchronousOptimization;
+};
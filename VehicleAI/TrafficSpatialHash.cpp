@@ -0,0 +1,62 @@
+#include "TrafficSpatialHash.h"
+
+void FTrafficSpatialHash::Initialize(float InCellSize, int32 InNumBuckets)
+{
+	check(FMath::IsPowerOfTwo(InNumBuckets));
+	InvCellSize = 1.0f / FMath::Max(InCellSize, 1.0f);
+	BucketMask = InNumBuckets - 1;
+	BucketStarts.SetNumZeroed(InNumBuckets + 1);
+	Reset();
+}
+
+void FTrafficSpatialHash::Reset()
+{
+	PendingItems.Reset();
+	Items.Reset();
+}
+
+void FTrafficSpatialHash::Add(int32 ItemId, const FVector& Location)
+{
+	FItem& Item = PendingItems.AddUninitialized_GetRef();
+	Item.Location = Location;
+	Item.ItemId = ItemId;
+	Item.CellX = FMath::FloorToInt(Location.X * InvCellSize);
+	Item.CellY = FMath::FloorToInt(Location.Y * InvCellSize);
+}
+
+void FTrafficSpatialHash::Build()
+{
+	const int32 NumBuckets = BucketStarts.Num() - 1;
+	if (NumBuckets <= 0)
+	{
+		return;
+	}
+
+	// Counting sort: 1) kova başına say
+	FMemory::Memzero(BucketStarts.GetData(), BucketStarts.Num() * sizeof(int32));
+	for (const FItem& Item : PendingItems)
+	{
+		++BucketStarts[HashCell(Item.CellX, Item.CellY) + 1];
+	}
+
+	// 2) Önek toplamı
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		BucketStarts[Bucket + 1] += BucketStarts[Bucket];
+	}
+
+	// 3) Dağıt (yazma imleçleri için geçici olarak başlangıçları kaydır)
+	Items.SetNumUninitialized(PendingItems.Num(), false);
+	for (const FItem& Item : PendingItems)
+	{
+		const int32 Bucket = HashCell(Item.CellX, Item.CellY);
+		Items[BucketStarts[Bucket]++] = Item;
+	}
+
+	// İmleçler bir sonraki kovanın başına kaydı - geri al
+	for (int32 Bucket = NumBuckets; Bucket > 0; --Bucket)
+	{
+		BucketStarts[Bucket] = BucketStarts[Bucket - 1];
+	}
+	BucketStarts[0] = 0;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Trafik için 2D uniform grid spatial hash (broadphase).
+ * Her adımda bir kez tüm araç konumlarından kurulur (counting sort, tahsis yok),
+ * sonra panik yayını gibi alan sorguları tek çağrıda yapılır.
+ *
+ * Hücre koordinatları sabit sayıda kovaya hash'lenir; aynı kovaya düşen uzak
+ * hücreler sorguda mesafe kontrolü ile elenir.
+ */
+class YOURGAMENAME_API FTrafficSpatialHash
+{
+public:
+	/**
+	 * Izgarayı yapılandırır.
+	 *
+	 * @param InCellSize Hücre boyu (birim)
+	 * @param InNumBuckets Kova sayısı (2'nin kuvveti)
+	 */
+	void Initialize(float InCellSize, int32 InNumBuckets);
+
+	/** Önceki adımın öğelerini temizler (bellek korunur). */
+	void Reset();
+
+	/** Bir öğe ekler. Build() çağrılana kadar sorgulanamaz. */
+	void Add(int32 ItemId, const FVector& Location);
+
+	/** Eklenen öğeleri kovalara dağıtır. */
+	void Build();
+
+	/** Yapıdaki öğe sayısı. */
+	int32 Num() const { return Items.Num(); }
+
+	/**
+	 * Merkeze Radius mesafesindeki (2D) her öğe için Func(ItemId, Location) çağırır.
+	 */
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& Center, float Radius, FuncType&& Func) const
+	{
+		if (BucketStarts.Num() == 0 || Items.Num() == 0)
+		{
+			return;
+		}
+
+		const float RadiusSquared = Radius * Radius;
+		const int32 MinX = FMath::FloorToInt((Center.X - Radius) * InvCellSize);
+		const int32 MaxX = FMath::FloorToInt((Center.X + Radius) * InvCellSize);
+		const int32 MinY = FMath::FloorToInt((Center.Y - Radius) * InvCellSize);
+		const int32 MaxY = FMath::FloorToInt((Center.Y + Radius) * InvCellSize);
+
+		for (int32 CellY = MinY; CellY <= MaxY; ++CellY)
+		{
+			for (int32 CellX = MinX; CellX <= MaxX; ++CellX)
+			{
+				const int32 Bucket = HashCell(CellX, CellY);
+				const int32 End = BucketStarts[Bucket + 1];
+				for (int32 Index = BucketStarts[Bucket]; Index < End; ++Index)
+				{
+					const FItem& Item = Items[Index];
+
+					// Farklı hücreden aynı kovaya düşenler ve yarıçap dışı olanlar elenir
+					if (Item.CellX == CellX && Item.CellY == CellY && FVector::DistSquared2D(Item.Location, Center) <= RadiusSquared)
+					{
+						Func(Item.ItemId, Item.Location);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	struct FItem
+	{
+		FVector Location;
+		int32 ItemId;
+		int32 CellX;
+		int32 CellY;
+	};
+
+	FORCEINLINE int32 HashCell(int32 CellX, int32 CellY) const
+	{
+		return (int32)(((uint32)CellX * 73856093u) ^ ((uint32)CellY * 19349663u)) & BucketMask;
+	}
+
+	/** Eklenme sırasındaki öğeler. */
+	TArray<FItem> PendingItems;
+
+	/** Kovaya göre sıralı öğeler. */
+	TArray<FItem> Items;
+
+	/** Her kovanın Items içindeki başlangıcı (NumBuckets + 1 eleman). */
+	TArray<int32> BucketStarts;
+
+	float InvCellSize = 1.0f / 2000.0f;
+	int32 BucketMask = 0;
+};
@@ -0,0 +1,2231 @@
+#include "TrafficSubsystem.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "VehicleAIController.h"
+#include "Vehicle.h"
+#include "TrafficLight.h"
+#include "TrafficAllocationTracker.h"
+#include "TrafficPedestrianSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Traffic Car Following"), STAT_TrafficCarFollowing, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Far Field Step"), STAT_TrafficFarFieldStep, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Far Field LOD"), STAT_TrafficFarFieldLOD, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Near Field Vehicles"), STAT_TrafficNearFieldVehicles, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Far Field Vehicles"), STAT_TrafficFarFieldVehicles, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Threat Broadcast"), STAT_TrafficThreatBroadcast, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Panic Timers"), STAT_TrafficPendingPanicTimers, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Controller Update"), STAT_TrafficControllerUpdate, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Occupancy Grid"), STAT_TrafficOccupancyGrid, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Overtake Planning"), STAT_TrafficOvertakePlanning, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overtake Plans"), STAT_TrafficOvertakePlans, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Forward Traces"), STAT_TrafficForwardTraces, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Forward Traces Saved"), STAT_TrafficForwardTracesSaved, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Pipeline Wait"), STAT_TrafficPipelineWait, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Events"), STAT_TrafficEvents, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traffic Events Applied"), STAT_TrafficEventsApplied, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traffic Events Dropped"), STAT_TrafficEventsDropped, STATGROUP_Traffic);
+DECLARE_CYCLE_STAT(TEXT("Traffic Maneuvers"), STAT_TrafficManeuvers, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Maneuvers"), STAT_TrafficActiveManeuvers, STATGROUP_Traffic);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Maneuver Resumes"), STAT_TrafficManeuverResumes, STATGROUP_Traffic);
+
+namespace
+{
+	/** Queue girdisinin durma çizgisi (sanal lider) olduğunu belirtir. */
+	constexpr int32 StopLineQueueSource = MIN_int32;
+
+	/** Queue girdisinin yol kapanması (geçilemeyen sanal lider) olduğunu belirtir. */
+	constexpr int32 ClosureQueueSource = MIN_int32 + 1;
+
+	/** Queue girdisinin komşu bölge hayaleti (salt okunur lider) olduğunu belirtir. */
+	constexpr int32 GhostQueueSource = MIN_int32 + 2;
+
+	/** Spatial hash kova sayısı. */
+	constexpr int32 SpatialHashBuckets = 4096;
+
+	/** Panik çarkı yuva sayısı (0.1 saniye adımla ~51 saniyelik tur). */
+	constexpr int32 PanicWheelSlots = 512;
+
+	/** Manevra zaman aşımı çarkı yuva sayısı (panik çarkının adımıyla ~25 saniyelik tur). */
+	constexpr int32 ManeuverWheelSlots = 256;
+
+	/** Sollama profili bu kat süre içinde bitmezse (yan şerit kapalı kaldı) manevradan vazgeçilir. */
+	constexpr float OvertakeStallRatio = 3.0f;
+
+	/** Bu yanal mesafeden (LaneWidth oranı) yakın araçlar sollama puanlamasında aynı şeritte sayılır. */
+	constexpr float OvertakeLateralClearance = 0.8f;
+
+	/** Doluluk tahmininde araç yarı genişliği (LaneWidth oranı). */
+	constexpr float OccupantWidthRatio = 0.4f;
+
+	/** Yan şerit doluluğu bu süre (saniye) içindeki katmanlarda aranır. */
+	constexpr float SideCheckHorizon = 1.0f;
+
+	/**
+	 * Çakışan çiftte yol verme kuralı (şimdiki konumlarla): öndeki araca yol verilir;
+	 * ikisi de birbirinin önündeyse (kavşakta kesişen yollar) küçük TrafficId geçer.
+	 */
+	bool ShouldYield(const FTrafficOccupant& Self, const FTrafficOccupant& Other, uint32 SelfId, uint32 OtherId)
+	{
+		const FVector2D ToOther(Other.Location.X - Self.Location.X, Other.Location.Y - Self.Location.Y);
+		if (FVector2D::DotProduct(Self.Forward, ToOther) <= 0.0f)
+		{
+			return false;
+		}
+
+		const bool bSelfAhead = FVector2D::DotProduct(Other.Forward, -ToOther) > 0.0f;
+		return !bSelfAhead || SelfId > OtherId;
+	}
+}
+
+UTrafficSubsystem::UTrafficSubsystem()
+{
+	LaneWidth = 300.0f; // Şerit genişliği (birim)
+	DemoteRadius = 20000.0f; // 200 metre
+	PromoteRadius = 15000.0f; // 150 metre
+	FarFieldStepInterval = 0.25f; // Saniyede 4 adım
+	MaxPromotionsPerStep = 8;
+	SignalAssociationRadius = 800.0f;
+	SampleSpacing = 1000.0f; // 10 metre
+	SignalIndexBucketSize = 1000.0f; // 10 metre
+	MinArrivalSpeed = 100.0f; // 1 m/s
+	SpatialHashCellSize = 2000.0f; // 20 metre
+	DefaultPanicDuration = 10.0f;
+	PanicWheelTickInterval = 0.1f;
+	bBatchControllerUpdates = true;
+	bGenericControllerUpdate = false;
+	OccupancyHorizon = 3.0f;
+	OccupancyLayerInterval = 0.5f;
+	OccupancyCellSize = 1000.0f; // 10 metre
+	bOvertakePlanning = true;
+	OvertakeHorizon = 5.0f;
+	OvertakeRetryInterval = 1.0f;
+	ForwardTraceMaxInterval = 0.5f;
+	ForwardTraceAssumedClosingSpeed = 1500.0f;
+	bPipelinedSimulation = true;
+	EventQueueCapacity = 1024;
+	LaneChangeGapTimeout = 5.0f;
+	LaneChangeSignalTime = 1.0f;
+	LaneChangeTimeout = 8.0f;
+	NextTrafficId = 1;
+	TrafficIdStride = 1;
+	StepIndex = 0;
+	FarFieldTimeAccumulator = 0.0f;
+	NumForwardTraces = 0;
+	NumForwardTracesSaved = 0;
+	LastForwardTraces = 0;
+	LastForwardTracesSaved = 0;
+	LastEventCount = 0;
+	ReportedDroppedEvents = 0;
+	bSpatialHashValid = false;
+	bOccupancyGridValid = false;
+	StateRevision = 1;
+}
+
+void UTrafficSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Config değerleri burada yüklenmiş olur
+	SpatialHash.Initialize(SpatialHashCellSize, SpatialHashBuckets);
+	PanicWheel.Initialize(PanicWheelSlots, PanicWheelTickInterval);
+	Maneuvers.Initialize(ManeuverWheelSlots, PanicWheelTickInterval);
+	OccupancyGrid.Initialize(OccupancyCellSize, SpatialHashBuckets, OccupancyLayerInterval, OccupancyHorizon);
+
+	// Kalabalık bu subsystem'in adımında ilerler; yaya alt sistemi önce kurulur
+	PedestrianSubsystem = Collection.InitializeDependency<UTrafficPedestrianSubsystem>();
+
+	EventQueue.Initialize(EventQueueCapacity);
+
+	FTrafficArchetypeTable::AddReader(this);
+}
+
+void UTrafficSubsystem::PostInitialize()
+{
+	Super::PostInitialize();
+
+	// Controller grup güncellemesi aktör tick'leri ile aynı grupta, araçlardan önce çalışır
+	UWorld* World = GetWorld();
+	if (bBatchControllerUpdates && World && World->PersistentLevel)
+	{
+		ControllerTickFunction.Subsystem = this;
+		ControllerTickFunction.TickGroup = TG_PrePhysics;
+		ControllerTickFunction.bCanEverTick = true;
+		ControllerTickFunction.bStartWithTickEnabled = true;
+		ControllerTickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+}
+
+void UTrafficSubsystem::Deinitialize()
+{
+	// Devam eden adım şerit ve yaya dizilerini kullanıyor
+	if (PipelinedStep.IsValid())
+	{
+		PipelinedStep.Wait();
+		PipelinedStep = TFuture<void>();
+	}
+
+	// Son dünya ise archetype tablosu sıfırlanır
+	FTrafficArchetypeTable::RemoveReader(this);
+
+	// Kuyrukta kalan olaylar uygulanmaz (ışık ve araç referansları zayıf, sahiplenilen bellek yok)
+	EventQueue.Drain([](FTrafficEvent&&) {});
+
+	if (ControllerTickFunction.IsTickFunctionRegistered())
+	{
+		ControllerTickFunction.UnRegisterTickFunction();
+	}
+
+	// Askıdaki manevralar controller'lara işaret ediyor - controller listesi temizlenmeden
+	Maneuvers.Reset();
+
+	// Controller'lardaki şerit referanslarını temizle
+	for (FTrafficLane& Lane : Lanes)
+	{
+		for (AVehicleAIController* Controller : Lane.Vehicles)
+		{
+			if (Controller)
+			{
+				Controller->LaneId = INDEX_NONE;
+			}
+		}
+	}
+
+	for (AVehicleAIController* Controller : Controllers)
+	{
+		if (Controller)
+		{
+			Controller->RegistryIndex = INDEX_NONE;
+			Controller->BehaviorBucketIndex = INDEX_NONE;
+		}
+	}
+
+	for (TArray<AVehicleAIController*>& Bucket : BehaviorBuckets)
+	{
+		Bucket.Empty();
+	}
+
+	Lanes.Empty();
+	LaneLookup.Empty();
+	TrafficLights.Empty();
+	FarFieldClasses.Empty();
+	Controllers.Empty();
+	ControllerGroups.Empty();
+	OvertakeRequesters.Empty();
+	OvertakeRequests.Empty();
+	OvertakePlans.Empty();
+	SpatialHash.Reset();
+	PanicWheel.Reset();
+	OccupancyGrid.Reset();
+	FrameArena.Flush();
+
+	Super::Deinitialize();
+}
+
+TStatId UTrafficSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrafficSubsystem, STATGROUP_Tickables);
+}
+
+bool UTrafficSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Sadece oyun dünyalarında çalış (editör önizlemesinde trafik simülasyonu yok)
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrafficSubsystem::Tick(float DeltaTime)
+{
+	// Controller'lar bu karenin geçici sonuçlarıyla işini bitirdi (subsystem aktörlerden sonra tick'lenir)
+	FrameArena.Flush();
+
+	if (DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	// Kararlı durumda trafik adımı heap tahsisi yapmaz (headless -CheckAllocations ile doğrulanır)
+	TRAFFIC_TRACK_ALLOCATIONS();
+
+	// Önceki adım normalde controller toplu güncellemesinin başında tamamlanır; güncelleme
+	// çalışmadıysa (ör. controller yok) burada beklenir
+	FinishPipelinedStep();
+	const bool bPipelined = IsPipelinedSimulation();
+
+	// Oyun mantığının önceki adımdan beri gönderdiği olaylar (adım worker'da değilken, tek noktada)
+	DrainEvents();
+
+	// Sadece olay gelen manevralar devam eder; boşluk bekleyenler her kare doluluk tahminiyle yoklanır
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TrafficManeuvers);
+		Maneuvers.Update(DeltaTime, [this](const AVehicleAIController* Controller, bool bRight)
+		{
+			return !IsSideLaneOccupied(Controller, bRight);
+		});
+		SET_DWORD_STAT(STAT_TrafficActiveManeuvers, Maneuvers.Num());
+		SET_DWORD_STAT(STAT_TrafficManeuverResumes, Maneuvers.GetLastResumeCount());
+	}
+
+	// Araçlar bu karede hareket etti - spatial hash, doluluk tahmini, yaya frenlemesi ve yardımcı görüntüler bir sonraki sorguda yeniden kurulur
+	bSpatialHashValid = false;
+	bOccupancyGridValid = false;
+	++StateRevision;
+
+	// Süresi dolan panikleri kapat (yenilenmiş panikler nesil farkı ile atlanır)
+	PanicWheel.Advance(DeltaTime, [](const FPanicExpiry& Expiry)
+	{
+		AVehicleAIController* Controller = Expiry.Controller.Get();
+		if (Controller && Controller->PanicGeneration == Expiry.Generation)
+		{
+			Controller->DisablePanicMode();
+		}
+	});
+
+	if (!bPipelined)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TrafficCarFollowing);
+		GatherLaneStates();
+		StepLanes(DeltaTime);
+		ScatterLaneStates();
+	}
+
+	// Sollama adayları bu adımın kuyruklarına göre puanlanır (boru hattında: önceki adımın yayınlanmış durumuna göre)
+	PlanOvertakes();
+
+	if (!bPipelined)
+	{
+		PedestrianSubsystem->StepCrowd(DeltaTime);
+	}
+
+	// Uzak alan her karede değil, FarFieldStepInterval aralıklarla güncellenir
+	float FarFieldDeltaTime = 0.0f;
+	FarFieldTimeAccumulator += DeltaTime;
+	if (FarFieldTimeAccumulator >= FarFieldStepInterval)
+	{
+		FarFieldDeltaTime = FarFieldTimeAccumulator;
+		FarFieldTimeAccumulator = 0.0f;
+
+		// Işık durumları oyun thread'inde okunur - paralel adım UObject'lere dokunmaz
+		CacheStopLineStates();
+
+		if (!bPipelined)
+		{
+			StepFarField(FarFieldDeltaTime);
+		}
+
+		// Spawn / yok etme kararlı durum değildir (boru hattında adım başlamadan, önceki adımın sonucu ile)
+		TRAFFIC_IGNORE_ALLOCATIONS();
+		UpdateFarFieldLOD();
+	}
+
+	SET_DWORD_STAT(STAT_TrafficNearFieldVehicles, GetNearFieldVehicleCount());
+	SET_DWORD_STAT(STAT_TrafficFarFieldVehicles, GetFarFieldVehicleCount());
+	SET_DWORD_STAT(STAT_TrafficPendingPanicTimers, PanicWheel.Num());
+
+	// Controller'lar bu karenin ön yol kararlarını subsystem'den önce verdi
+	LastForwardTraces = NumForwardTraces;
+	LastForwardTracesSaved = NumForwardTracesSaved;
+	NumForwardTraces = 0;
+	NumForwardTracesSaved = 0;
+	SET_DWORD_STAT(STAT_TrafficForwardTraces, LastForwardTraces);
+	SET_DWORD_STAT(STAT_TrafficForwardTracesSaved, LastForwardTracesSaved);
+
+	OnStepReady.Broadcast(this);
+
+	// Kernel, yayalar ve uzak alan worker görevinde bir sonraki controller güncellemesine kadar
+	// render ve oyun mantığı ile örtüşür; girdiler (hedef hızlar, ışık durumları, görüş noktaları) yukarıda alındı
+	if (bPipelined)
+	{
+		GatherLaneStates();
+		LaunchPipelinedStep(DeltaTime, FarFieldDeltaTime);
+	}
+
+	++StepIndex;
+}
+
+bool UTrafficSubsystem::IsPipelinedSimulation() const
+{
+	// Adım sonuçlarını tüketen nokta controller toplu güncellemesidir; o yoksa adım seri çalışır
+	return bPipelinedSimulation && ControllerTickFunction.IsTickFunctionRegistered();
+}
+
+void UTrafficSubsystem::SetPipelinedSimulation(bool bPipelined)
+{
+	FinishPipelinedStep();
+	bPipelinedSimulation = bPipelined;
+}
+
+void UTrafficSubsystem::LaunchPipelinedStep(float DeltaTime, float FarFieldDeltaTime)
+{
+	check(IsInGameThread() && !PipelinedStep.IsValid());
+
+	// Görev verisi motora ait, izlenmez; adım gövdesi izlenir
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	PipelinedStep = Async(EAsyncExecution::TaskGraph, [this, DeltaTime, FarFieldDeltaTime]()
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		{
+			SCOPE_CYCLE_COUNTER(STAT_TrafficCarFollowing);
+			StepLanes(DeltaTime);
+		}
+
+		PedestrianSubsystem->StepCrowd(DeltaTime);
+
+		if (FarFieldDeltaTime > 0.0f)
+		{
+			StepFarField(FarFieldDeltaTime);
+		}
+	});
+}
+
+void UTrafficSubsystem::FinishPipelinedStep()
+{
+	if (!PipelinedStep.IsValid())
+	{
+		return;
+	}
+
+	check(IsInGameThread());
+
+	{
+		// Oyun thread'inin adımı beklediği süre (örtüşme yetmediyse sıfırdan büyük)
+		SCOPE_CYCLE_COUNTER(STAT_TrafficPipelineWait);
+		PipelinedStep.Wait();
+	}
+	PipelinedStep = TFuture<void>();
+
+	// Adımın sonuçlarını yayınla: hızlar controller'lara, yaya konumları sorgulara
+	ScatterLaneStates();
+	bSpatialHashValid = false;
+	++StateRevision;
+
+	// Adım çalışırken gelen oyun girdileri artık doğrudan uygulanabilir
+	PedestrianSubsystem->ApplyPendingCrosswalkPhases();
+}
+
+void UTrafficSubsystem::DrainEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficEvents);
+	check(IsInGameThread() && !PipelinedStep.IsValid());
+
+	// Olaylar aktör yok eder ve ışık olaylarını tetikler - kararlı durum değildir
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	LastEventCount = EventQueue.Drain([this](FTrafficEvent&& Event)
+	{
+		ApplyEvent(Event);
+	});
+	SET_DWORD_STAT(STAT_TrafficEventsApplied, LastEventCount);
+
+	const int64 NumDropped = EventQueue.GetNumDropped();
+	SET_DWORD_STAT(STAT_TrafficEventsDropped, (uint32)NumDropped);
+	if (NumDropped > ReportedDroppedEvents)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik olay kuyruğu doldu: %lld olay düşürüldü (kapasite %d, EventQueueCapacity artırılmalı)"),
+			NumDropped - ReportedDroppedEvents, EventQueue.GetCapacity());
+		ReportedDroppedEvents = NumDropped;
+	}
+}
+
+void UTrafficSubsystem::ApplyEvent(const FTrafficEvent& Event)
+{
+	switch (Event.Type)
+	{
+	case ETrafficEventType::Threat:
+		BroadcastThreat(Event.Location, Event.Radius, Event.Duration);
+		break;
+
+	case ETrafficEventType::LightOverride:
+		// Işık olay kuyruktayken yok edilmiş olabilir
+		if (ATrafficLight* Light = Event.Light.Get())
+		{
+			Light->SetLightState(Event.LightState);
+		}
+		break;
+
+	case ETrafficEventType::RoadClosure:
+		if (Lanes.IsValidIndex(Event.LaneId))
+		{
+			FTrafficLane& Lane = Lanes[Event.LaneId];
+			Lane.ClosureDistance = FMath::Clamp(Event.Distance, 0.0f, Lane.Length);
+		}
+		break;
+
+	case ETrafficEventType::RoadReopen:
+		if (Lanes.IsValidIndex(Event.LaneId))
+		{
+			Lanes[Event.LaneId].ClosureDistance = FLT_MAX;
+		}
+		break;
+
+	case ETrafficEventType::Despawn:
+		if (!DespawnVehicle(Event.TrafficId))
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("Kaldırılacak araç bulunamadı: %u"), Event.TrafficId);
+		}
+		break;
+	}
+}
+
+bool UTrafficSubsystem::DespawnVehicle(uint32 TrafficId)
+{
+	if (TrafficId == 0)
+	{
+		return false;
+	}
+
+	// Yakın alan: aktörleri yok et (EndPlay Controllers'tan çıkarır - aramadan sonra)
+	AVehicleAIController* const* Found = Controllers.FindByPredicate([TrafficId](const AVehicleAIController* Controller)
+	{
+		return Controller && Controller->TrafficId == TrafficId;
+	});
+	if (Found)
+	{
+		DestroyNearFieldVehicle(*Found);
+		return true;
+	}
+
+	// Uzak alan: kompakt kaydı sil (sıra korunur)
+	for (FTrafficLane& Lane : Lanes)
+	{
+		const int32 Index = Lane.FarFieldIds.Find(TrafficId);
+		if (Index != INDEX_NONE)
+		{
+			Lane.FarField.RemoveAt(Index);
+			Lane.FarFieldIds.RemoveAt(Index);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UTrafficSubsystem::DestroyNearFieldVehicle(AVehicleAIController* Controller)
+{
+	AVehicle* Vehicle = Cast<AVehicle>(Controller->GetPawn());
+	UnregisterVehicle(Controller);
+	Controller->UnPossess();
+	if (Vehicle)
+	{
+		Vehicle->Destroy();
+	}
+	Controller->Destroy();
+}
+
+int32 UTrafficSubsystem::FindOrAddLane(USplineComponent* Spline, float LaneOffset)
+{
+	FinishPipelinedStep();
+
+	if (!Spline)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 LaneIndex = FMath::RoundToInt(LaneOffset / LaneWidth);
+	const TPair<const USplineComponent*, int32> Key(Spline, LaneIndex);
+
+	if (const int32* ExistingLaneId = LaneLookup.Find(Key))
+	{
+		return *ExistingLaneId;
+	}
+
+	// FFarFieldVehicle::LaneId 16-bit
+	if (Lanes.Num() >= MAX_uint16)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trafik şerit sayısı sınırına ulaşıldı"));
+		return INDEX_NONE;
+	}
+
+	const int32 NewLaneId = Lanes.AddDefaulted();
+	FTrafficLane& NewLane = Lanes[NewLaneId];
+	NewLane.Spline = Spline;
+	NewLane.LaneIndex = LaneIndex;
+	NewLane.LaneOffset = LaneIndex * LaneWidth;
+	NewLane.Length = Spline->GetSplineLength();
+	NewLane.bClosedLoop = Spline->IsClosedLoop();
+
+	// Örnek noktaları bir kez hesapla - LOD kontrolleri spline sorgusu yapmaz
+	const int32 NumSamples = FMath::CeilToInt(NewLane.Length / SampleSpacing) + 1;
+	NewLane.SamplePoints.Reserve(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float SampleDistance = FMath::Min(SampleIndex * SampleSpacing, NewLane.Length);
+		const FVector Location = Spline->GetLocationAtDistanceAlongSpline(SampleDistance, ESplineCoordinateSpace::World);
+		const FVector Right = Spline->GetRightVectorAtDistanceAlongSpline(SampleDistance, ESplineCoordinateSpace::World);
+		NewLane.SamplePoints.Add(Location + Right * NewLane.LaneOffset);
+	}
+
+	// Önceden kaydolmuş ışıkları bu şeride bağla
+	for (const TWeakObjectPtr<ATrafficLight>& TrafficLight : TrafficLights)
+	{
+		if (ATrafficLight* Light = TrafficLight.Get())
+		{
+			AssociateLightWithLane(Light, NewLane);
+		}
+	}
+
+	LaneLookup.Add(Key, NewLaneId);
+	return NewLaneId;
+}
+
+const FTrafficLane* UTrafficSubsystem::GetLane(int32 LaneId) const
+{
+	return Lanes.IsValidIndex(LaneId) ? &Lanes[LaneId] : nullptr;
+}
+
+bool UTrafficSubsystem::GetLaneTransform(int32 LaneId, float Distance, FVector& OutLocation, FRotator& OutRotation) const
+{
+	if (!Lanes.IsValidIndex(LaneId))
+	{
+		return false;
+	}
+
+	const FTrafficLane& Lane = Lanes[LaneId];
+	const int32 NumSamples = Lane.SamplePoints.Num();
+	if (NumSamples < 2)
+	{
+		return false;
+	}
+
+	if (Lane.bClosedLoop && Lane.Length > 0.0f)
+	{
+		Distance = FMath::Fmod(Distance, Lane.Length);
+		if (Distance < 0.0f)
+		{
+			Distance += Lane.Length;
+		}
+	}
+
+	const float SamplePosition = Distance / SampleSpacing;
+	const int32 SampleIndex = FMath::Clamp(FMath::FloorToInt(SamplePosition), 0, NumSamples - 2);
+	const FVector& SegmentStart = Lane.SamplePoints[SampleIndex];
+	const FVector& SegmentEnd = Lane.SamplePoints[SampleIndex + 1];
+
+	OutLocation = FMath::Lerp(SegmentStart, SegmentEnd, FMath::Clamp(SamplePosition - SampleIndex, 0.0f, 1.0f));
+	OutRotation = (SegmentEnd - SegmentStart).Rotation();
+	return true;
+}
+
+void UTrafficSubsystem::RegisterVehicle(AVehicleAIController* Controller, int32 LaneId)
+{
+	FinishPipelinedStep();
+
+	if (!Controller || !Lanes.IsValidIndex(LaneId))
+	{
+		return;
+	}
+
+	if (Controller->LaneId == LaneId)
+	{
+		return;
+	}
+
+	// Önceki şeritten çıkar (şerit değiştirme)
+	UnregisterVehicle(Controller);
+
+	FTrafficLane& Lane = Lanes[LaneId];
+	Lane.Vehicles.Add(Controller);
+	Lane.Followers.AddDefaulted();
+	Controller->LaneId = LaneId;
+}
+
+void UTrafficSubsystem::UnregisterVehicle(AVehicleAIController* Controller)
+{
+	FinishPipelinedStep();
+
+	if (!Controller || !Lanes.IsValidIndex(Controller->LaneId))
+	{
+		return;
+	}
+
+	FTrafficLane& Lane = Lanes[Controller->LaneId];
+	const int32 Slot = Lane.Vehicles.Find(Controller);
+	if (Slot != INDEX_NONE)
+	{
+		// Sıra korunmalı (kuyruk önden arkaya sıralı)
+		Lane.Vehicles.RemoveAt(Slot);
+		Lane.Followers.RemoveAt(Slot);
+	}
+
+	Controller->LaneId = INDEX_NONE;
+}
+
+void UTrafficSubsystem::RegisterTrafficLight(ATrafficLight* TrafficLight)
+{
+	FinishPipelinedStep();
+
+	if (!TrafficLight)
+	{
+		return;
+	}
+
+	TrafficLights.AddUnique(TrafficLight);
+
+	for (FTrafficLane& Lane : Lanes)
+	{
+		AssociateLightWithLane(TrafficLight, Lane);
+	}
+}
+
+void UTrafficSubsystem::UnregisterTrafficLight(ATrafficLight* TrafficLight)
+{
+	FinishPipelinedStep();
+
+	TrafficLights.Remove(TrafficLight);
+
+	for (FTrafficLane& Lane : Lanes)
+	{
+		const int32 NumRemoved = Lane.StopLines.RemoveAll([TrafficLight](const FLaneStopLine& StopLine)
+		{
+			return !StopLine.Light.IsValid() || StopLine.Light.Get() == TrafficLight;
+		});
+
+		if (NumRemoved > 0)
+		{
+			RebuildStopLineIndex(Lane);
+		}
+	}
+}
+
+void UTrafficSubsystem::AssociateLightWithLane(ATrafficLight* TrafficLight, FTrafficLane& Lane) const
+{
+	USplineComponent* Spline = Lane.Spline.Get();
+	if (!Spline)
+	{
+		return;
+	}
+
+	// Işığın spline üzerine izdüşümü = durma çizgisi
+	const FVector LightLocation = TrafficLight->GetActorLocation();
+	const float InputKey = Spline->FindInputKeyClosestToWorldLocation(LightLocation);
+	const float StopDistance = Spline->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+
+	const FVector LanePoint = Spline->GetLocationAtDistanceAlongSpline(StopDistance, ESplineCoordinateSpace::World)
+		+ Spline->GetRightVectorAtDistanceAlongSpline(StopDistance, ESplineCoordinateSpace::World) * Lane.LaneOffset;
+
+	// Şeride yeterince yakın değilse bu şeridin ışığı değil
+	if (FVector::DistSquared(LanePoint, LightLocation) > FMath::Square(SignalAssociationRadius))
+	{
+		return;
+	}
+
+	FLaneStopLine StopLine;
+	StopLine.Distance = StopDistance;
+	StopLine.Light = TrafficLight;
+	StopLine.CachedState = TrafficLight->GetCurrentState();
+
+	// Mesafeye göre artan sırada ekle
+	int32 InsertIndex = 0;
+	while (InsertIndex < Lane.StopLines.Num() && Lane.StopLines[InsertIndex].Distance < StopDistance)
+	{
+		++InsertIndex;
+	}
+	Lane.StopLines.Insert(StopLine, InsertIndex);
+
+	RebuildStopLineIndex(Lane);
+}
+
+void UTrafficSubsystem::RebuildStopLineIndex(FTrafficLane& Lane) const
+{
+	const int32 NumBuckets = FMath::FloorToInt(Lane.Length / SignalIndexBucketSize) + 1;
+	Lane.StopLineBuckets.SetNumUninitialized(NumBuckets);
+
+	// Kovalar ve çizgiler artan sırada - tek geçişte doldurulur
+	int32 StopIndex = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		const float BucketStart = Bucket * SignalIndexBucketSize;
+		while (StopIndex < Lane.StopLines.Num() && Lane.StopLines[StopIndex].Distance < BucketStart)
+		{
+			++StopIndex;
+		}
+		Lane.StopLineBuckets[Bucket] = StopIndex;
+	}
+}
+
+bool UTrafficSubsystem::FindNextSignal(int32 LaneId, float Distance, float Speed, FTrafficSignalLookahead& OutLookahead) const
+{
+	if (!Lanes.IsValidIndex(LaneId))
+	{
+		return false;
+	}
+
+	const FTrafficLane& Lane = Lanes[LaneId];
+	const int32 NumStopLines = Lane.StopLines.Num();
+	if (NumStopLines == 0 || Lane.StopLineBuckets.Num() == 0)
+	{
+		return false;
+	}
+
+	// Kovadan başla; aynı kova içinde geride kalan çizgileri atla (kova başına en fazla birkaç çizgi)
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt(Distance / SignalIndexBucketSize), 0, Lane.StopLineBuckets.Num() - 1);
+	int32 StopIndex = Lane.StopLineBuckets[Bucket];
+	while (StopIndex < NumStopLines && Lane.StopLines[StopIndex].Distance < Distance)
+	{
+		++StopIndex;
+	}
+
+	float DistanceToStopLine;
+	if (StopIndex < NumStopLines)
+	{
+		DistanceToStopLine = Lane.StopLines[StopIndex].Distance - Distance;
+	}
+	else if (Lane.bClosedLoop)
+	{
+		// Kapalı döngü: şeridin başındaki ilk çizgi
+		StopIndex = 0;
+		DistanceToStopLine = Lane.Length - Distance + Lane.StopLines[0].Distance;
+	}
+	else
+	{
+		return false;
+	}
+
+	ATrafficLight* Light = Lane.StopLines[StopIndex].Light.Get();
+	const UWorld* World = GetWorld();
+	if (!Light || !World)
+	{
+		return false;
+	}
+
+	OutLookahead.Light = Light;
+	OutLookahead.Distance = DistanceToStopLine;
+	OutLookahead.ArrivalTime = World->GetTimeSeconds() + DistanceToStopLine / FMath::Max(Speed, MinArrivalSpeed);
+	OutLookahead.CurrentState = Light->GetCurrentState();
+	OutLookahead.StateAtArrival = Light->GetStateAtTime(OutLookahead.ArrivalTime);
+	return true;
+}
+
+bool UTrafficSubsystem::AddFarFieldVehicle(int32 LaneId, float Distance, float Speed, TSubclassOf<AVehicle> VehicleClass)
+{
+	FinishPipelinedStep();
+
+	if (!Lanes.IsValidIndex(LaneId))
+	{
+		return false;
+	}
+
+	const int32 ClassIndex = FindOrAddFarFieldClass(VehicleClass);
+	if (ClassIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FTrafficLane& Lane = Lanes[LaneId];
+
+	FFarFieldVehicle FarVehicle;
+	FarVehicle.LaneId = (uint16)LaneId;
+	FarVehicle.QuantizedDistance = FFarFieldVehicle::QuantizeDistance(Distance, Lane.Length);
+	FarVehicle.QuantizedSpeed = FFarFieldVehicle::QuantizeSpeed(Speed);
+	FarVehicle.ClassIndex = (uint8)ClassIndex;
+
+	InsertFarFieldVehicle(Lane, FarVehicle, AllocateTrafficId());
+	return true;
+}
+
+int32 UTrafficSubsystem::GetFarFieldVehicleCount()
+{
+	FinishPipelinedStep();
+
+	int32 Count = 0;
+	for (const FTrafficLane& Lane : Lanes)
+	{
+		Count += Lane.FarField.Num();
+	}
+	return Count;
+}
+
+int32 UTrafficSubsystem::GetNearFieldVehicleCount()
+{
+	FinishPipelinedStep();
+
+	int32 Count = 0;
+	for (const FTrafficLane& Lane : Lanes)
+	{
+		Count += Lane.Vehicles.Num();
+	}
+	return Count;
+}
+
+uint32 UTrafficSubsystem::AllocateTrafficId()
+{
+	const uint32 TrafficId = NextTrafficId;
+	NextTrafficId += TrafficIdStride;
+	return TrafficId;
+}
+
+void UTrafficSubsystem::RegisterController(AVehicleAIController* Controller)
+{
+	if (!Controller || Controller->RegistryIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Controller->RegistryIndex = Controllers.Add(Controller);
+	AddToBehaviorBucket(Controller);
+	bSpatialHashValid = false;
+	bOccupancyGridValid = false;
+	++StateRevision;
+
+	if (Controller->TrafficId == 0)
+	{
+		Controller->AssignTrafficId(AllocateTrafficId());
+	}
+
+	// Controller bundan sonra varyant grubunda güncellenir - kendi actor tick'i kapatılır
+	if (ControllerTickFunction.IsTickFunctionRegistered())
+	{
+		Controller->SetActorTickEnabled(false);
+		AddControllerUpdatePrerequisite(Controller->GetPawn());
+	}
+}
+
+void UTrafficSubsystem::UnregisterController(AVehicleAIController* Controller)
+{
+	// Manevra çerçevesi controller'a işaret ediyor
+	Maneuvers.Cancel(Controller);
+
+	if (Controller && Controller->bOvertakePlanPending)
+	{
+		OvertakeRequesters.RemoveSingleSwap(Controller, false);
+		Controller->bOvertakePlanPending = false;
+	}
+
+	if (!Controller || !Controllers.IsValidIndex(Controller->RegistryIndex) || Controllers[Controller->RegistryIndex] != Controller)
+	{
+		return;
+	}
+
+	// Swap-remove: son controller'ın indeksini güncelle
+	const int32 Index = Controller->RegistryIndex;
+	Controllers.RemoveAtSwap(Index, 1, false);
+	if (Controllers.IsValidIndex(Index))
+	{
+		Controllers[Index]->RegistryIndex = Index;
+	}
+
+	Controller->RegistryIndex = INDEX_NONE;
+	RemoveFromBehaviorBucket(Controller);
+	bSpatialHashValid = false;
+	bOccupancyGridValid = false;
+	++StateRevision;
+}
+
+void UTrafficSubsystem::AddToBehaviorBucket(AVehicleAIController* Controller)
+{
+	Controller->BehaviorBucketIndex = BehaviorBuckets[(int32)Controller->CurrentVehicleBehavior].Add(Controller);
+}
+
+void UTrafficSubsystem::RemoveFromBehaviorBucket(AVehicleAIController* Controller)
+{
+	TArray<AVehicleAIController*>& Bucket = BehaviorBuckets[(int32)Controller->CurrentVehicleBehavior];
+	const int32 Index = Controller->BehaviorBucketIndex;
+	if (!Bucket.IsValidIndex(Index) || Bucket[Index] != Controller)
+	{
+		return;
+	}
+
+	// Swap-remove: son controller'ın indeksini güncelle
+	Bucket.RemoveAtSwap(Index, 1, false);
+	if (Bucket.IsValidIndex(Index))
+	{
+		Bucket[Index]->BehaviorBucketIndex = Index;
+	}
+
+	Controller->BehaviorBucketIndex = INDEX_NONE;
+}
+
+void UTrafficSubsystem::MoveToBehaviorBucket(AVehicleAIController* Controller, EVehicleBehavior NewBehavior)
+{
+	RemoveFromBehaviorBucket(Controller);
+	Controller->CurrentVehicleBehavior = NewBehavior;
+	AddToBehaviorBucket(Controller);
+}
+
+template<typename FuncType>
+void UTrafficSubsystem::ForEachInBehaviorUpdate(EVehicleBehaviorUpdate Update, FuncType&& Func)
+{
+	for (int32 State = 0; State < TrafficBehavior::NumStates; ++State)
+	{
+		if (TrafficBehavior::HasUpdate((EVehicleBehavior)State, Update))
+		{
+			// Func durumu değiştirmemeli (kova taşınırsa döngü atlar)
+			for (AVehicleAIController* Controller : BehaviorBuckets[State])
+			{
+				Func(Controller);
+			}
+		}
+	}
+}
+
+bool UTrafficSubsystem::RequestOvertakePlan(AVehicleAIController* Controller)
+{
+	if (!bOvertakePlanning || !Controller)
+	{
+		return false;
+	}
+
+	OvertakeRequesters.Add(Controller);
+	return true;
+}
+
+int32 UTrafficSubsystem::FindLaneId(const USplineComponent* Spline, int32 LaneIndex) const
+{
+	const int32* LaneId = LaneLookup.Find(TPair<const USplineComponent*, int32>(Spline, LaneIndex));
+	return LaneId ? *LaneId : INDEX_NONE;
+}
+
+void UTrafficSubsystem::PlanOvertakes()
+{
+	if (OvertakeRequesters.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TrafficOvertakePlanning);
+
+	// İstekleri bu adımın şerit durumundan kur
+	OvertakeRequests.Reset();
+	for (AVehicleAIController* Controller : OvertakeRequesters)
+	{
+		Controller->bOvertakePlanPending = false;
+		if (!Lanes.IsValidIndex(Controller->LaneId))
+		{
+			continue;
+		}
+
+		const FTrafficLane& Lane = Lanes[Controller->LaneId];
+		const USplineComponent* Spline = Lane.Spline.Get();
+		const FCarFollowingParams Params = Controller->GetCarFollowingParams();
+		const FTrafficArchetypeParams& Archetype = Controller->GetArchetype();
+
+		FTrafficOvertakeRequest& Request = OvertakeRequests.AddDefaulted_GetRef();
+		Request.Controller = Controller;
+		Request.LaneId = Controller->LaneId;
+		Request.bReturn = Controller->bHasOvertakeReturn;
+		Request.LeaderId = Request.bReturn ? Controller->OvertakeLeaderId : 0;
+
+		if (Request.bReturn)
+		{
+			Request.TargetLaneIds[0] = FindLaneId(Spline, FMath::RoundToInt(Controller->OvertakeReturnOffset / LaneWidth));
+		}
+		else
+		{
+			// Sol ve sağ komşu - sadece var olan şeritler (yolda olmayan şeride sollama yok)
+			Request.TargetLaneIds[0] = FindLaneId(Spline, Lane.LaneIndex - 1);
+			Request.TargetLaneIds[1] = FindLaneId(Spline, Lane.LaneIndex + 1);
+		}
+
+		for (int32 Target = 0; Target < FTrafficOvertakePlanner::NumTargets; ++Target)
+		{
+			if (Request.TargetLaneIds[Target] == Request.LaneId)
+			{
+				Request.TargetLaneIds[Target] = INDEX_NONE;
+			}
+			if (Request.TargetLaneIds[Target] != INDEX_NONE)
+			{
+				Request.TargetOffsets[Target] = Lanes[Request.TargetLaneIds[Target]].LaneOffset;
+			}
+		}
+
+		Request.Distance = Controller->DistanceAlongLane;
+		Request.Speed = Controller->CurrentSpeed;
+		Request.LaneOffset = Controller->CurrentLaneOffset;
+		Request.MaxSpeed = Controller->GetMaxSpeed();
+		Request.MaxAcceleration = Params.MaxAcceleration;
+		Request.VehicleLength = Params.VehicleLength;
+		Request.MinimumGap = Params.MinimumGap;
+		Request.TimeHeadway = Params.TimeHeadway;
+		Request.BaseLaneChangeDuration = LaneWidth / FMath::Max(Controller->GetLaneChangeSpeed(), 1.0f);
+		Request.OvertakeSpeedRatio = Archetype.OvertakeSpeedRatio;
+		Request.OvertakeLookahead = Archetype.OvertakeLookahead;
+	}
+	OvertakeRequesters.Reset();
+
+	// Planlama: istekler birbirinden bağımsız, şeritler sadece okunur
+	OvertakePlans.SetNum(OvertakeRequests.Num(), false);
+	{
+		// ParallelFor'un görev verisi motora ait, izlenmez; planlama gövdeleri izlenir
+		TRAFFIC_IGNORE_ALLOCATIONS();
+
+		const float LateralClearance = LaneWidth * OvertakeLateralClearance;
+		ParallelFor(OvertakeRequests.Num(), [this, LateralClearance](int32 Index)
+		{
+			TRAFFIC_TRACK_ALLOCATIONS();
+
+			const FTrafficOvertakeRequest& Request = OvertakeRequests[Index];
+			FTrafficOvertakePlan& Plan = OvertakePlans[Index];
+			Plan = FTrafficOvertakePlan();
+
+			FTrafficOvertakeObstacles Obstacles;
+			GatherOvertakeObstacles(Request, Obstacles);
+
+			// Sollama sadece yakın ve yavaş bir lider için (kendi şeridinde öndeki en yakın araç)
+			if (!Request.bReturn)
+			{
+				if (!Obstacles.HasLeader()
+					|| Obstacles.LeaderDistance - Request.Distance > Request.OvertakeLookahead
+					|| Obstacles.LeaderSpeed >= Request.MaxSpeed * Request.OvertakeSpeedRatio)
+				{
+					return;
+				}
+			}
+			// Dönüş sadece sollanan lider arkada kaldıysa (arka tamponumuz ile önü arasında asgari boşluk)
+			else if (Request.LeaderId != 0)
+			{
+				for (int32 Obstacle = 0; Obstacle < Obstacles.Num; ++Obstacle)
+				{
+					if (Obstacles.Id[Obstacle] == Request.LeaderId
+						&& Request.Distance - Obstacles.Distance[Obstacle] < 0.5f * (Request.VehicleLength + Obstacles.VehicleLength[Obstacle]) + Request.MinimumGap)
+					{
+						return;
+					}
+				}
+			}
+
+			Plan = FTrafficOvertakePlanner::Plan(Request, Obstacles, OvertakeHorizon, LateralClearance);
+			Plan.LeaderId = Obstacles.LeaderId;
+		});
+	}
+
+	// Seçilen manevraları başlat (oyun thread'i, profil bu karede kurulur)
+	const int32 NumRequests = OvertakeRequests.Num();
+	for (int32 Index = 0; Index < NumRequests; ++Index)
+	{
+		if (OvertakePlans[Index].Candidate != INDEX_NONE)
+		{
+			AVehicleAIController* Controller = OvertakeRequests[Index].Controller;
+			if (!OvertakeRequests[Index].bReturn)
+			{
+				Controller->OvertakeLeaderId = OvertakePlans[Index].LeaderId;
+			}
+			Maneuvers.Start(Controller, RunOvertake(Controller, OvertakePlans[Index].Maneuver, OvertakeRequests[Index].bReturn));
+		}
+	}
+
+	SET_DWORD_STAT(STAT_TrafficOvertakePlans, NumRequests);
+}
+
+bool UTrafficSubsystem::StartLaneChange(AVehicleAIController* Controller, float TargetOffset)
+{
+	if (!Controller || Controller->RegistryIndex == INDEX_NONE || FMath::IsNearlyEqual(Controller->TargetLaneOffset, TargetOffset))
+	{
+		return false;
+	}
+
+	// Sollama profili ile aynı anda çalışamaz
+	Controller->OvertakeManeuver = FTrafficOvertakeManeuver();
+	Controller->bHasOvertakeReturn = false;
+
+	Maneuvers.Start(Controller, RunLaneChange(Controller, TargetOffset, LaneChangeGapTimeout, LaneChangeSignalTime, LaneChangeTimeout));
+	return true;
+}
+
+FTrafficManeuverTask UTrafficSubsystem::RunLaneChange(AVehicleAIController* Controller, float TargetOffset, float GapTimeout, float SignalTime, float MoveTimeout)
+{
+	const float StartOffset = Controller->TargetLaneOffset;
+	const bool bRight = TargetOffset > StartOffset; // Pozitif offset = sağa
+
+	// 1) Yan şeritte boşluk (doluluk tahmininden, bekleyenler karede bir toplu test edilir)
+	if (co_await TrafficManeuver::WaitForGap(bRight, GapTimeout) == ETrafficManeuverWake::TimedOut)
+	{
+		co_return;
+	}
+
+	// 2) Sinyal ver; sinyal süresinde boşluk kapandıysa tekrar bekle
+	Controller->TurnSignal = bRight ? 1 : -1;
+	co_await TrafficManeuver::Delay(SignalTime);
+	if (co_await TrafficManeuver::WaitForGap(bRight, GapTimeout) == ETrafficManeuverWake::TimedOut)
+	{
+		Controller->TurnSignal = 0;
+		co_return;
+	}
+
+	// 3) Kay: offset UpdateDriving'de ilerler (yan sensör engel görürse bekler), şerit kaydı hedefi izler
+	Controller->TargetLaneOffset = TargetOffset;
+	const ETrafficManeuverWake Wake = co_await TrafficManeuver::WaitForOffset(MoveTimeout);
+	Controller->TurnSignal = 0;
+
+	// 4) Doğrula: zamanında ulaşamadıysa başladığı şeride dön
+	if (Wake == ETrafficManeuverWake::TimedOut)
+	{
+		Controller->TargetLaneOffset = StartOffset;
+	}
+}
+
+FTrafficManeuverTask UTrafficSubsystem::RunOvertake(AVehicleAIController* Controller, FTrafficOvertakeManeuver Maneuver, bool bReturn)
+{
+	Controller->BeginOvertake(Maneuver, bReturn);
+	Controller->TurnSignal = Maneuver.TargetOffset > Maneuver.StartOffset ? 1 : -1;
+
+	// Profil yan sensör engel görürken ilerlemez; süresinin katları boyunca bitmediyse boşluk kapanmış
+	const ETrafficManeuverWake Wake = co_await TrafficManeuver::WaitForOffset(Maneuver.Duration * OvertakeStallRatio);
+	Controller->TurnSignal = 0;
+
+	if (Wake == ETrafficManeuverWake::TimedOut && Controller->OvertakeManeuver.IsActive())
+	{
+		// Vazgeç: başladığı şeride sabit hızla dön, dönüş planlanmaz
+		Controller->OvertakeManeuver = FTrafficOvertakeManeuver();
+		Controller->bHasOvertakeReturn = false;
+		Controller->TargetLaneOffset = Maneuver.StartOffset;
+	}
+}
+
+void UTrafficSubsystem::GatherOvertakeObstacles(const FTrafficOvertakeRequest& Request, FTrafficOvertakeObstacles& OutObstacles) const
+{
+	// Ufuk boyunca etkileşebilecek araçlar: önde lider mesafesi veya ufuk yolu, arkada hızlı araçların ufuk yolu
+	const float Reach = Request.MaxSpeed * OvertakeHorizon;
+	const float WindowFront = Request.Distance + FMath::Max(Request.OvertakeLookahead, Reach);
+	const float WindowBack = Request.Distance - Reach;
+
+	// Kapasite dolarsa isteyene en yakın araçlar tutulur
+	OutObstacles.Reference = Request.Distance;
+
+	// Kendi şeridinde sadece öndekiler (arkadaki takipçi şerit değişince etkileşmez)
+	GatherLaneObstacles(Lanes[Request.LaneId], Request.Controller, WindowFront, Request.Distance, OutObstacles);
+
+	// Lider: kendi şeridinde öndeki en yakın araç (hedef şeritler eklenmeden, kayıtların hepsi öndedir)
+	for (int32 Obstacle = 0; Obstacle < OutObstacles.Num; ++Obstacle)
+	{
+		if (OutObstacles.Distance[Obstacle] < OutObstacles.LeaderDistance)
+		{
+			OutObstacles.LeaderDistance = OutObstacles.Distance[Obstacle];
+			OutObstacles.LeaderSpeed = OutObstacles.Speed[Obstacle];
+			OutObstacles.LeaderId = OutObstacles.Id[Obstacle];
+		}
+	}
+
+	for (int32 Target = 0; Target < FTrafficOvertakePlanner::NumTargets; ++Target)
+	{
+		if (Request.TargetLaneIds[Target] != INDEX_NONE)
+		{
+			GatherLaneObstacles(Lanes[Request.TargetLaneIds[Target]], nullptr, WindowFront, WindowBack, OutObstacles);
+		}
+	}
+}
+
+void UTrafficSubsystem::GatherLaneObstacles(const FTrafficLane& Lane, const AVehicleAIController* Exclude, float WindowFront, float WindowBack, FTrafficOvertakeObstacles& OutObstacles) const
+{
+	// Yakın alan (önden arkaya sıralı): pencerenin önündeki ilk araçtan başla
+	// (tampon dolunca Add en uzak kaydı değiştirir, pencere sonuna kadar taranır)
+	const int32 NumNear = Lane.Followers.Num();
+	int32 Index = Algo::LowerBoundBy(Lane.Followers, WindowFront, [](const FLaneFollower& Follower) { return Follower.Distance; }, TGreater<>());
+	for (; Index < NumNear; ++Index)
+	{
+		const FLaneFollower& Follower = Lane.Followers[Index];
+		if (Follower.Distance < WindowBack)
+		{
+			break;
+		}
+
+		// Şerit değiştiren araç gerçek yanal konumuyla
+		const AVehicleAIController* Vehicle = Lane.Vehicles[Index];
+		if (Vehicle != Exclude)
+		{
+			OutObstacles.Add(Vehicle->TrafficId, Follower.Distance, Follower.Speed, Vehicle->CurrentLaneOffset, Follower.Params.VehicleLength);
+		}
+	}
+
+	// Uzak alan (aynı sırada)
+	const int32 NumFar = Lane.FarField.Num();
+	const float LaneLength = Lane.Length;
+	Index = Algo::LowerBoundBy(Lane.FarField, WindowFront, [LaneLength](const FFarFieldVehicle& FarVehicle) { return FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, LaneLength); }, TGreater<>());
+	for (; Index < NumFar; ++Index)
+	{
+		const FFarFieldVehicle& FarVehicle = Lane.FarField[Index];
+		const float Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, LaneLength);
+		if (Distance < WindowBack)
+		{
+			break;
+		}
+
+		// Sınıf tablosunda olmayan kayıt varsayılan archetype'ın boyuyla
+		const int32 ArchetypeIndex = FarFieldClasses.IsValidIndex(FarVehicle.ClassIndex) ? FarFieldClasses[FarVehicle.ClassIndex].ArchetypeIndex : FTrafficArchetypeTable::DefaultIndex;
+		const FTrafficArchetypeParams& Archetype = FTrafficArchetypeTable::Get(ArchetypeIndex);
+		OutObstacles.Add(Lane.FarFieldIds[Index], Distance, FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed), Lane.LaneOffset, Archetype.CarFollowing.VehicleLength);
+	}
+}
+
+void UTrafficSubsystem::AddControllerUpdatePrerequisite(APawn* Pawn)
+{
+	if (Pawn && ControllerTickFunction.IsTickFunctionRegistered())
+	{
+		Pawn->PrimaryActorTick.AddPrerequisite(this, ControllerTickFunction);
+	}
+}
+
+void UTrafficSubsystem::UpdateControllers(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficControllerUpdate);
+
+	// Kararlı durumda araç güncellemesi heap tahsisi yapmaz (headless -CheckAllocations ile doğrulanır)
+	TRAFFIC_TRACK_ALLOCATIONS();
+
+	// Önceki trafik adımı (boru hattı) burada tamamlanır: controller'lar yayınlanan hızları okur
+	FinishPipelinedStep();
+
+	// Yan sensör sadece şerit değiştiren araçlarda (offset ilerlemesinden önce)
+	ForEachInBehaviorUpdate(EVehicleBehaviorUpdate::SideCheck, [](AVehicleAIController* Controller)
+	{
+		Controller->UpdateLaneChangeSideCheck();
+	});
+
+	constexpr int32 NumVariants = TrafficUpdatePolicy::NumVariants;
+
+	// Varyanta göre counting sort (genel yolda tek grup)
+	int32 GroupStarts[NumVariants + 1] = {};
+	for (const AVehicleAIController* Controller : Controllers)
+	{
+		const int32 Variant = bGenericControllerUpdate ? 0 : Controller->GetCapabilities() & (NumVariants - 1);
+		++GroupStarts[Variant + 1];
+	}
+
+	for (int32 Variant = 0; Variant < NumVariants; ++Variant)
+	{
+		GroupStarts[Variant + 1] += GroupStarts[Variant];
+	}
+
+	int32 WriteIndices[NumVariants];
+	FMemory::Memcpy(WriteIndices, GroupStarts, sizeof(WriteIndices));
+
+	// Güncelleme sırasında kayıt değişebilir - gruplar ayrı dizide
+	ControllerGroups.SetNumUninitialized(Controllers.Num(), false);
+	for (AVehicleAIController* Controller : Controllers)
+	{
+		const int32 Variant = bGenericControllerUpdate ? 0 : Controller->GetCapabilities() & (NumVariants - 1);
+		ControllerGroups[WriteIndices[Variant]++] = Controller;
+	}
+
+	// Her grup kendi derlenmiş döngüsünde
+	for (int32 Variant = 0; Variant < NumVariants; ++Variant)
+	{
+		const int32 Start = GroupStarts[Variant];
+		const int32 Count = GroupStarts[Variant + 1] - Start;
+		if (Count > 0)
+		{
+			const AVehicleAIController::FUpdateGroupFunction UpdateGroup = AVehicleAIController::GetUpdateGroupFunction((uint8)Variant, bGenericControllerUpdate);
+			UpdateGroup(MakeArrayView(ControllerGroups.GetData() + Start, Count), DeltaTime, this);
+		}
+	}
+
+	// Direksiyon sadece hareket eden araçlarda (geçişler bu karenin kararlarıyla yapıldı)
+	ForEachInBehaviorUpdate(EVehicleBehaviorUpdate::Steering, [](AVehicleAIController* Controller)
+	{
+		Controller->UpdateSteering();
+	});
+}
+
+void FTrafficControllerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		Subsystem->UpdateControllers(DeltaTime);
+	}
+}
+
+FString FTrafficControllerTickFunction::DiagnosticMessage()
+{
+	return TEXT("FTrafficControllerTickFunction");
+}
+
+void UTrafficSubsystem::BuildSpatialHash()
+{
+	// Yaya konumları adım görevinde yazılıyor olabilir
+	FinishPipelinedStep();
+
+	if (bSpatialHashValid)
+	{
+		return;
+	}
+
+	SpatialHash.Reset();
+	for (int32 Index = 0; Index < Controllers.Num(); ++Index)
+	{
+		if (const APawn* Pawn = Controllers[Index]->GetPawn())
+		{
+			SpatialHash.Add(Index, Pawn->GetActorLocation());
+		}
+	}
+	PedestrianSubsystem->AddToSpatialHash(SpatialHash);
+	SpatialHash.Build();
+
+	bSpatialHashValid = true;
+}
+
+const FTrafficOccupancyGrid& UTrafficSubsystem::GetOccupancyGrid()
+{
+	BuildOccupancyGrid();
+	return OccupancyGrid;
+}
+
+void UTrafficSubsystem::BuildOccupancyGrid()
+{
+	if (bOccupancyGridValid)
+	{
+		return;
+	}
+
+	check(IsInGameThread());
+	SCOPE_CYCLE_COUNTER(STAT_TrafficOccupancyGrid);
+
+	const float HalfWidth = LaneWidth * OccupantWidthRatio;
+	OccupancyGrid.Build(Controllers.Num(), [this, HalfWidth](int32 Index, TArrayView<FTrafficOccupant> OutLayers)
+	{
+		const AVehicleAIController* Controller = Controllers[Index];
+		const APawn* Pawn = Controller->GetPawn();
+		if (!Pawn)
+		{
+			return false;
+		}
+
+		const FVector Location = Pawn->GetActorLocation();
+		const FVector Forward = Pawn->GetActorForwardVector();
+		const float Speed = Controller->CurrentSpeed;
+		const float HalfLength = Controller->GetArchetype().CarFollowing.VehicleLength * 0.5f;
+		const FTrafficLane* Lane = Lanes.IsValidIndex(Controller->LaneId) ? &Lanes[Controller->LaneId] : nullptr;
+
+		for (int32 Layer = 0; Layer < OutLayers.Num(); ++Layer)
+		{
+			const float Time = OccupancyGrid.GetLayerTime(Layer);
+
+			FTrafficOccupant& Occupant = OutLayers[Layer];
+			Occupant.HalfLength = HalfLength;
+			Occupant.HalfWidth = HalfWidth;
+			Occupant.Group = Controller->LaneId;
+
+			// Şeride bağlı araç şerit boyunca ilerler (virajı izler), yanal konumu CurrentLaneOffset;
+			// şeritsiz araç şimdiki yönünde düz ilerler
+			FVector LaneLocation;
+			FRotator LaneRotation;
+			if (Layer > 0 && Lane && GetLaneTransform(Controller->LaneId, Controller->DistanceAlongLane + Speed * Time, LaneLocation, LaneRotation))
+			{
+				const FVector2D LaneForward = FVector2D(LaneRotation.Vector()).GetSafeNormal();
+				const FVector LaneRight(-LaneForward.Y, LaneForward.X, 0.0f);
+				Occupant.Location = LaneLocation + LaneRight * (Controller->CurrentLaneOffset - Lane->LaneOffset);
+				Occupant.Forward = LaneForward;
+			}
+			else
+			{
+				Occupant.Location = Location + Forward * (Speed * Time);
+				Occupant.Forward = FVector2D(Forward).GetSafeNormal();
+			}
+		}
+		return true;
+	});
+
+	// Trafiğe ait olmayan pawn'lar: oyuncular ve kayıtlı dış pawn'lar (tahmin yok, hareket payı ile)
+	ExternalOccupants.Reset();
+	auto AddExternalOccupant = [this](const APawn* Pawn)
+	{
+		if (!Pawn || Cast<AVehicleAIController>(Pawn->GetController()))
+		{
+			return;
+		}
+
+		FVector Origin;
+		FVector Extent;
+		Pawn->GetActorBounds(true, Origin, Extent);
+		const float Travel = Pawn->GetVelocity().Size2D() * FMath::Max(ForwardTraceMaxInterval, 0.0f);
+
+		FTrafficOccupant& Occupant = ExternalOccupants.AddDefaulted_GetRef();
+		Occupant.Location = Origin;
+		Occupant.HalfLength = Extent.X + Travel;
+		Occupant.HalfWidth = Extent.Y + Travel;
+	};
+
+	if (UWorld* World = GetWorld())
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			AddExternalOccupant(It->IsValid() ? (*It)->GetPawn() : nullptr);
+		}
+	}
+	for (const TWeakObjectPtr<APawn>& Pawn : ExternalPawns)
+	{
+		AddExternalOccupant(Pawn.Get());
+	}
+
+	bOccupancyGridValid = true;
+}
+
+bool UTrafficSubsystem::FindPredictedConflict(const AVehicleAIController* Controller, float& OutTime)
+{
+	if (!Controller || !Controllers.IsValidIndex(Controller->RegistryIndex))
+	{
+		return false;
+	}
+
+	BuildOccupancyGrid();
+
+	const int32 Self = Controller->RegistryIndex;
+	const FTrafficOccupant* SelfNow = OccupancyGrid.GetOccupant(0, Self);
+	if (!SelfNow)
+	{
+		return false;
+	}
+
+	const int32 NumLayers = OccupancyGrid.GetNumLayers();
+	for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+	{
+		const FTrafficOccupant* SelfBox = OccupancyGrid.GetOccupant(Layer, Self);
+		bool bYield = false;
+
+		OccupancyGrid.ForEachOverlap(Layer, *SelfBox, [this, Controller, SelfNow, SelfBox, &bYield](const FTrafficOccupant& Other)
+		{
+			// Aynı şeritteki araçlar kuyruk kerneli ile takip edilir
+			if (bYield || (Other.Group != INDEX_NONE && Other.Group == SelfBox->Group))
+			{
+				return;
+			}
+
+			const FTrafficOccupant* OtherNow = OccupancyGrid.GetOccupant(0, Other.ItemId);
+			bYield = ShouldYield(*SelfNow, *OtherNow, Controller->TrafficId, Controllers[Other.ItemId]->TrafficId);
+		});
+
+		if (bYield)
+		{
+			OutTime = OccupancyGrid.GetLayerTime(Layer);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UTrafficSubsystem::IsSideLaneOccupied(const AVehicleAIController* Controller, bool bRight)
+{
+	if (!Controller || !Controllers.IsValidIndex(Controller->RegistryIndex))
+	{
+		return false;
+	}
+
+	BuildOccupancyGrid();
+
+	const int32 Self = Controller->RegistryIndex;
+	const int32 LastLayer = OccupancyGrid.GetLayerForTime(SideCheckHorizon);
+	for (int32 Layer = 0; Layer <= LastLayer; ++Layer)
+	{
+		const FTrafficOccupant* SelfBox = OccupancyGrid.GetOccupant(Layer, Self);
+		if (!SelfBox)
+		{
+			return false;
+		}
+
+		// Aracın yanından yan şeridin ortasına kadar uzanan kutu (eski yan ışının kapladığı alan)
+		FTrafficOccupant SideBox = *SelfBox;
+		const FVector2D Right(-SelfBox->Forward.Y, SelfBox->Forward.X);
+		const float SideShift = (bRight ? 0.5f : -0.5f) * LaneWidth;
+		SideBox.Location += FVector(Right * SideShift, 0.0f);
+		SideBox.HalfWidth = LaneWidth * 0.5f;
+
+		bool bOccupied = false;
+		OccupancyGrid.ForEachOverlap(Layer, SideBox, [&bOccupied](const FTrafficOccupant&)
+		{
+			bOccupied = true;
+		});
+
+		if (bOccupied)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 UTrafficSubsystem::CountOccupantsAhead(const AVehicleAIController* Controller, float Length)
+{
+	if (!Controller || !Controllers.IsValidIndex(Controller->RegistryIndex) || Length <= 0.0f)
+	{
+		return 0;
+	}
+
+	BuildOccupancyGrid();
+
+	const FTrafficOccupant* SelfBox = OccupancyGrid.GetOccupant(0, Controller->RegistryIndex);
+	if (!SelfBox)
+	{
+		return 0;
+	}
+
+	// Ön tampondan başlayan, aracın genişliğinde kutu (kendisi ForEachOverlap'te dışlanır)
+	FTrafficOccupant Window = *SelfBox;
+	const float HalfWindow = Length * 0.5f;
+	Window.Location += FVector(SelfBox->Forward * (SelfBox->HalfLength + HalfWindow), 0.0f);
+	Window.HalfLength = HalfWindow;
+
+	int32 NumOccupants = 0;
+	OccupancyGrid.ForEachOverlap(0, Window, [&NumOccupants](const FTrafficOccupant&)
+	{
+		++NumOccupants;
+	});
+	return NumOccupants;
+}
+
+bool UTrafficSubsystem::IsExternalPawnAhead(const AVehicleAIController* Controller, float Length)
+{
+	if (!Controller || !Controllers.IsValidIndex(Controller->RegistryIndex) || Length <= 0.0f)
+	{
+		return false;
+	}
+
+	BuildOccupancyGrid();
+	if (ExternalOccupants.Num() == 0)
+	{
+		return false;
+	}
+
+	const FTrafficOccupant* SelfBox = OccupancyGrid.GetOccupant(0, Controller->RegistryIndex);
+	if (!SelfBox)
+	{
+		return false;
+	}
+
+	FTrafficOccupant Window = *SelfBox;
+	const float HalfWindow = Length * 0.5f;
+	Window.Location += FVector(SelfBox->Forward * (SelfBox->HalfLength + HalfWindow), 0.0f);
+	Window.HalfLength = HalfWindow;
+
+	for (const FTrafficOccupant& Occupant : ExternalOccupants)
+	{
+		if (FTrafficOccupant::Overlaps(Window, Occupant))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UTrafficSubsystem::RegisterExternalPawn(APawn* Pawn)
+{
+	if (Pawn)
+	{
+		ExternalPawns.AddUnique(Pawn);
+		bOccupancyGridValid = false;
+	}
+}
+
+void UTrafficSubsystem::UnregisterExternalPawn(APawn* Pawn)
+{
+	ExternalPawns.Remove(Pawn);
+	bOccupancyGridValid = false;
+}
+
+int32 UTrafficSubsystem::BroadcastThreat(FVector ThreatLocation, float Radius, float Duration)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficThreatBroadcast);
+
+	if (Radius <= 0.0f)
+	{
+		return 0;
+	}
+
+	// Spatial hash yaya konumlarını okur: worker'daki adım önce tamamlanır
+	FinishPipelinedStep();
+	BuildSpatialHash();
+
+	const float PanicDuration = Duration > 0.0f ? Duration : DefaultPanicDuration;
+	int32 NumAffected = 0;
+
+	SpatialHash.ForEachInRadius(ThreatLocation, Radius, [this, &ThreatLocation, PanicDuration, &NumAffected](int32 Index, const FVector& VehicleLocation)
+	{
+		if (FTrafficPedestrianCrowd::IsPedestrianItem(Index))
+		{
+			return;
+		}
+
+		AVehicleAIController* Controller = Controllers[Index];
+
+		// Panik yeteneği olmayan archetype (ör. otobüs) etkilenmez
+		if (!(Controller->GetCapabilities() & (uint8)ETrafficCapability::Panic))
+		{
+			return;
+		}
+
+		// Kaçış vektörü: tehditten araca doğru yön (yatay düzlemde)
+		Controller->PanicEscapeDirection = (VehicleLocation - ThreatLocation).GetSafeNormal2D();
+
+		SchedulePanic(Controller, PanicDuration);
+		++NumAffected;
+	});
+
+	return NumAffected;
+}
+
+void UTrafficSubsystem::StartPanic(AVehicleAIController* Controller, float Duration)
+{
+	if (!Controller || !(Controller->GetCapabilities() & (uint8)ETrafficCapability::Panic))
+	{
+		return;
+	}
+
+	Controller->PanicEscapeDirection = FVector::ZeroVector;
+	SchedulePanic(Controller, Duration > 0.0f ? Duration : DefaultPanicDuration);
+}
+
+void UTrafficSubsystem::SchedulePanic(AVehicleAIController* Controller, float Duration)
+{
+	Controller->bIsPanicking = true;
+	Controller->PanicEndTime = (GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f) + Duration;
+
+	// Önceki bitiş girdisi çarkta kalır ama nesli eskidiği için yok sayılır
+	++Controller->PanicGeneration;
+
+	FPanicExpiry Expiry;
+	Expiry.Controller = Controller;
+	Expiry.Generation = Controller->PanicGeneration;
+	PanicWheel.Schedule(Duration, Expiry);
+}
+
+void UTrafficSubsystem::GatherLaneStates()
+{
+	for (FTrafficLane& Lane : Lanes)
+	{
+		const int32 Count = Lane.Vehicles.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const AVehicleAIController* Controller = Lane.Vehicles[Index];
+			FLaneFollower& Follower = Lane.Followers[Index];
+
+			Follower.Distance = Controller->DistanceAlongLane;
+			Follower.Speed = Controller->CurrentSpeed;
+			Follower.DesiredSpeed = Controller->TargetSpeed;
+			Follower.MaxDeceleration = -Controller->GetMaxBrakingDeceleration(); // Negatif değer -> pozitif
+			Follower.Params = Controller->GetCarFollowingParams();
+		}
+	}
+}
+
+void UTrafficSubsystem::StepLanes(float DeltaTime)
+{
+	const FFarFieldVehicleClass* Classes = FarFieldClasses.GetData();
+
+	// ParallelFor'un görev verisi motora ait, izlenmez; şerit gövdeleri izlenir
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	// Şeritler birbirinden bağımsız - paralel işlenebilir
+	ParallelFor(Lanes.Num(), [this, Classes, DeltaTime](int32 LaneId)
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		FTrafficLane& Lane = Lanes[LaneId];
+		if (Lane.Followers.Num() == 0)
+		{
+			AdvanceGhosts(Lane, DeltaTime);
+			return;
+		}
+
+		SortLaneFrontToBack(Lane);
+
+		// Uzak alan araçları da lider olarak kuyruğa girer (sonuçları bu geçişte yazılmaz)
+		BuildQueue(Lane, Classes, false);
+		FCarFollowingModel::StepQueue(Lane.Queue, DeltaTime);
+
+		const int32 Count = Lane.Queue.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const int32 Source = Lane.QueueSources[Index];
+			if (Source >= 0)
+			{
+				Lane.Followers[Source].Speed = Lane.Queue[Index].Speed;
+				Lane.Followers[Source].Acceleration = Lane.Queue[Index].Acceleration;
+			}
+		}
+
+		// Kuyruk adımın başındaki konumları kullandı; hayaletler şimdi ilerler
+		AdvanceGhosts(Lane, DeltaTime);
+	});
+}
+
+void UTrafficSubsystem::ScatterLaneStates()
+{
+	for (FTrafficLane& Lane : Lanes)
+	{
+		const int32 Count = Lane.Vehicles.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Lane.Vehicles[Index]->CurrentSpeed = Lane.Followers[Index].Speed;
+		}
+	}
+}
+
+void UTrafficSubsystem::CacheStopLineStates()
+{
+	check(IsInGameThread());
+
+	for (FTrafficLane& Lane : Lanes)
+	{
+		for (FLaneStopLine& StopLine : Lane.StopLines)
+		{
+			const ATrafficLight* Light = StopLine.Light.Get();
+			StopLine.CachedState = Light ? Light->GetCurrentState() : ETrafficLightState::Green;
+		}
+	}
+}
+
+void UTrafficSubsystem::StepFarField(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficFarFieldStep);
+
+	// Işık durumları CacheStopLineStates ile önceden okundu - bu adım worker'da da çalışabilir
+	const FFarFieldVehicleClass* Classes = FarFieldClasses.GetData();
+
+	TRAFFIC_IGNORE_ALLOCATIONS();
+
+	ParallelFor(Lanes.Num(), [this, Classes, DeltaTime](int32 LaneId)
+	{
+		TRAFFIC_TRACK_ALLOCATIONS();
+
+		FTrafficLane& Lane = Lanes[LaneId];
+		if (Lane.FarField.Num() == 0)
+		{
+			return;
+		}
+
+		// Kırmızı / sarı durma çizgileri hızı 0 olan sanal lider olarak eklenir
+		BuildQueue(Lane, Classes, true);
+		FCarFollowingModel::StepQueue(Lane.Queue, DeltaTime);
+
+		// Konumları ilerlet (sadece uzak alan araçları; yakın alan araçlarını aktörleri hareket ettirir)
+		TArray<TPair<FFarFieldVehicle, uint32>, TInlineAllocator<4>> Wrapped;
+		int32 WriteIndex = 0;
+		float LeaderDistance = FLT_MAX;
+		float LeaderLength = 0.0f;
+
+		const int32 Count = Lane.Queue.Num();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const int32 Source = Lane.QueueSources[Index];
+			FLaneFollower& Entry = Lane.Queue[Index];
+
+			if (Source == StopLineQueueSource)
+			{
+				// Durma çizgisi geçilebilir (sarıda duramayan araç), lider sayılmaz
+				continue;
+			}
+
+			if (Source < 0 && Source != ClosureQueueSource && Source != GhostQueueSource)
+			{
+				// Sollama yok: liderin arkasında kal (kapanma ve hayalet de lider - ötesine geçilmez)
+				float NewDistance = Entry.Distance + Entry.Speed * DeltaTime;
+				if (LeaderDistance < FLT_MAX)
+				{
+					const float MaxDistance = LeaderDistance - 0.5f * (LeaderLength + Entry.Params.VehicleLength);
+					NewDistance = FMath::Max(Entry.Distance, FMath::Min(NewDistance, MaxDistance));
+				}
+				Entry.Distance = NewDistance;
+
+				FFarFieldVehicle FarVehicle = Lane.FarField[-Source - 1];
+				const uint32 TrafficId = Lane.FarFieldIds[-Source - 1];
+				FarVehicle.QuantizedSpeed = FFarFieldVehicle::QuantizeSpeed(Entry.Speed);
+
+				if (NewDistance >= Lane.Length)
+				{
+					// Şerit sonu: kapalı döngüde başa sar, değilse araç şehirden çıkar
+					if (Lane.bClosedLoop)
+					{
+						FarVehicle.QuantizedDistance = FFarFieldVehicle::QuantizeDistance(NewDistance - Lane.Length, Lane.Length);
+						Wrapped.Emplace(FarVehicle, TrafficId);
+					}
+				}
+				else
+				{
+					FarVehicle.QuantizedDistance = FFarFieldVehicle::QuantizeDistance(NewDistance, Lane.Length);
+
+					// Kuyruk sırası FarField sırasıyla aynı - yerinde sıkıştırarak yaz
+					Lane.FarField[WriteIndex] = FarVehicle;
+					Lane.FarFieldIds[WriteIndex] = TrafficId;
+					++WriteIndex;
+				}
+			}
+
+			LeaderDistance = Entry.Distance;
+			LeaderLength = Entry.Params.VehicleLength;
+		}
+
+		Lane.FarField.SetNum(WriteIndex, false);
+		Lane.FarFieldIds.SetNum(WriteIndex, false);
+
+		for (const TPair<FFarFieldVehicle, uint32>& WrappedVehicle : Wrapped)
+		{
+			InsertFarFieldVehicle(Lane, WrappedVehicle.Key, WrappedVehicle.Value);
+		}
+	});
+}
+
+void UTrafficSubsystem::UpdateFarFieldLOD()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrafficFarFieldLOD);
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Görüş noktalarını topla (her oyuncu kamerası)
+	ViewerLocations.Reset();
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewerLocations.Add(ViewLocation);
+		}
+	}
+
+	// Görüş noktası yoksa (headless) LOD değiştirme
+	if (ViewerLocations.Num() == 0)
+	{
+		return;
+	}
+
+	// Uzak alana indirme
+	const float DemoteRadiusSquared = FMath::Square(DemoteRadius);
+	TArray<AVehicleAIController*, TInlineAllocator<64>> VehiclesToDemote;
+
+	for (const FTrafficLane& Lane : Lanes)
+	{
+		for (AVehicleAIController* Controller : Lane.Vehicles)
+		{
+			const APawn* ControlledPawn = Controller->GetPawn();
+			if (!ControlledPawn)
+			{
+				continue;
+			}
+
+			// Panik veya şerit değiştirme sırasında 1D temsil tutarlı olmaz
+			if (Controller->bIsPanicking || !FMath::IsNearlyEqual(Controller->CurrentLaneOffset, Controller->TargetLaneOffset))
+			{
+				continue;
+			}
+
+			if (GetMinDistSquaredToViewers(ControlledPawn->GetActorLocation()) > DemoteRadiusSquared)
+			{
+				VehiclesToDemote.Add(Controller);
+			}
+		}
+	}
+
+	for (AVehicleAIController* Controller : VehiclesToDemote)
+	{
+		DemoteVehicle(Controller);
+	}
+
+	// Yakın alana geri dönüş (örnek noktalar ile - spline sorgusu yok)
+	const float PromoteRadiusSquared = FMath::Square(PromoteRadius);
+	int32 Promotions = 0;
+
+	for (int32 LaneId = 0; LaneId < Lanes.Num() && Promotions < MaxPromotionsPerStep; ++LaneId)
+	{
+		if (Lanes[LaneId].SamplePoints.Num() == 0)
+		{
+			continue;
+		}
+
+		for (int32 Index = Lanes[LaneId].FarField.Num() - 1; Index >= 0 && Promotions < MaxPromotionsPerStep; --Index)
+		{
+			// Spawn şerit ekleyebilir (Lanes yeniden tahsis edilir): referans her turda yeniden alınır
+			const FTrafficLane& Lane = Lanes[LaneId];
+			const FFarFieldVehicle FarVehicle = Lane.FarField[Index];
+			const uint32 TrafficId = Lane.FarFieldIds[Index];
+			const float Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, Lane.Length);
+			const int32 SampleIndex = FMath::Clamp(FMath::RoundToInt(Distance / SampleSpacing), 0, Lane.SamplePoints.Num() - 1);
+
+			if (GetMinDistSquaredToViewers(Lane.SamplePoints[SampleIndex]) >= PromoteRadiusSquared)
+			{
+				continue;
+			}
+
+			// Başarısız denemeler de bütçeden düşer (sınıfı veya spline'ı eksik araç her adım denenir)
+			++Promotions;
+
+			// Kayıt ancak aktör oluştuktan sonra silinir; başarısız spawn aracı şehirden düşürmez
+			if (PromoteFarFieldVehicle(LaneId, FarVehicle, TrafficId))
+			{
+				FTrafficLane& PromotedLane = Lanes[LaneId];
+				PromotedLane.FarField.RemoveAt(Index);
+				PromotedLane.FarFieldIds.RemoveAt(Index);
+			}
+		}
+	}
+}
+
+float UTrafficSubsystem::GetMinDistSquaredToViewers(const FVector& Location) const
+{
+	float MinDistSquared = FLT_MAX;
+	for (const FVector& ViewerLocation : ViewerLocations)
+	{
+		MinDistSquared = FMath::Min(MinDistSquared, FVector::DistSquared(ViewerLocation, Location));
+	}
+	return MinDistSquared;
+}
+
+int32 UTrafficSubsystem::FindOrAddFarFieldClass(TSubclassOf<AVehicle> VehicleClass)
+{
+	// Worker adımı FarFieldClasses'ı ham işaretçi ile okur; dizi yeniden tahsis edilebilir
+	FinishPipelinedStep();
+
+	if (!VehicleClass)
+	{
+		return INDEX_NONE;
+	}
+
+	for (int32 ClassIndex = 0; ClassIndex < FarFieldClasses.Num(); ++ClassIndex)
+	{
+		if (FarFieldClasses[ClassIndex].VehicleClass == VehicleClass)
+		{
+			return ClassIndex;
+		}
+	}
+
+	// FFarFieldVehicle::ClassIndex 8-bit
+	if (FarFieldClasses.Num() > MAX_uint8)
+	{
+		return INDEX_NONE;
+	}
+
+	// Parametreler sınıfın archetype'ından alınır
+	const AVehicle* VehicleDefaults = VehicleClass->GetDefaultObject<AVehicle>();
+
+	FFarFieldVehicleClass& NewClass = FarFieldClasses.AddDefaulted_GetRef();
+	NewClass.VehicleClass = VehicleClass;
+	NewClass.ControllerClass = VehicleDefaults->AIControllerClass ? VehicleDefaults->AIControllerClass : TSubclassOf<AVehicleAIController>(AVehicleAIController::StaticClass());
+	NewClass.ArchetypeIndex = FTrafficArchetypeTable::Register(VehicleDefaults->GetArchetypeAsset());
+
+	return FarFieldClasses.Num() - 1;
+}
+
+void UTrafficSubsystem::DemoteVehicle(AVehicleAIController* Controller)
+{
+	AVehicle* Vehicle = Cast<AVehicle>(Controller->GetPawn());
+	if (!Vehicle || !Lanes.IsValidIndex(Controller->LaneId))
+	{
+		return;
+	}
+
+	const int32 ClassIndex = FindOrAddFarFieldClass(Vehicle->GetClass());
+	if (ClassIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 LaneId = Controller->LaneId;
+	FTrafficLane& Lane = Lanes[LaneId];
+
+	FFarFieldVehicle FarVehicle;
+	FarVehicle.LaneId = (uint16)LaneId;
+	FarVehicle.QuantizedDistance = FFarFieldVehicle::QuantizeDistance(Controller->DistanceAlongLane, Lane.Length);
+	FarVehicle.QuantizedSpeed = FFarFieldVehicle::QuantizeSpeed(Controller->CurrentSpeed);
+	FarVehicle.ClassIndex = (uint8)ClassIndex;
+
+	UnregisterVehicle(Controller);
+	InsertFarFieldVehicle(Lane, FarVehicle, Controller->TrafficId);
+
+	// Aktörler artık gerekli değil
+	Controller->UnPossess();
+	Vehicle->Destroy();
+	Controller->Destroy();
+}
+
+bool UTrafficSubsystem::PromoteFarFieldVehicle(int32 LaneId, const FFarFieldVehicle& FarVehicle, uint32 TrafficId)
+{
+	const FTrafficLane& Lane = Lanes[LaneId];
+	const float Distance = FFarFieldVehicle::DequantizeDistance(FarVehicle.QuantizedDistance, Lane.Length);
+	const float Speed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+
+	return SpawnLaneVehicle(LaneId, FarVehicle.ClassIndex, Distance, Speed, TrafficId) != nullptr;
+}
+
+AVehicleAIController* UTrafficSubsystem::SpawnLaneVehicle(int32 LaneId, int32 ClassIndex, float Distance, float Speed, uint32 TrafficId)
+{
+	UWorld* World = GetWorld();
+	const FTrafficLane& Lane = Lanes[LaneId];
+	USplineComponent* Spline = Lane.Spline.Get();
+	if (!World || !Spline || !FarFieldClasses.IsValidIndex(ClassIndex))
+	{
+		return nullptr;
+	}
+
+	const FFarFieldVehicleClass& VehicleClass = FarFieldClasses[ClassIndex];
+
+	// Şerit konumundan transform oluştur
+	const FVector Location = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World)
+		+ Spline->GetRightVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World) * Lane.LaneOffset;
+	const FRotator Rotation = Spline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AVehicle* Vehicle = World->SpawnActor<AVehicle>(VehicleClass.VehicleClass, Location, Rotation, SpawnParams);
+	if (!Vehicle)
+	{
+		return nullptr;
+	}
+
+	AVehicleAIController* Controller = World->SpawnActor<AVehicleAIController>(VehicleClass.ControllerClass, Location, Rotation, SpawnParams);
+	if (!Controller)
+	{
+		Vehicle->Destroy();
+		return nullptr;
+	}
+
+	// Uzak alan durumunu controller'a aktar (kuyruk kaydı ve hız tutarlı kalsın)
+	Controller->AssignTrafficId(TrafficId); // BeginPlay'de atanan yeni kimliğin yerine kalıcı kimlik (sürücü varyansı da kimlikten)
+	Controller->Possess(Vehicle);
+	Controller->PlaceOnLane(Spline, Lane.LaneOffset, Distance, Speed);
+
+	return Controller;
+}
+
+void UTrafficSubsystem::InsertFarFieldVehicle(FTrafficLane& Lane, const FFarFieldVehicle& FarVehicle, uint32 TrafficId)
+{
+	// Önden arkaya (azalan mesafe) sıralı ekle
+	int32 InsertIndex = Algo::LowerBound(Lane.FarField, FarVehicle, [](const FFarFieldVehicle& A, const FFarFieldVehicle& B)
+	{
+		return A.QuantizedDistance > B.QuantizedDistance;
+	});
+	Lane.FarField.Insert(FarVehicle, InsertIndex);
+	Lane.FarFieldIds.Insert(TrafficId, InsertIndex);
+}
+
+void UTrafficSubsystem::SortLaneFrontToBack(FTrafficLane& Lane)
+{
+	// Insertion sort: kareler arası sıra neredeyse sabit olduğu için ~O(n)
+	TArray<AVehicleAIController*>& Vehicles = Lane.Vehicles;
+	TArray<FLaneFollower>& Followers = Lane.Followers;
+
+	const int32 Count = Followers.Num();
+	for (int32 Index = 1; Index < Count; ++Index)
+	{
+		int32 Current = Index;
+		while (Current > 0 && Followers[Current - 1].Distance < Followers[Current].Distance)
+		{
+			Followers.Swap(Current - 1, Current);
+			Vehicles.Swap(Current - 1, Current);
+			--Current;
+		}
+	}
+}
+
+void UTrafficSubsystem::AdvanceGhosts(FTrafficLane& Lane, float DeltaTime)
+{
+	TArray<FLaneFollower>& Ghosts = Lane.Ghosts;
+	const int32 Count = Ghosts.Num();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FLaneFollower& Ghost = Ghosts[Index];
+		Ghost.Distance += Ghost.Speed * DeltaTime;
+		if (Lane.bClosedLoop && Ghost.Distance >= Lane.Length)
+		{
+			Ghost.Distance -= Lane.Length;
+		}
+
+		// Hızlı hayalet yavaşını geçebilir veya döngü başına sarabilir
+		int32 Current = Index;
+		while (Current > 0 && Ghosts[Current - 1].Distance < Ghosts[Current].Distance)
+		{
+			Ghosts.Swap(Current - 1, Current);
+			--Current;
+		}
+	}
+}
+
+void UTrafficSubsystem::BuildQueue(FTrafficLane& Lane, const FFarFieldVehicleClass* Classes, bool bIncludeStopLines)
+{
+	Lane.Queue.Reset();
+	Lane.QueueSources.Reset();
+
+	const int32 NumNear = Lane.Followers.Num();
+	const int32 NumFar = Lane.FarField.Num();
+	const int32 NumGhosts = Lane.Ghosts.Num();
+	int32 NearIndex = 0;
+	int32 FarIndex = 0;
+	int32 GhostIndex = 0;
+	int32 StopIndex = Lane.StopLines.Num() - 1; // Artan sıralı - sondan başla
+	bool bClosurePending = Lane.ClosureDistance < FLT_MAX; // Kapanma her iki geçişte de geçilemez
+
+	// Dört sıralı diziyi ve kapanmayı önden arkaya birleştir
+	while (true)
+	{
+		if (bIncludeStopLines)
+		{
+			// Yeşil ışıklar sanal lider oluşturmaz
+			while (StopIndex >= 0 && Lane.StopLines[StopIndex].CachedState == ETrafficLightState::Green)
+			{
+				--StopIndex;
+			}
+		}
+
+		const bool bHasNear = NearIndex < NumNear;
+		const bool bHasFar = FarIndex < NumFar;
+		const bool bHasGhost = GhostIndex < NumGhosts;
+		const bool bHasStop = bIncludeStopLines && StopIndex >= 0;
+		if (!bHasNear && !bHasFar && !bHasGhost && !bHasStop && !bClosurePending)
+		{
+			break;
+		}
+
+		const float NearDistance = bHasNear ? Lane.Followers[NearIndex].Distance : -FLT_MAX;
+		const float FarDistance = bHasFar ? FFarFieldVehicle::DequantizeDistance(Lane.FarField[FarIndex].QuantizedDistance, Lane.Length) : -FLT_MAX;
+		const float GhostDistance = bHasGhost ? Lane.Ghosts[GhostIndex].Distance : -FLT_MAX;
+		const float StopDistance = bHasStop ? Lane.StopLines[StopIndex].Distance : -FLT_MAX;
+		const float ClosureDistance = bClosurePending ? Lane.ClosureDistance : -FLT_MAX;
+
+		if (bHasNear && NearDistance >= FarDistance && NearDistance >= GhostDistance && NearDistance >= StopDistance && NearDistance >= ClosureDistance)
+		{
+			Lane.Queue.Add(Lane.Followers[NearIndex]);
+			Lane.QueueSources.Add(NearIndex);
+			++NearIndex;
+		}
+		else if (bHasFar && FarDistance >= GhostDistance && FarDistance >= StopDistance && FarDistance >= ClosureDistance)
+		{
+			const FFarFieldVehicle& FarVehicle = Lane.FarField[FarIndex];
+			const FTrafficArchetypeParams& Archetype = FTrafficArchetypeTable::Get(Classes[FarVehicle.ClassIndex].ArchetypeIndex);
+
+			FLaneFollower& Entry = Lane.Queue.AddDefaulted_GetRef();
+			Entry.Distance = FarDistance;
+			Entry.Speed = FFarFieldVehicle::DequantizeSpeed(FarVehicle.QuantizedSpeed);
+			Entry.DesiredSpeed = Archetype.MaxSpeed;
+			Entry.MaxDeceleration = -Archetype.MaxBrakingDeceleration;
+			Entry.Params = Archetype.CarFollowing;
+			Lane.QueueSources.Add(-(FarIndex + 1));
+			++FarIndex;
+		}
+		else if (bHasGhost && GhostDistance >= StopDistance && GhostDistance >= ClosureDistance)
+		{
+			// Komşu bölgenin aracı: takip edilir ama bu süreç ilerletmez (sahibi gönderir)
+			Lane.Queue.Add(Lane.Ghosts[GhostIndex]);
+			Lane.QueueSources.Add(GhostQueueSource);
+			++GhostIndex;
+		}
+		else if (bHasStop && StopDistance >= ClosureDistance)
+		{
+			// Sanal lider: durma çizgisinde duran, uzunluğu olmayan araç
+			FLaneFollower& Entry = Lane.Queue.AddDefaulted_GetRef();
+			Entry.Distance = StopDistance;
+			Entry.Speed = 0.0f;
+			Entry.DesiredSpeed = 0.0f;
+			Entry.Params.VehicleLength = 0.0f;
+			Lane.QueueSources.Add(StopLineQueueSource);
+			--StopIndex;
+		}
+		else
+		{
+			// Yol kapanması: durma çizgisi gibi sanal lider, ama her zaman durdurur
+			FLaneFollower& Entry = Lane.Queue.AddDefaulted_GetRef();
+			Entry.Distance = ClosureDistance;
+			Entry.Speed = 0.0f;
+			Entry.DesiredSpeed = 0.0f;
+			Entry.Params.VehicleLength = 0.0f;
+			Lane.QueueSources.Add(ClosureQueueSource);
+			bClosurePending = false;
+		}
+	}
+}
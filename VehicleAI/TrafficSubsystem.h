@@ -0,0 +1,908 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Misc/MemStack.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CarFollowingModel.h"
+#include "TrafficFarField.h"
+#include "TrafficSpatialHash.h"
+#include "TrafficOccupancyGrid.h"
+#include "TrafficTimingWheel.h"
+#include "VehicleAIController.h" // ETrafficLightState enum'u için
+#include "TrafficBehavior.h"
+#include "TrafficOvertakePlanner.h"
+#include "TrafficEventQueue.h"
+#include "TrafficManeuver.h"
+#include "TrafficSubsystem.generated.h"
+
+class AVehicle;
+class ATrafficLight;
+class USplineComponent;
+class UTrafficPedestrianSubsystem;
+
+DECLARE_STATS_GROUP(TEXT("Traffic"), STATGROUP_Traffic, STATCAT_Advanced);
+
+/** Simülasyon adımı bittiğinde, worker'daki bir sonraki adım başlamadan yayınlanır (kayıt). */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTrafficStepReady, UTrafficSubsystem* /*TrafficSubsystem*/);
+
+/**
+ * Şerit üzerindeki bir durma çizgisi (trafik ışığı).
+ * Işığın spline üzerine izdüşümü ile belirlenir.
+ */
+struct FLaneStopLine
+{
+	/** Durma çizgisinin şerit üzerindeki mesafesi (birim). */
+	float Distance = 0.0f;
+
+	/** Çizgiyi kontrol eden trafik ışığı. */
+	TWeakObjectPtr<ATrafficLight> Light;
+
+	/** Işığın bu adımdaki durumu (oyun thread'inde okunur, paralel adımda kullanılır). */
+	ETrafficLightState CachedState = ETrafficLightState::Green;
+};
+
+/**
+ * Şerit üzerindeki bir sonraki sinyalin sorgu sonucu.
+ * UTrafficSubsystem::FindNextSignal tarafından doldurulur.
+ */
+struct FTrafficSignalLookahead
+{
+	/** Sinyali kontrol eden trafik ışığı. */
+	ATrafficLight* Light = nullptr;
+
+	/** Durma çizgisine kalan mesafe (birim). */
+	float Distance = 0.0f;
+
+	/** Tahmini varış zamanı (dünya zamanı, saniye). */
+	float ArrivalTime = 0.0f;
+
+	/** Işığın şu anki durumu. */
+	ETrafficLightState CurrentState = ETrafficLightState::Green;
+
+	/** Işığın tahmini varış anındaki durumu (ortak saat ile hesaplanır). */
+	ETrafficLightState StateAtArrival = ETrafficLightState::Green;
+};
+
+/**
+ * Paylaşılan çarktaki panik bitiş girdisi.
+ * Generation, girdi eklendikten sonra panik yenilendiyse eski girdiyi geçersiz kılar.
+ */
+struct FPanicExpiry
+{
+	TWeakObjectPtr<AVehicleAIController> Controller;
+	uint32 Generation = 0;
+};
+
+/**
+ * Kayıtlı controller'ların toplu güncelleme tick'i (TG_PrePhysics).
+ * Controller'ların kendi actor tick'leri kapatılır; araçlar (pawn) bu tick'ten sonra çalışır.
+ */
+struct FTrafficControllerTickFunction : public FTickFunction
+{
+	UTrafficSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+ * Trafik şeridi.
+ * Bir spline ve o spline üzerindeki şerit offset'i (CurrentLaneOffset) bir şeridi tanımlar.
+ * Şeritteki araçlar önden arkaya sıralı bitişik dizilerde tutulur.
+ */
+struct FTrafficLane
+{
+	/** Şeridin takip ettiği spline. */
+	TWeakObjectPtr<USplineComponent> Spline;
+
+	/** Şerit sırası (offset / LaneWidth). */
+	int32 LaneIndex = 0;
+
+	/** Spline'a dik şerit offset'i (birim). */
+	float LaneOffset = 0.0f;
+
+	/** Spline uzunluğu (birim). */
+	float Length = 0.0f;
+
+	/** Spline kapalı döngü mü (uzak alan araçları sonda başa sarar). */
+	bool bClosedLoop = false;
+
+	/** Yakın alan araçları (Followers ile aynı sırada, önden arkaya). */
+	TArray<AVehicleAIController*> Vehicles;
+
+	/** Yakın alan araçlarının kompakt durumu. */
+	TArray<FLaneFollower> Followers;
+
+	/** Uzak alan araçları (önden arkaya sıralı). */
+	TArray<FFarFieldVehicle> FarField;
+
+	/** Uzak alan araçlarının kalıcı kimlikleri (FarField ile aynı sırada; kompakt kayıt 8 byte kalsın diye ayrı). */
+	TArray<uint32> FarFieldIds;
+
+	/** Durma çizgileri (mesafeye göre artan sırada). */
+	TArray<FLaneStopLine> StopLines;
+
+	/**
+	 * Mesafe indeksi: her kova için kova başlangıcından sonraki ilk durma çizgisinin indeksi.
+	 * Kova boyu SignalIndexBucketSize; StopLines.Num() = ileride çizgi yok.
+	 */
+	TArray<int32> StopLineBuckets;
+
+	/** Şerit boyunca SampleSpacing aralıklı dünya konumları (mesafe kontrolü için, spline sorgusu yok). */
+	TArray<FVector> SamplePoints;
+
+	/** Birleştirilmiş kuyruk (yakın + uzak + durma çizgileri), her adımda yeniden kurulur. */
+	TArray<FLaneFollower> Queue;
+
+	/** Queue girdilerinin kaynağı: >= 0 yakın alan indeksi, < 0 uzak alan indeksi (-(i + 1)). */
+	TArray<int32> QueueSources;
+
+	/**
+	 * Komşu bölgelerin sınır araçları (önden arkaya, salt okunur lider; FTrafficRegionHandoff::SetGhosts).
+	 * Bir sonraki değişime kadar her adımda kendi hızıyla ilerletilir (AdvanceGhosts).
+	 */
+	TArray<FLaneFollower> Ghosts;
+
+	/** Yol kapanmasının şerit üzerindeki mesafesi (FLT_MAX = açık); araçlar önünde durur. */
+	float ClosureDistance = FLT_MAX;
+};
+
+/**
+ * Trafik alt sistemi.
+ * Şeride bağlı araçların hızlarını her karede tek geçişte hesaplar.
+ * Her şerit kuyruğu önden arkaya IDM kerneli ile taranır, şeritler paralel işlenir.
+ * Şeride bağlı araçlarda SmoothSpeedTransition'daki Lerp yerine bu kernel kullanılır.
+ *
+ * LOD: Görüş noktalarından DemoteRadius'tan uzaklaşan araçlar aktörsüz uzak alan
+ * temsiline (FFarFieldVehicle) indirilir, PromoteRadius içine giren uzak alan
+ * araçları tekrar AVehicle / AVehicleAIController olarak spawn edilir.
+ */
+UCLASS(Config = Game)
+class YOURGAMENAME_API UTrafficSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTrafficSubsystem();
+
+	// UTickableWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void PostInitialize() override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ============================================
+	// ŞERİT YÖNETİMİ
+	// ============================================
+
+	/**
+	 * Spline ve şerit offset'ine karşılık gelen şeridi döndürür, yoksa oluşturur.
+	 *
+	 * @param Spline Şeridin spline'ı
+	 * @param LaneOffset Spline'a dik offset (LaneWidth katlarına yuvarlanır)
+	 * @return Şerit ID'si (INDEX_NONE = geçersiz spline)
+	 */
+	int32 FindOrAddLane(USplineComponent* Spline, float LaneOffset);
+
+	/**
+	 * Şerit bilgisini döndürür.
+	 *
+	 * @return Şerit (nullptr = geçersiz ID)
+	 */
+	const FTrafficLane* GetLane(int32 LaneId) const;
+
+	/**
+	 * Tüm şeritlerin salt okunur görünümü (şerit ID'si = indeks). Worker'daki adım önce beklenir.
+	 * Şerit verisini okuyan yardımcı alt sistemler içindir; görünüm yeni şerit eklenene kadar geçerlidir.
+	 */
+	TArrayView<const FTrafficLane> GetLanes()
+	{
+		FinishPipelinedStep();
+		return Lanes;
+	}
+
+	/** Şerit genişliği (birim). Offset'ler bu değere göre şeritlere ayrılır. */
+	float GetLaneWidth() const { return LaneWidth; }
+
+	/** Şerit örnek noktaları arasındaki mesafe (birim). Kaldırımlar da aynı aralıkla örneklenir. */
+	float GetSampleSpacing() const { return SampleSpacing; }
+
+	/**
+	 * Şerit üzerindeki mesafeye karşılık gelen dünya konumu ve yönü.
+	 * Örnek noktaları arasında doğrusal aradeğerleme yapılır (spline sorgusu yok).
+	 *
+	 * @return Şerit geçersizse veya örnek noktası yoksa false
+	 */
+	bool GetLaneTransform(int32 LaneId, float Distance, FVector& OutLocation, FRotator& OutRotation) const;
+
+	// ============================================
+	// ARAÇ KAYDI
+	// ============================================
+
+	/**
+	 * Aracı bir şeride kaydeder. Araç zaten başka bir şeritteyse oradan çıkarılır.
+	 */
+	void RegisterVehicle(AVehicleAIController* Controller, int32 LaneId);
+
+	/**
+	 * Aracın şerit kaydını siler.
+	 */
+	void UnregisterVehicle(AVehicleAIController* Controller);
+
+	// ============================================
+	// TRAFİK IŞIKLARI
+	// ============================================
+
+	/**
+	 * Trafik ışığını kaydeder ve yakınından geçen şeritlere durma çizgisi olarak ekler.
+	 */
+	void RegisterTrafficLight(ATrafficLight* TrafficLight);
+
+	/**
+	 * Trafik ışığının kaydını ve durma çizgilerini siler.
+	 */
+	void UnregisterTrafficLight(ATrafficLight* TrafficLight);
+
+	/** Kayıtlı trafik ışıkları (kayıt sırasıyla; yok edilenler geçersiz kalır). */
+	TArrayView<const TWeakObjectPtr<ATrafficLight>> GetTrafficLights() const { return TrafficLights; }
+
+	/**
+	 * Şeritte verilen mesafeden sonraki ilk sinyali bulur (O(1), ışın yok).
+	 * Varış zamanı mevcut hıza göre tahmin edilir ve ışığın o andaki durumu
+	 * ortak saat (dünya zamanı) üzerinden hesaplanır.
+	 *
+	 * @param LaneId Şerit ID'si
+	 * @param Distance Aracın şerit üzerindeki mesafesi (birim)
+	 * @param Speed Aracın hızı (cm/s)
+	 * @param OutLookahead Sonuç
+	 * @return Önde sinyal varsa true
+	 */
+	bool FindNextSignal(int32 LaneId, float Distance, float Speed, FTrafficSignalLookahead& OutLookahead) const;
+
+	// ============================================
+	// UZAK ALAN (FAR FIELD)
+	// ============================================
+
+	/**
+	 * Aktör oluşturmadan doğrudan uzak alana araç ekler (şehir geneli trafik yoğunluğu için).
+	 *
+	 * @param LaneId Şerit ID'si
+	 * @param Distance Şerit üzerindeki mesafe (birim)
+	 * @param Speed Başlangıç hızı (cm/s)
+	 * @param VehicleClass Yakın alana dönüşte spawn edilecek sınıf
+	 * @return Eklendiyse true
+	 */
+	bool AddFarFieldVehicle(int32 LaneId, float Distance, float Speed, TSubclassOf<AVehicle> VehicleClass);
+
+	/** Uzak alandaki toplam araç sayısı (worker'daki adım önce beklenir). */
+	int32 GetFarFieldVehicleCount();
+
+	/** Uzak alan araç sınıfları (FFarFieldVehicle::ClassIndex). */
+	TArrayView<const FFarFieldVehicleClass> GetFarFieldClasses() const { return FarFieldClasses; }
+
+	/** Yakın alandaki (aktörlü, şeride bağlı) toplam araç sayısı (worker'daki adım önce beklenir). */
+	int32 GetNearFieldVehicleCount();
+
+	// ============================================
+	// PANİK (TEHDİT YAYINI)
+	// ============================================
+
+	/**
+	 * Controller'ı tehdit sorguları için genel kayda ekler (şeride bağlı olmasa da).
+	 */
+	void RegisterController(AVehicleAIController* Controller);
+
+	/**
+	 * Controller'ı genel kayıttan çıkarır.
+	 */
+	void UnregisterController(AVehicleAIController* Controller);
+
+	/** Kayıtlı controller'lar (indeks = AVehicleAIController::RegistryIndex). */
+	TArrayView<AVehicleAIController* const> GetControllers() const { return Controllers; }
+
+	/** Pawn'ın tick'ini controller grup güncellemesinden sonraya alır (possess sırasında). */
+	void AddControllerUpdatePrerequisite(APawn* Pawn);
+
+	/**
+	 * Kayıtlı controller'ları varyant gruplarına ayırıp günceller (yetenek kümesi başına dalsız döngü).
+	 * FTrafficControllerTickFunction tarafından çağrılır.
+	 */
+	void UpdateControllers(float DeltaTime);
+
+	/**
+	 * true = tüm controller'lar tek grupta, yetenekler çalışma zamanında okunarak güncellenir.
+	 * Varyantlı güncellemenin kazancını ölçmek için (headless -GenericUpdate).
+	 */
+	void SetGenericControllerUpdate(bool bInGeneric) { bGenericControllerUpdate = bInGeneric; }
+
+	/** Davranış durumundaki kayıtlı araç sayısı. */
+	int32 GetBehaviorVehicleCount(EVehicleBehavior Behavior) const { return BehaviorBuckets[(int32)Behavior].Num(); }
+
+	// ============================================
+	// SPATIAL HASH
+	// ============================================
+
+	/**
+	 * Kayıtlı controller'ların ve yayaların konumları (öğe = controller kayıt indeksi, yayalar
+	 * negatif: FTrafficPedestrianCrowd::ToItemId). Durum değiştikten sonraki ilk sorguda kurulur.
+	 * Sadece oyun thread'inden.
+	 */
+	const FTrafficSpatialHash& GetSpatialHash()
+	{
+		BuildSpatialHash();
+		return SpatialHash;
+	}
+
+	/**
+	 * Araç dışı konumlar (yayalar) adım dışında değişti: spatial hash ve durum sayacına bağlı
+	 * yardımcı görüntüler bir sonraki sorguda yeniden kurulur.
+	 */
+	void InvalidateSpatialState()
+	{
+		bSpatialHashValid = false;
+		++StateRevision;
+	}
+
+	/** Yayalar, yaya geçitleri ve acil fren hacimleri (kalabalık bu alt sistemin adımında ilerler). */
+	UTrafficPedestrianSubsystem* GetPedestrianSubsystem() const { return PedestrianSubsystem; }
+
+	// ============================================
+	// DOLULUK TAHMİNİ
+	// ============================================
+
+	/**
+	 * Kayıtlı araçların şimdiki ve OccupancyHorizon'a kadarki tahmini kapladığı alanlar
+	 * (öğe = controller kayıt indeksi, grup = şerit ID'si). Karede en fazla bir kez,
+	 * ilk sorguda paralel kurulur; sonra salt okunurdur. Sadece oyun thread'inden.
+	 */
+	const FTrafficOccupancyGrid& GetOccupancyGrid();
+
+	/**
+	 * Aracın tahmini yolunda başka şeritten veya şeritsiz bir araçla çakışma arar (kavşak, birleşme).
+	 * Aynı şeritteki araçlar kuyruk kernelinde takip edildiği için sayılmaz. Çakışan çiftte
+	 * sadece biri yol verir: öndeki araca yol verilir, ikisi de birbirinin önündeyse küçük TrafficId geçer.
+	 *
+	 * @param OutTime Yol verilmesi gereken ilk çakışmanın zamanı (saniye)
+	 * @return Yol verilmesi gerekiyorsa true
+	 */
+	bool FindPredictedConflict(const AVehicleAIController* Controller, float& OutTime);
+
+	/**
+	 * Aracın sağındaki / solundaki şerit genişliğinde kısa süre içinde araç var mı (yan sensör, ışın yok).
+	 * Izgarada sadece kayıtlı controller'lar bulunur; AVehicleAIController::IsSidePathClear
+	 * false sonucu oyuncu aracı ve yayalar için yan ışınla tamamlar.
+	 */
+	bool IsSideLaneOccupied(const AVehicleAIController* Controller, bool bRight);
+
+	/**
+	 * Aracın ön tamponundan Length kadar ileri uzanan şerit genişliğindeki pencerede şimdi
+	 * bulunan araç sayısı (doluluk ızgarası, katman 0). Ön yol taraması atlanırken pencereye
+	 * yeni araç girip girmediğini anlamak için.
+	 */
+	int32 CountOccupantsAhead(const AVehicleAIController* Controller, float Length);
+
+	/**
+	 * CountOccupantsAhead ile aynı pencerede trafiğe ait olmayan bir pawn (oyuncu aracı,
+	 * RegisterExternalPawn ile eklenenler) var mı. Bu pawn'lar doluluk ızgarasında olmadığı için
+	 * kutuları hızlarıyla ForwardTraceMaxInterval boyunca katedecekleri kadar büyütülür.
+	 */
+	bool IsExternalPawnAhead(const AVehicleAIController* Controller, float Length);
+
+	/**
+	 * Trafiğe ait olmayan pawn'ı ön yol taraması atlama kontrolüne ekler (oyuncu pawn'ları
+	 * otomatik eklenir). Yayalar, fiziksel araçlar gibi aniden yola girebilecek aktörler için.
+	 */
+	void RegisterExternalPawn(APawn* Pawn);
+
+	/** RegisterExternalPawn ile eklenen pawn'ı çıkarır. */
+	void UnregisterExternalPawn(APawn* Pawn);
+
+	// ============================================
+	// SOLLAMA
+	// ============================================
+
+	/**
+	 * Sollama veya eski şeride dönüş planlama isteğini bu karenin toplu planlamasına ekler.
+	 * İstekler trafik adımında, araç takip kernelinden sonra tek ParallelFor ile planlanır;
+	 * seçilen manevra manevra zamanlayıcısında (RunOvertake) başlatılır.
+	 *
+	 * @return Planlama kapalıysa false (bOvertakePlanning)
+	 */
+	bool RequestOvertakePlan(AVehicleAIController* Controller);
+
+	/** Planlama istekleri arasındaki en kısa süre (saniye). */
+	float GetOvertakeRetryInterval() const { return OvertakeRetryInterval; }
+
+	// ============================================
+	// MANEVRALAR
+	// ============================================
+
+	/**
+	 * Güvenli şerit değiştirme manevrası başlatır: yan şeritte boşluk bekler, sinyal verir,
+	 * offset'i hedefe kaydırır ve ulaşınca sinyali kapatır. Boşluk LaneChangeGapTimeout içinde
+	 * açılmazsa vazgeçer; kayma LaneChangeTimeout içinde bitmezse eski offset'e döner.
+	 * Askıdaki manevra sadece boşluk beklerken kare başına bir doluluk sorgusu maliyeti getirir
+	 * (FTrafficManeuverScheduler).
+	 *
+	 * @return Manevra başladıysa true (araç kayıtlı değilse false)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lane Changing")
+	bool StartLaneChange(AVehicleAIController* Controller, float TargetOffset);
+
+	/** Controller'ın manevrasına olay bildirir (manevra o olayı beklemiyorsa etkisiz). */
+	void SignalManeuver(const AVehicleAIController* Controller, ETrafficManeuverWait Event) { Maneuvers.Signal(Controller, Event); }
+
+	/** Controller'ın çalışan manevrası var mı. */
+	bool HasManeuver(const AVehicleAIController* Controller) const { return Maneuvers.HasManeuver(Controller); }
+
+	/** Askıdaki manevra sayısı. */
+	int32 GetActiveManeuverCount() const { return Maneuvers.Num(); }
+
+	/**
+	 * Tehdit noktasına Radius mesafesindeki tüm araçları tek spatial sorgu ile paniğe sokar.
+	 * Kaçış yönü (tehditten araca, yatay) aynı geçişte hesaplanır; panik bitişi paylaşılan
+	 * timing wheel'e eklenir. Uzak alan araçlarının aktörü olmadığı için etkilenmez.
+	 *
+	 * @param ThreatLocation Tehdit noktası (silah ateşi, patlama vb.)
+	 * @param Radius Etki yarıçapı (birim)
+	 * @param Duration Panik süresi (saniye, <= 0 = DefaultPanicDuration)
+	 * @return Paniğe giren araç sayısı (worker'daki adım önce beklenir)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Panic System")
+	int32 BroadcastThreat(FVector ThreatLocation, float Radius, float Duration = 0.0f);
+
+	/**
+	 * Tek bir aracı paniğe sokar (tehdit noktası bilinmiyorsa kaçış yönü sıfırlanır).
+	 *
+	 * @param Controller Araç controller'ı
+	 * @param Duration Panik süresi (saniye, <= 0 = DefaultPanicDuration)
+	 */
+	void StartPanic(AVehicleAIController* Controller, float Duration = 0.0f);
+
+	/** Süre verilmeyen panikler için varsayılan süre (saniye). */
+	float GetDefaultPanicDuration() const { return DefaultPanicDuration; }
+
+	// ============================================
+	// ADIM
+	// ============================================
+
+	/** Tamamlanan simülasyon adımı sayısı. */
+	int32 GetStepIndex() const { return StepIndex; }
+
+	/**
+	 * Her adımın sonunda, adım sayacı artmadan ve worker'daki bir sonraki adım başlamadan
+	 * yayınlanır. Dinleyiciler bu adımın durumunu okuyabilir (UTrafficRecordingSubsystem).
+	 */
+	FOnTrafficStepReady OnStepReady;
+
+	// ============================================
+	// KARELİK GEÇİCİ BELLEK
+	// ============================================
+
+	/**
+	 * Karelik arenada T oluşturur (ör. controller tarama sonuçları).
+	 * Arena her adımın başında topluca bırakılır; yıkıcı çağrılmaz, bu yüzden T heap belleğe
+	 * sahip olmamalıdır. Sayfalar havuzdan gelir, kararlı durumda heap tahsisi yapılmaz.
+	 * Sadece oyun thread'inden çağrılır.
+	 */
+	template<typename T>
+	T& NewFrameScratch()
+	{
+		check(IsInGameThread());
+		return *new (FrameArena) T();
+	}
+
+	// ============================================
+	// BORU HATTI
+	// ============================================
+
+	/**
+	 * Trafik adımı (şerit kerneli, yayalar, uzak alan) worker görevinde bir adım önde mi çalışıyor.
+	 * Adım subsystem Tick'inin sonunda başlar ve bir sonraki karenin controller toplu güncellemesinin
+	 * başında tamamlanır; arada render ve oyun mantığı ile örtüşür. Oyun thread'i sadece önceki
+	 * adımın yayınlanmış hızlarını ve konumlarını okur. Controller toplu güncellemesi yoksa seri.
+	 */
+	bool IsPipelinedSimulation() const;
+
+	/** Boru hattını açar / kapatır (devam eden adım önce tamamlanır). */
+	void SetPipelinedSimulation(bool bPipelined);
+
+	/**
+	 * Devam eden adım varsa bekler ve sonuçlarını yayınlar (hızlar, yaya konumları), sonra adım
+	 * sırasında biriken oyun girdilerini uygular. Şerit, uzak alan veya yaya verisine dokunan
+	 * oyun thread'i yolları önce bunu çağırır; adım yoksa maliyeti yoktur.
+	 */
+	void FinishPipelinedStep();
+
+	/** Adım şu anda worker'da çalışıyor mu (çalışırken şerit ve yaya verisi değiştirilemez). */
+	bool IsStepRunning() const { return PipelinedStep.IsValid(); }
+
+	/**
+	 * Araç durumu her değiştiğinde artar (adım, adım sonuçlarının yayını, geri yükleme).
+	 * Yardımcı alt sistemler karelik görüntülerini bu sayaca göre yeniden kurar.
+	 */
+	uint32 GetStateRevision() const { return StateRevision; }
+
+	// ============================================
+	// OYUN OLAYLARI
+	// ============================================
+
+	/**
+	 * Olayı trafiğe gönderir. Herhangi bir thread'den (oyun mantığı, ağ, ses görevleri)
+	 * kilitsiz çağrılabilir; olaylar bir sonraki adımın başında oyun thread'inde gönderildiği
+	 * sırayla uygulanır, böylece worker'daki adım yarıda değişen duruma rastlamaz.
+	 *
+	 * @return Kuyruk doluysa false (olay düşürülür ve taşma sayacına eklenir)
+	 */
+	bool PostEvent(const FTrafficEvent& Event) { return EventQueue.Push(Event); }
+
+	/** Son adımın başında uygulanan olay sayısı. */
+	int32 GetLastEventCount() const { return LastEventCount; }
+
+	/** Kuyruk dolu olduğu için düşürülen toplam olay sayısı. */
+	int64 GetDroppedEventCount() const { return EventQueue.GetNumDropped(); }
+
+	// ============================================
+	// ÖN YOL TARAMASI
+	// ============================================
+
+	/** İki ön yol taraması arasındaki en uzun süre (saniye, <= 0 = her karede tara). */
+	float GetForwardTraceMaxInterval() const { return ForwardTraceMaxInterval; }
+
+	/** Boş çıkan ön yol taramasından sonra açıklığa karşıdan gelebilecek engelin varsayılan hızı (cm/s). */
+	float GetForwardTraceAssumedClosingSpeed() const { return ForwardTraceAssumedClosingSpeed; }
+
+	/** Controller'ın bu karedeki ön yol kararını sayar (bTraced = ışın atıldı, false = önceki karar kullanıldı). */
+	void CountForwardTrace(bool bTraced)
+	{
+		if (bTraced)
+		{
+			++NumForwardTraces;
+		}
+		else
+		{
+			++NumForwardTracesSaved;
+		}
+	}
+
+	/** Son adımda atılan ve açıklık yeterli olduğu için atlanan ön yol taramaları. */
+	int32 GetLastForwardTraceCount() const { return LastForwardTraces; }
+	int32 GetLastForwardTracesSaved() const { return LastForwardTracesSaved; }
+
+protected:
+	/** Şerit genişliği (birim). IsSidePathClear'daki yan sensör mesafesiyle aynı. */
+	UPROPERTY(Config)
+	float LaneWidth;
+
+	/** Bu mesafeden (birim) uzaklaşan araçlar uzak alana indirilir. */
+	UPROPERTY(Config)
+	float DemoteRadius;
+
+	/** Bu mesafeye (birim) yaklaşan uzak alan araçları tekrar aktör olarak spawn edilir. DemoteRadius'tan küçük olmalı (histerezis). */
+	UPROPERTY(Config)
+	float PromoteRadius;
+
+	/** Uzak alan adım aralığı (saniye). Uzak alan her karede değil, bu aralıkla güncellenir. */
+	UPROPERTY(Config)
+	float FarFieldStepInterval;
+
+	/** Bir karede spawn edilebilecek en fazla araç (spawn maliyetini karelere yaymak için). */
+	UPROPERTY(Config)
+	int32 MaxPromotionsPerStep;
+
+	/** Trafik ışığının bir şeride durma çizgisi olarak bağlanması için en fazla yanal mesafe (birim). */
+	UPROPERTY(Config)
+	float SignalAssociationRadius;
+
+	/** Şerit örnek noktaları arasındaki mesafe (birim). */
+	UPROPERTY(Config)
+	float SampleSpacing;
+
+	/** Sinyal mesafe indeksinin kova boyu (birim). */
+	UPROPERTY(Config)
+	float SignalIndexBucketSize;
+
+	/** Varış zamanı tahmininde kullanılan en düşük hız (cm/s). Duran araçlar için sonsuz varış süresini önler. */
+	UPROPERTY(Config)
+	float MinArrivalSpeed;
+
+	/** Araç spatial hash'inin hücre boyu (birim). */
+	UPROPERTY(Config)
+	float SpatialHashCellSize;
+
+	/** Süre verilmeyen panikler için varsayılan süre (saniye). */
+	UPROPERTY(Config)
+	float DefaultPanicDuration;
+
+	/** Panik timing wheel'inin adımı (saniye). Panik bitişi en fazla bu kadar gecikir. */
+	UPROPERTY(Config)
+	float PanicWheelTickInterval;
+
+	/** Controller'lar toplu varyant gruplarında mı güncellensin (false = her controller kendi actor tick'inde, genel yol). */
+	UPROPERTY(Config)
+	bool bBatchControllerUpdates;
+
+	/** Doluluk tahmini ufku (saniye). */
+	UPROPERTY(Config)
+	float OccupancyHorizon;
+
+	/** Doluluk tahmini katmanları arasındaki süre (saniye). */
+	UPROPERTY(Config)
+	float OccupancyLayerInterval;
+
+	/** Doluluk tahmini hücre boyu (birim). */
+	UPROPERTY(Config)
+	float OccupancyCellSize;
+
+	/** Yavaş liderlerin yörünge kafesi ile sollanması (false = şerit sadece TargetLaneOffset ile değişir). */
+	UPROPERTY(Config)
+	bool bOvertakePlanning;
+
+	/** Sollama adaylarının tahmin ufku (saniye). */
+	UPROPERTY(Config)
+	float OvertakeHorizon;
+
+	/** Aynı aracın iki planlama isteği arasındaki en kısa süre (saniye). */
+	UPROPERTY(Config)
+	float OvertakeRetryInterval;
+
+	/**
+	 * İki ön yol taraması arasındaki en uzun süre (saniye). Bir araç engele açıklığı duruş
+	 * mesafesinden büyük kaldıkça daha seyrek tarar; yaklaşan araç her karede tarar. 0 = her karede tara.
+	 */
+	UPROPERTY(Config)
+	float ForwardTraceMaxInterval;
+
+	/**
+	 * Ön yol taraması hiçbir şeye çarpmadığında açıklığın karşı ucundan yaklaşabilecek görünmeyen
+	 * engelin varsayılan hızı (cm/s). Işın atlama süresi bu hızla en kötü durum için hesaplanır.
+	 */
+	UPROPERTY(Config)
+	float ForwardTraceAssumedClosingSpeed;
+
+	/** Trafik adımı worker görevinde, oyun thread'inden bir adım önde çalışsın (IsPipelinedSimulation). */
+	UPROPERTY(Config)
+	bool bPipelinedSimulation;
+
+	/** Olay kuyruğu kapasitesi (2'nin kuvvetine yuvarlanır). Adım başına gelen olaylardan büyük olmalı. */
+	UPROPERTY(Config)
+	int32 EventQueueCapacity;
+
+	/** Şerit değiştirme manevrasının yan şeritte boşluk bekleme süresi (saniye, sonra vazgeçer). */
+	UPROPERTY(Config)
+	float LaneChangeGapTimeout;
+
+	/** Şerit değiştirmeden önce sinyal verme süresi (saniye). */
+	UPROPERTY(Config)
+	float LaneChangeSignalTime;
+
+	/** Kaymanın tamamlanması için süre (saniye, sonra eski offset'e dönülür). */
+	UPROPERTY(Config)
+	float LaneChangeTimeout;
+
+private:
+	/** Kontrol noktası yazma ve geri yükleme tüm simülasyon durumuna erişir. */
+	friend class UTrafficRecordingSubsystem;
+	friend class FTrafficRegionHandoff;
+
+	/** Controller'lardan mesafe, hız ve hedef hız bilgisini şerit dizilerine kopyalar. */
+	void GatherLaneStates();
+
+	/** Yakın alan kuyruklarını araç takip kerneli ile paralel günceller. */
+	void StepLanes(float DeltaTime);
+
+	/** Hesaplanan hızları controller'lara geri yazar. */
+	void ScatterLaneStates();
+
+	/** Uzak alanı (hız + konum) araç takip ve sinyal kuralları ile paralel ilerletir. */
+	void StepFarField(float DeltaTime);
+
+	/** Uzak alana indirme ve yakın alana geri dönüş kontrolleri. */
+	void UpdateFarFieldLOD();
+
+	/** Araç sınıfı için uzak alan sınıf indeksini döndürür, yoksa ekler. */
+	int32 FindOrAddFarFieldClass(TSubclassOf<AVehicle> VehicleClass);
+
+	/** Yeni kalıcı araç kimliği (bölge ayrıldıysa bu bölgenin sınıfından). */
+	uint32 AllocateTrafficId();
+
+	/** Uzak alan aracını aktör olarak spawn eder (kalıcı kimlik controller'a aktarılır). */
+	bool PromoteFarFieldVehicle(int32 LaneId, const FFarFieldVehicle& FarVehicle, uint32 TrafficId);
+
+	/** Şerit konumunda sınıfın aracını ve controller'ını spawn eder, kimliği atar ve şeride yerleştirir. */
+	AVehicleAIController* SpawnLaneVehicle(int32 LaneId, int32 ClassIndex, float Distance, float Speed, uint32 TrafficId);
+
+	/** Yakın alan aracını uzak alana indirir ve aktörlerini yok eder. */
+	void DemoteVehicle(AVehicleAIController* Controller);
+
+	/** Uzak alan aracını şeridin sıralı dizisine ekler. */
+	static void InsertFarFieldVehicle(FTrafficLane& Lane, const FFarFieldVehicle& FarVehicle, uint32 TrafficId);
+
+	/** Işığı şeride durma çizgisi olarak bağlar (yeterince yakınsa). */
+	void AssociateLightWithLane(ATrafficLight* TrafficLight, FTrafficLane& Lane) const;
+
+	/** Şeridin durma çizgisi mesafe indeksini yeniden oluşturur. */
+	void RebuildStopLineIndex(FTrafficLane& Lane) const;
+
+	/** Görüş noktalarından birine olan en küçük uzaklığın karesi. */
+	float GetMinDistSquaredToViewers(const FVector& Location) const;
+
+	/** Spatial hash'i kayıtlı controller'ların ve yayaların konumlarından kurar (karede en fazla bir kez). */
+	void BuildSpatialHash();
+
+	/** Doluluk tahminini kurar (karede en fazla bir kez). */
+	void BuildOccupancyGrid();
+
+	/** Durma çizgilerinin ışık durumlarını oyun thread'inde önbelleğe alır (uzak alan adımı için). */
+	void CacheStopLineStates();
+
+	/** Şerit kerneli, yaya ve (FarFieldDeltaTime > 0 ise) uzak alan adımını worker görevinde başlatır. */
+	void LaunchPipelinedStep(float DeltaTime, float FarFieldDeltaTime);
+
+	/** Olay kuyruğunu boşaltır ve olayları uygular (adım başında, adım tamamlandıktan sonra). */
+	void DrainEvents();
+
+	/** Şerit değiştirme manevrası (StartLaneChange). */
+	static FTrafficManeuverTask RunLaneChange(AVehicleAIController* Controller, float TargetOffset, float GapTimeout, float SignalTime, float MoveTimeout);
+
+	/** Sollama / dönüş manevrası: profil biter veya yan şerit çok uzun kapalı kalırsa vazgeçer. */
+	static FTrafficManeuverTask RunOvertake(AVehicleAIController* Controller, FTrafficOvertakeManeuver Maneuver, bool bReturn);
+
+	/** Tek bir olayı uygular. */
+	void ApplyEvent(const FTrafficEvent& Event);
+
+	/** Kalıcı kimliği verilen aracı (yakın veya uzak alan) kaldırır. */
+	bool DespawnVehicle(uint32 TrafficId);
+
+	/** Yakın alan aracının şerit kaydını siler, aracı ve controller'ı yok eder. */
+	void DestroyNearFieldVehicle(AVehicleAIController* Controller);
+
+	/** Controller'ı davranış durumunun kovasına ekler. */
+	void AddToBehaviorBucket(AVehicleAIController* Controller);
+
+	/** Controller'ı davranış kovasından çıkarır (swap-remove). */
+	void RemoveFromBehaviorBucket(AVehicleAIController* Controller);
+
+	/** Durumu değiştirir ve controller'ı yeni kovaya taşır (AVehicleAIController::SetBehavior). */
+	void MoveToBehaviorBucket(AVehicleAIController* Controller, EVehicleBehavior NewBehavior);
+
+	/** Güncellemesi Update olan durumların kovalarındaki her controller için Func çağırır. */
+	template<typename FuncType>
+	void ForEachInBehaviorUpdate(EVehicleBehaviorUpdate Update, FuncType&& Func);
+
+	/** Bu karenin sollama isteklerini paralel planlar ve seçilen manevraları başlatır. */
+	void PlanOvertakes();
+
+	/** İsteğin tahmini doluluğu: kendi şeridinde öndeki, hedef şeritlerde ufuk penceresindeki araçlar. */
+	void GatherOvertakeObstacles(const FTrafficOvertakeRequest& Request, FTrafficOvertakeObstacles& OutObstacles) const;
+
+	/** Şeridin [WindowBack, WindowFront] aralığındaki yakın ve uzak alan araçlarını ekler (Exclude hariç). */
+	void GatherLaneObstacles(const FTrafficLane& Lane, const AVehicleAIController* Exclude, float WindowFront, float WindowBack, FTrafficOvertakeObstacles& OutObstacles) const;
+
+	/** Var olan şeridin ID'si (INDEX_NONE = yok; şerit oluşturmaz). */
+	int32 FindLaneId(const USplineComponent* Spline, int32 LaneIndex) const;
+
+	/** Paniği başlatır ve bitişini çarka ekler (kaçış yönü çağırıcı tarafından atanır). */
+	void SchedulePanic(AVehicleAIController* Controller, float Duration);
+
+	/** Yakın alan dizisini önden arkaya sıralar (kareler arası sıra neredeyse hiç değişmez). */
+	static void SortLaneFrontToBack(FTrafficLane& Lane);
+
+	/** Bölge hayaletlerini kendi hızlarıyla ilerletir ve önden arkaya sırayı korur. */
+	static void AdvanceGhosts(FTrafficLane& Lane, float DeltaTime);
+
+	/**
+	 * Yakın alan, uzak alan, komşu bölge hayaletleri ve (isteğe bağlı) kırmızı/sarı durma çizgilerini
+	 * önden arkaya tek kuyrukta birleştirir. Durma çizgileri hızı 0 olan sanal lider olarak eklenir;
+	 * yol kapanması (ClosureDistance) her zaman aynı şekilde eklenir.
+	 */
+	static void BuildQueue(FTrafficLane& Lane, const FFarFieldVehicleClass* Classes, bool bIncludeStopLines);
+
+	/** Tüm şeritler. Şerit ID'si bu dizideki indekstir. */
+	TArray<FTrafficLane> Lanes;
+
+	/** (Spline, şerit sırası) -> şerit ID'si. */
+	TMap<TPair<const USplineComponent*, int32>, int32> LaneLookup;
+
+	/** Kayıtlı trafik ışıkları. */
+	TArray<TWeakObjectPtr<ATrafficLight>> TrafficLights;
+
+	/** Uzak alan araç sınıfları (FFarFieldVehicle::ClassIndex). */
+	TArray<FFarFieldVehicleClass> FarFieldClasses;
+
+	/** Görüş noktaları (oyuncu kameraları), her LOD kontrolünde güncellenir. */
+	TArray<FVector> ViewerLocations;
+
+	/** Uzak alan adımı için biriken süre. */
+	float FarFieldTimeAccumulator;
+
+	/** Tüm araç controller'ları (AVehicleAIController::RegistryIndex bu dizideki indekstir). */
+	TArray<AVehicleAIController*> Controllers;
+
+	/** Controller ve yaya konumlarının spatial hash'i (öğe = Controllers indeksi, yayalar negatif: FTrafficPedestrianCrowd::ToItemId). */
+	FTrafficSpatialHash SpatialHash;
+
+	/** Spatial hash bu karede kuruldu mu (her Tick'te sıfırlanır, ilk sorguda kurulur). */
+	bool bSpatialHashValid;
+
+	/** Kısa ufuklu doluluk tahmini (öğe = Controllers indeksi). */
+	FTrafficOccupancyGrid OccupancyGrid;
+
+	/** RegisterExternalPawn ile eklenen, trafiğe ait olmayan pawn'lar. */
+	TArray<TWeakObjectPtr<APawn>> ExternalPawns;
+
+	/** Oyuncu ve dış pawn'ların kutuları (hızla büyütülmüş), doluluk ızgarası ile birlikte kurulur. */
+	TArray<FTrafficOccupant> ExternalOccupants;
+
+	/** Doluluk tahmini bu karede kuruldu mu (her Tick'te ve kayıt değişince sıfırlanır). */
+	bool bOccupancyGridValid;
+
+	/** Panik bitişleri için paylaşılan timing wheel (controller başına FTimerHandle yerine). */
+	TTrafficTimingWheel<FPanicExpiry> PanicWheel;
+
+	/** Şerit değiştirme ve sollama manevraları (araç başına en fazla bir). */
+	FTrafficManeuverScheduler Maneuvers;
+
+	/** Bir sonraki kalıcı araç kimliği (0 = atanmamış). */
+	uint32 NextTrafficId;
+
+	/** Ardışık atanan kimlikler arasındaki fark (bölge sayısı; FTrafficRegionHandoff::SetTrafficIdPartition). */
+	uint32 TrafficIdStride;
+
+	/** Simülasyon adım sayacı. */
+	int32 StepIndex;
+
+	/** Araç durumu sayacı (GetStateRevision). */
+	uint32 StateRevision;
+
+	/** Karelik geçici bellek (NewFrameScratch). */
+	FMemStackBase FrameArena;
+
+	/** Bu karede atılan / atlanan ön yol taramaları (Tick'te istatistiğe yazılıp sıfırlanır). */
+	int32 NumForwardTraces;
+	int32 NumForwardTracesSaved;
+
+	/** Son adımın sayıları. */
+	int32 LastForwardTraces;
+	int32 LastForwardTracesSaved;
+
+	/** Oyun mantığından gelen olaylar (çok üretici, tüketici oyun thread'i). */
+	TTrafficEventQueue<FTrafficEvent> EventQueue;
+
+	/** Son adımda uygulanan olaylar. */
+	int32 LastEventCount;
+
+	/** Uyarısı verilmiş düşürülen olay sayısı (yeni taşmalar bir kez raporlanır). */
+	int64 ReportedDroppedEvents;
+
+	FTrafficControllerTickFunction ControllerTickFunction;
+
+	/**
+	 * Davranış durum kovaları (AVehicleAIController::BehaviorBucketIndex).
+	 * Direksiyon ve yan sensör gibi güncellemeler sadece ilgili durumların kovalarında çalışır.
+	 */
+	TArray<AVehicleAIController*> BehaviorBuckets[TrafficBehavior::NumStates];
+
+	/** Varyanta göre sıralı controller'lar (her güncellemede counting sort ile kurulur). */
+	TArray<AVehicleAIController*> ControllerGroups;
+
+	/** Genel yol ile güncelle (SetGenericControllerUpdate). */
+	bool bGenericControllerUpdate;
+
+	/** Bu karede planlama isteyen controller'lar (AVehicleAIController::bOvertakePlanPending). */
+	TArray<AVehicleAIController*> OvertakeRequesters;
+
+	/** Bu karenin planlama istekleri ve sonuçları (aynı sırada). */
+	TArray<FTrafficOvertakeRequest> OvertakeRequests;
+	TArray<FTrafficOvertakePlan> OvertakePlans;
+
+	/** Kalabalığı bu subsystem'in adımında ilerletilen yaya alt sistemi (bağımlılık olarak kurulur). */
+	UPROPERTY(Transient)
+	TObjectPtr<UTrafficPedestrianSubsystem> PedestrianSubsystem;
+
+	/** Devam eden trafik adımı (geçersiz = adım yok). */
+	TFuture<void> PipelinedStep;
+};
@@ -0,0 +1,211 @@
+#include "TrafficSweep.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "TrafficArchetype.h"
+#include "TrafficScenario.h"
+#include "TrafficSubsystem.h"
+
+namespace
+{
+	const TCHAR* LightPrefix = TEXT("Light.");
+	const TCHAR* TrafficPrefix = TEXT("Traffic.");
+
+	/** JSON değerini metne çevirir (sayılar tam sayıysa ondalıksız). */
+	FString ValueToString(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (Value->Type == EJson::Number)
+		{
+			const double Number = Value->AsNumber();
+			return FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number)) ? FString::Printf(TEXT("%lld"), (int64)FMath::RoundToDouble(Number)) : FString::SanitizeFloat(Number);
+		}
+		if (Value->Type == EJson::Boolean)
+		{
+			return Value->AsBool() ? TEXT("True") : TEXT("False");
+		}
+		return Value->AsString();
+	}
+}
+
+bool FTrafficSweep::LoadFromFile(const FString& FilePath)
+{
+	FString JsonText;
+	if (!FFileHelper::LoadFileToString(JsonText, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Tarama tanımı okunamadı: %s"), *FilePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Tarama JSON'u geçersiz: %s"), *FilePath);
+		return false;
+	}
+
+	if (!Root->TryGetStringField(TEXT("Scenario"), ScenarioPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Tarama tanımında Scenario yok: %s"), *FilePath);
+		return false;
+	}
+	if (FPaths::IsRelative(ScenarioPath))
+	{
+		ScenarioPath = FPaths::ConvertRelativePathToFull(FPaths::GetPath(FilePath), ScenarioPath);
+	}
+
+	double Number;
+	NumSteps = Root->TryGetNumberField(TEXT("Steps"), Number) ? (int32)Number : 0;
+	WarmupSteps = Root->TryGetNumberField(TEXT("WarmupSteps"), Number) ? (int32)Number : WarmupSteps;
+
+	Seeds.Reset();
+	const TArray<TSharedPtr<FJsonValue>>* SeedValues;
+	if (Root->TryGetArrayField(TEXT("Seeds"), SeedValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *SeedValues)
+		{
+			Seeds.Add((int32)Value->AsNumber());
+		}
+	}
+
+	// Nesne alan sırası korunur (CSV sütunları ve iş indeksi bu sırayla)
+	Parameters.Reset();
+	const TSharedPtr<FJsonObject>* ParameterObject;
+	if (Root->TryGetObjectField(TEXT("Parameters"), ParameterObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*ParameterObject)->Values)
+		{
+			FTrafficSweepParameter& Parameter = Parameters.AddDefaulted_GetRef();
+			Parameter.Name = Pair.Key;
+
+			if (Pair.Value->Type == EJson::Array)
+			{
+				for (const TSharedPtr<FJsonValue>& Value : Pair.Value->AsArray())
+				{
+					Parameter.Values.Add(ValueToString(Value));
+				}
+			}
+			else
+			{
+				Parameter.Values.Add(ValueToString(Pair.Value));
+			}
+
+			if (Parameter.Values.Num() == 0)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Tarama parametresi %s için değer yok"), *Parameter.Name);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FTrafficSweep::GetNumJobs() const
+{
+	int64 NumJobs = FMath::Max(Seeds.Num(), 1);
+	for (const FTrafficSweepParameter& Parameter : Parameters)
+	{
+		NumJobs *= Parameter.Values.Num();
+	}
+	return (int32)FMath::Min(NumJobs, (int64)MAX_int32);
+}
+
+void FTrafficSweep::GetJob(int32 JobIndex, TArray<FString>& OutValues, int32& OutSeed, int32 DefaultSeed) const
+{
+	OutValues.Reset(Parameters.Num());
+
+	// Karma tabanlı: ilk parametre en hızlı değişir
+	int32 Remainder = JobIndex;
+	for (const FTrafficSweepParameter& Parameter : Parameters)
+	{
+		OutValues.Add(Parameter.Values[Remainder % Parameter.Values.Num()]);
+		Remainder /= Parameter.Values.Num();
+	}
+
+	OutSeed = Seeds.Num() > 0 ? Seeds[Remainder % Seeds.Num()] : DefaultSeed;
+}
+
+bool FTrafficSweep::ApplyToScenario(const TArray<FString>& Values, FTrafficScenario& Scenario) const
+{
+	for (int32 Index = 0; Index < Parameters.Num(); ++Index)
+	{
+		const FString& Name = Parameters[Index].Name;
+		if (!Name.StartsWith(LightPrefix))
+		{
+			continue;
+		}
+
+		const FString Field = Name.RightChop(FCString::Strlen(LightPrefix));
+		const float Value = FCString::Atof(*Values[Index]);
+		for (FTrafficScenarioLight& Light : Scenario.Lights)
+		{
+			if (Field == TEXT("GreenDuration"))
+			{
+				Light.GreenDuration = Value;
+			}
+			else if (Field == TEXT("YellowDuration"))
+			{
+				Light.YellowDuration = Value;
+			}
+			else if (Field == TEXT("RedDuration"))
+			{
+				Light.RedDuration = Value;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("Bilinmeyen ışık parametresi: %s"), *Name);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FTrafficSweep::ApplyToSubsystemDefaults(const TArray<FString>& Values) const
+{
+	UTrafficSubsystem* Defaults = GetMutableDefault<UTrafficSubsystem>();
+
+	for (int32 Index = 0; Index < Parameters.Num(); ++Index)
+	{
+		const FString& Name = Parameters[Index].Name;
+		if (!Name.StartsWith(TrafficPrefix))
+		{
+			continue;
+		}
+
+		// Sadece Config ayarları varsayılan nesneden yeni örneğe kopyalanır
+		const FString Field = Name.RightChop(FCString::Strlen(TrafficPrefix));
+		const FProperty* Property = UTrafficSubsystem::StaticClass()->FindPropertyByName(FName(*Field));
+		if (!Property || !Property->HasAnyPropertyFlags(CPF_Config)
+			|| !Property->ImportText_Direct(*Values[Index], Property->ContainerPtrToValuePtr<void>(Defaults), Defaults, PPF_None))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Trafik ayarı uygulanamadı: %s = %s"), *Name, *Values[Index]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FTrafficSweep::ApplyToArchetypes(const TArray<FString>& Values) const
+{
+	for (int32 Index = 0; Index < Parameters.Num(); ++Index)
+	{
+		const FString& Name = Parameters[Index].Name;
+		if (Name.StartsWith(LightPrefix) || Name.StartsWith(TrafficPrefix))
+		{
+			continue;
+		}
+
+		if (!FTrafficArchetypeTable::SetParamOverride(Name, Values[Index]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
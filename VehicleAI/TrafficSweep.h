@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTrafficScenario;
+
+/**
+ * Taramadaki bir parametre ve denenecek değerleri.
+ *
+ * Ad hedefi belirler:
+ *   "Light.GreenDuration", "Light.YellowDuration", "Light.RedDuration"  Senaryodaki tüm ışıklar
+ *   "Traffic.<Alan>"                                                   UTrafficSubsystem Config ayarı (ör. Traffic.DemoteRadius)
+ *   Diğerleri                                                          Tüm archetype'lar (ör. SafeFollowingDistance, CarFollowing.TimeHeadway)
+ */
+struct FTrafficSweepParameter
+{
+	FString Name;
+	TArray<FString> Values;
+};
+
+/**
+ * Parametre taraması tanımı (JSON).
+ *
+ * { "Scenario": "City.json", "Steps": 3600, "WarmupSteps": 600, "Seeds": [1, 2, 3],
+ *   "Parameters": { "SafeFollowingDistance": [300, 500, 700], "Light.GreenDuration": [8, 12, 16] } }
+ *
+ * Konfigürasyonlar parametre değerlerinin kartezyen çarpımıdır; her konfigürasyon her tohumla
+ * ayrı iş olarak çalışır. İş indeksi karma tabanlı sayıdır (ilk parametre en hızlı değişir,
+ * tohum en yavaş), böylece aynı tanım her çalıştırmada aynı işleri üretir.
+ */
+struct YOURGAMENAME_API FTrafficSweep
+{
+	/** Senaryo dosyası (göreli ise tarama dosyasının klasörüne göre). */
+	FString ScenarioPath;
+
+	/** Adım sayısı (0 = senaryonun). */
+	int32 NumSteps = 0;
+
+	/** Metriklerden önce çalışan adımlar (trafik oturur, ışık metrikleri sonra sıfırlanır). */
+	int32 WarmupSteps = 300;
+
+	/** Boş = senaryonun tohumu. */
+	TArray<int32> Seeds;
+
+	TArray<FTrafficSweepParameter> Parameters;
+
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Toplam iş sayısı (konfigürasyon * tohum). */
+	int32 GetNumJobs() const;
+
+	/**
+	 * İşin parametre değerleri (Parameters sırasıyla) ve tohumu.
+	 */
+	void GetJob(int32 JobIndex, TArray<FString>& OutValues, int32& OutSeed, int32 DefaultSeed) const;
+
+	/**
+	 * Senaryo parametrelerini (Light.*) uygular. Dünya kurulmadan önce çağrılır.
+	 *
+	 * @return Bilinmeyen Light.* alanında false
+	 */
+	bool ApplyToScenario(const TArray<FString>& Values, FTrafficScenario& Scenario) const;
+
+	/**
+	 * Subsystem parametrelerini (Traffic.*) UTrafficSubsystem'in varsayılan nesnesine yazar.
+	 * Dünya oluşturulmadan önce çağrılır: yeni subsystem Config ayarlarını varsayılan nesneden
+	 * alır, böylece sadece Initialize'da okunan ayarlar da etkili olur. Varsayılan nesne geri
+	 * alınmaz (tarama her işi ayrı süreçte çalıştırır).
+	 *
+	 * @return Alan bulunamadıysa, Config ayarı değilse veya değer ayrıştırılamadıysa false
+	 */
+	bool ApplyToSubsystemDefaults(const TArray<FString>& Values) const;
+
+	/**
+	 * Archetype parametrelerini (Light.* ve Traffic.* dışındakiler) uygular. Senaryo spawn
+	 * edilmeden önce çağrılır.
+	 *
+	 * @return Parametre bilinmiyorsa veya değer ayrıştırılamadıysa false
+	 */
+	bool ApplyToArchetypes(const TArray<FString>& Values) const;
+};
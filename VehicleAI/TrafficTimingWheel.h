@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hashed timing wheel (paylaşılan zamanlayıcı).
+ * Binlerce kısa süreli zamanlayıcıyı (panik bitişi vb.) FTimerManager'a tek tek
+ * kaydetmek yerine tek bir çark üzerinde tutar. Ekleme O(1), her adımda sadece
+ * ilgili yuva taranır.
+ *
+ * Süre, TickInterval çözünürlüğüne yukarı yuvarlanır (zamanlayıcı asla erken bitmez).
+ * İptal tembel yapılır: yük (payload) içinde nesil (generation) tutulur ve süresi dolan
+ * girdi çağırıcı tarafından geçerli nesille karşılaştırılır.
+ */
+template<typename PayloadType>
+class TTrafficTimingWheel
+{
+public:
+	/**
+	 * @param InNumSlots Yuva sayısı (2'nin kuvveti olmalı)
+	 * @param InTickInterval Çark adımı (saniye)
+	 */
+	void Initialize(int32 InNumSlots, float InTickInterval)
+	{
+		check(FMath::IsPowerOfTwo(InNumSlots));
+		Slots.Reset();
+		Slots.SetNum(InNumSlots);
+		SlotMask = InNumSlots - 1;
+		TickInterval = FMath::Max(InTickInterval, KINDA_SMALL_NUMBER);
+		CurrentTick = 0;
+		TimeAccumulator = 0.0f;
+		NumEntries = 0;
+	}
+
+	/**
+	 * Delay saniye sonra süresi dolacak bir girdi ekler.
+	 */
+	void Schedule(float Delay, const PayloadType& Payload)
+	{
+		// En az bir adım sonra (aynı adımda eklenen girdi hemen bitmez)
+		const uint64 Ticks = (uint64)FMath::Max(1, FMath::CeilToInt((Delay - TimeAccumulator) / TickInterval));
+		const uint64 ExpiryTick = CurrentTick + Ticks;
+
+		FEntry& Entry = Slots[(int32)(ExpiryTick & SlotMask)].AddDefaulted_GetRef();
+		Entry.ExpiryTick = ExpiryTick;
+		Entry.Payload = Payload;
+		++NumEntries;
+	}
+
+	/**
+	 * Çarkı ilerletir ve süresi dolan her girdi için OnExpired(Payload) çağırır.
+	 */
+	template<typename FuncType>
+	void Advance(float DeltaTime, FuncType&& OnExpired)
+	{
+		if (Slots.Num() == 0)
+		{
+			return;
+		}
+
+		TimeAccumulator += DeltaTime;
+		while (TimeAccumulator >= TickInterval)
+		{
+			TimeAccumulator -= TickInterval;
+			++CurrentTick;
+
+			// Sadece bu adımın yuvası taranır; tur sayısı dolmamış girdiler yerinde kalır
+			TArray<FEntry>& Slot = Slots[(int32)(CurrentTick & SlotMask)];
+			for (int32 Index = Slot.Num() - 1; Index >= 0; --Index)
+			{
+				if (Slot[Index].ExpiryTick <= CurrentTick)
+				{
+					const PayloadType Payload = Slot[Index].Payload;
+					Slot.RemoveAtSwap(Index, 1, false);
+					--NumEntries;
+					OnExpired(Payload);
+				}
+			}
+		}
+	}
+
+	/** Çarkta bekleyen girdi sayısı. */
+	int32 Num() const { return NumEntries; }
+
+	/** Çark adımı (saniye). */
+	float GetTickInterval() const { return TickInterval; }
+
+	/**
+	 * Tüm bekleyen girdileri kalan süreleriyle ziyaret eder (checkpoint vb. için).
+	 */
+	template<typename FuncType>
+	void ForEachPending(FuncType&& Func) const
+	{
+		for (const TArray<FEntry>& Slot : Slots)
+		{
+			for (const FEntry& Entry : Slot)
+			{
+				const float Remaining = (float)(Entry.ExpiryTick - CurrentTick) * TickInterval - TimeAccumulator;
+				Func(Entry.Payload, FMath::Max(0.0f, Remaining));
+			}
+		}
+	}
+
+	/** Tüm girdileri siler. */
+	void Reset()
+	{
+		for (TArray<FEntry>& Slot : Slots)
+		{
+			Slot.Reset();
+		}
+		NumEntries = 0;
+	}
+
+private:
+	struct FEntry
+	{
+		uint64 ExpiryTick = 0;
+		PayloadType Payload;
+	};
+
+	TArray<TArray<FEntry>> Slots;
+	uint64 SlotMask = 0;
+	uint64 CurrentTick = 0;
+	float TickInterval = 0.1f;
+	float TimeAccumulator = 0.0f;
+	int32 NumEntries = 0;
+};
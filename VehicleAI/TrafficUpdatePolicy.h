@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrafficArchetype.h"
+
+class AVehicleAIController;
+
+/**
+ * Controller güncelleme politikaları.
+ * AVehicleAIController::UpdateDriving her yetenek kümesi için ayrı derlenir; derleme zamanı
+ * maskesinde olmayan yeteneklerin dalları (panik, ışık ve araç cast'leri, şerit değiştirme)
+ * kodda hiç yer almaz. UTrafficSubsystem araçları varyanta göre gruplar ve her grubu
+ * kendi döngüsünde günceller.
+ */
+namespace TrafficUpdatePolicy
+{
+	/** Varyant sayısı (4 yetenek biti). */
+	constexpr int32 NumVariants = 1 << 4;
+}
+
+/**
+ * Derleme zamanı yetenek maskesi.
+ */
+template<uint8 CapabilityMask>
+struct TTrafficUpdatePolicy
+{
+	static FORCEINLINE constexpr bool Has(const AVehicleAIController&, ETrafficCapability Capability)
+	{
+		return (CapabilityMask & (uint8)Capability) != 0;
+	}
+};
+
+/**
+ * Genel yol: yetenekler her araç için çalışma zamanında archetype'tan okunur.
+ * Blueprint çağrıları, gruplama dışındaki araçlar ve karşılaştırma ölçümleri (-GenericUpdate) için.
+ */
+struct FTrafficGenericUpdatePolicy
+{
+	static bool Has(const AVehicleAIController& Controller, ETrafficCapability Capability);
+};
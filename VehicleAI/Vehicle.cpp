@@ -5,6 +5,8 @@
 #include "GameFramework/PawnMovementComponent.h"
 #include "Components/SceneComponent.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "TrafficArchetype.h"
 
 // Sets default values
 AVehicle::AVehicle(const FObjectInitializer& ObjectInitializer)
@@ -27,6 +29,7 @@ AVehicle::AVehicle(const FObjectInitializer& ObjectInitializer)
 	VehicleMesh->SetCollisionObjectType(ECC_Pawn);
 	VehicleMesh->SetCollisionResponseToAllChannels(ECR_Block);
 	VehicleMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+	VehicleMesh->SetGenerateOverlapEvents(true); // Trafik ışığı TriggerBox kuyruk sayaçları için
 
 	// Spring Arm Component oluştur
 	SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
@@ -43,13 +46,23 @@ AVehicle::AVehicle(const FObjectInitializer& ObjectInitializer)
 	Camera->SetupAttachment(SpringArm, USpringArmComponent::SocketName);
 	Camera->bUsePawnControlRotation = false; // Spring Arm rotasyonunu kullan
 
-	// Varsayılan değerler
-	MaxMovementSpeed = 1000.0f;
-	MaxSteeringAngle = 45.0f;
+	// Varsayılan değerler (maksimum hız ve direksiyon açısı archetype'tan gelir)
+	Archetype = nullptr;
+	ArchetypeIndex = FTrafficArchetypeTable::DefaultIndex;
 	MovementForceMultiplier = 1000.0f;
 	VehicleAIControllerRef = nullptr;
 }
 
+void AVehicle::PostInitializeComponents()
+{
+	// Varsayılan controller Super içinde spawn edilip possess edebilir - indeks ondan önce hazır olmalı
+	// Tablo oyun dünyalarının ömrüne bağlı: editör dünyasındaki araçlar varsayılanı kullanır
+	const UWorld* World = GetWorld();
+	ArchetypeIndex = World && World->IsGameWorld() ? FTrafficArchetypeTable::Register(Archetype) : FTrafficArchetypeTable::DefaultIndex;
+
+	Super::PostInitializeComponents();
+}
+
 // Called when the game starts or when spawned
 void AVehicle::BeginPlay()
 {
@@ -83,7 +96,7 @@ void AVehicle::Tick(float DeltaTime)
 		float CurrentSpeed = VehicleAIControllerRef->CurrentSpeed;
 		
 		// Normalize edilmiş hız değeri (0.0 - 1.0 arası)
-		float NormalizedSpeed = FMath::Clamp(CurrentSpeed / MaxMovementSpeed, 0.0f, 1.0f);
+		float NormalizedSpeed = FMath::Clamp(CurrentSpeed / FTrafficArchetypeTable::Get(ArchetypeIndex).MaxMovementSpeed, 0.0f, 1.0f);
 		
 		// Hareketi uygula
 		ApplyMovement(NormalizedSpeed);
@@ -102,6 +115,21 @@ void AVehicle::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 	// AI kontrolü kullanıldığında bu fonksiyon genellikle kullanılmaz
 }
 
+void AVehicle::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	// Runtime'da spawn edilip sonradan possess edilen araçlarda BeginPlay'de controller henüz yoktur
+	VehicleAIControllerRef = Cast<AVehicleAIController>(NewController);
+}
+
+void AVehicle::UnPossessed()
+{
+	Super::UnPossessed();
+
+	VehicleAIControllerRef = nullptr;
+}
+
 void AVehicle::ApplyMovement(float Speed)
 {
 	// Speed değerini clamp et (0.0 - 1.0 arası)
@@ -117,7 +145,7 @@ void AVehicle::ApplyMovement(float Speed)
 	FVector ForwardVector = GetActorForwardVector();
 	
 	// Hızı hesapla (normalize edilmiş değer * maksimum hız)
-	float ActualSpeed = Speed * MaxMovementSpeed;
+	float ActualSpeed = Speed * FTrafficArchetypeTable::Get(ArchetypeIndex).MaxMovementSpeed;
 	
 	// Hareket vektörünü hesapla
 	FVector MovementVector = ForwardVector * ActualSpeed * GetWorld()->GetDeltaSeconds();
@@ -147,7 +175,7 @@ void AVehicle::ApplySteering(float SteerValue)
 	}
 
 	// Maksimum direksiyon açısını hesapla
-	float SteeringAngle = SteerValue * MaxSteeringAngle;
+	float SteeringAngle = SteerValue * FTrafficArchetypeTable::Get(ArchetypeIndex).MaxSteeringAngle;
 	
 	// Yaw rotasyonunu uygula (Y ekseni etrafında dönüş)
 	FRotator CurrentRotation = GetActorRotation();
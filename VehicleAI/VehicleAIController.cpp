@@ -6,9 +6,19 @@
 #include "Engine/Engine.h"
 #include "TrafficLight.h"
 #include "Components/SplineComponent.h"
-#include "Components/AudioComponent.h"
 #include "TimerManager.h"
 #include "Vehicle.h"
+#include "TrafficSubsystem.h"
+#include "TrafficAudioSubsystem.h"
+#include "TrafficPedestrianSubsystem.h"
+#include "TrafficAllocationTracker.h"
+#include "TrafficBehavior.h"
+
+namespace
+{
+	/** Ön yol kararı araç son taramadan bu açının kosinüsünden fazla dönmediyse kullanılır (~5 derece). */
+	constexpr float ForwardTraceHeadingTolerance = 0.996f;
+}
 
 AVehicleAIController::AVehicleAIController(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -17,41 +27,340 @@ AVehicleAIController::AVehicleAIController(const FObjectInitializer& ObjectIniti
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.TickGroup = TG_PrePhysics;
 
-	// Varsayılan değerler
-	DetectionDistance = 1000.0f;
-	DotProductThreshold = 0.7f;
+	// Varsayılan değerler (sürüş parametreleri archetype'tan gelir)
+	ArchetypeIndex = FTrafficArchetypeTable::DefaultIndex;
 	CurrentSpeed = 0.0f;
 	TargetSpeed = 0.0f;
-	MaxSpeed = 1000.0f; // Maksimum hız (cm/s veya m/s)
-	MaxBrakingDeceleration = -500.0f; // Negatif değer (frenleme)
 	CurrentTrafficLightState = ETrafficLightState::Green;
 	TargetSpline = nullptr;
-	LookAheadDistance = 500.0f;
 	CurrentSteerValue = 0.0f;
 	CurrentVehicleBehavior = EVehicleBehavior::Normal;
 	CurrentLaneOffset = 0.0f;
 	TargetLaneOffset = 0.0f;
-	LaneChangeSpeed = 200.0f; // Birim/saniye
 	bIsPanicking = false;
-	SafeFollowingDistance = 500.0f; // Güvenli takip mesafesi (birim)
-	HornAudioComponent = nullptr;
+	PanicEscapeDirection = FVector::ZeroVector;
+	PanicSwerveDistance = 100.0f;
+	PanicGeneration = 0;
+	PanicEndTime = 0.0f;
+	RegistryIndex = INDEX_NONE;
+	ManeuverSlot = INDEX_NONE;
+	TurnSignal = 0;
+	BehaviorBucketIndex = INDEX_NONE;
+	bBlockedByObstacle = false;
+	bLaneChangeSideBlocked = false;
+	OvertakeReturnOffset = 0.0f;
+	bHasOvertakeReturn = false;
+	OvertakeLeaderId = 0;
+	bOvertakePlanPending = false;
+	OvertakeRetryTimer = 0.0f;
+	ForwardTraceClearance = 0.0f;
+	ForwardTraceTravel = 0.0f;
+	ForwardTraceElapsed = 0.0f;
+	ForwardTraceClosingSpeed = 0.0f;
+	ForwardTraceEntrants = 0;
+	ForwardTraceTimer = 0.0f;
+	ForwardTraceDirection = FVector::ZeroVector;
+	ForwardPathTargetSpeed = 0.0f;
+	bForwardPathFollowing = false;
+	bForwardTracePanicking = false;
+	TrafficId = 0;
+	HornSound = nullptr;
+	HornCooldown = 3.0f;
+	HornUrgency = 1.0f;
+	bHornArmed = true;
+	LastHornTime = -MAX_flt;
+	LaneId = INDEX_NONE;
+	DistanceAlongLane = 0.0f;
+	StopLineTolerance = 50.0f;
+
+	// Basit collision, fiziksel materyal bilgisine ihtiyacımız yok (yoksayılan aktör OnPossess'te eklenir)
+	TraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(VehicleAITrace), false);
+	TraceParams.bReturnPhysicalMaterial = false;
+}
+
+void AVehicleAIController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UTrafficSubsystem* TrafficSubsystem = World->GetSubsystem<UTrafficSubsystem>())
+		{
+			// Tehdit yayınları için genel kayıt (şeride bağlı olmasa da)
+			TrafficSubsystem->RegisterController(this);
+		}
+	}
+
+	// TargetSpline atanmışsa aracı şerit kuyruğuna kaydet
+	SyncLaneRegistration();
+}
+
+void AVehicleAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Şerit kuyruğundan çıkar (subsystem'de geçersiz pointer kalmasın)
+	if (UWorld* World = GetWorld())
+	{
+		if (UTrafficSubsystem* TrafficSubsystem = World->GetSubsystem<UTrafficSubsystem>())
+		{
+			TrafficSubsystem->UnregisterVehicle(this);
+			TrafficSubsystem->UnregisterController(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AVehicleAIController::SyncLaneRegistration()
+{
+	UWorld* World = GetWorld();
+	UTrafficSubsystem* TrafficSubsystem = World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (!TrafficSubsystem)
+	{
+		return;
+	}
+
+	// Spline yoksa şeride bağlı değil - Lerp tabanlı hız geçişi kullanılır
+	if (!TargetSpline)
+	{
+		TrafficSubsystem->UnregisterVehicle(this);
+		return;
+	}
+
+	// Şerit değiştirme sırasında araç hedef şeridin kuyruğuna geçer
+	const int32 DesiredLaneId = TrafficSubsystem->FindOrAddLane(TargetSpline, TargetLaneOffset);
+	if (DesiredLaneId != LaneId)
+	{
+		TrafficSubsystem->RegisterVehicle(this, DesiredLaneId);
+	}
+}
+
+void AVehicleAIController::PlaceOnLane(USplineComponent* Spline, float LaneOffset, float Distance, float Speed)
+{
+	TargetSpline = Spline;
+	CurrentLaneOffset = LaneOffset;
+	TargetLaneOffset = LaneOffset;
+	DistanceAlongLane = Distance;
+	CurrentSpeed = Speed;
+	TargetSpeed = Speed;
+
+	// Yerleştirilen araç manevra ortasında başlamaz
+	OvertakeManeuver = FTrafficOvertakeManeuver();
+	bHasOvertakeReturn = false;
+
+	// Yeni konumda önceki ön yol kararı geçersiz
+	ForwardTraceTimer = 0.0f;
+
+	SyncLaneRegistration();
+}
+
+void AVehicleAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	// Sürüş parametreleri aracın archetype'ından (taksi, otobüs vb.)
+	if (const AVehicle* Vehicle = Cast<AVehicle>(InPawn))
+	{
+		ArchetypeIndex = Vehicle->GetArchetypeIndex();
+	}
+
+	// Kendi aracımızı ignore et (tarama parametreleri karelerce yeniden kullanılır)
+	TraceParams.ClearIgnoredActors();
+	TraceParams.AddIgnoredActor(InPawn);
+	ForwardTraceTimer = 0.0f;
+
+	// ACC yoksa Pawn'lar ışını durdurmaz (örtüşme): şeride bağlı AI araçları isabet
+	// döngüsünde elenir, oyuncu aracı ve yayalar engel olarak görülmeye devam eder
+	TraceResponseParams = FCollisionResponseParams::DefaultResponseParam;
+	if (!(GetCapabilities() & (uint8)ETrafficCapability::AdaptiveCruise))
+	{
+		TraceResponseParams.CollisionResponse.SetResponse(ECC_Pawn, ECR_Overlap);
+	}
+
+	// Araç, varyant grubunun güncellemesinden sonra tick'lensin
+	if (UWorld* World = GetWorld())
+	{
+		if (UTrafficSubsystem* TrafficSubsystem = World->GetSubsystem<UTrafficSubsystem>())
+		{
+			TrafficSubsystem->AddControllerUpdatePrerequisite(InPawn);
+		}
+	}
+}
+
+void AVehicleAIController::OnUnPossess()
+{
+	TraceParams.ClearIgnoredActors();
+
+	Super::OnUnPossess();
+}
+
+void AVehicleAIController::AssignTrafficId(uint32 InTrafficId)
+{
+	TrafficId = InTrafficId;
+	DriverVariance = FTrafficDriverVariance::FromSeed(InTrafficId);
+}
+
+float AVehicleAIController::GetMaxSpeed() const
+{
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+	return Archetype.MaxSpeed * FTrafficDriverVariance::ToScale(DriverVariance.Speed, Archetype.SpeedVariance);
+}
+
+float AVehicleAIController::GetSafeFollowingDistance() const
+{
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+	return Archetype.SafeFollowingDistance * FTrafficDriverVariance::ToScale(DriverVariance.Headway, Archetype.HeadwayVariance);
+}
+
+float AVehicleAIController::GetLaneChangeSpeed() const
+{
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+	return Archetype.LaneChangeSpeed * FTrafficDriverVariance::ToScale(DriverVariance.LaneChange, Archetype.LaneChangeVariance);
+}
+
+FCarFollowingParams AVehicleAIController::GetCarFollowingParams() const
+{
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+	FCarFollowingParams Params = Archetype.CarFollowing;
+	Params.TimeHeadway *= FTrafficDriverVariance::ToScale(DriverVariance.Headway, Archetype.HeadwayVariance);
+	return Params;
+}
+
+bool FTrafficGenericUpdatePolicy::Has(const AVehicleAIController& Controller, ETrafficCapability Capability)
+{
+	return (Controller.GetCapabilities() & (uint8)Capability) != 0;
 }
 
 void AVehicleAIController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// UTrafficSubsystem'e kayıtlı araçlar varyant gruplarında toplu güncellenir (bu tick kapatılır);
+	// buraya sadece subsystem'i olmayan araçlar gelir - genel yol
+	TRAFFIC_TRACK_ALLOCATIONS();
+
+	if (TrafficBehavior::HasUpdate(CurrentVehicleBehavior, EVehicleBehaviorUpdate::SideCheck))
+	{
+		UpdateLaneChangeSideCheck();
+	}
+
+	UWorld* World = GetWorld();
+	UpdateDriving<FTrafficGenericUpdatePolicy>(DeltaTime, World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr);
+
+	// Spline takip: direksiyon değerini güncelle (sonuç CurrentSteerValue olarak Vehicle'a iletilir)
+	if (TrafficBehavior::HasUpdate(CurrentVehicleBehavior, EVehicleBehaviorUpdate::Steering))
+	{
+		UpdateSteering();
+	}
+}
+
+template<typename PolicyType>
+void AVehicleAIController::UpdateDriving(float DeltaTime, UTrafficSubsystem* TrafficSubsystem)
+{
+	// Şerit kaydını güncel tut (TargetSpline / TargetLaneOffset değişmiş olabilir)
+	SyncLaneRegistration();
+
 	// Ön yol kontrolü: engel / trafik ışığı varsa TargetSpeed güncellenir (Vehicle hızı buna göre uygular)
-	FHitResult HitResult;
-	CheckForwardPath(HitResult);
+	// Açıklık duruş mesafesinden yeterince büyükse önceki karar kullanılır (ışın atılmaz)
+	// Tarama sonucu karelik arenadan alınır (adım sonunda topluca bırakılır)
+	if (TrafficSubsystem)
+	{
+		const float MaxTraceInterval = TrafficSubsystem->GetForwardTraceMaxInterval();
+		if (CanReuseForwardPath(DeltaTime, MaxTraceInterval, TrafficSubsystem))
+		{
+			TargetSpeed = ForwardPathTargetSpeed;
+			TrafficSubsystem->CountForwardTrace(false);
+		}
+		else
+		{
+			FHitResult& HitResult = TrafficSubsystem->NewFrameScratch<FHitResult>();
+			EvaluateForwardPath<PolicyType>(HitResult);
+			ScheduleForwardTrace(HitResult, MaxTraceInterval, TrafficSubsystem);
+			TrafficSubsystem->CountForwardTrace(true);
+		}
+	}
+	else
+	{
+		FHitResult HitResult;
+		EvaluateForwardPath<PolicyType>(HitResult);
+
+		// Panik çarkı yok: bitiş controller'da denetlenir
+		if (PolicyType::Has(*this, ETrafficCapability::Panic) && bIsPanicking && GetWorld() && GetWorld()->GetTimeSeconds() >= PanicEndTime)
+		{
+			DisablePanicMode();
+		}
+	}
+
+	// Şeride bağlı araçlar sinyalleri ışın yerine şerit indeksinden öğrenir
+	if (PolicyType::Has(*this, ETrafficCapability::SignalAware) && IsLaneBound())
+	{
+		ApplySignalLookahead(DeltaTime, TrafficSubsystem);
+	}
+
+	// Başka şeritten veya şeritsiz bir araçla tahmini çakışma (kavşak, birleşme): paylaşılan doluluk tahmininden
+	// Duruş süresi içindeki çakışmada tam fren, daha uzaktakinde yavaşla (öncelikli araç geçsin)
+	float ConflictTime = 0.0f;
+	if (TrafficSubsystem && TrafficSubsystem->FindPredictedConflict(this, ConflictTime))
+	{
+		const float StoppingTime = CurrentSpeed / FMath::Max(-GetMaxBrakingDeceleration(), 1.0f);
+		if (ConflictTime <= StoppingTime + TrafficSubsystem->GetOccupancyGrid().GetLayerInterval())
+		{
+			TargetSpeed = 0.0f;
+		}
+		else
+		{
+			TargetSpeed = FMath::Min(TargetSpeed, CurrentSpeed * 0.5f);
+		}
+	}
+
+	// Acil fren: hıza göre uzayan fren hacminde yaya varsa dur (hacimler subsystem'de toplu test edilir)
+	if (TrafficSubsystem && TrafficSubsystem->GetPedestrianSubsystem()->IsBrakingForPedestrian(this))
+	{
+		TargetSpeed = 0.0f;
+	}
 
 	// Hızı hedef hıza doğru yumuşakça yaklaştır (sonuç CurrentSpeed olarak Vehicle'a iletilir)
-	SmoothSpeedTransition(DeltaTime);
+	// Şeride bağlı araçlarda hız UTrafficSubsystem'in kuyruk kerneli ile hesaplanır
+	if (!IsLaneBound())
+	{
+		SmoothSpeedTransition(DeltaTime);
+	}
+
+	// Hedef dışarıdan (Blueprint) değiştiyse sollama manevrası iptal edilir
+	if (OvertakeManeuver.IsActive() && OvertakeManeuver.TargetOffset != TargetLaneOffset)
+	{
+		OvertakeManeuver = FTrafficOvertakeManeuver();
+		bHasOvertakeReturn = false;
+	}
 
-	// Şerit offset'ini hedef değere doğru yumuşakça yaklaştır
-	if (!FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset))
+	// Şerit değiştiremeyen archetype: offset doğrudan hedefe eşitlenir (yerleştirme / uzak alandan dönüş)
+	if (!PolicyType::Has(*this, ETrafficCapability::LaneChange))
 	{
-		float OffsetDelta = FMath::Sign(TargetLaneOffset - CurrentLaneOffset) * LaneChangeSpeed * DeltaTime;
+		CurrentLaneOffset = TargetLaneOffset;
+	}
+	// Sollama: offset seçilen adayın yanal profilini, hedef hız hız profilini izler (yan sensör engel görüyorsa profil bekler)
+	else if (OvertakeManeuver.IsActive())
+	{
+		if (!bLaneChangeSideBlocked)
+		{
+			OvertakeManeuver.Elapsed += DeltaTime;
+		}
+
+		TargetSpeed = FMath::Min(TargetSpeed, OvertakeManeuver.GetSpeedLimit());
+
+		if (OvertakeManeuver.Elapsed >= OvertakeManeuver.Duration)
+		{
+			CurrentLaneOffset = TargetLaneOffset;
+			OvertakeManeuver = FTrafficOvertakeManeuver();
+		}
+		else
+		{
+			CurrentLaneOffset = OvertakeManeuver.GetOffset();
+		}
+	}
+	// Şerit offset'ini hedef değere doğru yumuşakça yaklaştır (yan sensör engel görüyorsa bekle)
+	else if (!bLaneChangeSideBlocked && !FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset))
+	{
+		float OffsetDelta = FMath::Sign(TargetLaneOffset - CurrentLaneOffset) * GetLaneChangeSpeed() * DeltaTime;
 		float NewOffset = CurrentLaneOffset + OffsetDelta;
 		
 		// Hedef değere ulaşıldıysa clamp et
@@ -64,24 +373,176 @@ void AVehicleAIController::Tick(float DeltaTime)
 		{
 			CurrentLaneOffset = NewOffset;
 		}
+	}
+
+	// Manevra offset'i bekliyorsa olayı bildir (askıdaki manevra sadece bu olayla devam eder)
+	if (TrafficSubsystem && ManeuverSlot != INDEX_NONE && !OvertakeManeuver.IsActive() && FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset))
+	{
+		TrafficSubsystem->SignalManeuver(this, ETrafficManeuverWait::OffsetReached);
+	}
+
+	// Sollama planlaması subsystem'de toplu yapılır (sonuç bir sonraki karede uygulanır)
+	if (PolicyType::Has(*this, ETrafficCapability::LaneChange))
+	{
+		UpdateOvertaking(DeltaTime, TrafficSubsystem);
+	}
 
-		// Şerit değiştirme durumunu güncelle
-		if (FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset))
+	// Davranış durumu (direksiyon ve yan sensör durum kovalarına göre ayrıca çalışır)
+	UpdateBehavior<PolicyType>();
+}
+
+template<typename PolicyType>
+void AVehicleAIController::UpdateBehavior()
+{
+	if (PolicyType::Has(*this, ETrafficCapability::Panic))
+	{
+		ApplyBehaviorEvent(bIsPanicking ? EVehicleBehaviorEvent::BeginPanic : EVehicleBehaviorEvent::EndPanic);
+	}
+
+	if (PolicyType::Has(*this, ETrafficCapability::LaneChange))
+	{
+		ApplyBehaviorEvent(FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset) ? EVehicleBehaviorEvent::EndLaneChange : EVehicleBehaviorEvent::BeginLaneChange);
+	}
+
+	// Durma nedeni: engel > ışık > öndeki araç
+	EVehicleBehaviorEvent MotionEvent = EVehicleBehaviorEvent::Move;
+	if (CurrentSpeed <= TrafficBehavior::StoppedSpeed)
+	{
+		if (bBlockedByObstacle)
 		{
-			CurrentVehicleBehavior = EVehicleBehavior::Normal;
+			MotionEvent = EVehicleBehaviorEvent::StopForObstacle;
+		}
+		else if (CurrentTrafficLightState != ETrafficLightState::Green)
+		{
+			MotionEvent = EVehicleBehaviorEvent::StopAtLight;
 		}
 		else
 		{
-			CurrentVehicleBehavior = EVehicleBehavior::LaneChanging;
+			MotionEvent = EVehicleBehaviorEvent::StopInQueue;
 		}
 	}
+	ApplyBehaviorEvent(MotionEvent);
+}
+
+void AVehicleAIController::ApplyBehaviorEvent(EVehicleBehaviorEvent Event)
+{
+	const EVehicleBehavior NewBehavior = TrafficBehavior::Transition(CurrentVehicleBehavior, Event);
+	if (NewBehavior != CurrentVehicleBehavior)
+	{
+		SetBehavior(NewBehavior);
+	}
+}
 
-	// Spline takip: direksiyon değerini güncelle (sonuç CurrentSteerValue olarak Vehicle'a iletilir)
-	UpdateSteering();
+void AVehicleAIController::SetBehavior(EVehicleBehavior NewBehavior)
+{
+	// Direksiyon güncellenmeyen durumda eski değer aracı yerinde döndürmesin
+	if (!TrafficBehavior::HasUpdate(NewBehavior, EVehicleBehaviorUpdate::Steering))
+	{
+		CurrentSteerValue = 0.0f;
+	}
+
+	// Yan sensör sonucu sadece şerit değiştirirken geçerli
+	if (!TrafficBehavior::HasUpdate(NewBehavior, EVehicleBehaviorUpdate::SideCheck))
+	{
+		bLaneChangeSideBlocked = false;
+	}
+
+	UWorld* World = GetWorld();
+	UTrafficSubsystem* TrafficSubsystem = World && BehaviorBucketIndex != INDEX_NONE ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (TrafficSubsystem)
+	{
+		TrafficSubsystem->MoveToBehaviorBucket(this, NewBehavior);
+	}
+	else
+	{
+		CurrentVehicleBehavior = NewBehavior;
+	}
+}
+
+void AVehicleAIController::UpdateLaneChangeSideCheck()
+{
+	// Pozitif offset = sağa
+	bLaneChangeSideBlocked = !IsSidePathClear(TargetLaneOffset > CurrentLaneOffset);
+}
+
+void AVehicleAIController::UpdateOvertaking(float DeltaTime, UTrafficSubsystem* TrafficSubsystem)
+{
+	OvertakeRetryTimer -= DeltaTime;
+
+	// Şeride bağlı, hareket halinde ve şerit değiştirmiyorken (ışıkta, kuyrukta veya panikte sollama yok)
+	if (!TrafficSubsystem || !IsLaneBound() || bIsPanicking || bOvertakePlanPending || OvertakeRetryTimer > 0.0f || ManeuverSlot != INDEX_NONE
+		|| OvertakeManeuver.IsActive() || !FMath::IsNearlyEqual(CurrentLaneOffset, TargetLaneOffset)
+		|| CurrentSpeed <= TrafficBehavior::StoppedSpeed || CurrentTrafficLightState != ETrafficLightState::Green)
+	{
+		return;
+	}
+
+	if (!bHasOvertakeReturn && GetArchetype().OvertakeSpeedRatio <= 0.0f)
+	{
+		return;
+	}
+
+	OvertakeRetryTimer = TrafficSubsystem->GetOvertakeRetryInterval();
+	bOvertakePlanPending = TrafficSubsystem->RequestOvertakePlan(this);
+}
+
+void AVehicleAIController::BeginOvertake(const FTrafficOvertakeManeuver& Maneuver, bool bReturn)
+{
+	// Sollamada eski şerit hatırlanır, dönüşte unutulur
+	bHasOvertakeReturn = !bReturn;
+	if (!bReturn)
+	{
+		OvertakeReturnOffset = Maneuver.StartOffset;
+	}
+
+	OvertakeManeuver = Maneuver;
+	TargetLaneOffset = Maneuver.TargetOffset;
+}
+
+template<typename PolicyType>
+void AVehicleAIController::UpdateGroup(TArrayView<AVehicleAIController* const> Group, float DeltaTime, UTrafficSubsystem* TrafficSubsystem)
+{
+	for (AVehicleAIController* Controller : Group)
+	{
+		Controller->UpdateDriving<PolicyType>(DeltaTime, TrafficSubsystem);
+	}
+}
+
+AVehicleAIController::FUpdateGroupFunction AVehicleAIController::GetUpdateGroupFunction(uint8 Capabilities, bool bGeneric)
+{
+	// Her yetenek kümesi için ayrı derlenmiş döngü (indeks = ETrafficCapability maskesi)
+	static const FUpdateGroupFunction Variants[TrafficUpdatePolicy::NumVariants] =
+	{
+		&UpdateGroup<TTrafficUpdatePolicy<0>>,
+		&UpdateGroup<TTrafficUpdatePolicy<1>>,
+		&UpdateGroup<TTrafficUpdatePolicy<2>>,
+		&UpdateGroup<TTrafficUpdatePolicy<3>>,
+		&UpdateGroup<TTrafficUpdatePolicy<4>>,
+		&UpdateGroup<TTrafficUpdatePolicy<5>>,
+		&UpdateGroup<TTrafficUpdatePolicy<6>>,
+		&UpdateGroup<TTrafficUpdatePolicy<7>>,
+		&UpdateGroup<TTrafficUpdatePolicy<8>>,
+		&UpdateGroup<TTrafficUpdatePolicy<9>>,
+		&UpdateGroup<TTrafficUpdatePolicy<10>>,
+		&UpdateGroup<TTrafficUpdatePolicy<11>>,
+		&UpdateGroup<TTrafficUpdatePolicy<12>>,
+		&UpdateGroup<TTrafficUpdatePolicy<13>>,
+		&UpdateGroup<TTrafficUpdatePolicy<14>>,
+		&UpdateGroup<TTrafficUpdatePolicy<15>>,
+	};
+
+	if (bGeneric)
+	{
+		return &UpdateGroup<FTrafficGenericUpdatePolicy>;
+	}
+
+	return Variants[Capabilities & (TrafficUpdatePolicy::NumVariants - 1)];
 }
 
 float AVehicleAIController::CalculateBrakingDistance() const
 {
+	const float MaxBrakingDeceleration = GetMaxBrakingDeceleration();
+
 	// Sıfıra bölme hatasını önlemek için kontrol
 	// MaxBrakingDeceleration 0 veya çok küçük bir değerse, duruş mesafesi hesaplanamaz
 	if (FMath::IsNearlyZero(MaxBrakingDeceleration))
@@ -121,6 +582,39 @@ float AVehicleAIController::CalculateBrakingDistance() const
 }
 
 bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
+{
+	return EvaluateForwardPath<FTrafficGenericUpdatePolicy>(OutHitResult);
+}
+
+bool AVehicleAIController::TraceForwardSkippingLaneVehicles(UWorld* World, const FVector& StartLocation, const FVector& EndLocation, FHitResult& OutHitResult)
+{
+	// Pawn isabetleri örtüşme olarak mesafeye göre sıralı gelir, blok eden isabet en sondadır
+	ForwardTraceHits.Reset();
+	World->LineTraceMultiByChannel(ForwardTraceHits, StartLocation, EndLocation, ECC_Visibility, TraceParams, TraceResponseParams);
+
+	for (const FHitResult& Hit : ForwardTraceHits)
+	{
+		// Şeride bağlı AI araçları şerit kuyruğunda ve doluluk ızgarasında takip edilir;
+		// oyuncu aracı, yayalar ve şeride bağlı olmayan araçlar engeldir
+		if (!Hit.bBlockingHit && IsLaneBound())
+		{
+			const APawn* HitPawn = Cast<APawn>(Hit.GetActor());
+			const AVehicleAIController* HitController = HitPawn ? Cast<AVehicleAIController>(HitPawn->GetController()) : nullptr;
+			if (HitController && HitController->IsLaneBound())
+			{
+				continue;
+			}
+		}
+
+		OutHitResult = Hit;
+		return true;
+	}
+
+	return false;
+}
+
+template<typename PolicyType>
+bool AVehicleAIController::EvaluateForwardPath(FHitResult& OutHitResult)
 {
 	// Pawn kontrolü - eğer kontrol edilen bir pawn yoksa false döndür
 	APawn* ControlledPawn = GetPawn();
@@ -136,34 +630,43 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 		return false;
 	}
 
+	// Paylaşılan archetype + sürücü varyansı
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+	const float MaxSpeed = GetMaxSpeed();
+
+	// Panik yeteneği olmayan varyantlarda panik dalları derlenmez
+	const bool bPanicking = PolicyType::Has(*this, ETrafficCapability::Panic) && bIsPanicking;
+
+	// Engel nedeniyle durma bilgisi her taramada yeniden belirlenir
+	bBlockedByObstacle = false;
+	bForwardPathFollowing = false;
+
 	// Araç yön vektörünü ve konumunu al
 	FVector ForwardVector = ControlledPawn->GetActorForwardVector();
 	FVector StartLocation = ControlledPawn->GetActorLocation();
 	
 	// DetectionDistance mesafesinde bir nokta hesapla (Öklid mesafesi)
-	FVector EndLocation = StartLocation + (ForwardVector * DetectionDistance);
-
-	// LineTrace parametrelerini ayarla
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(ControlledPawn); // Kendi aracımızı ignore et
-	QueryParams.bTraceComplex = false; // Basit collision kullan (performans için)
-	QueryParams.bReturnPhysicalMaterial = false; // Fiziksel materyal bilgisine ihtiyacımız yok
+	FVector EndLocation = StartLocation + (ForwardVector * Archetype.DetectionDistance);
 
 	// LineTraceSingleByChannel kullanarak önümüzdeki engelleri tara
 	// ECC_Visibility channel'ı görünür nesneleri algılar
-	bool bHit = World->LineTraceSingleByChannel(
-		OutHitResult,
-		StartLocation,
-		EndLocation,
-		ECC_Visibility, // Collision channel: görünür nesneler
-		QueryParams
-	);
+	// (ACC yoksa Pawn'lar örtüşme olarak döner, şeride bağlı araçlar elenir)
+	bool bHit = PolicyType::Has(*this, ETrafficCapability::AdaptiveCruise)
+		? World->LineTraceSingleByChannel(
+			OutHitResult,
+			StartLocation,
+			EndLocation,
+			ECC_Visibility, // Collision channel: görünür nesneler
+			TraceParams, // OnPossess'te kurulan paylaşılan parametreler (kendi aracımız yoksayılır)
+			TraceResponseParams)
+		: TraceForwardSkippingLaneVehicles(World, StartLocation, EndLocation, OutHitResult);
 
 	// Eğer hiçbir şey algılanmadıysa, engel yok demektir - maksimum hıza dön
 	if (!bHit)
 	{
 		TargetSpeed = MaxSpeed;
 		CurrentTrafficLightState = ETrafficLightState::Green;
+		bHornArmed = true; // Yol açık - korna kapısını yeniden aç
 		return false;
 	}
 
@@ -180,7 +683,7 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 	// DotProductThreshold'dan büyükse, engel rotamızda demektir
 	// Sadece tam önündeki engeller için dur (DotProductThreshold kontrolü)
 	
-	bool bObstacleInPath = DotProduct > DotProductThreshold;
+	bool bObstacleInPath = DotProduct > Archetype.DotProductThreshold;
 
 	// Eğer engel rotamızda ise (tam önümüzde), trafik ışığı kontrolü yap
 	if (bObstacleInPath)
@@ -189,12 +692,18 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 		AActor* HitActor = OutHitResult.GetActor();
 		
 		// Cast<ATrafficLight> ile trafik ışığı olup olmadığını kontrol et
-		ATrafficLight* TrafficLight = Cast<ATrafficLight>(HitActor);
+		// (sinyal farkındalığı olmayan varyantta ışık sıradan engeldir, cast yok)
+		ATrafficLight* TrafficLight = PolicyType::Has(*this, ETrafficCapability::SignalAware) ? Cast<ATrafficLight>(HitActor) : nullptr;
 		
-		if (TrafficLight)
+		if (TrafficLight && IsLaneBound())
+		{
+			// Şeride bağlı araç: ışık ApplySignalLookahead ile değerlendirilir, ışın engel saymaz
+			TargetSpeed = MaxSpeed;
+		}
+		else if (TrafficLight)
 		{
 			// Panik sistemi: Eğer panik modundaysa trafik ışıklarını görmezden gel
-			if (bIsPanicking)
+			if (bPanicking)
 			{
 				// Panik modunda trafik ışığını görmezden gel, maksimum hıza devam et
 				TargetSpeed = MaxSpeed;
@@ -223,19 +732,25 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 		{
 			// Trafik ışığı değil, engel kontrolü yap
 			// ACC (Adaptive Cruise Control): Öndeki araç kontrolü
-			AVehicle* FrontVehicle = Cast<AVehicle>(HitActor);
+			// (ACC olmayan varyantta kalan Pawn isabetleri - oyuncu, yaya - sıradan engeldir)
+			AVehicle* FrontVehicle = PolicyType::Has(*this, ETrafficCapability::AdaptiveCruise) ? Cast<AVehicle>(HitActor) : nullptr;
 			
 			if (FrontVehicle)
 			{
 				// Öndeki araç ile mesafeyi hesapla
 				float DistanceToFrontVehicle = FVector::Dist(StartLocation, OutHitResult.ImpactPoint);
 				
+				// Öndeki aracın AI Controller'ını al
+				AVehicleAIController* FrontVehicleController = Cast<AVehicleAIController>(FrontVehicle->GetController());
+
+				// Aynı şeritteki lider kuyruk kernelinde takip edilir (boşluk ve yaklaşma hızı ile)
+				if (IsLaneBound() && FrontVehicleController && FrontVehicleController->LaneId == LaneId)
+				{
+					TargetSpeed = MaxSpeed;
+				}
 				// Güvenli takip mesafesinden azsa, öndeki aracın hızına eşitle
-				if (DistanceToFrontVehicle < SafeFollowingDistance)
+				else if (DistanceToFrontVehicle < GetSafeFollowingDistance())
 				{
-					// Öndeki aracın AI Controller'ını al
-					AVehicleAIController* FrontVehicleController = Cast<AVehicleAIController>(FrontVehicle->GetController());
-					
 					if (FrontVehicleController)
 					{
 						// Öndeki aracın hızını al ve hedef hız olarak ayarla
@@ -246,6 +761,9 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 						// AI Controller yoksa, öndeki aracın hızını tahmin et veya dur
 						TargetSpeed = FMath::Max(0.0f, CurrentSpeed * 0.8f); // Yavaşla
 					}
+
+					// Hedef hız öndeki aracın bu karedeki hızına bağlı - tarama atlanmaz
+					bForwardPathFollowing = true;
 				}
 				else
 				{
@@ -255,8 +773,10 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 			}
 			else
 			{
-				// Araç değil, normal engel - dur
+				// Araç değil, normal engel - dur ve korna çal (DoOnce)
 				TargetSpeed = 0.0f;
+				bBlockedByObstacle = true;
+				PlayHorn();
 			}
 		}
 	}
@@ -265,11 +785,151 @@ bool AVehicleAIController::CheckForwardPath(FHitResult& OutHitResult)
 		// Engel yok veya rotamızda değil - maksimum hıza dön
 		TargetSpeed = MaxSpeed;
 		CurrentTrafficLightState = ETrafficLightState::Green; // Durumu güncelle
+		bHornArmed = true;
 	}
 
 	return bObstacleInPath;
 }
 
+bool AVehicleAIController::CanReuseForwardPath(float DeltaTime, float MaxInterval, UTrafficSubsystem* TrafficSubsystem)
+{
+	// Son taramadan beri katedilen yol (bu karenin hareketi ile)
+	ForwardTraceTravel += CurrentSpeed * DeltaTime;
+	ForwardTraceElapsed += DeltaTime;
+	ForwardTraceTimer -= DeltaTime;
+
+	if (MaxInterval <= 0.0f || ForwardTraceTimer <= 0.0f || bForwardPathFollowing || bIsPanicking != bForwardTracePanicking)
+	{
+		return false;
+	}
+
+	// Araç döndüyse ışın başka yöne bakar
+	const APawn* ControlledPawn = GetPawn();
+	if (!ControlledPawn || FVector::DotProduct(ControlledPawn->GetActorForwardVector().GetSafeNormal2D(), ForwardTraceDirection) < ForwardTraceHeadingTolerance)
+	{
+		return false;
+	}
+
+	// Garanti: kalan açıklık (engel de yaklaşıyor) bu karenin yolu + şimdiki duruş mesafesinden
+	// büyük olmalı, yoksa engel bir sonraki karede fren mesafesinin içine girebilir
+	const float RemainingClearance = ForwardTraceClearance - ForwardTraceTravel - ForwardTraceClosingSpeed * ForwardTraceElapsed;
+	if (RemainingClearance <= CalculateBrakingDistance() + (CurrentSpeed + ForwardTraceClosingSpeed) * DeltaTime + StopLineTolerance)
+	{
+		return false;
+	}
+
+	if (!TrafficSubsystem)
+	{
+		return true;
+	}
+
+	// Doluluk ızgarasında olmayan oyuncu / dış pawn açıklığa girdiyse (veya girebilecekse) hemen tara
+	if (TrafficSubsystem->IsExternalPawnAhead(this, ForwardTraceClearance - ForwardTraceTravel))
+	{
+		return false;
+	}
+
+	// Işın aralıklarında şeride giren araç (birleşme, şerit değiştirme): doluluk ızgarasından
+	return TrafficSubsystem->CountOccupantsAhead(this, RemainingClearance) <= ForwardTraceEntrants;
+}
+
+void AVehicleAIController::ScheduleForwardTrace(const FHitResult& HitResult, float MaxInterval, UTrafficSubsystem* TrafficSubsystem)
+{
+	const APawn* ControlledPawn = GetPawn();
+	const FTrafficArchetypeParams& Archetype = GetArchetype();
+
+	ForwardTraceClearance = HitResult.bBlockingHit ? HitResult.Distance : Archetype.DetectionDistance;
+	ForwardTraceTravel = 0.0f;
+	ForwardTraceElapsed = 0.0f;
+	ForwardTraceDirection = ControlledPawn ? ControlledPawn->GetActorForwardVector().GetSafeNormal2D() : FVector::ZeroVector;
+	ForwardPathTargetSpeed = TargetSpeed;
+	bForwardTracePanicking = bIsPanicking;
+
+	// Engelin bize doğru hız bileşeni (karşıdan gelen araç, yaya); duran veya uzaklaşan engel 0.
+	// Işın boşsa açıklığın ucundan görünmeyen bir engelin varsayılan hızla yaklaştığı kabul edilir
+	const AActor* HitActor = HitResult.bBlockingHit ? HitResult.GetActor() : nullptr;
+	if (HitActor)
+	{
+		ForwardTraceClosingSpeed = FMath::Max(0.0f, -FVector::DotProduct(HitActor->GetVelocity(), ForwardTraceDirection));
+	}
+	else
+	{
+		ForwardTraceClosingSpeed = TrafficSubsystem ? TrafficSubsystem->GetForwardTraceAssumedClosingSpeed() : GetDefault<UTrafficSubsystem>()->GetForwardTraceAssumedClosingSpeed();
+	}
+
+	// Duruş mesafesi üstündeki pay: araç bu payı şimdiki hızdan en büyük ivmeyle hızlanarak ve
+	// engel yaklaşırken tüketene kadar yeniden bakmaya gerek yok ((v + c)*t + a*t²/2 = pay);
+	// pay yoksa her karede taranır
+	const float Margin = ForwardTraceClearance - CalculateBrakingDistance() - StopLineTolerance;
+	if (Margin <= 0.0f || MaxInterval <= 0.0f)
+	{
+		ForwardTraceTimer = 0.0f;
+		return;
+	}
+
+	ForwardTraceEntrants = TrafficSubsystem ? TrafficSubsystem->CountOccupantsAhead(this, ForwardTraceClearance) : 0;
+
+	const float ApproachSpeed = CurrentSpeed + ForwardTraceClosingSpeed;
+	const float Acceleration = Archetype.CarFollowing.MaxAcceleration;
+	const float TimeToMargin = Acceleration > KINDA_SMALL_NUMBER
+		? (FMath::Sqrt(FMath::Square(ApproachSpeed) + 2.0f * Acceleration * Margin) - ApproachSpeed) / Acceleration
+		: Margin / FMath::Max(ApproachSpeed, KINDA_SMALL_NUMBER);
+
+	ForwardTraceTimer = FMath::Min(TimeToMargin, MaxInterval);
+}
+
+void AVehicleAIController::ApplySignalLookahead(float DeltaTime, UTrafficSubsystem* TrafficSubsystem)
+{
+	// Panik modunda trafik ışıkları görmezden gelinir
+	if (bIsPanicking)
+	{
+		CurrentTrafficLightState = ETrafficLightState::Green;
+		return;
+	}
+
+	FTrafficSignalLookahead Lookahead;
+	if (!TrafficSubsystem || !TrafficSubsystem->FindNextSignal(LaneId, DistanceAlongLane, CurrentSpeed, Lookahead))
+	{
+		// Önde sinyal yok
+		CurrentTrafficLightState = ETrafficLightState::Green;
+		return;
+	}
+
+	CurrentTrafficLightState = Lookahead.StateAtArrival;
+
+	// Aracın ön tamponu çizgide dursun
+	const float DistanceToStop = Lookahead.Distance - GetArchetype().CarFollowing.VehicleLength * 0.5f;
+	const float BrakingDistance = CalculateBrakingDistance();
+
+	// Çizgide bekleyen araç: ışık şu an yeşil değilse bekle (varışta yeşil olacak olsa bile çizgiyi geçme)
+	if (DistanceToStop <= StopLineTolerance)
+	{
+		if (Lookahead.CurrentState != ETrafficLightState::Green && BrakingDistance <= DistanceToStop + StopLineTolerance)
+		{
+			TargetSpeed = 0.0f;
+		}
+		return;
+	}
+
+	// Varışta yeşil: durmaya gerek yok
+	if (Lookahead.StateAtArrival == ETrafficLightState::Green)
+	{
+		return;
+	}
+
+	// İkilem bölgesi: sarıda artık duramayacak kadar yakınsa devam et
+	if (Lookahead.CurrentState == ETrafficLightState::Yellow && BrakingDistance > DistanceToStop + StopLineTolerance)
+	{
+		return;
+	}
+
+	// Frenleme tam duruş mesafesinde başlar (bir karelik yol payı ile)
+	if (DistanceToStop <= BrakingDistance + CurrentSpeed * DeltaTime + StopLineTolerance)
+	{
+		TargetSpeed = 0.0f;
+	}
+}
+
 float AVehicleAIController::SmoothSpeedTransition(float DeltaTime, float TransitionSpeed)
 {
 	// Linear Interpolation (Lerp) formülü:
@@ -318,8 +978,11 @@ float AVehicleAIController::UpdateSteering()
 	float ClosestInputKey = TargetSpline->FindInputKeyClosestToWorldLocation(VehicleLocation);
 	float ClosestDistance = TargetSpline->GetDistanceAlongSplineAtSplineInputKey(ClosestInputKey);
 
+	// Şerit kuyruğu kerneli için mesafeyi sakla
+	DistanceAlongLane = ClosestDistance;
+
 	// Bu mesafeye LookAheadDistance ekleyerek hedef mesafeyi belirle
-	float TargetDistance = ClosestDistance + LookAheadDistance;
+	float TargetDistance = ClosestDistance + GetArchetype().LookAheadDistance;
 
 	// Spline sonunu aşmayacak şekilde clamp et
 	if (TargetDistance > SplineLength)
@@ -338,6 +1001,12 @@ float AVehicleAIController::UpdateSteering()
 	// Pozitif offset = sağa, Negatif offset = sola
 	TargetPoint = TargetPoint + (SplineRightVector * CurrentLaneOffset);
 
+	// Panik: hedef, kaçış yönünün şeride dik bileşeni kadar tehditten uzağa kayar (tehdit tam öndeyse/arkadaysa kayma yok)
+	if (bIsPanicking && !PanicEscapeDirection.IsNearlyZero())
+	{
+		TargetPoint += SplineRightVector * (FVector::DotProduct(PanicEscapeDirection, SplineRightVector) * PanicSwerveDistance);
+	}
+
 	// Direksiyon matematiği:
 	// Araçtan hedef noktaya giden yön vektörünü hesapla (TargetDirection)
 	FVector TargetDirection = (TargetPoint - VehicleLocation).GetSafeNormal();
@@ -366,6 +1035,14 @@ bool AVehicleAIController::IsSidePathClear(bool bCheckRight)
 		return false;
 	}
 
+	// Kayıtlı araçlar önce paylaşılan doluluk tahminini okur (kısa ufuk dahil). Izgarada sadece
+	// kayıtlı controller'lar var: boş çıkarsa oyuncu aracı, yayalar ve kayıtsız Pawn'lar için ışın atılır
+	UTrafficSubsystem* TrafficSubsystem = World->GetSubsystem<UTrafficSubsystem>();
+	if (TrafficSubsystem && RegistryIndex != INDEX_NONE && TrafficSubsystem->IsSideLaneOccupied(this, bCheckRight))
+	{
+		return false;
+	}
+
 	// Aracın konumu ve yön vektörleri
 	FVector VehicleLocation = ControlledPawn->GetActorLocation();
 	FVector ForwardVector = ControlledPawn->GetActorForwardVector();
@@ -381,20 +1058,13 @@ bool AVehicleAIController::IsSidePathClear(bool bCheckRight)
 	FVector SideStartLocation = VehicleLocation + (ForwardVector * 100.0f); // Biraz önde başla
 	FVector SideEndLocation = SideStartLocation + (SideDirection * SideSensorDistance);
 
-	// LineTrace parametreleri
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(ControlledPawn); // Kendi aracımızı ignore et
-	QueryParams.bTraceComplex = false;
-	QueryParams.bReturnPhysicalMaterial = false;
-
 	// Yan tarafta engel var mı kontrol et
-	FHitResult SideHitResult;
-	bool bHit = World->LineTraceSingleByChannel(
-		SideHitResult,
+	// Sadece çarpışma olup olmadığı gerekli - FHitResult doldurulmaz, parametreler paylaşılan
+	bool bHit = World->LineTraceTestByChannel(
 		SideStartLocation,
 		SideEndLocation,
 		ECC_Visibility,
-		QueryParams
+		TraceParams
 	);
 
 	// Eğer çarpışma varsa yol kapalı demektir
@@ -403,39 +1073,57 @@ bool AVehicleAIController::IsSidePathClear(bool bCheckRight)
 
 void AVehicleAIController::PlayHorn()
 {
-	// Korna sesini çal
-	// Şimdilik sadece tanım olarak bırakılmıştır
-	// UAudioComponent implementasyonu eklendiğinde burada ses çalınacak
-	
-	if (HornAudioComponent)
+	// DoOnce: yol açılana kadar tekrar çalma
+	if (!bHornArmed || !HornSound)
 	{
-		// Audio component varsa ses çal
-		// HornAudioComponent->Play();
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	APawn* ControlledPawn = GetPawn();
+	if (!World || !ControlledPawn)
+	{
+		return;
+	}
+
+	// Bekleme süresi dolmadıysa çalma
+	const float CurrentTime = World->GetTimeSeconds();
+	if (CurrentTime - LastHornTime < HornCooldown)
+	{
+		return;
+	}
+
+	bHornArmed = false;
+	LastHornTime = CurrentTime;
+
+	// Ortak ses havuzuna istek gönder (kanal, dinleyici mesafesi ve aciliyete göre atanır)
+	if (UTrafficAudioSubsystem* AudioSubsystem = World->GetSubsystem<UTrafficAudioSubsystem>())
+	{
+		AudioSubsystem->RequestSound(HornSound, ControlledPawn, bIsPanicking ? HornUrgency * 2.0f : HornUrgency);
 	}
-	
-	// Debug mesajı (isteğe bağlı)
-	// UE_LOG(LogTemp, Log, TEXT("Horn played!"));
 }
 
 void AVehicleAIController::OnWeaponFireDetected()
 {
+	// Panik yeteneği olmayan archetype (ör. otobüs) etkilenmez
+	if (!(GetCapabilities() & (uint8)ETrafficCapability::Panic))
+	{
+		return;
+	}
+
 	// Silah ateşi algılandı - panik modunu aktif et
-	bIsPanicking = true;
-	
-	// Mevcut timer'ı iptal et (eğer varsa)
+	// Bitiş, controller başına timer yerine paylaşılan çarkta tutulur (tekrar çağrı süreyi yeniler)
 	UWorld* World = GetWorld();
-	if (World)
+	UTrafficSubsystem* TrafficSubsystem = World ? World->GetSubsystem<UTrafficSubsystem>() : nullptr;
+	if (TrafficSubsystem)
 	{
-		World->GetTimerManager().ClearTimer(PanicTimerHandle);
-		
-		// 10 saniye sonra panik modunu kapat
-		World->GetTimerManager().SetTimer(
-			PanicTimerHandle,
-			this,
-			&AVehicleAIController::DisablePanicMode,
-			10.0f,
-			false // Tekrar eden değil, bir kez çalışacak
-		);
+		// Süre DefaultPanicDuration ayarından
+		TrafficSubsystem->StartPanic(this);
+	}
+	else
+	{
+		bIsPanicking = true;
+		PanicEndTime = (World ? World->GetTimeSeconds() : 0.0f) + GetDefault<UTrafficSubsystem>()->GetDefaultPanicDuration();
 	}
 }
 
@@ -443,4 +1131,5 @@ void AVehicleAIController::DisablePanicMode()
 {
 	// Panik modunu kapat
 	bIsPanicking = false;
+	PanicEscapeDirection = FVector::ZeroVector;
 }
@@ -4,10 +4,16 @@
 #include "AIController.h"
 #include "Engine/Engine.h"
 #include "Components/SplineComponent.h"
-#include "Components/AudioComponent.h"
 #include "TimerManager.h"
+#include "CollisionQueryParams.h"
+#include "CarFollowingModel.h"
+#include "TrafficArchetype.h"
+#include "TrafficUpdatePolicy.h"
+#include "TrafficOvertakePlanner.h"
 #include "VehicleAIController.generated.h"
 
+class UTrafficSubsystem;
+
 /**
  * Trafik ışığı durumlarını temsil eden enum.
  * Trafik ışığı sisteminde kullanılacak durumları tanımlar.
@@ -22,16 +28,21 @@ enum class ETrafficLightState : uint8
 
 /**
  * Araç davranış durumlarını temsil eden enum.
- * Araçların mevcut durumunu belirler (normal sürüş, bekleme, şerit değiştirme).
+ * Geçişler TrafficBehavior::Transitions tablosu ile yapılır (TrafficBehavior.h).
  */
 UENUM(BlueprintType)
 enum class EVehicleBehavior : uint8
 {
 	Normal		UMETA(DisplayName = "Normal"),
 	Waiting		UMETA(DisplayName = "Waiting"),
-	LaneChanging	UMETA(DisplayName = "Lane Changing")
+	LaneChanging	UMETA(DisplayName = "Lane Changing"),
+	StoppedAtLight	UMETA(DisplayName = "Stopped At Light"),
+	Queued		UMETA(DisplayName = "Queued"),
+	Panicking	UMETA(DisplayName = "Panicking")
 };
 
+enum class EVehicleBehaviorEvent : uint8;
+
 /**
  * Araç AI kontrolcüsü sınıfı.
  * AAIController'dan türeyen bu sınıf, araçların otomatik kontrolü için
@@ -49,27 +60,35 @@ public:
 	virtual void Tick(float DeltaTime) override;
 
 protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	// Called when the controller is removed from the world
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Called when the controller takes control of a pawn (archetype araçtan alınır)
+	virtual void OnPossess(APawn* InPawn) override;
+
+	// Called when the controller releases its pawn
+	virtual void OnUnPossess() override;
+
 	// ============================================
-	// ALGILAMA (PERCEPTION) DEĞİŞKENLERİ
+	// ARCHETYPE
 	// ============================================
-	
+
 	/**
-	 * Önündeki engelleri algılamak için kullanılan maksimum algılama mesafesi.
-	 * Öklid mesafesi (Euclidean Distance) kullanılarak aracın önündeki nesnelerin
-	 * uzaklığını ölçmek için kullanılır. LineTrace işlemlerinde bu mesafe
-	 * içindeki nesneler algılanır.
+	 * Sürücü / araç archetype'ının FTrafficArchetypeTable indeksi.
+	 * Algılama mesafesi, maksimum hız, frenleme, ileri bakış, şerit değiştirme hızı,
+	 * takip mesafesi ve IDM parametreleri araç başına değil, archetype başına tutulur.
+	 * Possess edilen AVehicle'ın Archetype'ından alınır.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception", meta = (ClampMin = "0.0"))
-	float DetectionDistance;
+	uint16 ArchetypeIndex;
 
 	/**
-	 * Engelin rotamızda olup olmadığını anlamak için kullanılan eşik değeri.
-	 * Dot Product (nokta çarpım) hesaplamasında kullanılır. Araç yön vektörü ile
-	 * engel yön vektörü arasındaki açıyı kontrol eder. Değer 1.0'a yakınsa engel
-	 * tam önümüzde, 0.0'a yakınsa yanımızda demektir.
+	 * Sürücü başına varyans (archetype değerlerinden küçük sapmalar).
+	 * TrafficId atandığında kimlikten üretilir.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Perception", meta = (ClampMin = "-1.0", ClampMax = "1.0"))
-	float DotProductThreshold;
+	FTrafficDriverVariance DriverVariance;
 
 	// ============================================
 	// KİNEMATİK DEĞİŞKENLER
@@ -91,22 +110,6 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Kinematics", meta = (ClampMin = "0.0"))
 	float TargetSpeed;
 
-	/**
-	 * Aracın maksimum hızı (m/s veya cm/s).
-	 * Yeşil ışıkta veya engel yokken TargetSpeed bu değere ayarlanır.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Kinematics", meta = (ClampMin = "0.0"))
-	float MaxSpeed;
-
-	/**
-	 * Maksimum frenleme gücü (negatif ivme, m/s² veya cm/s²).
-	 * Kinematik formül: v² = u² + 2as
-	 * Burada 'a' negatif değer (frenleme) olarak kullanılır.
-	 * CalculateBrakingDistance fonksiyonunda durma mesafesi hesaplamak için kullanılır.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Kinematics", meta = (ClampMax = "0.0"))
-	float MaxBrakingDeceleration;
-
 	// ============================================
 	// TRAFİK IŞIĞI DURUMU
 	// ============================================
@@ -130,14 +133,6 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Path")
 	USplineComponent* TargetSpline;
 
-	/**
-	 * Takip mesafesi (birim).
-	 * Aracın önündeki hangi noktaya bakacağını belirler.
-	 * Spline üzerinde en yakın noktadan itibaren bu kadar ileriye bakılır.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spline Path", meta = (ClampMin = "1.0"))
-	float LookAheadDistance;
-
 	/**
 	 * UpdateSteering() tarafından hesaplanan güncel direksiyon değeri.
 	 * -1.0 = tam sol, 0.0 = düz, 1.0 = tam sağ.
@@ -153,10 +148,15 @@ protected:
 	/**
 	 * Aracın mevcut davranış durumu.
 	 * Normal: Normal sürüş modu
-	 * Waiting: Bekleme modu (trafik ışığı, engel vb.)
+	 * Waiting: Araç olmayan bir engel önünde bekleme
 	 * LaneChanging: Şerit değiştirme modu
+	 * StoppedAtLight: Kırmızı / sarı ışıkta bekleme
+	 * Queued: Öndeki araç nedeniyle bekleme
+	 * Panicking: Panik modu
+	 *
+	 * Sadece geçiş tablosu ile değişir (UTrafficSubsystem durum kovaları güncel kalsın).
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lane Changing")
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Behavior")
 	EVehicleBehavior CurrentVehicleBehavior;
 
 	/**
@@ -175,11 +175,11 @@ protected:
 	float TargetLaneOffset;
 
 	/**
-	 * Şerit değiştirme hızı (birim/saniye).
-	 * CurrentLaneOffset'in TargetLaneOffset'e ne kadar hızlı yaklaşacağını belirler.
+	 * Sinyal (-1 = sol, 0 = kapalı, 1 = sağ).
+	 * UTrafficSubsystem'in şerit değiştirme ve sollama manevraları yakar ve söndürür.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lane Changing", meta = (ClampMin = "0.0"))
-	float LaneChangeSpeed;
+	UPROPERTY(BlueprintReadOnly, Category = "Lane Changing")
+	int32 TurnSignal;
 
 	// ============================================
 	// PANİK SİSTEMİ
@@ -194,33 +194,163 @@ protected:
 	bool bIsPanicking;
 
 	/**
-	 * Panik modunu kapatmak için kullanılan timer handle.
-	 * OnWeaponFireDetected() çağrıldığında 10 saniye sonra panik modunu kapatır.
+	 * Kaçış yönü (tehditten araca doğru, yatay, birim vektör).
+	 * UTrafficSubsystem::BroadcastThreat tarafından tehdit noktasına göre hesaplanır.
+	 * Tehdit noktası bilinmiyorsa sıfır vektördür.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Panic System")
+	FVector PanicEscapeDirection;
+
+	/**
+	 * Panikte direksiyon hedefinin kaçış yönüne kaydırılma miktarı (cm).
+	 * Şerit offset'i değişmez; araç şeridinde kalırken tehditten uzak kenara yaslanır.
 	 */
-	FTimerHandle PanicTimerHandle;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Panic System", meta = (ClampMin = "0.0"))
+	float PanicSwerveDistance;
+
+	/**
+	 * Panik nesli. Her yeni panikte artar; paylaşılan timing wheel'deki
+	 * eski bitiş girdileri bu değerle karşılaştırılarak yok sayılır.
+	 */
+	uint32 PanicGeneration;
+
+	/**
+	 * Panik bitiş zamanı (dünya zamanı, saniye). Bölge devrinde kalan süre buradan hesaplanır.
+	 * Subsystem yoksa (çark yok) panik bu zamanda controller tarafından kapatılır.
+	 */
+	float PanicEndTime;
+
+	/**
+	 * UTrafficSubsystem genel controller kaydındaki indeks (INDEX_NONE = kayıtlı değil).
+	 */
+	int32 RegistryIndex;
+
+	/**
+	 * UTrafficSubsystem'deki davranış durum kovasındaki indeks (INDEX_NONE = kovada değil).
+	 */
+	int32 BehaviorBucketIndex;
+
+	/**
+	 * Çalışan manevranın FTrafficManeuverScheduler yuvası (INDEX_NONE = manevra yok).
+	 */
+	int32 ManeuverSlot;
+
+	/** Bu karede araç olmayan bir engel için duruldu mu (Waiting durumuna geçiş için). */
+	bool bBlockedByObstacle;
+
+	/** Şerit değiştirme yönündeki yan sensör engel algıladı mı (offset ilerlemez). */
+	bool bLaneChangeSideBlocked;
+
+	/** Aktif sollama manevrası (UTrafficSubsystem'in yörünge kafesi planlayıcısı seçer). */
+	FTrafficOvertakeManeuver OvertakeManeuver;
+
+	/** Sollama sonrası dönülecek şerit offset'i (bHasOvertakeReturn ise geçerli). */
+	float OvertakeReturnOffset;
+
+	/** Sollama tamamlandı, eski şeride dönüş planlanacak. */
+	bool bHasOvertakeReturn;
+
+	/** Sollanan liderin TrafficId'si (0 = bilinmiyor); dönüş lider geride kalınca planlanır. */
+	uint32 OvertakeLeaderId;
+
+	/** Planlama isteği subsystem kuyruğunda (sonuç bu karenin trafik adımında uygulanır). */
+	bool bOvertakePlanPending;
+
+	/** Bir sonraki planlama isteğine kalan süre (saniye). */
+	float OvertakeRetryTimer;
+
+	/** Son ön yol taramasında engele kalan mesafe (engel yoksa DetectionDistance). */
+	float ForwardTraceClearance;
+
+	/** Son taramadan beri katedilen yol (birim). */
+	float ForwardTraceTravel;
+
+	/** Son taramadan beri geçen süre (saniye). */
+	float ForwardTraceElapsed;
+
+	/** Son taramada çarpılan nesnenin bize yaklaşma hızı (cm/s, uzaklaşıyor veya duruyorsa 0). */
+	float ForwardTraceClosingSpeed;
+
+	/** Son taramada şerit penceresindeki (ön tampon - engel) doluluk ızgarası aracı sayısı. */
+	int32 ForwardTraceEntrants;
+
+	/** Bir sonraki zorunlu taramaya kalan süre (saniye). */
+	float ForwardTraceTimer;
+
+	/** Son taramanın yatay yönü (araç bundan fazla dönerse yeniden taranır). */
+	FVector ForwardTraceDirection;
+
+	/** Son taramanın belirlediği hedef hız (tarama atlanan karelerde TargetSpeed buradan başlar). */
+	float ForwardPathTargetSpeed;
+
+	/** Son tarama öndeki aracın hızını izliyor (ACC takip): karar her karede yenilenmeli. */
+	bool bForwardPathFollowing;
+
+	/** Son tarama panik modunda mı yapıldı (panik ışıkları yoksayar, değişince yeniden taranır). */
+	bool bForwardTracePanicking;
+
+	/**
+	 * Kalıcı araç kimliği (0 = atanmamış). UTrafficSubsystem tarafından atanır;
+	 * uzak alana inip tekrar spawn edilen araç aynı kimliği korur (kayıt, tekrar oynatma).
+	 */
+	uint32 TrafficId;
 
 	// ============================================
-	// HIZ SABİTLEME (ACC - ADAPTIVE CRUISE CONTROL)
+	// ŞERİT KUYRUĞU (CAR FOLLOWING)
 	// ============================================
 
 	/**
-	 * Güvenli takip mesafesi (birim).
-	 * Öndeki araçla mesafe bu değerden azsa, hızı öndeki aracın hızına eşitler.
-	 * ACC (Adaptive Cruise Control) sistemi için kullanılır.
+	 * Aracın kayıtlı olduğu şerit ID'si (UTrafficSubsystem).
+	 * INDEX_NONE ise araç şeride bağlı değildir ve SmoothSpeedTransition kullanılır.
+	 */
+	int32 LaneId;
+
+	/**
+	 * Spline üzerindeki mesafe (birim).
+	 * UpdateSteering() içinde en yakın nokta hesaplanırken güncellenir.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Car Following")
+	float DistanceAlongLane;
+
+	/**
+	 * Durma çizgisinde tolerans (birim).
+	 * Duran bir aracın çizgiye bu mesafeden daha fazla yaklaşmaya çalışmasını engeller.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ACC", meta = (ClampMin = "0.0"))
-	float SafeFollowingDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Traffic Light", meta = (ClampMin = "0.0"))
+	float StopLineTolerance;
 
 	// ============================================
 	// KORNA SİSTEMİ
 	// ============================================
 
 	/**
-	 * Korna sesi için kullanılan audio component.
-	 * PlayHorn() fonksiyonu bu component üzerinden ses çalar.
+	 * Korna sesi.
+	 * Araç kendi audio component'ini tutmaz; PlayHorn() sesi UTrafficAudioSubsystem'in
+	 * ortak ses havuzuna istek olarak gönderir.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Horn System")
+	class USoundBase* HornSound;
+
+	/**
+	 * İki korna arasındaki en kısa süre (saniye).
+	 * DoOnce kapısı yol açılınca sıfırlansa bile bu süre dolmadan tekrar korna çalınmaz.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Horn System", meta = (ClampMin = "0.0"))
+	float HornCooldown;
+
+	/**
+	 * Korna aciliyeti (ses havuzunda önceliği belirler). Panik modunda iki katına çıkar.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Horn System", meta = (ClampMin = "0.0"))
+	float HornUrgency;
+
+	/**
+	 * DoOnce kapısı: engel algılandığında korna bir kez çalar, yol açılana kadar tekrar çalmaz.
 	 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Horn System")
-	class UAudioComponent* HornAudioComponent;
+	bool bHornArmed;
+
+	/** Son korna zamanı (dünya zamanı, saniye). */
+	float LastHornTime;
 
 public:
 	// ============================================
@@ -252,7 +382,8 @@ public:
 	 *    DotProduct = ForwardVector · ToObstacleVector
 	 *    Eğer DotProduct > DotProductThreshold ise engel rotamızda
 	 * 3. Eğer engel bir ATrafficLight ise ve durumu Red veya Yellow ise,
-	 *    TargetSpeed'i 0'a çeker
+	 *    TargetSpeed'i 0'a çeker (şeride bağlı araçlarda ışıklar bunun yerine
+	 *    ApplySignalLookahead ile şerit indeksinden okunur)
 	 * 
 	 * @param OutHitResult LineTrace sonucunu döndüren parametre
 	 * @return Engelin algılanıp algılanmadığı (true = engel var)
@@ -262,6 +393,8 @@ public:
 
 	/**
 	 * Hızı hedef hıza (0 veya max) yaklaştıran Lerp tabanlı fonksiyon.
+	 * Şeride bağlı araçlarda kullanılmaz; onların hızı UTrafficSubsystem'in
+	 * araç takip kerneli ile hesaplanır.
 	 * 
 	 * Linear Interpolation (Lerp) formülü:
 	 * NewSpeed = CurrentSpeed + (TargetSpeed - CurrentSpeed) * Alpha
@@ -291,6 +424,8 @@ public:
 	/**
 	 * Yan taraftaki yolun açık olup olmadığını kontrol eden fonksiyon.
 	 * Şerit değiştirme öncesi güvenlik kontrolü için kullanılır.
+	 * UTrafficSubsystem'e kayıtlı araçlar ışın atmaz, paylaşılan doluluk tahminini okur
+	 * (yan şeritteki araçlar; yakın süre içinde yanımıza gelecekler dahil).
 	 * 
 	 * @param bCheckRight true = sağ tarafı kontrol et, false = sol tarafı kontrol et
 	 * @return true = yol açık (şerit değiştirilebilir), false = yol kapalı (engel var)
@@ -300,24 +435,209 @@ public:
 
 	/**
 	 * Korna sesini çalan fonksiyon.
-	 * UAudioComponent üzerinden ses çalar.
-	 * Şimdilik sadece tanım olarak bırakılmıştır.
+	 * DoOnce mantığı: engel başına bir kez çalar (yol açılınca kapı yeniden açılır)
+	 * ve HornCooldown dolmadan tekrar çalmaz. Ses, araç başına component yerine
+	 * UTrafficAudioSubsystem'in öncelikli ses havuzundan çalınır.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Horn System")
 	void PlayHorn();
 
 	/**
 	 * Silah ateşi algılandığında çağrılan fonksiyon.
-	 * Panik modunu aktif eder ve 10 saniye sonra otomatik olarak kapatır.
-	 * Dış etki (damage) sisteminde kullanılır.
+	 * Panik modunu aktif eder ve 10 saniye sonra otomatik olarak kapatır
+	 * (UTrafficSubsystem'in paylaşılan timing wheel'i ile; subsystem yoksa PanicEndTime ile).
+	 * Dış etki (damage) sisteminde kullanılır. Bir bölgedeki tüm araçlar için
+	 * UTrafficSubsystem::BroadcastThreat tercih edilmelidir.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Panic System")
 	void OnWeaponFireDetected();
 
+	/**
+	 * Aracın bir şeride bağlı olup olmadığını döndürür.
+	 * Şeride bağlı araçların hızı UTrafficSubsystem'deki kuyruk kerneli ile güncellenir.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Car Following")
+	bool IsLaneBound() const { return LaneId != INDEX_NONE; }
+
+	/**
+	 * Aracı bir şeride yerleştirir: spline, şerit offset'i, şerit üzerindeki mesafe ve hız
+	 * atanır ve şerit kuyruğuna kaydolur. Uzak alandan dönüşte ve senaryo yüklemede kullanılır.
+	 * Pawn'ın transform'u değiştirilmez (spawn konumu çağırıcıya aittir).
+	 */
+	void PlaceOnLane(USplineComponent* Spline, float LaneOffset, float Distance, float Speed);
+
+	/** Kalıcı araç kimliği (0 = henüz UTrafficSubsystem'e kaydolmadı). */
+	uint32 GetTrafficId() const { return TrafficId; }
+
+	// ============================================
+	// ARCHETYPE ERİŞİMİ
+	// ============================================
+
+	/** Aracın paylaşılan archetype parametreleri (sürücü varyansı uygulanmamış). */
+	const FTrafficArchetypeParams& GetArchetype() const { return FTrafficArchetypeTable::Get(ArchetypeIndex); }
+
+	/** Sürücü varyansı uygulanmış maksimum hız (cm/s). */
+	UFUNCTION(BlueprintCallable, Category = "Kinematics")
+	float GetMaxSpeed() const;
+
+	/** Maksimum frenleme (negatif ivme, cm/s²). */
+	UFUNCTION(BlueprintCallable, Category = "Kinematics")
+	float GetMaxBrakingDeceleration() const { return GetArchetype().MaxBrakingDeceleration; }
+
+	/** Sürücü varyansı uygulanmış güvenli takip mesafesi (birim). */
+	UFUNCTION(BlueprintCallable, Category = "ACC")
+	float GetSafeFollowingDistance() const;
+
+	/** Sürücü varyansı uygulanmış şerit değiştirme hızı (birim/saniye). */
+	UFUNCTION(BlueprintCallable, Category = "Lane Changing")
+	float GetLaneChangeSpeed() const;
+
+	/** Sürücü varyansı (TimeHeadway) uygulanmış IDM parametreleri. */
+	FCarFollowingParams GetCarFollowingParams() const;
+
+	/** Archetype yetenekleri (ETrafficCapability maskesi, güncelleme varyantını seçer). */
+	uint8 GetCapabilities() const { return GetArchetype().Capabilities; }
+
+	// ============================================
+	// VARYANT GÜNCELLEME
+	// ============================================
+
+	/** Bir araç grubunu aynı varyantla günceller. */
+	using FUpdateGroupFunction = void (*)(TArrayView<AVehicleAIController* const> Group, float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * Yetenek maskesine göre derlenmiş grup güncellemesini döndürür.
+	 *
+	 * @param Capabilities ETrafficCapability maskesi
+	 * @param bGeneric true = yetenekler çalışma zamanında okunur (karşılaştırma için)
+	 */
+	static FUpdateGroupFunction GetUpdateGroupFunction(uint8 Capabilities, bool bGeneric);
+
 private:
+	friend class UTrafficSubsystem;
+	friend class FTrafficManeuverScheduler;
+	friend class UTrafficPedestrianSubsystem;
+	friend class UTrafficRecordingSubsystem;
+	friend class UTrafficReplicationSubsystem;
+	friend class FTrafficRegionHandoff;
+
+	/**
+	 * Şerit kaydını TargetSpline ve TargetLaneOffset ile senkronize eder.
+	 * Spline değiştiğinde veya şerit değiştirildiğinde araç yeni şeride taşınır.
+	 */
+	void SyncLaneRegistration();
+
+	/** Kalıcı kimliği atar ve sürücü varyansını kimlikten üretir. */
+	void AssignTrafficId(uint32 InTrafficId);
+
+	/**
+	 * Karelik sürüş güncellemesi (şerit kaydı, ön yol, sinyal, hız, şerit offset'i, direksiyon).
+	 * PolicyType'ın derleme zamanında kapattığı yeteneklerin dalları derlenmez.
+	 */
+	template<typename PolicyType>
+	void UpdateDriving(float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+
+	/** CheckForwardPath'in politika ile derlenen gövdesi. */
+	template<typename PolicyType>
+	bool EvaluateForwardPath(FHitResult& OutHitResult);
+
+	/**
+	 * Son ön yol kararı bu karede de geçerli mi (ışın atılmaz). Engel son taramadaki yaklaşma
+	 * hızıyla gelmeye devam eder varsayılır; kalan açıklık (katedilen yol ve engelin yaklaşması
+	 * düşülerek) bu karenin yolu ve şimdiki duruş mesafesine (CalculateBrakingDistance) sığmıyorsa,
+	 * doluluk ızgarası şerit penceresine yeni bir araç girdiğini gösteriyorsa, pencerede (veya
+	 * ForwardTraceMaxInterval içinde girebilecek mesafede) trafiğe ait olmayan bir pawn varsa,
+	 * süre dolduysa, araç döndüyse veya panik durumu değiştiyse false. Boş taramada yaklaşma hızı
+	 * ForwardTraceAssumedClosingSpeed kabul edilir; ızgarada ve oyuncu / dış pawn listesinde
+	 * olmayan bir engel bu hızdan hızlı gelmedikçe iki tarama arasında fren mesafesine giremez.
+	 *
+	 * @param MaxInterval İki tarama arasındaki en uzun süre (saniye, <= 0 = her karede tara)
+	 */
+	bool CanReuseForwardPath(float DeltaTime, float MaxInterval, UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * Taramadan sonra bir sonraki tarama süresini açıklıktan belirler: şimdiki hız, engelin
+	 * yaklaşma hızı ve en büyük ivmeyle açıklığın duruş mesafesi üstündeki payı tükenene kadar
+	 * (MaxInterval ile sınırlı). Işın boşsa yaklaşma hızı ForwardTraceAssumedClosingSpeed'dir.
+	 * Şerit penceresindeki araç sayısı da burada kaydedilir.
+	 */
+	void ScheduleForwardTrace(const FHitResult& HitResult, float MaxInterval, UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * Bu karenin kararlarından davranış olaylarını türetir ve geçiş tablosuna uygular
+	 * (panik, şerit değiştirme, hareket sırasıyla).
+	 */
+	template<typename PolicyType>
+	void UpdateBehavior();
+
+	/** Olayı geçiş tablosuna uygular, durum değiştiyse SetBehavior çağırır. */
+	void ApplyBehaviorEvent(EVehicleBehaviorEvent Event);
+
+	/** Durumu değiştirir (subsystem kovası taşınır, direksiyon gerekmeyen durumda direksiyon sıfırlanır). */
+	void SetBehavior(EVehicleBehavior NewBehavior);
+
+	/** Şerit değiştirme yönündeki yan sensör (sadece LaneChanging kovası). */
+	void UpdateLaneChangeSideCheck();
+
+	/**
+	 * Sollama veya dönüş için planlama isteği gönderir (şerit değiştirmiyorsa, aralıkla).
+	 * Sollanacak lider olup olmadığına planlayıcı karar verir.
+	 */
+	void UpdateOvertaking(float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * Planlayıcının seçtiği manevrayı başlatır (UTrafficSubsystem, oyun thread'i).
+	 *
+	 * @param Maneuver Seçilen aday
+	 * @param bReturn true = eski şeride dönüş
+	 */
+	void BeginOvertake(const FTrafficOvertakeManeuver& Maneuver, bool bReturn);
+
+	template<typename PolicyType>
+	static void UpdateGroup(TArrayView<AVehicleAIController* const> Group, float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+
+	/**
+	 * CheckForwardPath ve IsSidePathClear'ın ortak tarama parametreleri.
+	 * Possess sırasında bir kez kurulur (kendi aracımız yoksayılır); her karede
+	 * yeni FCollisionQueryParams ve yoksayılan aktör listesi oluşturulmaz.
+	 */
+	FCollisionQueryParams TraceParams;
+
+	/**
+	 * Tarama yanıtları. ACC yeteneği olmayan archetype'larda Pawn nesneleri ışını
+	 * durdurmaz (örtüşme); TraceForwardSkippingLaneVehicles şeride bağlı AI araçlarını
+	 * eler, oyuncu aracı ve yayalar engel olarak kalır.
+	 */
+	FCollisionResponseParams TraceResponseParams;
+
+	/** ACC olmayan ileri taramanın isabet tamponu (kapasite karelerce korunur). */
+	TArray<FHitResult> ForwardTraceHits;
+
+	/**
+	 * ACC olmayan varyantın ileri taraması. Çoklu ışın atar ve şerit kuyruğunda takip
+	 * edilen (şeride bağlı) AI araçlarını atlayarak ilk gerçek engeli döndürür.
+	 *
+	 * @param World Tarama dünyası
+	 * @param StartLocation Işın başlangıcı
+	 * @param EndLocation Işın sonu
+	 * @param OutHitResult İlk engel (varsa)
+	 * @return Engel bulunduysa true
+	 */
+	bool TraceForwardSkippingLaneVehicles(UWorld* World, const FVector& StartLocation, const FVector& EndLocation, FHitResult& OutHitResult);
+
+	/**
+	 * Şeride bağlı araçlarda bir sonraki sinyali şerit indeksinden sorgular (ışın gerekmez).
+	 * Işığın tahmini varış anındaki durumu Red veya Yellow ise ve durma çizgisine kalan
+	 * mesafe CalculateBrakingDistance() değerine inmişse TargetSpeed 0'a çekilir.
+	 *
+	 * @param DeltaTime Frame süresi (saniye) - bir karelik yol payı için
+	 * @param TrafficSubsystem Çağıranın subsystem'i (null = önde sinyal yok sayılır)
+	 */
+	void ApplySignalLookahead(float DeltaTime, UTrafficSubsystem* TrafficSubsystem);
+
 	/**
 	 * Panik modunu kapatmak için kullanılan private fonksiyon.
-	 * Timer tarafından 10 saniye sonra çağrılır.
+	 * UTrafficSubsystem'in panik çarkı tarafından süre dolunca çağrılır.
 	 */
 	void DisablePanicMode();
 };
@@ -8,6 +8,8 @@
 #include "VehicleAIController.h"
 #include "Vehicle.generated.h"
 
+class UTrafficArchetype;
+
 /**
  * Araç sınıfı.
  * APawn'dan türeyen bu sınıf, araçların görsel temsilini ve hareket mekanizmasını sağlar.
@@ -29,10 +31,34 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "AI")
 	TSubclassOf<AVehicleAIController> AIControllerClass;
 
+	/** Archetype'ın FTrafficArchetypeTable indeksi (PostInitializeComponents'te çözülür). */
+	uint16 GetArchetypeIndex() const { return ArchetypeIndex; }
+
+	/** Atanmış archetype asset'i (nullptr = varsayılan parametreler). */
+	const UTrafficArchetype* GetArchetypeAsset() const { return Archetype; }
+
 protected:
+	// Called after components are initialized (archetype, controller possess etmeden önce çözülür)
+	virtual void PostInitializeComponents() override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// ============================================
+	// ARCHETYPE
+	// ============================================
+
+	/**
+	 * Sürücü / araç archetype'ı ("temkinli işe giden", "taksi", "otobüs").
+	 * Maksimum hız, direksiyon açısı ve sürücü parametreleri aynı archetype'taki
+	 * tüm araçlarca paylaşılır. Boş ise varsayılan parametreler kullanılır.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Archetype")
+	UTrafficArchetype* Archetype;
+
+	/** Archetype'ın tablo indeksi. */
+	uint16 ArchetypeIndex;
+
 	// ============================================
 	// COMPONENT'LER
 	// ============================================
@@ -74,20 +100,6 @@ protected:
 	// HAREKET PARAMETRELERİ
 	// ============================================
 
-	/**
-	 * Maksimum hız (cm/s veya m/s).
-	 * ApplyMovement fonksiyonunda kullanılır.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
-	float MaxMovementSpeed;
-
-	/**
-	 * Maksimum direksiyon açısı (derece).
-	 * ApplySteering fonksiyonunda kullanılır.
-	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0", ClampMax = "90.0"))
-	float MaxSteeringAngle;
-
 	/**
 	 * Hareket gücü çarpanı.
 	 * Hızın ne kadar güçlü uygulanacağını belirler.
@@ -102,6 +114,12 @@ public:
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	// Called when a controller possesses this pawn (runtime spawn / far field promotion)
+	virtual void PossessedBy(AController* NewController) override;
+
+	// Called when the controller releases this pawn
+	virtual void UnPossessed() override;
+
 	// ============================================
 	// HAREKET FONKSİYONLARI
 	// ============================================